@@ -253,7 +253,8 @@ done
 #
 # make speed_cppad in case make check above is commented out
 echo_log_eval make -j $n_job speed_cppad
-for option in onetape colpack optimize atomic memory boolsparsity
+for option in onetape colpack optimize atomic memory boolsparsity \
+    star acyclic bidirectional
 do
     #
     echo_eval speed/cppad/speed_cppad correct 432 $option
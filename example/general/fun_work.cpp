@@ -0,0 +1,101 @@
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-22 Bradley M. Bell
+
+CppAD is distributed under the terms of the
+             Eclipse Public License Version 2.0.
+
+This Source Code may also be made available under the following
+Secondary License when the conditions for such availability set forth
+in the Eclipse Public License, Version 2.0 are satisfied:
+      GNU General Public License, Version 2.0 or later.
+---------------------------------------------------------------------------- */
+
+/*
+$begin fun_work.cpp$$
+$spell
+    Cpp
+$$
+
+$section Forward and Reverse Using a Workspace: Example and Test$$
+
+$srcthisfile%0%// BEGIN C++%// END C++%1%$$
+
+$end
+*/
+// BEGIN C++
+# include <cppad/cppad.hpp>
+
+bool fun_work(void)
+{   bool ok = true;
+    using CppAD::AD;
+    using CppAD::NearEqual;
+    double eps = 10. * std::numeric_limits<double>::epsilon();
+
+    // domain space vector
+    size_t n = 2;
+    CPPAD_TESTVECTOR(AD<double>) ax(n);
+    ax[0] = 0.;
+    ax[1] = 1.;
+
+    // declare independent variables and starting recording
+    CppAD::Independent(ax);
+
+    // range space vector
+    size_t m = 1;
+    CPPAD_TESTVECTOR(AD<double>) ay(m);
+    ay[0] = ax[0] * ax[0] * ax[1];
+
+    // create f: x -> y and stop tape recording
+    // (f is const after this point)
+    const CppAD::ADFun<double> f(ax, ay);
+
+    // two workspaces for the same function
+    CppAD::fun_work<double> work_a, work_b;
+    ok &= work_a.size_order() == 0;
+
+    // zero order forward using the first workspace
+    CPPAD_TESTVECTOR(double) xa(n), ya(m);
+    xa[0] = 3.;
+    xa[1] = 4.;
+    ya    = f.forward(work_a, 0, xa);
+    ok   &= NearEqual(ya[0] , xa[0]*xa[0]*xa[1], eps, eps);
+    ok   &= work_a.size_order() == 1;
+
+    // zero order forward using the second workspace
+    CPPAD_TESTVECTOR(double) xb(n), yb(m);
+    xb[0] = 5.;
+    xb[1] = 6.;
+    yb    = f.forward(work_b, 0, xb);
+    ok   &= NearEqual(yb[0] , xb[0]*xb[0]*xb[1], eps, eps);
+
+    // first order forward using the first workspace (partial w.r.t. x_0)
+    CPPAD_TESTVECTOR(double) dx(n), dy(m);
+    dx[0] = 1.;
+    dx[1] = 0.;
+    dy    = f.forward(work_a, 1, dx);
+    ok   &= NearEqual(dy[0] , 2.*xa[0]*xa[1], eps, eps);
+    ok   &= work_a.size_order() == 2;
+
+    // first order reverse using the second workspace (derivative at xb)
+    CPPAD_TESTVECTOR(double) w(m), dw(n);
+    w[0] = 1.;
+    dw   = f.reverse(work_b, 1, w);
+    ok  &= NearEqual(dw[0] , 2.*xb[0]*xb[1], eps, eps);
+    ok  &= NearEqual(dw[1] ,    xb[0]*xb[0], eps, eps);
+
+    // second order reverse using the first workspace
+    CPPAD_TESTVECTOR(double) ddw(n * 2);
+    ddw = f.reverse(work_a, 2, w);
+    ok &= NearEqual(ddw[0 * 2 + 0] , 2.*xa[0]*xa[1], eps, eps);
+    ok &= NearEqual(ddw[1 * 2 + 0] ,    xa[0]*xa[0], eps, eps);
+    ok &= NearEqual(ddw[0 * 2 + 1] ,    2.*xa[1],    eps, eps);
+    ok &= NearEqual(ddw[1 * 2 + 1] ,    2.*xa[0],    eps, eps);
+
+    // free the memory held by the workspaces
+    work_a.clear();
+    work_b.clear();
+    ok &= work_a.size_order() == 0;
+
+    return ok;
+}
+// END C++
@@ -127,6 +127,7 @@ extern bool forward_dir(void);
 extern bool forward_order(void);
 extern bool fun_assign(void);
 extern bool fun_property(void);
+extern bool fun_work(void);
 extern bool function_name(void);
 extern bool interp_onetape(void);
 extern bool interp_retape(void);
@@ -241,6 +242,7 @@ int main(void)
     Run( forward_order,     "forward_order"    );
     Run( fun_assign,        "fun_assign"       );
     Run( fun_property,      "fun_property"     );
+    Run( fun_work,          "fun_work"         );
     Run( function_name,     "function_name"    );
     Run( interp_onetape,    "interp_onetape"   );
     Run( interp_retape,     "interp_retape"    );
@@ -0,0 +1,87 @@
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-22 Bradley M. Bell
+
+CppAD is distributed under the terms of the
+             Eclipse Public License Version 2.0.
+
+This Source Code may also be made available under the following
+Secondary License when the conditions for such availability set forth
+in the Eclipse Public License, Version 2.0 are satisfied:
+      GNU General Public License, Version 2.0 or later.
+---------------------------------------------------------------------------- */
+/*
+$begin optimize_cache_plan.cpp$$
+$spell
+    retaped
+$$
+
+$section Re-Optimizing a Function With the Same Structure: Example and Test$$
+
+$head Discussion$$
+The function $latex f(x) = c \exp(x_0) + \sin(x_1) \sin(x_1)$$
+is retaped for different values of the constant $latex c$$.
+The structure of the operation sequence does not depend on $latex c$$,
+so the analysis done by the first $code optimize$$ is used for the
+other values of $latex c$$.
+
+$srcthisfile%0%// BEGIN C++%// END C++%1%$$
+
+$end
+*/
+// BEGIN C++
+# include <cppad/cppad.hpp>
+namespace {
+    template <class Scalar>
+    void fun(const Scalar& c, const CppAD::vector<Scalar>& x, CppAD::vector<Scalar>& y)
+    {   // sin(x[1]) is a common sub-expression
+        y[0] = c * exp( x[0] ) + sin( x[1] ) * sin( x[1] );
+    }
+}
+bool cache_plan(void)
+{   bool ok = true;
+    using CppAD::AD;
+    using CppAD::vector;
+    double eps99 = 99.0 * std::numeric_limits<double>::epsilon();
+
+    size_t n = 2, m = 1;
+    vector< AD<double> > ax(n), ay(m);
+    vector<double> x(n), y(m), check(m);
+    ax[0] = 0.5;
+    ax[1] = 1.0;
+    x[0]  = 0.25;
+    x[1]  = 0.75;
+    //
+    CppAD::ADFun<double> f;
+    size_t size_var = 0;
+    for(size_t k = 0; k < 3; ++k)
+    {   // retape f with a different value for the constant c
+        double c = double(k + 2);
+        Independent(ax);
+        fun(AD<double>(c), ax, ay);
+        f.Dependent(ax, ay);
+        //
+        // the first optimization saves the plan, the others use it
+        f.optimize("cache_plan");
+        if( k == 0 )
+            size_var = f.size_var();
+        ok &= f.size_var() == size_var;
+        //
+        // check zero order forward for this value of c
+        y = f.Forward(0, x);
+        fun(c, x, check);
+        ok &= CppAD::NearEqual(y[0], check[0], eps99, eps99);
+    }
+    //
+    // retape with a different structure (c is zero), the analysis is done
+    // again and its result replaces the saved plan
+    Independent(ax);
+    ay[0] = exp( ax[0] ) + ax[1];
+    f.Dependent(ax, ay);
+    f.optimize("cache_plan");
+    y   = f.Forward(0, x);
+    ok &= CppAD::NearEqual(y[0], exp(x[0]) + x[1], eps99, eps99);
+    //
+    return ok;
+}
+
+// END C++
@@ -0,0 +1,102 @@
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-22 Bradley M. Bell
+
+CppAD is distributed under the terms of the
+             Eclipse Public License Version 2.0.
+
+This Source Code may also be made available under the following
+Secondary License when the conditions for such availability set forth
+in the Eclipse Public License, Version 2.0 are satisfied:
+      GNU General Public License, Version 2.0 or later.
+---------------------------------------------------------------------------- */
+/*
+$begin optimize_dynamic_param.cpp$$
+$spell
+    CppAD
+    azmul
+$$
+
+$section Optimize Dynamic Parameter Operations: Example and Test$$
+
+$head Discussion$$
+The optimizer removes dynamic parameter operations that are
+the same as a previous operation,
+that only depend on constants,
+or that are equal to one of their arguments; e.g.,
+$latex p \times 1 = p$$.
+
+$srcthisfile%0%// BEGIN C++%// END C++%1%$$
+
+$end
+*/
+// BEGIN C++
+# include <cppad/cppad.hpp>
+namespace {
+    template <class Scalar>
+    Scalar fun(const Scalar& x, const Scalar& p0, const Scalar& p1)
+    {   Scalar one  = Scalar(1.0);
+        Scalar zero = Scalar(0.0);
+        //
+        // identical conditional expressions
+        Scalar c1 = CppAD::CondExpLt(p0, p1, p0, p1);
+        Scalar c2 = CppAD::CondExpLt(p0, p1, p0, p1);
+        //
+        // multiplication by one and azmul by zero
+        Scalar d1 = p0 * one;
+        Scalar d2 = CppAD::azmul(zero, p1);
+        //
+        // a conditional expression that has the same true and false cases
+        Scalar e1 = CppAD::CondExpGt(p0, p1, d1, p0);
+        //
+        // a function of a constant
+        Scalar e2 = exp(d2);
+        //
+        return x * (c1 + c2 + e1 + e2);
+    }
+}
+bool dynamic_param(void)
+{   bool ok = true;
+    using CppAD::AD;
+    using CppAD::vector;
+
+    // independent dynamic parameters
+    vector< AD<double> > ap(2);
+    ap[0] = 1.0;
+    ap[1] = 2.0;
+    //
+    // independent variables
+    vector< AD<double> > ax(1);
+    ax[0] = 3.0;
+    //
+    // record f(x; p)
+    size_t abort_op_index = 0;
+    bool   record_compare = true;
+    CppAD::Independent(ax, abort_op_index, record_compare, ap);
+    vector< AD<double> > ay(1);
+    ay[0] = fun(ax[0], ap[0], ap[1]);
+    CppAD::ADFun<double> f(ax, ay);
+    //
+    // optimize f
+    size_t size_dyn_par = f.size_dyn_par();
+    f.optimize();
+    //
+    // The optimized version only needs the two independent dynamic parameters,
+    // one conditional expression, and the three additions.
+    ok &= f.size_dyn_par() < size_dyn_par;
+    ok &= f.size_dyn_par() == 2 + 1 + 3;
+    //
+    // check the values for different dynamic parameters
+    vector<double> p(2), x(1), y(1);
+    for(size_t k = 0; k < 2; ++k)
+    {   p[0] = double(3 * k);
+        p[1] = 2.0;
+        x[0] = 4.0;
+        f.new_dynamic(p);
+        y = f.Forward(0, x);
+        ok &= y[0] == fun(x[0], p[0], p[1]);
+    }
+    //
+    return ok;
+}
+
+// END C++
@@ -22,14 +22,19 @@ in the Eclipse Public License, Version 2.0 are satisfied:
 # include <cppad/utility/test_boolofvoid.hpp>
 
 // external complied tests
+extern bool cache_plan(void);
 extern bool compare_op(void);
 extern bool conditional_skip(void);
 extern bool cumulative_sum(void);
+extern bool dynamic_param(void);
 extern bool forward_active(void);
 extern bool nest_conditional(void);
 extern bool print_for(void);
+extern bool report(void);
 extern bool reverse_active(void);
+extern bool skip_threshold(void);
 extern bool optimize_twice(void);
+extern bool zero_order_only(void);
 
 // main program that runs all the tests
 int main(void)
@@ -40,14 +45,19 @@ int main(void)
     // This line is used by test_one.sh
 
     // external compiled tests
+    Run( cache_plan,          "cache_plan"         );
     Run( cumulative_sum,      "compare_op"         );
     Run( cumulative_sum,      "cumulative_sum"     );
     Run( conditional_skip,    "conditional_skip"   );
+    Run( dynamic_param,       "dynamic_param"      );
     Run( forward_active,      "forward_active"     );
     Run( nest_conditional,    "nest_conditional"   );
     Run( print_for,           "print_for"          );
+    Run( report,              "report"             );
     Run( reverse_active,      "reverse_active"     );
     Run( optimize_twice,         "re_optimize"        );
+    Run( skip_threshold,      "skip_threshold"     );
+    Run( zero_order_only,     "zero_order_only"    );
     //
     // check for memory leak
     bool memory_ok = CppAD::thread_alloc::free_all();
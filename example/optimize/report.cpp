@@ -0,0 +1,105 @@
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-22 Bradley M. Bell
+
+CppAD is distributed under the terms of the
+             Eclipse Public License Version 2.0.
+
+This Source Code may also be made available under the following
+Secondary License when the conditions for such availability set forth
+in the Eclipse Public License, Version 2.0 are satisfied:
+      GNU General Public License, Version 2.0 or later.
+---------------------------------------------------------------------------- */
+/*
+$begin optimize_report.cpp$$
+
+$section Optimize Report: Example and Test$$
+
+$srcthisfile%0%// BEGIN C++%// END C++%1%$$
+
+$end
+*/
+// BEGIN C++
+# include <cppad/cppad.hpp>
+# include <sstream>
+bool report(void)
+{   bool ok = true;
+    using CppAD::AD;
+    using CppAD::vector;
+
+    // independent variables
+    size_t n = 3;
+    vector< AD<double> > ax(n);
+    ax[0] = 0.5;
+    ax[1] = 1.0;
+    ax[2] = 2.0;
+    CppAD::Independent(ax);
+    //
+    // exp(x[1]) does not affect the dependent variables
+    AD<double> dead = exp( ax[1] );
+    //
+    // sin(x[0]) is a common sub-expression
+    AD<double> cse  = sin( ax[0] ) * sin( ax[0] );
+    //
+    // this summation becomes a cumulative summation
+    AD<double> sum  = ax[0] + ax[1] + ax[2];
+    //
+    // only one of exp(x[2]) and cos(x[2]) is needed
+    AD<double> cexp = CppAD::CondExpLt(
+        ax[0], ax[1], exp( ax[2] ), cos( ax[2] )
+    );
+    //
+    vector< AD<double> > ay(1);
+    ay[0] = cse + sum + cexp;
+    CppAD::ADFun<double> f;
+    f.Dependent(ax, ay);
+    //
+    // the report is not valid before the function is optimized
+    ok &= ! f.optimize_report().valid;
+    //
+    // optimize f
+    size_t size_var_before = f.size_var();
+    f.optimize();
+    const CppAD::optimize_report& report( f.optimize_report() );
+    ok &= report.valid;
+    ok &= ! report.used_plan;
+    //
+    // dead code elimination removed exp(x[1])
+    ok &= report.dead_op == 1;
+    ok &= report.dead_var == 1;
+    //
+    // common sub-expression elimination removed the second sin(x[0])
+    // (a sine operator has two results, the sine and cosine)
+    ok &= report.cse_op == 1;
+    ok &= report.cse_var == 2;
+    //
+    // additions were combined into cumulative summations
+    ok &= report.csum_op > 0;
+    //
+    // one conditional skip operator that can skip exp(x[2]) or cos(x[2])
+    ok &= report.cskip_op == 1;
+    ok &= report.cskip_skip >= 2;
+    //
+    // size of the operation sequence before and after
+    ok &= report.size_var_before == size_var_before;
+    ok &= report.size_var_after  == f.size_var();
+    ok &= report.size_var_after  <  size_var_before;
+    ok &= report.size_op_after   == f.size_op();
+    //
+    // time spent in the optimizer
+    ok &= 0.0 <= report.time_record;
+    ok &= report.time_record <= report.time_total;
+    //
+    // the report can be written to an output stream
+    std::stringstream ss;
+    ss << report;
+    ok &= ss.str().substr(0, 16) == "optimize_report:";
+    //
+    // a new operation sequence has not been optimized
+    CppAD::Independent(ax);
+    ay[0] = ax[0] + ax[1];
+    f.Dependent(ax, ay);
+    ok &= ! f.optimize_report().valid;
+    //
+    return ok;
+}
+// END C++
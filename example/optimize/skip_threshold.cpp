@@ -0,0 +1,112 @@
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-22 Bradley M. Bell
+
+CppAD is distributed under the terms of the
+             Eclipse Public License Version 2.0.
+
+This Source Code may also be made available under the following
+Secondary License when the conditions for such availability set forth
+in the Eclipse Public License, Version 2.0 are satisfied:
+      GNU General Public License, Version 2.0 or later.
+---------------------------------------------------------------------------- */
+/*
+$begin optimize_skip_threshold.cpp$$
+$spell
+    cskip
+$$
+
+$section Conditional Skip Threshold: Example and Test$$
+
+$head Discussion$$
+The function below has two conditional expressions.
+The first has a large branch (four variables) and the second only
+has small branches (one variable each).
+Using the option $code conditional_skip_threshold=2$$,
+a conditional skip operator is only generated for the first one.
+The skipped operators are also skipped during first order forward
+and reverse mode.
+
+$srcthisfile%0%// BEGIN C++%// END C++%1%$$
+
+$end
+*/
+// BEGIN C++
+# include <cppad/cppad.hpp>
+namespace {
+    template <class Scalar>
+    Scalar fun(const CppAD::vector<Scalar>& x)
+    {   // large branch: four variables
+        Scalar big = exp( x[1] ) * x[1] + 2.0;
+        big        = big * big;
+        Scalar y   = CppAD::CondExpLt(x[0], x[1], x[0], big);
+        //
+        // small branches: one variable each
+        y += CppAD::CondExpLt(x[0], x[2], 2.0 * x[2], 3.0 * x[2]);
+        return y;
+    }
+}
+bool skip_threshold(void)
+{   bool ok = true;
+    using CppAD::AD;
+    using CppAD::vector;
+    using CppAD::NearEqual;
+    double eps99 = 99.0 * std::numeric_limits<double>::epsilon();
+
+    // record f(x)
+    size_t n = 3;
+    vector< AD<double> > ax(n), ay(1);
+    ax[0] = 0.0;
+    ax[1] = 1.0;
+    ax[2] = 2.0;
+    CppAD::Independent(ax);
+    ay[0] = fun(ax);
+    CppAD::ADFun<double> f;
+    f.Dependent(ax, ay);
+    //
+    // optimize f
+    f.optimize("conditional_skip_threshold=2");
+    //
+    // only the first conditional expression has a skip operator
+    ok &= f.optimize_report().cskip_op == 1;
+    //
+    // x[0] < x[1] is true so the large branch is skipped
+    vector<double> x(n), y(1), check(1);
+    x[0] = 0.5;
+    x[1] = 1.0;
+    x[2] = 0.25;
+    y    = f.Forward(0, x);
+    ok  &= f.number_skip() == 4;
+    check[0] = fun(x);
+    ok  &= NearEqual(y[0], check[0], eps99, eps99);
+    //
+    // first order forward and reverse mode skip the same operators
+    // f'(x) = (1, 0, 3)
+    vector<double> dx(n), dy(1), w(1), dw(n);
+    for(size_t j = 0; j < n; ++j)
+    {   for(size_t k = 0; k < n; ++k)
+            dx[k] = 0.0;
+        dx[j] = 1.0;
+        dy    = f.Forward(1, dx);
+        check[0] = 0.0;
+        if( j == 0 )
+            check[0] = 1.0;
+        if( j == 2 )
+            check[0] = 3.0;
+        ok &= NearEqual(dy[0], check[0], eps99, eps99);
+    }
+    w[0] = 1.0;
+    dw   = f.Reverse(1, w);
+    ok  &= NearEqual(dw[0], 1.0, eps99, eps99);
+    ok  &= NearEqual(dw[1], 0.0, eps99, eps99);
+    ok  &= NearEqual(dw[2], 3.0, eps99, eps99);
+    //
+    // the default threshold generates a skip operator for both
+    CppAD::Independent(ax);
+    ay[0] = fun(ax);
+    f.Dependent(ax, ay);
+    f.optimize();
+    ok &= f.optimize_report().cskip_op == 2;
+    //
+    return ok;
+}
+// END C++
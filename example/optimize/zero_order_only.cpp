@@ -0,0 +1,99 @@
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-22 Bradley M. Bell
+
+CppAD is distributed under the terms of the
+             Eclipse Public License Version 2.0.
+
+This Source Code may also be made available under the following
+Secondary License when the conditions for such availability set forth
+in the Eclipse Public License, Version 2.0 are satisfied:
+      GNU General Public License, Version 2.0 or later.
+---------------------------------------------------------------------------- */
+/*
+$begin optimize_zero_order_only.cpp$$
+
+$section Optimize Zero Order Only Slot Reuse: Example and Test$$
+
+
+$srcthisfile%0%// BEGIN C++%// END C++%1%$$
+
+$end
+*/
+// BEGIN C++
+# include <cppad/cppad.hpp>
+
+namespace {
+    template <class Vector> void fun(const Vector& x, Vector& y)
+    {   typedef typename Vector::value_type scalar;
+        //
+        // a long chain of intermediate values that are only used once
+        scalar z = x[0];
+        for(size_t k = 0; k < 50; ++k)
+            z = sin(z) * x[1] + cos(z);
+        //
+        // a conditional expression
+        scalar zero(0.0);
+        y[0] = CppAD::CondExpLt(z, zero, z * z, exp(z) );
+        //
+        // a value that is used again after a long time
+        y[1] = y[0] + x[0];
+    }
+}
+bool zero_order_only(void)
+{   bool ok = true;
+    using CppAD::AD;
+    using CppAD::NearEqual;
+    double eps99 = 99.0 * std::numeric_limits<double>::epsilon();
+
+    // domain space vector
+    size_t n  = 2;
+    CPPAD_TESTVECTOR(AD<double>) ax(n);
+    ax[0] = 0.5;
+    ax[1] = 1.5;
+
+    // declare independent variables and start tape recording
+    CppAD::Independent(ax);
+
+    // range space vector
+    size_t m = 2;
+    CPPAD_TESTVECTOR(AD<double>) ay(m);
+    fun(ax, ay);
+
+    // create f: x -> y and stop tape recording
+    CppAD::ADFun<double> f(ax, ay);
+
+    // Optimize the operation sequence for zero order forward only
+    f.optimize("zero_order_only");
+
+    // Check result for a zero order calculation for a different x
+    CPPAD_TESTVECTOR(double) x(n), y(m), check(m);
+    x[0] = 0.75;
+    x[1] = 2.25;
+    y    = f.Forward(0, x);
+    fun(x, check);
+    for(size_t i = 0; i < m; ++i)
+        ok  &= NearEqual(y[i], check[i], eps99, eps99);
+
+    // Taylor coefficients are not retained for this function
+    ok &= f.size_order() == 0;
+
+    // A second zero order calculation at a different x
+    x[0] = -0.25;
+    y    = f.Forward(0, x);
+    fun(x, check);
+    for(size_t i = 0; i < m; ++i)
+        ok  &= NearEqual(y[i], check[i], eps99, eps99);
+
+    // Optimizing without zero_order_only removes the restriction
+    f.optimize();
+    y    = f.Forward(0, x);
+    ok  &= f.size_order() == 1;
+    CPPAD_TESTVECTOR(double) dx(n), dy(m);
+    dx[0] = 1.0;
+    dx[1] = 0.0;
+    dy    = f.Forward(1, dx);
+    ok   &= f.size_order() == 2;
+
+    return ok;
+}
+// END C++
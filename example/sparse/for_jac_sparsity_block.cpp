@@ -0,0 +1,125 @@
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-22 Bradley M. Bell
+
+CppAD is distributed under the terms of the
+             Eclipse Public License Version 2.0.
+
+This Source Code may also be made available under the following
+Secondary License when the conditions for such availability set forth
+in the Eclipse Public License, Version 2.0 are satisfied:
+      GNU General Public License, Version 2.0 or later.
+---------------------------------------------------------------------------- */
+/*
+$begin for_jac_sparsity_block.cpp$$
+$spell
+    Jacobian
+    Jac
+$$
+
+$section Forward Mode Jacobian Sparsity for Blocks of Columns: Example and Test$$
+
+$head Discussion$$
+The sparsity pattern for the Jacobian is computed one block of columns
+at a time and the blocks are concatenated.
+The blocks could be computed by different threads; see
+$cref/parallel mode/for_jac_sparsity_block/Parallel Mode/$$.
+
+$srcthisfile%0%// BEGIN C++%// END C++%1%$$
+
+$end
+*/
+// BEGIN C++
+# include <cppad/cppad.hpp>
+
+bool for_jac_sparsity_block(void)
+{   bool ok = true;
+    using CppAD::AD;
+    typedef CPPAD_TESTVECTOR(size_t)     SizeVector;
+    typedef CppAD::sparse_rc<SizeVector> sparsity;
+    //
+    // domain space vector
+    size_t n = 5;
+    CPPAD_TESTVECTOR(AD<double>) ax(n);
+    for(size_t j = 0; j < n; ++j)
+        ax[j] = double(j + 1);
+
+    // declare independent variables and start recording
+    CppAD::Independent(ax);
+
+    // range space vector
+    size_t m = 3;
+    CPPAD_TESTVECTOR(AD<double>) ay(m);
+    ay[0] = ax[0] * ax[4];
+    ay[1] = ax[1] + ax[2];
+    ay[2] = sin( ax[3] );
+
+    // create f: x -> y and stop tape recording
+    CppAD::ADFun<double> f(ax, ay);
+
+    // sparsity pattern for the identity matrix
+    sparsity pattern_in(n, n, n);
+    for(size_t k = 0; k < n; k++)
+        pattern_in.set(k, k, k);
+    //
+    // pattern for the entire Jacobian
+    bool transpose       = false;
+    bool dependency      = false;
+    bool internal_bool   = true;
+    sparsity pattern_full;
+    f.for_jac_sparsity(
+        pattern_in, transpose, dependency, internal_bool, pattern_full
+    );
+    //
+    // compute the pattern using blocks with at most two columns
+    // and concatenate the blocks
+    size_t n_block = 2;
+    std::vector<size_t> row_all, col_all;
+    for(size_t col_begin = 0; col_begin < n; col_begin += n_block)
+    {   size_t col_end = std::min(col_begin + n_block, n);
+        sparsity pattern_block;
+        f.for_jac_sparsity_block(
+            pattern_in, transpose, dependency,
+            col_begin, col_end, pattern_block
+        );
+        ok &= pattern_block.nr() == m;
+        ok &= pattern_block.nc() == n;
+        for(size_t k = 0; k < pattern_block.nnz(); ++k)
+        {   size_t c = pattern_block.col()[k];
+            ok &= col_begin <= c && c < col_end;
+            row_all.push_back( pattern_block.row()[k] );
+            col_all.push_back( c );
+        }
+    }
+    sparsity pattern_out(m, n, row_all.size());
+    for(size_t k = 0; k < row_all.size(); ++k)
+        pattern_out.set(k, row_all[k], col_all[k]);
+    //
+    // check that the two patterns are the same
+    size_t nnz = pattern_out.nnz();
+    ok        &= nnz == 5;
+    ok        &= nnz == pattern_full.nnz();
+    SizeVector row_major      = pattern_out.row_major();
+    SizeVector row_major_full = pattern_full.row_major();
+    for(size_t k = 0; k < nnz; ++k)
+    {   size_t k_out  = row_major[k];
+        size_t k_full = row_major_full[k];
+        ok &= pattern_out.row()[k_out] == pattern_full.row()[k_full];
+        ok &= pattern_out.col()[k_out] == pattern_full.col()[k_full];
+    }
+    //
+    // transposed block for columns one and two (rows of J^T)
+    transpose = true;
+    f.for_jac_sparsity_block(
+        pattern_in, transpose, dependency, 1, 3, pattern_out
+    );
+    ok &= pattern_out.nr() == n;
+    ok &= pattern_out.nc() == m;
+    ok &= pattern_out.nnz() == 2;
+    for(size_t k = 0; k < pattern_out.nnz(); ++k)
+    {   ok &= pattern_out.row()[k] == 1 || pattern_out.row()[k] == 2;
+        ok &= pattern_out.col()[k] == 1;
+    }
+    //
+    return ok;
+}
+// END C++
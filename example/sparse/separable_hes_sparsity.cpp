@@ -0,0 +1,122 @@
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-22 Bradley M. Bell
+
+CppAD is distributed under the terms of the
+             Eclipse Public License Version 2.0.
+
+This Source Code may also be made available under the following
+Secondary License when the conditions for such availability set forth
+in the Eclipse Public License, Version 2.0 are satisfied:
+      GNU General Public License, Version 2.0 or later.
+---------------------------------------------------------------------------- */
+/*
+$begin separable_hes_sparsity.cpp$$
+$spell
+    Hessian
+$$
+
+$section Hessian Sparsity for a Sum of Terms: Example and Test$$
+
+$head Discussion$$
+The first component of the function below is a sum of terms
+where each term depends on at most two independent variables.
+Its Hessian sparsity pattern is the same as the one computed by
+$cref for_hes_sparsity$$.
+The second component is a single term $latex x_0 x_1$$,
+for which the diagonal entries are included in the pattern.
+
+$srcthisfile%0%// BEGIN C++%// END C++%1%$$
+
+$end
+*/
+// BEGIN C++
+# include <cppad/cppad.hpp>
+
+bool separable_hes_sparsity(void)
+{   bool ok = true;
+    using CppAD::AD;
+    typedef CPPAD_TESTVECTOR(size_t)     SizeVector;
+    typedef CPPAD_TESTVECTOR(bool)       BoolVector;
+    typedef CppAD::sparse_rc<SizeVector> sparsity;
+    //
+    // domain space vector
+    size_t n = 6;
+    CPPAD_TESTVECTOR(AD<double>) ax(n);
+    for(size_t j = 0; j < n; ++j)
+        ax[j] = double(j + 1);
+
+    // declare independent variables and start recording
+    CppAD::Independent(ax);
+
+    // range space vector
+    size_t m = 2;
+    CPPAD_TESTVECTOR(AD<double>) ay(m);
+    //
+    // sum of (x[k] * x[k+1])^2 for k = 0, 2
+    ay[0] = 0.0;
+    for(size_t k = 0; k < 4; k += 2)
+    {   AD<double> prod = ax[k] * ax[k+1];
+        ay[0] += prod * prod;
+    }
+    // plus a linear term and a conditional expression
+    ay[0] += 3.0 * ax[4] - ax[5];
+    ay[0] += CppAD::CondExpLt(ax[0], ax[1], exp( ax[4] ), ax[5] * ax[5]);
+    //
+    // a single term
+    ay[1] = ax[0] * ax[1];
+
+    // create f: x -> y and stop tape recording
+    CppAD::ADFun<double> f(ax, ay);
+    //
+    // select all the independent variables and the first dependent variable
+    BoolVector select_domain(n), select_range(m);
+    for(size_t j = 0; j < n; ++j)
+        select_domain[j] = true;
+    select_range[0] = true;
+    select_range[1] = false;
+    //
+    // sparsity pattern for the sum of terms
+    sparsity pattern_out;
+    f.separable_hes_sparsity(select_domain, select_range, pattern_out);
+    //
+    // the same pattern computed by for_hes_sparsity
+    bool internal_bool = false;
+    sparsity pattern_check;
+    f.for_hes_sparsity(
+        select_domain, select_range, internal_bool, pattern_check
+    );
+    //
+    // (0,0), (0,1), (1,0), (1,1), (2,2), (2,3), (3,2), (3,3), (4,4), (5,5)
+    size_t nnz = pattern_out.nnz();
+    ok        &= nnz == 10;
+    ok        &= pattern_out.nr() == n;
+    ok        &= pattern_out.nc() == n;
+    ok        &= pattern_check.nnz() == nnz;
+    SizeVector row_major = pattern_check.row_major();
+    for(size_t k = 0; k < nnz; ++k)
+    {   // pattern_out is in row major order
+        size_t k_check = row_major[k];
+        ok &= pattern_out.row()[k] == pattern_check.row()[k_check];
+        ok &= pattern_out.col()[k] == pattern_check.col()[k_check];
+    }
+    //
+    // the second component includes the diagonal entries
+    select_range[0] = false;
+    select_range[1] = true;
+    f.separable_hes_sparsity(select_domain, select_range, pattern_out);
+    ok &= pattern_out.nnz() == 4;
+    for(size_t k = 0; k < pattern_out.nnz(); ++k)
+    {   ok &= pattern_out.row()[k] == k / 2;
+        ok &= pattern_out.col()[k] == k % 2;
+    }
+    //
+    // do not select x[1]
+    select_domain[1] = false;
+    f.separable_hes_sparsity(select_domain, select_range, pattern_out);
+    ok &= pattern_out.nnz() == 1;
+    ok &= pattern_out.row()[0] == 0;
+    ok &= pattern_out.col()[0] == 0;
+    //
+    return ok;
+}
+// END C++
@@ -37,14 +37,19 @@ extern bool conj_grad(void);
 extern bool dependency(void);
 extern bool for_hes_sparsity(void);
 extern bool for_jac_sparsity(void);
+extern bool for_jac_sparsity_block(void);
 extern bool for_sparse_hes(void);
 extern bool rc_sparsity(void);
 extern bool rev_hes_sparsity(void);
 extern bool rev_jac_sparsity(void);
 extern bool rev_sparse_hes(void);
+extern bool separable_hes_sparsity(void);
 extern bool sparse2eigen(void);
+extern bool sparse_cache(void);
+extern bool sparse_coloring(void);
 extern bool sparse_hes(void);
 extern bool sparse_hessian(void);
+extern bool sparse_jac_color(void);
 extern bool sparse_jac_for(void);
 extern bool sparse_jac_rev(void);
 extern bool sparse_jacobian(void);
@@ -54,13 +59,14 @@ extern bool sub_sparse_hes(void);
 extern bool subgraph_hes2jac(void);
 extern bool subgraph_jac_rev(void);
 extern bool subgraph_reverse(void);
+extern bool subgraph_row_callback(void);
 extern bool subgraph_sparsity(void);
 // END_SORT_THIS_LINE_MINUS_1
 
 // main program that runs all the tests
 int main(void)
 {   std::string group = "example/sparse";
-    size_t      width = 20;
+    size_t      width = 25;
     CppAD::test_boolofvoid Run(group, width);
 
     // This line is used by test_one.sh
@@ -73,13 +79,18 @@ int main(void)
     Run( dependency,                "dependency" );
     Run( for_hes_sparsity,          "for_hes_sparsity" );
     Run( for_jac_sparsity,          "for_jac_sparsity" );
+    Run( for_jac_sparsity_block,    "for_jac_sparsity_block" );
     Run( for_sparse_hes,            "for_sparse_hes" );
     Run( rc_sparsity,               "rc_sparsity" );
     Run( rev_hes_sparsity,          "rev_hes_sparsity" );
     Run( rev_jac_sparsity,          "rev_jac_sparsity" );
     Run( rev_sparse_hes,            "rev_sparse_hes" );
+    Run( separable_hes_sparsity,    "separable_hes_sparsity" );
+    Run( sparse_cache,              "sparse_cache" );
+    Run( sparse_coloring,           "sparse_coloring" );
     Run( sparse_hes,                "sparse_hes" );
     Run( sparse_hessian,            "sparse_hessian" );
+    Run( sparse_jac_color,          "sparse_jac_color" );
     Run( sparse_jac_for,            "sparse_jac_for" );
     Run( sparse_jac_rev,            "sparse_jac_rev" );
     Run( sparse_jacobian,           "sparse_jacobian" );
@@ -89,6 +100,7 @@ int main(void)
     Run( subgraph_hes2jac,          "subgraph_hes2jac" );
     Run( subgraph_jac_rev,          "subgraph_jac_rev" );
     Run( subgraph_reverse,          "reverse_subgraph");
+    Run( subgraph_row_callback,     "subgraph_row_callback" );
     Run( subgraph_sparsity,         "subgraph_sparsity" );
     // END_SORT_THIS_LINE_MINUS_1
     //
@@ -0,0 +1,146 @@
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-22 Bradley M. Bell
+
+CppAD is distributed under the terms of the
+             Eclipse Public License Version 2.0.
+
+This Source Code may also be made available under the following
+Secondary License when the conditions for such availability set forth
+in the Eclipse Public License, Version 2.0 are satisfied:
+      GNU General Public License, Version 2.0 or later.
+---------------------------------------------------------------------------- */
+/*
+$begin sparse_cache.cpp$$
+$spell
+    Jacobian
+$$
+
+$section Cache Sparsity Patterns and Colorings: Example and Test$$
+
+$head Discussion$$
+The sparsity pattern and the coloring for a Jacobian are computed
+and written to a file.
+A second cache, read from the file, is then used to compute the
+same Jacobian for a function with the same structure
+(as would be done by another run of the same program).
+
+$srcthisfile%0%// BEGIN C++%// END C++%1%$$
+
+$end
+*/
+// BEGIN C++
+# include <cppad/cppad.hpp>
+# include <cstdio>
+
+namespace {
+    // f(x) = [ x_0 * x_1 , c * sin(x_2), x_0 + x_3 ]
+    void record(CppAD::ADFun<double>& f, double c)
+    {   using CppAD::AD;
+        size_t n = 4, m = 3;
+        CPPAD_TESTVECTOR(AD<double>) ax(n), ay(m);
+        for(size_t j = 0; j < n; ++j)
+            ax[j] = double(j + 1);
+        CppAD::Independent(ax);
+        ay[0] = ax[0] * ax[1];
+        ay[1] = c * sin( ax[2] );
+        ay[2] = ax[0] + ax[3];
+        f.Dependent(ax, ay);
+    }
+}
+
+bool sparse_cache(void)
+{   bool ok = true;
+    typedef CPPAD_TESTVECTOR(size_t)     SizeVector;
+    typedef CPPAD_TESTVECTOR(double)     DoubleVector;
+    typedef CppAD::sparse_rc<SizeVector> sparsity;
+    typedef CppAD::sparse_rcv<SizeVector, DoubleVector> sparse_matrix;
+    //
+    size_t n = 4, m = 3;
+    std::string file_name = "sparse_cache.txt";
+    //
+    // identity matrix sparsity pattern
+    sparsity pattern_in(m, m, m);
+    for(size_t k = 0; k < m; ++k)
+        pattern_in.set(k, k, k);
+    //
+    // point at which we compute the Jacobian
+    DoubleVector x(n);
+    for(size_t j = 0; j < n; ++j)
+        x[j] = double(j + 2);
+    //
+    // options for the sparsity and Jacobian calculations
+    bool transpose      = false;
+    bool dependency     = false;
+    bool internal_bool  = false;
+    std::string coloring = "cppad";
+    //
+    // compute the pattern and coloring and write them to the file
+    size_t nnz;
+    {   CppAD::ADFun<double> f;
+        record(f, 2.0);
+        CppAD::sparse_cache cache(file_name);
+        cache.clear();
+        f.use_sparse_cache(&cache);
+        //
+        sparsity pattern_jac;
+        f.rev_jac_sparsity(
+            pattern_in, transpose, dependency, internal_bool, pattern_jac
+        );
+        nnz = pattern_jac.nnz();
+        ok &= nnz == 5;
+        //
+        sparse_matrix subset( pattern_jac );
+        CppAD::sparse_jac_work work;
+        size_t n_sweep = f.sparse_jac_rev(
+            x, subset, pattern_jac, coloring, work
+        );
+        ok &= n_sweep == 2;
+        //
+        // the pattern and coloring are in the cache
+        ok &= cache.size() == 2;
+        ok &= cache.n_hit() == 0;
+        ok &= cache.write();
+    }
+    // use the file to compute the Jacobian for a function with
+    // the same structure but a different constant
+    {   CppAD::ADFun<double> g;
+        record(g, 3.0);
+        CppAD::sparse_cache cache(file_name);
+        ok &= cache.size() == 2;
+        g.use_sparse_cache(&cache);
+        //
+        sparsity pattern_jac;
+        g.rev_jac_sparsity(
+            pattern_in, transpose, dependency, internal_bool, pattern_jac
+        );
+        ok &= pattern_jac.nnz() == nnz;
+        ok &= cache.n_hit() == 1;
+        //
+        sparse_matrix subset( pattern_jac );
+        CppAD::sparse_jac_work work;
+        size_t n_sweep = g.sparse_jac_rev(
+            x, subset, pattern_jac, coloring, work
+        );
+        ok &= n_sweep == 2;
+        ok &= cache.n_hit() == 2;
+        //
+        // check the Jacobian values
+        double eps = 10. * CppAD::numeric_limits<double>::epsilon();
+        for(size_t k = 0; k < nnz; ++k)
+        {   size_t i = subset.row()[k];
+            size_t j = subset.col()[k];
+            double check = 1.0;
+            if( i == 0 && j == 0 )
+                check = x[1];
+            else if( i == 0 && j == 1 )
+                check = x[0];
+            else if( i == 1 )
+                check = 3.0 * std::cos( x[2] );
+            ok &= CppAD::NearEqual(subset.val()[k], check, eps, eps);
+        }
+    }
+    std::remove( file_name.c_str() );
+    //
+    return ok;
+}
+// END C++
@@ -0,0 +1,192 @@
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-22 Bradley M. Bell
+
+CppAD is distributed under the terms of the
+             Eclipse Public License Version 2.0.
+
+This Source Code may also be made available under the following
+Secondary License when the conditions for such availability set forth
+in the Eclipse Public License, Version 2.0 are satisfied:
+      GNU General Public License, Version 2.0 or later.
+---------------------------------------------------------------------------- */
+
+/*
+$begin sparse_coloring.cpp$$
+$spell
+    Jacobian
+    tri
+$$
+
+$section Comparing Coloring Methods: Example and Test$$
+
+$head Hessian$$
+The Hessian for this example is tri-diagonal.
+The $code cppad.acyclic$$ coloring uses two sweeps
+to compute the Hessian.
+
+$head Jacobian$$
+The Jacobian for this example has a dense row and a dense column.
+Using only forward (reverse) sweeps requires one sweep for each column (row).
+The $code cppad.bidirectional$$ coloring computes the
+dense row using one reverse sweep.
+
+$srcthisfile%0%// BEGIN C++%// END C++%1%$$
+
+$end
+*/
+// BEGIN C++
+# include <cppad/cppad.hpp>
+namespace {
+    typedef CPPAD_TESTVECTOR(double)     d_vector;
+    typedef CPPAD_TESTVECTOR(size_t)     s_vector;
+    typedef CPPAD_TESTVECTOR(bool)       b_vector;
+    typedef CppAD::sparse_rc<s_vector>             sparsity;
+    typedef CppAD::sparse_rcv<s_vector, d_vector>  sparse_matrix;
+    //
+    bool hessian(void)
+    {   bool ok = true;
+        using CppAD::AD;
+        double eps = 10. * CppAD::numeric_limits<double>::epsilon();
+        //
+        // f(x) = sum_j x_j * x_{j+1} + x_j^3 / 6
+        size_t n = 6;
+        CPPAD_TESTVECTOR(AD<double>) ax(n), ay(1);
+        for(size_t j = 0; j < n; j++)
+            ax[j] = 0.0;
+        CppAD::Independent(ax);
+        ay[0] = 0.0;
+        for(size_t j = 0; j < n; j++)
+        {   ay[0] += ax[j] * ax[j] * ax[j] / 6.0;
+            if( j + 1 < n )
+                ay[0] += ax[j] * ax[j+1];
+        }
+        CppAD::ADFun<double> f(ax, ay);
+        //
+        // sparsity pattern for the Hessian
+        b_vector select_domain(n), select_range(1);
+        for(size_t j = 0; j < n; j++)
+            select_domain[j] = true;
+        select_range[0] = true;
+        bool internal_bool = false;
+        sparsity pattern;
+        f.for_hes_sparsity(select_domain, select_range, internal_bool, pattern);
+        ok &= pattern.nnz() == 3 * n - 2;
+        //
+        // point at which to compute the Hessian
+        d_vector x(n), w(1);
+        for(size_t j = 0; j < n; j++)
+            x[j] = double(j + 2);
+        w[0] = 1.0;
+        //
+        const char* coloring[] = {
+            "cppad.general", "cppad.symmetric", "cppad.star", "cppad.acyclic"
+        };
+        size_t n_sweep[4];
+        for(size_t ell = 0; ell < 4; ell++)
+        {   // compute the entire Hessian
+            sparse_matrix subset( pattern );
+            CppAD::sparse_hes_work work;
+            n_sweep[ell] = f.sparse_hes(
+                x, w, subset, pattern, coloring[ell], work
+            );
+            // check the values
+            for(size_t k = 0; k < subset.nnz(); k++)
+            {   size_t i = subset.row()[k];
+                size_t j = subset.col()[k];
+                double check = 1.0;
+                if( i == j )
+                    check = x[i];
+                ok &= CppAD::NearEqual(subset.val()[k], check, eps, eps);
+            }
+        }
+        // the acyclic coloring for a tri-diagonal matrix uses two colors
+        ok &= n_sweep[3] == 2;
+        ok &= n_sweep[3] <= n_sweep[2];
+        ok &= n_sweep[2] <= n_sweep[0];
+        //
+        return ok;
+    }
+    //
+    bool jacobian(void)
+    {   bool ok = true;
+        using CppAD::AD;
+        double eps = 10. * CppAD::numeric_limits<double>::epsilon();
+        //
+        // y_0 = sum_j x_j * x_j, y_i = x_0 * x_i for i > 0
+        size_t n = 6, m = n;
+        CPPAD_TESTVECTOR(AD<double>) ax(n), ay(m);
+        for(size_t j = 0; j < n; j++)
+            ax[j] = 0.0;
+        CppAD::Independent(ax);
+        ay[0] = 0.0;
+        for(size_t j = 0; j < n; j++)
+            ay[0] += ax[j] * ax[j];
+        for(size_t i = 1; i < m; i++)
+            ay[i] = ax[0] * ax[i];
+        CppAD::ADFun<double> f(ax, ay);
+        //
+        // sparsity pattern for the Jacobian
+        b_vector select_domain(n), select_range(m);
+        for(size_t j = 0; j < n; j++)
+            select_domain[j] = true;
+        for(size_t i = 0; i < m; i++)
+            select_range[i] = true;
+        bool transpose = false;
+        sparsity pattern;
+        f.subgraph_sparsity(select_domain, select_range, transpose, pattern);
+        ok &= pattern.nnz() == 3 * n - 2;
+        //
+        // point at which to compute the Jacobian
+        d_vector x(n);
+        for(size_t j = 0; j < n; j++)
+            x[j] = double(j + 2);
+        //
+        size_t group_max = 1;
+        for(size_t ell = 0; ell < 3; ell++)
+        {   sparse_matrix subset( pattern );
+            CppAD::sparse_jac_work work;
+            size_t n_sweep;
+            if( ell == 0 )
+            {   n_sweep = f.sparse_jac_for(
+                    group_max, x, subset, pattern, "cppad", work
+                );
+                ok &= n_sweep == n;
+            }
+            else if( ell == 1 )
+            {   n_sweep = f.sparse_jac_rev(
+                    x, subset, pattern, "cppad", work
+                );
+                ok &= n_sweep == m;
+            }
+            else
+            {   n_sweep = f.sparse_jac_rev(
+                    x, subset, pattern, "cppad.bidirectional", work
+                );
+                // one reverse sweep for row zero, two forward sweeps
+                // for the other elements
+                ok &= n_sweep == 3;
+            }
+            // check the values
+            for(size_t k = 0; k < subset.nnz(); k++)
+            {   size_t i = subset.row()[k];
+                size_t j = subset.col()[k];
+                double check;
+                if( i == 0 )
+                    check = 2.0 * x[j];
+                else if( j == 0 )
+                    check = x[i];
+                else
+                    check = x[0];
+                ok &= CppAD::NearEqual(subset.val()[k], check, eps, eps);
+            }
+        }
+        return ok;
+    }
+}
+bool sparse_coloring(void)
+{   bool ok = true;
+    ok &= hessian();
+    ok &= jacobian();
+    return ok;
+}
+// END C++
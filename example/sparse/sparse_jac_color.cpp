@@ -0,0 +1,138 @@
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-22 Bradley M. Bell
+
+CppAD is distributed under the terms of the
+             Eclipse Public License Version 2.0.
+
+This Source Code may also be made available under the following
+Secondary License when the conditions for such availability set forth
+in the Eclipse Public License, Version 2.0 are satisfied:
+      GNU General Public License, Version 2.0 or later.
+---------------------------------------------------------------------------- */
+
+/*
+$begin sparse_jac_color.cpp$$
+$spell
+    Jacobian
+$$
+
+$section Computing Sparse Jacobian by Ranges of Colors: Example and Test$$
+
+$head Discussion$$
+The colors are divided into two ranges and each range is computed using
+a different copy of the function and of the subset.
+This is done sequentially here, but the ranges could be computed
+by different threads in $cref/parallel mode/sparse_jac/Parallel Mode/$$.
+
+$srcthisfile%0%// BEGIN C++%// END C++%1%$$
+
+$end
+*/
+// BEGIN C++
+# include <cppad/cppad.hpp>
+bool sparse_jac_color(void)
+{   bool ok = true;
+    //
+    using CppAD::AD;
+    using CppAD::NearEqual;
+    using CppAD::sparse_rc;
+    using CppAD::sparse_rcv;
+    //
+    typedef CPPAD_TESTVECTOR(AD<double>) a_vector;
+    typedef CPPAD_TESTVECTOR(double)     d_vector;
+    typedef CPPAD_TESTVECTOR(size_t)     s_vector;
+    typedef CPPAD_TESTVECTOR(bool)       b_vector;
+    //
+    double eps = 10. * CppAD::numeric_limits<double>::epsilon();
+    //
+    // domain space vector
+    size_t n = 4;
+    a_vector  a_x(n);
+    for(size_t j = 0; j < n; j++)
+        a_x[j] = AD<double> (0);
+    //
+    // declare independent variables and starting recording
+    CppAD::Independent(a_x);
+    //
+    // y_i = x_i * x_{i+1}
+    size_t m = n - 1;
+    a_vector  a_y(m);
+    for(size_t i = 0; i < m; i++)
+        a_y[i] = a_x[i] * a_x[i+1];
+    //
+    // create f: x -> y and stop tape recording
+    CppAD::ADFun<double> f(a_x, a_y);
+    //
+    // new value for the independent variable vector
+    d_vector x(n);
+    for(size_t j = 0; j < n; j++)
+        x[j] = double(j + 2);
+    //
+    // sparsity pattern for the Jacobian
+    b_vector select_domain(n), select_range(m);
+    for(size_t j = 0; j < n; j++)
+        select_domain[j] = true;
+    for(size_t i = 0; i < m; i++)
+        select_range[i] = true;
+    sparse_rc<s_vector> pattern;
+    bool transpose = false;
+    f.subgraph_sparsity(select_domain, select_range, transpose, pattern);
+    size_t nnz = pattern.nnz();
+    ok &= nnz == 2 * m;
+    //
+    // copies of the function used for each range of colors
+    CppAD::ADFun<double> f_0, f_1;
+    f_0 = f;
+    f_1 = f;
+    //
+    std::string coloring = "cppad";
+    size_t group_max     = 1;
+    for(size_t mode = 0; mode < 2; ++mode)
+    {   // compute the coloring (no sweeps are done)
+        sparse_rcv<s_vector, d_vector> subset_0( pattern );
+        sparse_rcv<s_vector, d_vector> subset_1( pattern );
+        CppAD::sparse_jac_work work;
+        size_t n_color;
+        if( mode == 0 ) n_color = f.sparse_jac_for(
+            group_max, x, subset_0, pattern, coloring, work, 0, 0
+        );
+        else n_color = f.sparse_jac_rev(
+            x, subset_0, pattern, coloring, work, 0, 0
+        );
+        ok &= n_color == 2;
+        //
+        // first range of colors uses f_0 and subset_0
+        if( mode == 0 ) f_0.sparse_jac_for(
+            group_max, x, subset_0, pattern, coloring, work, 0, 1
+        );
+        else f_0.sparse_jac_rev(
+            x, subset_0, pattern, coloring, work, 0, 1
+        );
+        //
+        // second range of colors uses f_1 and subset_1
+        if( mode == 0 ) f_1.sparse_jac_for(
+            group_max, x, subset_1, pattern, coloring, work, 1, n_color
+        );
+        else f_1.sparse_jac_rev(
+            x, subset_1, pattern, coloring, work, 1, n_color
+        );
+        //
+        // the sum of the subsets is the Jacobian
+        const s_vector& row( subset_0.row() );
+        const s_vector& col( subset_0.col() );
+        size_t n_zero = 0;
+        for(size_t k = 0; k < nnz; ++k)
+        {   double v_0 = subset_0.val()[k];
+            double v_1 = subset_1.val()[k];
+            // each element is computed by exactly one range of colors
+            if( v_0 == 0.0 ) ++n_zero;
+            if( v_1 == 0.0 ) ++n_zero;
+            // y_i = x_i * x_{i+1}
+            double check = x[ col[k] == row[k] ? row[k] + 1 : row[k] ];
+            ok &= NearEqual(v_0 + v_1, check, eps, eps);
+        }
+        ok &= n_zero == nnz;
+    }
+    return ok;
+}
+// END C++
@@ -0,0 +1,100 @@
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-22 Bradley M. Bell
+
+CppAD is distributed under the terms of the
+             Eclipse Public License Version 2.0.
+
+This Source Code may also be made available under the following
+Secondary License when the conditions for such availability set forth
+in the Eclipse Public License, Version 2.0 are satisfied:
+      GNU General Public License, Version 2.0 or later.
+---------------------------------------------------------------------------- */
+/*
+$begin subgraph_row_callback.cpp$$
+$spell
+    subgraph
+    Jacobian
+$$
+
+$section Subgraph Sparsity One Row at a Time: Example and Test$$
+
+$head Discussion$$
+The row callback below counts the number of elements in each row of
+the sparsity pattern, instead of storing the pattern.
+
+$srcthisfile%0%// BEGIN C++%// END C++%1%$$
+
+$end
+*/
+// BEGIN C++
+# include <cppad/cppad.hpp>
+
+namespace {
+    // row callback that counts the elements in each row
+    class count_row {
+    public:
+        // number of elements in each row
+        CppAD::vector<size_t> count;
+        // rows in the order they were reported
+        CppAD::vector<size_t> order;
+        //
+        count_row(size_t m) : count(m)
+        {   for(size_t i = 0; i < m; ++i)
+                count[i] = 0;
+        }
+        void operator()(size_t i, const CppAD::vector<size_t>& col)
+        {   count[i] = col.size();
+            order.push_back(i);
+        }
+    };
+}
+
+bool subgraph_row_callback(void)
+{   bool ok = true;
+    using CppAD::AD;
+    typedef CPPAD_TESTVECTOR(bool)   BoolVector;
+    //
+    // domain space vector
+    size_t n = 4;
+    CPPAD_TESTVECTOR(AD<double>) ax(n);
+    for(size_t j = 0; j < n; ++j)
+        ax[j] = double(j + 1);
+
+    // declare independent variables and start recording
+    CppAD::Independent(ax);
+
+    // range space vector
+    size_t m = 3;
+    CPPAD_TESTVECTOR(AD<double>) ay(m);
+    ay[0] = ax[0] * ax[1] * ax[2];
+    ay[1] = sin( ax[3] );
+    ay[2] = ax[0] + ax[3];
+
+    // create f: x -> y and stop tape recording
+    CppAD::ADFun<double> f(ax, ay);
+    //
+    // select all of the domain and the first and last component of the range
+    BoolVector select_domain(n), select_range(m);
+    for(size_t j = 0; j < n; ++j)
+        select_domain[j] = true;
+    select_range[0] = true;
+    select_range[1] = false;
+    select_range[2] = true;
+    //
+    // report the sparsity pattern one row at a time
+    count_row row_callback(m);
+    f.subgraph_sparsity(select_domain, select_range, row_callback);
+    //
+    // check the number of elements in each row
+    ok &= row_callback.count[0] == 3;
+    ok &= row_callback.count[1] == 0;
+    ok &= row_callback.count[2] == 2;
+    //
+    // check that only the selected rows were reported
+    ok &= row_callback.order.size() == 2;
+    ok &= row_callback.order[0] == 0;
+    ok &= row_callback.order[1] == 2;
+    //
+    return ok;
+}
+// END C++
@@ -211,6 +211,8 @@ bool thread_alloc(void)
 
     // check that there is only on thread
     ok  &= thread_alloc::num_threads() == 1;
+    // per thread information can be used for at least this many threads
+    ok  &= thread_alloc::max_num_threads() >= CPPAD_MAX_NUM_THREADS;
     // so thread number must be zero
     ok  &= thread_alloc::thread_num() == 0;
     // and we are in sequential execution mode
@@ -0,0 +1,105 @@
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-22 Bradley M. Bell
+
+CppAD is distributed under the terms of the
+             Eclipse Public License Version 2.0.
+
+This Source Code may also be made available under the following
+Secondary License when the conditions for such availability set forth
+in the Eclipse Public License, Version 2.0 are satisfied:
+      GNU General Public License, Version 2.0 or later.
+---------------------------------------------------------------------------- */
+
+/*
+$begin thread_pool.cpp$$
+$spell
+    alloc
+$$
+
+$section A Work Stealing Pool of Threads: Example and Test$$
+
+$head Discussion$$
+The tasks in this example take very different amounts of time
+(the amount of work for a task grows with its index).
+Each task is executed exactly once and
+the thread_alloc memory allocator is used by all the threads.
+
+$srcthisfile%0%// BEGIN C++%// END C++%1%$$
+
+$end
+*/
+// BEGIN C++
+# include <cppad/utility/thread_pool.hpp>
+# include <cppad/utility/vector.hpp>
+
+namespace { // BEGIN_EMPTY_NAMESPACE
+    // job that sums the integers less than or equal its task number
+    class sum_job {
+    private:
+        // sum for each task
+        CppAD::vector<size_t>& sum_;
+        // thread that executed each task
+        CppAD::vector<size_t>& thread_;
+        // is thread_alloc::thread_num() equal thread for each task
+        CppAD::vector<bool>&   ok_;
+    public:
+        sum_job(
+            CppAD::vector<size_t>& sum    ,
+            CppAD::vector<size_t>& thread ,
+            CppAD::vector<bool>&   ok     )
+        : sum_(sum), thread_(thread), ok_(ok)
+        { }
+        void operator()(size_t task, size_t thread)
+        {   // memory for this task is allocated by this thread
+            CppAD::vector<size_t> term(task + 1);
+            for(size_t i = 0; i <= task; ++i)
+                term[i] = i;
+            size_t sum = 0;
+            for(size_t i = 0; i <= task; ++i)
+                sum += term[i];
+            //
+            sum_[task]    = sum;
+            thread_[task] = thread;
+            ok_[task]     = CppAD::thread_alloc::thread_num() == thread;
+            ok_[task]    &= CppAD::thread_alloc::in_parallel();
+        }
+    };
+} // END_EMPTY_NAMESPACE
+
+bool thread_pool(void)
+{   bool ok = true;
+    using CppAD::thread_alloc;
+    //
+    // create the pool (this calls thread_alloc::parallel_setup)
+    size_t num_threads = 4;
+    {   CppAD::thread_pool pool(num_threads);
+        ok &= pool.num_threads() == num_threads;
+        ok &= thread_alloc::num_threads() == num_threads;
+        ok &= ! thread_alloc::in_parallel();
+        //
+        // run the job
+        size_t n_task = 1000;
+        CppAD::vector<size_t> sum(n_task), thread(n_task);
+        CppAD::vector<bool>   task_ok(n_task);
+        for(size_t task = 0; task < n_task; ++task)
+        {   thread[task]  = num_threads;
+            task_ok[task] = false;
+        }
+        sum_job job(sum, thread, task_ok);
+        pool.run(n_task, job);
+        ok &= ! thread_alloc::in_parallel();
+        //
+        // check the results
+        for(size_t task = 0; task < n_task; ++task)
+        {   ok &= sum[task] == task * (task + 1) / 2;
+            ok &= thread[task] < num_threads;
+            ok &= task_ok[task];
+        }
+    }
+    // the pool destructor returns to sequential mode
+    ok &= thread_alloc::num_threads() == 1;
+    ok &= ! thread_alloc::in_parallel();
+    //
+    return ok;
+}
+// END C++
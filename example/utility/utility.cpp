@@ -49,6 +49,7 @@ extern bool set_union(void);
 extern bool sparse_rc(void);
 extern bool sparse_rcv(void);
 extern bool thread_alloc(void);
+extern bool thread_pool(void);
 extern bool to_string(void);
 extern bool vectorBool(void);
 // END_SORT_THIS_LINE_MINUS_1
@@ -88,6 +89,7 @@ int main(void)
     Run( sparse_rc,              "sparse_rc" );
     Run( sparse_rcv,             "sparse_rcv" );
     Run( thread_alloc,           "thread_alloc" );
+    Run( thread_pool,            "thread_pool" );
     Run( to_string,              "to_string" );
     Run( vectorBool,             "vectorBool" );
 // END_SORT_THIS_LINE_MINUS_1
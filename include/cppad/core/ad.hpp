@@ -295,6 +295,8 @@ private:
     // static
     static tape_id_t*            tape_id_ptr(size_t thread);
     static local::ADTape<Base>** tape_handle(size_t thread);
+    static void                  tape_id_rebase(size_t thread);
+    static size_t                tape_id_max(size_t tape_id);
     static local::ADTape<Base>*         tape_manage(tape_manage_enum job);
     static local::ADTape<Base>*  tape_ptr(void);
     static local::ADTape<Base>*  tape_ptr(tape_id_t tape_id);
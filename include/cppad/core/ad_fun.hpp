@@ -42,7 +42,8 @@ $childtable%
     include/cppad/core/ad_fun.omh%
     include/cppad/core/optimize.hpp%
     include/cppad/core/fun_check.hpp%
-    include/cppad/core/check_for_nan.hpp
+    include/cppad/core/check_for_nan.hpp%
+    include/cppad/core/fun_work.hpp
 %$$
 
 $end
@@ -50,6 +51,10 @@ $end
 # include <cppad/core/graph/cpp_graph.hpp>
 # include <cppad/local/subgraph/info.hpp>
 # include <cppad/local/graph/cpp_graph_op.hpp>
+# include <cppad/local/optimize/optimize_plan.hpp>
+# include <cppad/core/optimize_report.hpp>
+# include <cppad/core/sparse_cache.hpp>
+# include <cppad/utility/thread_pool.hpp>
 
 namespace CppAD { // BEGIN_CPPAD_NAMESPACE
 /*!
@@ -113,6 +118,10 @@ private:
     /// number of variables in the recording (play_)
     size_t num_var_tape_;
 
+    /// If zero, this function was not optimized with zero_order_only.
+    /// Otherwise, number of zero order Taylor coefficient slots in taylor_.
+    size_t num_slot_;
+
     /// tape address for the independent variables
     local::pod_vector<size_t> ind_taddr_;
 
@@ -130,6 +139,16 @@ private:
     /// (if zero, the operation corresponds to a parameter).
     local::pod_vector<addr_t> load_op2var_;
 
+    /// slot for primary result of each operator (empty if num_slot_ is zero)
+    local::pod_vector<addr_t> slot_op_;
+
+    /// operator arguments with variable indices replaced by slots
+    /// (empty if num_slot_ is zero)
+    local::pod_vector<addr_t> slot_arg_;
+
+    /// slot for each dependent variable (empty if num_slot_ is zero)
+    local::pod_vector<size_t> slot_dep_;
+
     /// results of the forward mode calculations
     local::pod_vector_maybe<Base> taylor_;
 
@@ -141,6 +160,15 @@ private:
     /// the operation sequence corresponding to this object
     local::player<Base> play_;
 
+    /// optimizer decisions saved by the cache_plan option
+    local::optimize::optimize_plan<Base> optimize_plan_;
+
+    /// time and effect of the previous optimization
+    CppAD::optimize_report optimize_report_;
+
+    /// cache for sparsity patterns and colorings (null if not used)
+    CppAD::sparse_cache* sparse_cache_;
+
     /// subgraph information for this object
     local::subgraph::subgraph_info subgraph_info_;
 
@@ -162,6 +190,21 @@ private:
     template <class ADvector>
     void Dependent(local::ADTape<Base> *tape, const ADvector &y);
 
+    /// hash code that identifies this operation sequence in sparse_cache_
+    size_t sparse_cache_code(void) const
+    {   size_t code = play_.structure_hash();
+        return CppAD::sparse_cache::hash(code, dep_taddr_);
+    }
+
+    /// does this operation sequence contain atomic function calls
+    bool sparse_cache_atomic(void) const
+    {   for(size_t i_op = 0; i_op < play_.num_op_rec(); ++i_op)
+        {   if( play_.GetOp(i_op) == local::AFunOp )
+                return true;
+        }
+        return false;
+    }
+
     // vector of bool version of ForSparseJac
     // (doxygen in cppad/core/for_sparse_jac.hpp)
     template <class SetVector>
@@ -289,6 +332,28 @@ private:
               sparse_hessian_work&     work
     );
 
+    // one multiple direction forward sweep for a group of colors
+    template <class SizeVector, class BaseVector>
+    size_t sparse_jac_forward_dir(
+        size_t                               color_begin ,
+        size_t                               group_size  ,
+        const vector<size_t>&                color       ,
+        const vector<size_t>&                order       ,
+        size_t                               k           ,
+        sparse_rcv<SizeVector, BaseVector>&  subset
+    );
+
+    // sparse Jacobian using both forward and reverse mode
+    template <class SizeVector, class BaseVector>
+    size_t sparse_jac_bidirectional(
+        const BaseVector&                    x           ,
+        sparse_rcv<SizeVector, BaseVector>&  subset      ,
+        const sparse_rc<SizeVector>&         pattern     ,
+        sparse_jac_work&                     work        ,
+        size_t                               color_begin ,
+        size_t                               color_end
+    );
+
 public:
     /// default constructor
     ADFun(void);
@@ -361,6 +426,25 @@ public:
     template <class BaseVector>
     BaseVector Reverse(size_t p, const BaseVector &v);
 
+    // forward mode using a separate workspace
+    // (doxygen in cppad/core/fun_work.hpp)
+    template <class BaseVector>
+    BaseVector forward(
+        fun_work<Base>&   work                  ,
+        size_t            q                     ,
+        const BaseVector& xq                    ,
+        std::ostream&     s          = std::cout
+    ) const;
+
+    // reverse mode using a separate workspace
+    // (doxygen in cppad/core/fun_work.hpp)
+    template <class BaseVector>
+    BaseVector reverse(
+        fun_work<Base>&   work  ,
+        size_t            q     ,
+        const BaseVector& w
+    ) const;
+
     // forward Jacobian sparsity pattern
     // (doxygen in cppad/core/for_sparse_jac.hpp)
     template <class SetVector>
@@ -434,6 +518,27 @@ public:
         const std::string&                   coloring  ,
         sparse_jac_work&                     work
     );
+    template <class SizeVector, class BaseVector>
+    size_t sparse_jac_for(
+        size_t                               group_max   ,
+        const BaseVector&                    x           ,
+        sparse_rcv<SizeVector, BaseVector>&  subset      ,
+        const sparse_rc<SizeVector>&         pattern     ,
+        const std::string&                   coloring    ,
+        sparse_jac_work&                     work        ,
+        size_t                               color_begin ,
+        size_t                               color_end
+    );
+    template <class SizeVector, class BaseVector>
+    size_t sparse_jac_for(
+        size_t                               group_max ,
+        const BaseVector&                    x         ,
+        sparse_rcv<SizeVector, BaseVector>&  subset    ,
+        const sparse_rc<SizeVector>&         pattern   ,
+        const std::string&                   coloring  ,
+        sparse_jac_work&                     work      ,
+        thread_pool&                         pool
+    );
 
     // compute sparse Jacobian using reverse mode
     // (doxygen in cppad/core/sparse_jac.hpp)
@@ -445,6 +550,25 @@ public:
         const std::string&                   coloring ,
         sparse_jac_work&                     work
     );
+    template <class SizeVector, class BaseVector>
+    size_t sparse_jac_rev(
+        const BaseVector&                    x           ,
+        sparse_rcv<SizeVector, BaseVector>&  subset      ,
+        const sparse_rc<SizeVector>&         pattern     ,
+        const std::string&                   coloring    ,
+        sparse_jac_work&                     work        ,
+        size_t                               color_begin ,
+        size_t                               color_end
+    );
+    template <class SizeVector, class BaseVector>
+    size_t sparse_jac_rev(
+        const BaseVector&                    x        ,
+        sparse_rcv<SizeVector, BaseVector>&  subset   ,
+        const sparse_rc<SizeVector>&         pattern  ,
+        const std::string&                   coloring ,
+        sparse_jac_work&                     work     ,
+        thread_pool&                         pool
+    );
 
     // compute sparse Hessian
     // (doxygen in cppad/core/sparse_hes.hpp)
@@ -457,6 +581,16 @@ public:
         const std::string&                   coloring ,
         sparse_hes_work&                     work
     );
+    template <class SizeVector, class BaseVector>
+    size_t sparse_hes(
+        const BaseVector&                    x        ,
+        const BaseVector&                    w        ,
+        sparse_rcv<SizeVector, BaseVector>&  subset   ,
+        const sparse_rc<SizeVector>&         pattern  ,
+        const std::string&                   coloring ,
+        sparse_hes_work&                     work     ,
+        thread_pool&                         pool
+    );
 
     // compute sparsity pattern using subgraphs
     // (doxygen in cppad/core/subgraph_sparsity.hpp)
@@ -468,6 +602,15 @@ public:
         sparse_rc<SizeVector>&       pattern_out
     );
 
+    // subgraph_sparsity reported one row at a time
+    // (doxygen in cppad/core/subgraph_sparsity.hpp)
+    template <class BoolVector, class RowCallback>
+    void subgraph_sparsity(
+        const BoolVector&            select_domain    ,
+        const BoolVector&            select_range     ,
+        RowCallback&                 row_callback
+    );
+
 
     // forward mode Jacobian sparsity pattern
     // (doxygen in cppad/core/for_jac_sparsity.hpp)
@@ -480,6 +623,18 @@ public:
         sparse_rc<SizeVector>&       pattern_out
     );
 
+    // forward mode Jacobian sparsity pattern for a block of columns
+    // (doxygen in cppad/core/for_jac_sparsity_block.hpp)
+    template <class SizeVector>
+    void for_jac_sparsity_block(
+        const sparse_rc<SizeVector>& pattern_in       ,
+        bool                         transpose        ,
+        bool                         dependency       ,
+        size_t                       col_begin        ,
+        size_t                       col_end          ,
+        sparse_rc<SizeVector>&       pattern_out
+    ) const;
+
     // reverse mode Jacobian sparsity pattern
     // (doxygen in cppad/core/for_jac_sparsity.hpp)
     template <class SizeVector>
@@ -511,6 +666,15 @@ public:
         sparse_rc<SizeVector>&       pattern_out
     );
 
+    // Hessian sparsity pattern for a sum of terms
+    // (doxygen in cppad/core/separable_hes_sparsity.hpp)
+    template <class BoolVector, class SizeVector>
+    void separable_hes_sparsity(
+        const BoolVector&            select_domain    ,
+        const BoolVector&            select_range     ,
+        sparse_rc<SizeVector>&       pattern_out
+    );
+
     // forward mode Hessian sparsity pattern
     // (see doxygen in cppad/core/for_sparse_hes.hpp)
     template <class SetVector>
@@ -569,6 +733,15 @@ public:
     bool exceed_collision_limit(void) const
     {   return exceed_collision_limit_; }
 
+    /// time and effect of the previous optimization
+    const CppAD::optimize_report& optimize_report(void) const
+    {   return optimize_report_; }
+
+    /// cache for sparsity patterns and colorings
+    /// (nullptr means do not use a cache)
+    void use_sparse_cache(CppAD::sparse_cache* cache)
+    {   sparse_cache_ = cache; }
+
     /// amount of memory used for boolean Jacobain sparsity pattern
     size_t size_forward_bool(void) const
     {   return for_jac_sparse_pack_.memory(); }
@@ -706,11 +879,17 @@ public:
     /// calculate entire Jacobian
     template <class BaseVector>
     BaseVector Jacobian(const BaseVector &x);
+    template <class BaseVector>
+    BaseVector Jacobian(const BaseVector &x, thread_pool& pool);
 
     /// calculate Hessian for one component of f
     template <class BaseVector>
     BaseVector Hessian(const BaseVector &x, const BaseVector &w);
     template <class BaseVector>
+    BaseVector Hessian(
+        const BaseVector &x, const BaseVector &w, thread_pool& pool
+    );
+    template <class BaseVector>
     BaseVector Hessian(const BaseVector &x, size_t i);
 
     /// forward mode calculation of partial w.r.t one domain component
@@ -186,7 +186,7 @@ private:
     // Use pointers, to avoid false sharing between threads.
     // Not using: vector<work_struct*> work_;
     // so that deprecated atomic examples do not result in a memory leak.
-    work_struct* work_[CPPAD_MAX_NUM_THREADS];
+    local::thread_registry<work_struct*> work_;
     // -----------------------------------------------------
 public:
     // =====================================================================
@@ -339,7 +339,7 @@ public:
         CPPAD_ASSERT_UNKNOWN( type == 4 );
         //
         // free temporary work memory
-        for(size_t thread = 0; thread < CPPAD_MAX_NUM_THREADS; thread++)
+        for(size_t thread = 0; thread < work_.size(); thread++)
             free_work(thread);
     }
     /// allocates work_ for a specified thread
@@ -76,9 +76,12 @@ $icode atomic_user$$ implementations.
 
 $head atomic_four$$
 
-$subhead Restrictions$$
-The $code atomic_four$$ constructor and destructor cannot be called in
-$cref/parallel/ta_in_parallel/$$ mode.
+$subhead Parallel Mode$$
+The $code atomic_four$$ constructor and destructor can be called in
+$cref/parallel/ta_in_parallel/$$ mode; e.g.,
+different threads can create their own atomic functions.
+An atomic function object can only be used by a thread after its
+constructor has completed.
 
 $subhead Base$$
 The template parameter determines the
@@ -125,12 +128,7 @@ atomic_four<Base>::atomic_four(void)
 template <class Base>
 atomic_four<Base>::atomic_four(const std::string& name )
 // END_PROTOTYPE
-{   CPPAD_ASSERT_KNOWN(
-        ! thread_alloc::in_parallel() ,
-        "atomic_four: constructor cannot be called in parallel mode."
-    );
-    //
-    // index_
+{   // index_
     bool        set_null  = false;
     size_t      index     = 0;
     size_t      type      = 4;
@@ -140,9 +138,7 @@ atomic_four<Base>::atomic_four(const std::string& name )
         set_null, index, type, &copy_name, copy_this
     );
     //
-    // work_
-    for(size_t thread = 0; thread < CPPAD_MAX_NUM_THREADS; thread++)
-        work_[thread] = nullptr;
+    // work_ pointers are initialized as null by its constructor
 }
 
 } // END_CPPAD_NAMESPACE
@@ -76,9 +76,12 @@ $icode atomic_user$$ implementations.
 
 $head atomic_three$$
 
-$subhead Restrictions$$
-The $code atomic_three$$ constructor and destructor cannot be called in
-$cref/parallel/ta_in_parallel/$$ mode.
+$subhead Parallel Mode$$
+The $code atomic_three$$ constructor and destructor can be called in
+$cref/parallel/ta_in_parallel/$$ mode; e.g.,
+different threads can create their own atomic functions.
+An atomic function object can only be used by a thread after its
+constructor has completed.
 
 $subhead Base$$
 The template parameter determines the
@@ -142,12 +145,7 @@ name used for error reporting
 template <class Base>
 atomic_three<Base>::atomic_three(const std::string& name )
 // END_PROTOTYPE
-{   CPPAD_ASSERT_KNOWN(
-        ! thread_alloc::in_parallel() ,
-        "atomic_three: constructor cannot be called in parallel mode."
-    );
-    //
-    // atomic_index
+{   // atomic_index
     bool        set_null  = false;
     size_t      index     = 0;
     size_t      type      = 3;
@@ -156,9 +154,7 @@ atomic_three<Base>::atomic_three(const std::string& name )
     index_  = local::atomic_index<Base>(
         set_null, index, type, &copy_name, copy_this
     );
-    // initialize work pointers as null;
-    for(size_t thread = 0; thread < CPPAD_MAX_NUM_THREADS; thread++)
-        work_[thread] = nullptr;
+    // work pointers are initialized as null by the work_ constructor
 }
 
 } // END_CPPAD_NAMESPACE
@@ -79,7 +79,7 @@ void atomic_base<Base>::clear(void)
         if( type == 2 )
         {   atomic_base* op = reinterpret_cast<atomic_base*>(v_ptr);
             if( op != nullptr )
-            {   for(size_t thread = 0; thread < CPPAD_MAX_NUM_THREADS; thread++)
+            {   for(size_t thread = 0; thread < op->work_.size(); thread++)
                     op->free_work(thread);
             }
         }
@@ -164,9 +164,7 @@ sparsity_( sparsity               )
     index_  = local::atomic_index<Base>(
         set_null, index, type, &copy_name, copy_this
     );
-    // initialize work pointers as null;
-    for(size_t thread = 0; thread < CPPAD_MAX_NUM_THREADS; thread++)
-        work_[thread] = nullptr;
+    // work pointers are initialized as null by the work_ constructor
 }
 
 } // END_CPPAD_NAMESPACE
@@ -86,6 +86,7 @@ ADFun< AD<Base>, RecBase > ADFun<Base,RecBase>::base2ad(void) const
     CPPAD_ASSERT_UNKNOWN( fun.cap_order_taylor_ == 0 );
     CPPAD_ASSERT_UNKNOWN( fun.num_direction_taylor_ == 0 );
     fun.num_var_tape_              = num_var_tape_;
+    fun.num_slot_                  = num_slot_;
     //
     // pod_vector objects
     fun.ind_taddr_                 = ind_taddr_;
@@ -93,6 +94,9 @@ ADFun< AD<Base>, RecBase > ADFun<Base,RecBase>::base2ad(void) const
     fun.dep_parameter_             = dep_parameter_;
     fun.cskip_op_                  = cskip_op_;
     fun.load_op2var_               = load_op2var_;
+    fun.slot_op_                   = slot_op_;
+    fun.slot_arg_                  = slot_arg_;
+    fun.slot_dep_                  = slot_dep_;
     //
     // pod_maybe_vector< AD<Base> > = pod_maybe_vector<Base>
     CPPAD_ASSERT_UNKNOWN( fun.taylor_.size() == 0 );
@@ -104,6 +108,9 @@ ADFun< AD<Base>, RecBase > ADFun<Base,RecBase>::base2ad(void) const
     // subgraph
     fun.subgraph_info_ = subgraph_info_;
     //
+    // optimize_report
+    fun.optimize_report_ = optimize_report_;
+    //
     // sparse_pack
     fun.for_jac_sparse_pack_ = for_jac_sparse_pack_;
     //
@@ -282,7 +282,8 @@ private:
     member_struct const_member_;
 
     /// use pointers and allocate memory to avoid false sharing
-    member_struct* member_[CPPAD_MAX_NUM_THREADS];
+    /// (initialized to null by its constructor)
+    local::thread_registry<member_struct*> member_;
     //
     /// allocate member_ for this thread
     void allocate_member(size_t thread)
@@ -406,7 +407,7 @@ public:
             CPPAD_ASSERT_KNOWN(false, msg.c_str() );
         }
 # endif
-        for(size_t thread = 0; thread < CPPAD_MAX_NUM_THREADS; ++thread)
+        for(size_t thread = 0; thread < member_.size(); ++thread)
             free_member(thread);
     }
     // ------------------------------------------------------------------------
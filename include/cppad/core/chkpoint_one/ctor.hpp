@@ -32,8 +32,6 @@ checkpoint<Base>::checkpoint(
         CPPAD_ASSERT_KNOWN(false, msg.c_str() );
     }
 # endif
-    for(size_t thread = 0; thread < CPPAD_MAX_NUM_THREADS; ++thread)
-        member_[thread] = nullptr;
     //
     CheckSimpleVector< CppAD::AD<Base> , ADVector>();
     //
@@ -148,8 +148,8 @@ private:
         //
     };
     /// use pointers and allocate memory to avoid false sharing
-    /// (initialized to null by constructor)
-    member_struct* member_[CPPAD_MAX_NUM_THREADS];
+    /// (initialized to null by its constructor)
+    local::thread_registry<member_struct*> member_;
     //
     // ------------------------------------------------------------------------
     /// allocate member_ for this thread
@@ -131,9 +131,7 @@ use_in_parallel_ ( use_in_parallel )
         ! thread_alloc::in_parallel() ,
         "chkpoint_two: constructor cannot be called in parallel mode."
     );
-    // initialize member pointers as null;
-    for(size_t thread = 0; thread < CPPAD_MAX_NUM_THREADS; thread++)
-        member_[thread] = nullptr;
+    // member pointers are initialized as null by the member_ constructor
     //
     // g_
     g_ = fun;
@@ -215,7 +213,7 @@ chkpoint_two<Base>::~chkpoint_two(void)
         CPPAD_ASSERT_KNOWN(false, msg.c_str() );
     }
 # endif
-    for(size_t thread = 0; thread < CPPAD_MAX_NUM_THREADS; ++thread)
+    for(size_t thread = 0; thread < member_.size(); ++thread)
         free_member(thread);
     }
 } // END_CPPAD_NAMESPACE
@@ -103,7 +103,7 @@ namespace CppAD {
         if( x.tape_id_ == 0 )
             return true;
         //
-        size_t thread = size_t(x.tape_id_ % CPPAD_MAX_NUM_THREADS);
+        size_t thread = size_t(x.tape_id_ % thread_alloc::max_num_threads());
         return x.tape_id_ != *AD<Base>::tape_id_ptr(thread);
     }
     //
@@ -113,7 +113,7 @@ namespace CppAD {
         if( x.tape_id_ == 0 )
             return true;
         //
-        size_t thread = size_t(x.tape_id_ % CPPAD_MAX_NUM_THREADS);
+        size_t thread = size_t(x.tape_id_ % thread_alloc::max_num_threads());
         return x.tape_id_ != *AD<Base>::tape_id_ptr(thread);
     }
     // -----------------------------------------------------------------------
@@ -124,7 +124,7 @@ namespace CppAD {
         if( (x.tape_id_ == 0) | (x.ad_type_ != dynamic_enum) )
             return false;
         //
-        size_t thread = size_t(x.tape_id_ % CPPAD_MAX_NUM_THREADS);
+        size_t thread = size_t(x.tape_id_ % thread_alloc::max_num_threads());
         return x.tape_id_ == *AD<Base>::tape_id_ptr(thread);
     }
     //
@@ -134,7 +134,7 @@ namespace CppAD {
         if( (x.tape_id_ == 0) | (x.ad_type_ != dynamic_enum) )
             return false;
         //
-        size_t thread = size_t(x.tape_id_ % CPPAD_MAX_NUM_THREADS);
+        size_t thread = size_t(x.tape_id_ % thread_alloc::max_num_threads());
         return x.tape_id_ == *AD<Base>::tape_id_ptr(thread);
     }
     // -----------------------------------------------------------------------
@@ -145,7 +145,7 @@ namespace CppAD {
         if( (x.tape_id_ == 0) | (x.ad_type_ == dynamic_enum) )
             return true;
         //
-        size_t thread = size_t(x.tape_id_ % CPPAD_MAX_NUM_THREADS);
+        size_t thread = size_t(x.tape_id_ % thread_alloc::max_num_threads());
         return x.tape_id_ != *AD<Base>::tape_id_ptr(thread);
     }
     //
@@ -155,7 +155,7 @@ namespace CppAD {
         if( (x.tape_id_ == 0) | (x.ad_type_ == dynamic_enum) )
             return true;
         //
-        size_t thread = size_t(x.tape_id_ % CPPAD_MAX_NUM_THREADS);
+        size_t thread = size_t(x.tape_id_ % thread_alloc::max_num_threads());
         return x.tape_id_ != *AD<Base>::tape_id_ptr(thread);
     }
     // -----------------------------------------------------------------------
@@ -166,7 +166,7 @@ namespace CppAD {
         if( (x.tape_id_ == 0) | (x.ad_type_ != variable_enum) )
             return false;
         //
-        size_t thread = size_t(x.tape_id_ % CPPAD_MAX_NUM_THREADS);
+        size_t thread = size_t(x.tape_id_ % thread_alloc::max_num_threads());
         return x.tape_id_ == *AD<Base>::tape_id_ptr(thread);
     }
     //
@@ -176,7 +176,7 @@ namespace CppAD {
         if( (x.tape_id_ == 0) | (x.ad_type_ != variable_enum) )
             return false;
         //
-        size_t thread = size_t(x.tape_id_ % CPPAD_MAX_NUM_THREADS);
+        size_t thread = size_t(x.tape_id_ % thread_alloc::max_num_threads());
         return x.tape_id_ == *AD<Base>::tape_id_ptr(thread);
     }
 }
@@ -270,6 +270,9 @@ void ADFun<Base,RecBase>::Dependent(local::ADTape<Base> *tape, const ADvector &y
     // bool values in this object except check_for_nan_
     has_been_optimized_        = false;
     //
+    // this operation sequence has not been optimized
+    optimize_report_.clear();
+    //
     // size_t values in this object
     compare_change_count_      = 1;
     compare_change_number_     = 0;
@@ -278,6 +281,7 @@ void ADFun<Base,RecBase>::Dependent(local::ADTape<Base> *tape, const ADvector &y
     cap_order_taylor_          = 0;
     num_direction_taylor_      = 0;
     num_var_tape_              = tape->Rec_.num_var_rec();
+    num_slot_                  = 0;
 
     // taylor_
     taylor_.resize(0);
@@ -288,6 +292,11 @@ void ADFun<Base,RecBase>::Dependent(local::ADTape<Base> *tape, const ADvector &y
     // load_op2var_
     load_op2var_.resize( tape->Rec_.num_var_load_rec() );
 
+    // slot_op_, slot_arg_, slot_dep_
+    slot_op_.clear();
+    slot_arg_.clear();
+    slot_dep_.clear();
+
     // play_
     // Now that each dependent variable has a place in the tape,
     // and there is a EndOp at the end of the tape, we can transfer the
@@ -179,6 +179,17 @@ void ADFun<Base,RecBase>::for_hes_sparsity(
         "for_hes_sparsity: size of select_range is not equal to "
         "number of dependent variables"
     );
+    //
+    // check if this pattern is in the sparse cache
+    std::string cache_key;
+    if( sparse_cache_ != nullptr && ! sparse_cache_atomic() )
+    {   size_t code = sparse_cache_code();
+        code = sparse_cache::hash(code, select_domain);
+        code = sparse_cache::hash(code, select_range);
+        cache_key = sparse_cache::key("for_hes_sparsity", code);
+        if( sparse_cache_->get_pattern(cache_key, pattern_out) )
+            return;
+    }
     // do not need transpose or depenency
     bool transpose  = false;
     bool dependency = false;
@@ -281,6 +292,9 @@ void ADFun<Base,RecBase>::for_hes_sparsity(
     {   CPPAD_ASSERT_UNKNOWN( 0 < col[k] );
         pattern_out.set(k, row[k], col[k] - 1);
     }
+    // put this pattern in the sparse cache
+    if( cache_key != "" )
+        sparse_cache_->set_pattern(cache_key, pattern_out);
     return;
 }
 } // END_CPPAD_NAMESPACE
@@ -0,0 +1,305 @@
+# ifndef CPPAD_CORE_FOR_JAC_SPARSITY_BLOCK_HPP
+# define CPPAD_CORE_FOR_JAC_SPARSITY_BLOCK_HPP
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-22 Bradley M. Bell
+
+CppAD is distributed under the terms of the
+             Eclipse Public License Version 2.0.
+
+This Source Code may also be made available under the following
+Secondary License when the conditions for such availability set forth
+in the Eclipse Public License, Version 2.0 are satisfied:
+      GNU General Public License, Version 2.0 or later.
+---------------------------------------------------------------------------- */
+/*
+$begin for_jac_sparsity_block$$
+$spell
+    Jacobian
+    jac
+    bool
+    const
+    rc
+    cpp
+    nnz
+$$
+
+$section Forward Mode Jacobian Sparsity Patterns for a Block of Columns$$
+
+$head Syntax$$
+$icode%f%.for_jac_sparsity_block(
+    %pattern_in%, %transpose%, %dependency%,
+    %col_begin%, %col_end%, %pattern_out%
+)%$$
+
+$head Purpose$$
+We use $latex F : \B{R}^n \rightarrow \B{R}^m$$ to denote the
+$cref/AD function/glossary/AD Function/$$ corresponding to
+the operation sequence stored in $icode f$$.
+Fix $latex R \in \B{R}^{n \times \ell}$$ and define the function
+$latex \[
+    J(x) = F^{(1)} ( x ) * R
+\] $$
+Given the $cref/sparsity pattern/glossary/Sparsity Pattern/$$ for $latex R$$,
+this routine computes the sparsity pattern for
+columns $icode col_begin$$ through $icode%col_end%-1%$$ of $latex J(x)$$.
+The time and memory used by $cref for_jac_sparsity$$
+are proportional to the number of variables in $icode f$$ times $latex \ell$$.
+Splitting the columns into blocks bounds the memory,
+and the blocks can be computed by different threads.
+
+$head f$$
+The object $icode f$$ has prototype
+$codei%
+    const ADFun<%Base%> %f%
+%$$
+Note that, in contrast to $cref for_jac_sparsity$$,
+no sparsity patterns are stored in $icode f$$ by this routine.
+
+$head pattern_in$$
+The argument $icode pattern_in$$ has prototype
+$codei%
+    const sparse_rc<%SizeVector%>& %pattern_in%
+%$$
+If $icode transpose$$ it is false (true),
+$icode pattern_in$$ is a sparsity pattern for $latex R$$ ($latex R^\R{T}$$).
+Only the entries corresponding to columns of $latex R$$ in the block
+are used.
+
+$head transpose$$
+This argument has prototype
+$codei%
+    bool %transpose%
+%$$
+See $cref/pattern_in/for_jac_sparsity_block/pattern_in/$$ above and
+$cref/pattern_out/for_jac_sparsity_block/pattern_out/$$ below.
+
+$head dependency$$
+This argument has prototype
+$codei%
+    bool %dependency%
+%$$
+If it is true, $icode pattern_out$$ is a
+$cref/dependency pattern/dependency.cpp/Dependency Pattern/$$
+instead of sparsity pattern.
+
+$head col_begin$$
+This argument has prototype
+$codei%
+    size_t %col_begin%
+%$$
+and is the first column of $latex R$$, and $latex J(x)$$, in the block.
+
+$head col_end$$
+This argument has prototype
+$codei%
+    size_t %col_end%
+%$$
+and is one more than the last column in the block.
+It must hold that $icode%col_begin% <= %col_end% <= %ell%$$.
+
+$head pattern_out$$
+This argument has prototype
+$codei%
+    sparse_rc<%SizeVector%>& %pattern_out%
+%$$
+This input value of $icode pattern_out$$ does not matter.
+If $icode transpose$$ it is false (true),
+upon return $icode pattern_out$$ has the same dimensions as
+$latex J(x)$$ ($latex J(x)^\R{T}$$)
+and contains the possibly non-zero entries in the columns (rows)
+$icode col_begin$$ through $icode%col_end%-1%$$.
+The entries are in row major (column major) order.
+If the blocks cover all the columns,
+the union of the entries for each block is the same as the pattern computed by
+$cref for_jac_sparsity$$ (possibly in a different order).
+
+$head SizeVector$$
+The type $icode SizeVector$$ is a $cref SimpleVector$$ class with
+$cref/elements of type/SimpleVector/Elements of Specified Type/$$
+$code size_t$$.
+
+$head Parallel Mode$$
+This routine does not modify $icode f$$.
+After $cref parallel_ad$$ has been called,
+different threads can use the same $icode f$$ to compute
+different blocks at the same time
+(each thread must use its own $icode pattern_out$$).
+Each thread uses memory proportional to the number of variables in $icode f$$
+times the number of columns in its block.
+The resulting patterns can be concatenated using the
+$cref/set/sparse_rc/set/$$ operation.
+
+$head Example$$
+$children%
+    example/sparse/for_jac_sparsity_block.cpp
+%$$
+The file
+$cref for_jac_sparsity_block.cpp$$
+contains an example and test of this operation.
+
+$end
+-----------------------------------------------------------------------------
+*/
+# include <cppad/core/ad_fun.hpp>
+# include <cppad/local/sparse/internal.hpp>
+
+namespace CppAD { // BEGIN_CPPAD_NAMESPACE
+
+/*!
+Forward Jacobian sparsity patterns for a block of columns.
+
+\tparam Base
+is the base type for this recording.
+
+\tparam SizeVector
+is the simple vector with elements of type size_t that is used for
+row, column index sparsity patterns.
+
+\param pattern_in
+is the sparsity pattern for for R or R^T depending on transpose.
+
+\param transpose
+Is the input and returned sparsity pattern transposed.
+
+\param dependency
+Are the derivatives with respect to left and right of the expression below
+considered to be non-zero:
+\code
+    CondExpRel(left, right, if_true, if_false)
+\endcode
+
+\param col_begin
+is the first column of R, and J(x), in the block.
+
+\param col_end
+is one more than the last column of R, and J(x), in the block.
+
+\param pattern_out
+The value of transpose is false (true),
+the return value is the sparsity pattern for the columns (rows)
+col_begin, ..., col_end-1 of J(x) ( J(x)^T ) where
+\f[
+    J(x) = F^{(1)} (x) * R
+\f]
+Here F is the function corresponding to the operation sequence
+and x is any argument value.
+*/
+template <class Base, class RecBase>
+template <class SizeVector>
+void ADFun<Base,RecBase>::for_jac_sparsity_block(
+    const sparse_rc<SizeVector>& pattern_in       ,
+    bool                         transpose        ,
+    bool                         dependency       ,
+    size_t                       col_begin        ,
+    size_t                       col_end          ,
+    sparse_rc<SizeVector>&       pattern_out      ) const
+{
+    // used to identify the RecBase type in calls to sweeps
+    RecBase not_used_rec_base(0.0);
+    //
+    // number or rows, columns, and non-zeros in pattern_in
+    size_t nr_in  = pattern_in.nr();
+    size_t nc_in  = pattern_in.nc();
+    size_t nnz_in = pattern_in.nnz();
+    //
+    size_t n   = nr_in;
+    size_t ell = nc_in;
+    if( transpose )
+        std::swap(n, ell);
+    //
+    CPPAD_ASSERT_KNOWN(
+        n == Domain() ,
+        "for_jac_sparsity_block: number rows in R "
+        "is not equal number of independent variables."
+    );
+    CPPAD_ASSERT_KNOWN(
+        col_begin <= col_end && col_end <= ell ,
+        "for_jac_sparsity_block: col_begin > col_end or "
+        "col_end > number of columns in R"
+    );
+    //
+    // number of columns in this block
+    size_t n_col = col_end - col_begin;
+    //
+    // number of dependent variables
+    size_t m = dep_taddr_.size();
+    //
+    // case where the block is empty
+    if( n_col == 0 )
+    {   if( transpose )
+            pattern_out.resize(ell, m, 0);
+        else
+            pattern_out.resize(m, ell, 0);
+        return;
+    }
+    //
+    // the rows of R corresponding to the columns in this block
+    const SizeVector& row_in( pattern_in.row() );
+    const SizeVector& col_in( pattern_in.col() );
+    size_t nnz_block = 0;
+    for(size_t k = 0; k < nnz_in; ++k)
+    {   size_t j = transpose ? row_in[k] : col_in[k];
+        if( col_begin <= j && j < col_end )
+            ++nnz_block;
+    }
+    sparse_rc<SizeVector> pattern_block(n, n_col, nnz_block);
+    size_t k_block = 0;
+    for(size_t k = 0; k < nnz_in; ++k)
+    {   size_t i = row_in[k];
+        size_t j = col_in[k];
+        if( transpose )
+            std::swap(i, j);
+        if( col_begin <= j && j < col_end )
+            pattern_block.set(k_block++, i, j - col_begin);
+    }
+    //
+    // sparsity patterns for all the variables in this block
+    local::sparse::pack_setvec var_sparsity;
+    var_sparsity.resize(num_var_tape_, n_col);
+    //
+    // set sparsity patttern for independent variables
+    bool zero_empty  = true;
+    bool input_empty = true;
+    local::sparse::set_internal_pattern(
+        zero_empty            ,
+        input_empty           ,
+        false                 ,
+        ind_taddr_            ,
+        var_sparsity          ,
+        pattern_block
+    );
+    //
+    // compute sparsity for other variables
+    local::sweep::for_jac<addr_t>(
+        &play_,
+        dependency,
+        n,
+        num_var_tape_,
+        var_sparsity,
+        not_used_rec_base
+    );
+    //
+    // get the pattern for this block
+    local::sparse::get_internal_pattern(
+        transpose, dep_taddr_, var_sparsity, pattern_block
+    );
+    //
+    // shift the columns of J (rows of J^T) to their index in J
+    size_t nnz = pattern_block.nnz();
+    const SizeVector& row_block( pattern_block.row() );
+    const SizeVector& col_block( pattern_block.col() );
+    if( transpose )
+    {   pattern_out.resize(ell, m, nnz);
+        for(size_t k = 0; k < nnz; ++k)
+            pattern_out.set(k, row_block[k] + col_begin, col_block[k]);
+    }
+    else
+    {   pattern_out.resize(m, ell, nnz);
+        for(size_t k = 0; k < nnz; ++k)
+            pattern_out.set(k, row_block[k], col_block[k] + col_begin);
+    }
+    return;
+}
+
+} // END_CPPAD_NAMESPACE
+# endif
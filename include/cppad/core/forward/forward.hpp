@@ -125,6 +125,14 @@ BaseVector ADFun<Base,RecBase>::Forward(
     size_t p = q + 1 - size_t(xq.size()) / n;
     CPPAD_ASSERT_UNKNOWN( p == 0 || p == q );
 
+    // check for optimize zero_order_only option
+    bool use_slot = num_slot_ > 0;
+    CPPAD_ASSERT_KNOWN(
+        q == 0 || ! use_slot,
+        "Forward(q, xq): q > 0 and this ADFun object has been optimized"
+        "\nusing the zero_order_only option."
+    );
+
     // check one order case
     CPPAD_ASSERT_KNOWN(
         q <= num_order_taylor_ || p == 0,
@@ -141,7 +149,14 @@ BaseVector ADFun<Base,RecBase>::Forward(
     );
 
     // does taylor_ need more orders or fewer directions
-    if( (cap_order_taylor_ <= q) | (num_direction_taylor_ != 1) )
+    if( use_slot )
+    {   // one zero order coefficient per slot; see optimize_get_var_slot
+        num_order_taylor_     = 0;
+        cap_order_taylor_     = 0;
+        num_direction_taylor_ = 1;
+        taylor_.resize(num_slot_);
+    }
+    else if( (cap_order_taylor_ <= q) | (num_direction_taylor_ != 1) )
     {   if( p == 0 )
         {   // no need to copy old values during capacity_order
             num_order_taylor_ = 0;
@@ -152,21 +167,30 @@ BaseVector ADFun<Base,RecBase>::Forward(
         size_t r = 1;
         capacity_order(c, r);
     }
-    CPPAD_ASSERT_UNKNOWN( cap_order_taylor_ > q );
+    CPPAD_ASSERT_UNKNOWN( cap_order_taylor_ > q || use_slot );
     CPPAD_ASSERT_UNKNOWN( num_direction_taylor_ == 1 );
 
     // short hand notation for order capacity
     size_t C = cap_order_taylor_;
+    if( use_slot )
+        C = 1;
+
+    // number of rows in taylor_
+    size_t num_row = num_var_tape_;
+    if( use_slot )
+        num_row = num_slot_;
 
     // The optimizer may skip a step that does not affect dependent variables.
     // Initilaizing zero order coefficients avoids following valgrind warning:
     // "Conditional jump or move depends on uninitialised value(s)".
-    for(j = 0; j < num_var_tape_; j++)
+    for(j = 0; j < num_row; j++)
     {   for(k = p; k <= q; k++)
             taylor_[C * j + k] = CppAD::numeric_limits<Base>::quiet_NaN();
     }
 
     // set Taylor coefficients for independent variables
+    // (when use_slot is true, the slot for an independent variable
+    // is its index on the tape)
     for(j = 0; j < n; j++)
     {   CPPAD_ASSERT_UNKNOWN( ind_taddr_[j] < num_var_tape_  );
 
@@ -185,13 +209,20 @@ BaseVector ADFun<Base,RecBase>::Forward(
     CPPAD_ASSERT_UNKNOWN( cskip_op_.size() == play_.num_op_rec() );
     CPPAD_ASSERT_UNKNOWN( load_op2var_.size()  == play_.num_var_load_rec() );
     if( q == 0 )
-    {
+    {   const addr_t* slot_op  = nullptr;
+        const addr_t* slot_arg = nullptr;
+        if( use_slot )
+        {   slot_op  = slot_op_.data();
+            slot_arg = slot_arg_.data();
+        }
         local::sweep::forward0(&play_, s, true,
-            n, num_var_tape_, C,
+            n, num_row, C,
             taylor_.data(), cskip_op_.data(), load_op2var_,
             compare_change_count_,
             compare_change_number_,
             compare_change_op_index_,
+            slot_op,
+            slot_arg,
             not_used_rec_base
         );
     }
@@ -208,7 +239,14 @@ BaseVector ADFun<Base,RecBase>::Forward(
 
     // return Taylor coefficients for dependent variables
     BaseVector yq;
-    if( p == q )
+    if( use_slot )
+    {   yq.resize(m);
+        for(i = 0; i < m; i++)
+        {   CPPAD_ASSERT_UNKNOWN( slot_dep_[i] < num_slot_  );
+            yq[i] = taylor_[ slot_dep_[i] ];
+        }
+    }
+    else if( p == q )
     {   yq.resize(m);
         for(i = 0; i < m; i++)
         {   CPPAD_ASSERT_UNKNOWN( dep_taddr_[i] < num_var_tape_  );
@@ -286,7 +324,9 @@ BaseVector ADFun<Base,RecBase>::Forward(
 # endif
 
     // now we have q + 1  taylor_ coefficient orders per variable
-    num_order_taylor_ = q + 1;
+    // (the values in the slots are only valid for zero order forward)
+    if( ! use_slot )
+        num_order_taylor_ = q + 1;
 
     return yq;
 }
@@ -264,7 +264,9 @@ compare_change_op_index_(0),
 num_order_taylor_(0),
 cap_order_taylor_(0),
 num_direction_taylor_(0),
-num_var_tape_(0)
+num_var_tape_(0),
+num_slot_(0),
+sparse_cache_(nullptr)
 { }
 //
 // move semantics version of constructor
@@ -317,6 +319,7 @@ void ADFun<Base,RecBase>::operator=(const ADFun& f)
     cap_order_taylor_          = f.cap_order_taylor_;
     num_direction_taylor_      = f.num_direction_taylor_;
     num_var_tape_              = f.num_var_tape_;
+    num_slot_                  = f.num_slot_;
     //
     // pod_vector objects
     ind_taddr_                 = f.ind_taddr_;
@@ -324,6 +327,9 @@ void ADFun<Base,RecBase>::operator=(const ADFun& f)
     dep_parameter_             = f.dep_parameter_;
     cskip_op_                  = f.cskip_op_;
     load_op2var_               = f.load_op2var_;
+    slot_op_                   = f.slot_op_;
+    slot_arg_                  = f.slot_arg_;
+    slot_dep_                  = f.slot_dep_;
     //
     // pod_vector_maybe_vectors
     taylor_                    = f.taylor_;
@@ -332,6 +338,15 @@ void ADFun<Base,RecBase>::operator=(const ADFun& f)
     // player
     play_                      = f.play_;
     //
+    // optimize_plan
+    optimize_plan_             = f.optimize_plan_;
+    //
+    // sparse_cache
+    sparse_cache_              = f.sparse_cache_;
+    //
+    // optimize_report
+    optimize_report_           = f.optimize_report_;
+    //
     // subgraph
     subgraph_info_             = f.subgraph_info_;
     //
@@ -361,6 +376,7 @@ void ADFun<Base,RecBase>::swap(ADFun& f)
     std::swap( cap_order_taylor_          , f.cap_order_taylor_);
     std::swap( num_direction_taylor_      , f.num_direction_taylor_);
     std::swap( num_var_tape_              , f.num_var_tape_);
+    std::swap( num_slot_                  , f.num_slot_);
     //
     // pod_vector objects
     ind_taddr_.swap(      f.ind_taddr_);
@@ -369,10 +385,22 @@ void ADFun<Base,RecBase>::swap(ADFun& f)
     taylor_.swap(         f.taylor_);
     cskip_op_.swap(       f.cskip_op_);
     load_op2var_.swap(    f.load_op2var_);
+    slot_op_.swap(        f.slot_op_);
+    slot_arg_.swap(       f.slot_arg_);
+    slot_dep_.swap(       f.slot_dep_);
     //
     // player
     play_.swap(f.play_);
     //
+    // optimize_plan
+    optimize_plan_.swap(f.optimize_plan_);
+    //
+    // sparse_cache
+    std::swap( sparse_cache_, f.sparse_cache_ );
+    //
+    // optimize_report
+    std::swap( optimize_report_, f.optimize_report_ );
+    //
     // subgraph_info
     subgraph_info_.swap(f.subgraph_info_);
     //
@@ -472,6 +500,7 @@ ADFun<Base,RecBase>::ADFun(const ADVector &x, const ADVector &y)
 
     // ad_fun.hpp member values not set by dependent
     check_for_nan_       = true;
+    sparse_cache_        = nullptr;
 
     // allocate memory for one zero order taylor_ coefficient
     CPPAD_ASSERT_UNKNOWN( num_order_taylor_ == 0 );
@@ -499,6 +528,8 @@ ADFun<Base,RecBase>::ADFun(const ADVector &x, const ADVector &y)
         compare_change_count_,
         compare_change_number_,
         compare_change_op_index_,
+        nullptr,
+        nullptr,
         not_used_rec_base
     );
     CPPAD_ASSERT_UNKNOWN( compare_change_count_    == 1 );
@@ -0,0 +1,550 @@
+# ifndef CPPAD_CORE_FUN_WORK_HPP
+# define CPPAD_CORE_FUN_WORK_HPP
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-22 Bradley M. Bell
+
+CppAD is distributed under the terms of the
+             Eclipse Public License Version 2.0.
+
+This Source Code may also be made available under the following
+Secondary License when the conditions for such availability set forth
+in the Eclipse Public License, Version 2.0 are satisfied:
+      GNU General Public License, Version 2.0 or later.
+---------------------------------------------------------------------------- */
+/*
+$begin fun_work$$
+$spell
+    const
+    xq
+    yq
+    dw
+    std
+    ostream
+    cout
+    Taylor
+    op
+$$
+
+$section Forward and Reverse Mode Using a Separate Workspace$$
+
+$head Syntax$$
+$codei%fun_work<%Base%> %work%
+%$$
+$icode%yq% = %f%.forward(%work%, %q%, %xq% )
+%$$
+$icode%yq% = %f%.forward(%work%, %q%, %xq%, %s%)
+%$$
+$icode%dw% = %f%.reverse(%work%, %q%, %w%)
+%$$
+$icode%work%.size_order()
+%$$
+$icode%work%.compare_change_number()
+%$$
+$icode%work%.compare_change_op_index()
+%$$
+$icode%work%.clear()
+%$$
+
+$head Prototype$$
+$srcthisfile%
+    0%// BEGIN_FORWARD_PROTOTYPE%// END_FORWARD_PROTOTYPE%1
+%$$
+$srcthisfile%
+    0%// BEGIN_REVERSE_PROTOTYPE%// END_REVERSE_PROTOTYPE%1
+%$$
+
+$head Purpose$$
+The routines $cref/f.Forward/forward_order/$$ and
+$cref/f.Reverse/reverse_any/$$ store the Taylor coefficients,
+and other information about the most recent evaluation, in $icode f$$.
+Hence they cannot be used by two threads at the same time
+(even when all the threads use the same argument values).
+The routines $code forward$$ and $code reverse$$ (lower case)
+store this information in $icode work$$ and do not change $icode f$$.
+Multiple threads can use the same function object $icode f$$ at the same
+time provided that each thread uses a different workspace $icode work$$.
+This avoids making a copy of $icode f$$ for each thread.
+
+$head Base$$
+This is the type used for the evaluations; i.e.,
+$icode f$$ is an $codei%ADFun<%Base%>%$$ object.
+
+$head f$$
+This object is $code const$$ for the $code forward$$ and $code reverse$$
+routines.
+Operations that change $icode f$$, for example
+$cref/f.Forward/forward_order/$$ or $cref new_dynamic$$,
+must not be done while another thread is using $icode f$$.
+
+$head work$$
+This workspace holds the Taylor coefficients, and the other information,
+for the most recent $code forward$$ call that used $icode work$$.
+It starts out empty and will grow as necessary.
+If $icode work$$ is used with a different function,
+or the same function after $cref/optimization/optimize/$$,
+its previous information is discarded.
+Only one thread can use $icode work$$ at a time,
+but it can be used by different threads at different times.
+
+$subhead size_order$$
+The return value of $icode%work%.size_order()%$$
+is the number of Taylor coefficient orders, per variable,
+currently stored in $icode work$$; see $cref size_order$$.
+
+$subhead compare_change$$
+The values returned by $icode%work%.compare_change_number()%$$ and
+$icode%work%.compare_change_op_index()%$$ are the
+$cref/number/compare_change/number/$$ and
+$cref/op_index/compare_change/op_index/$$ for the most recent
+zero order $code forward$$ that used $icode work$$.
+The corresponding $cref/count/compare_change/count/$$ is the one set
+for $icode f$$.
+
+$subhead clear$$
+The routine $icode%work%.clear()%$$ frees the memory
+that is held by $icode work$$.
+
+$head forward$$
+The arguments $icode q$$, $icode xq$$, $icode s$$ and the
+return value $icode yq$$ have the same meaning as for
+$cref/f.Forward(q, xq, s)/forward_order/$$
+where the Taylor coefficients of order less than $icode q$$
+are the ones stored in $icode work$$ (instead of $icode f$$).
+Only one direction is supported; i.e., there is no $icode work$$ version of
+$cref/f.Forward(q, r, xq)/forward_dir/$$.
+
+$head reverse$$
+The arguments $icode q$$, $icode w$$, and the
+return value $icode dw$$ have the same meaning as for
+$cref/f.Reverse(q, w)/reverse_any/$$
+where the Taylor coefficients are the ones stored in $icode work$$
+(instead of $icode f$$).
+
+$head Atomic Functions$$
+If $icode f$$ contains $cref atomic$$ function calls,
+and $code forward$$ or $code reverse$$ is used in
+$cref/parallel mode/ta_in_parallel/$$,
+the atomic functions must support parallel execution;
+e.g., see $cref/parallel_ad/parallel_ad/Purpose/$$.
+
+$children%
+    example/general/fun_work.cpp
+%$$
+$head Example$$
+The file $cref fun_work.cpp$$
+contains an example and test of this operation.
+
+$end
+-----------------------------------------------------------------------------
+*/
+# include <cppad/local/pod_vector.hpp>
+# include <cppad/local/play/sequential_iterator.hpp>
+
+namespace CppAD { // BEGIN_CPPAD_NAMESPACE
+/*!
+\file fun_work.hpp
+Forward and reverse mode that store their results in a separate workspace.
+*/
+
+/*!
+Workspace used by the const ADFun forward and reverse routines.
+
+\tparam Base
+is the base type for the ADFun object that uses this workspace.
+*/
+template <class Base>
+class fun_work {
+    // the ADFun routines that use this workspace
+    template <class Base2, class RecBase2> friend class ADFun;
+private:
+    /// number of rows in taylor_ (variables or slots)
+    size_t num_row_;
+
+    /// number of orders stored in taylor_
+    size_t num_order_;
+
+    /// maximum number of orders that will fit in taylor_
+    size_t cap_order_;
+
+    /// results of the comparisons during the most recent zero order forward
+    size_t compare_change_number_;
+    size_t compare_change_op_index_;
+
+    /// which operations can be conditionally skipped
+    local::pod_vector<bool> cskip_op_;
+
+    /// variable index that each load operation corresponds to
+    local::pod_vector<addr_t> load_op2var_;
+
+    /// Taylor coefficients for each row
+    local::pod_vector_maybe<Base> taylor_;
+
+    /// partials for reverse mode
+    local::pod_vector_maybe<Base> partial_;
+
+    /// prepare this workspace for a function with the specified sizes
+    void setup(size_t num_op, size_t num_load, size_t num_row)
+    {   if( cskip_op_.size() == num_op &&
+            load_op2var_.size() == num_load &&
+            num_row_ == num_row )
+            return;
+        clear();
+        num_row_ = num_row;
+        cskip_op_.resize(num_op);
+        load_op2var_.resize(num_load);
+    }
+
+    /// make sure there is room for c orders, keep the current orders
+    void capacity_order(size_t c)
+    {   if( c <= cap_order_ )
+            return;
+        local::pod_vector_maybe<Base> new_taylor(num_row_ * c);
+        for(size_t i = 0; i < num_row_; ++i)
+        {   for(size_t k = 0; k < num_order_; ++k)
+                new_taylor[c * i + k] = taylor_[cap_order_ * i + k];
+        }
+        taylor_.swap(new_taylor);
+        cap_order_ = c;
+    }
+public:
+    /// constructor
+    fun_work(void)
+    : num_row_(0)
+    , num_order_(0)
+    , cap_order_(0)
+    , compare_change_number_(0)
+    , compare_change_op_index_(0)
+    { }
+
+    /// number of Taylor coefficient orders currently stored
+    size_t size_order(void) const
+    {   return num_order_; }
+
+    /// number of comparisons that changed during the most recent forward
+    size_t compare_change_number(void) const
+    {   return compare_change_number_; }
+
+    /// operator index for the first comparison that changed
+    size_t compare_change_op_index(void) const
+    {   return compare_change_op_index_; }
+
+    /// free the memory held by this workspace
+    void clear(void)
+    {   num_row_                 = 0;
+        num_order_               = 0;
+        cap_order_               = 0;
+        compare_change_number_   = 0;
+        compare_change_op_index_ = 0;
+        cskip_op_.clear();
+        load_op2var_.clear();
+        taylor_.clear();
+        partial_.clear();
+    }
+};
+
+/*!
+Forward mode Taylor coefficients stored in a workspace.
+
+\param work
+contains the Taylor coefficients of order less than q (when xq.size() == n)
+and is where the new Taylor coefficients are stored.
+
+\param q
+is the highest order for this forward mode computation.
+
+\param xq
+contains the Taylor coefficients for the independent variables;
+see f.Forward(q, xq, s).
+
+\param s
+is the stream where output corresponding to PriOp operations are written.
+
+\return
+is the Taylor coefficients for the dependent variables;
+see f.Forward(q, xq, s).
+*/
+// BEGIN_FORWARD_PROTOTYPE
+template <class Base, class RecBase>
+template <class BaseVector>
+BaseVector ADFun<Base,RecBase>::forward(
+    fun_work<Base>&     work      ,
+    size_t              q         ,
+    const BaseVector&   xq        ,
+    std::ostream&       s         ) const
+// END_FORWARD_PROTOTYPE
+{
+    // used to identify the RecBase type in calls to sweeps
+    RecBase not_used_rec_base(0.0);
+
+    // number of independent variables
+    size_t n = ind_taddr_.size();
+
+    // number of dependent variables
+    size_t m = dep_taddr_.size();
+
+    // check Vector is Simple Vector class with Base type elements
+    CheckSimpleVector<Base, BaseVector>();
+
+    // check size of xq
+    CPPAD_ASSERT_KNOWN(
+        size_t(xq.size()) == n || size_t(xq.size()) == n*(q+1),
+        "f.forward(work, q, xq): xq.size() is not equal n or n*(q+1)"
+    );
+
+    // p = lowest order we are computing
+    size_t p = q + 1 - size_t(xq.size()) / n;
+    CPPAD_ASSERT_UNKNOWN( p == 0 || p == q );
+
+    // check for optimize zero_order_only option
+    bool use_slot = num_slot_ > 0;
+    CPPAD_ASSERT_KNOWN(
+        q == 0 || ! use_slot,
+        "f.forward(work, q, xq): q > 0 and this ADFun object has been"
+        "\noptimized using the zero_order_only option."
+    );
+
+    // number of rows in the Taylor coefficient matrix
+    size_t num_row = num_var_tape_;
+    if( use_slot )
+        num_row = num_slot_;
+
+    // discard information for a different function
+    work.setup(play_.num_op_rec(), play_.num_var_load_rec(), num_row);
+
+    // check one order case
+    CPPAD_ASSERT_KNOWN(
+        q <= work.num_order_ || p == 0,
+        "f.forward(work, q, xq): Number of Taylor coefficient orders stored"
+        " in work\nis less than q and xq.size() != n*(q+1)."
+    );
+
+    // make sure there is room for q + 1 orders
+    if( use_slot )
+    {   // one zero order coefficient per slot; see optimize_get_var_slot
+        work.num_order_ = 0;
+        work.capacity_order(1);
+    }
+    else
+    {   if( p == 0 )
+            work.num_order_ = 0;
+        else
+            work.num_order_ = q;
+        work.capacity_order(q + 1);
+    }
+    size_t C = work.cap_order_;
+    if( use_slot )
+        C = 1;
+    Base* taylor = work.taylor_.data();
+
+    // The optimizer may skip a step that does not affect dependent variables.
+    // Initializing zero order coefficients avoids following valgrind warning:
+    // "Conditional jump or move depends on uninitialised value(s)".
+    for(size_t j = 0; j < num_row; j++)
+    {   for(size_t k = p; k <= q; k++)
+            taylor[C * j + k] = CppAD::numeric_limits<Base>::quiet_NaN();
+    }
+
+    // set Taylor coefficients for independent variables
+    for(size_t j = 0; j < n; j++)
+    {   CPPAD_ASSERT_UNKNOWN( ind_taddr_[j] < num_var_tape_  );
+        CPPAD_ASSERT_UNKNOWN( play_.GetOp( ind_taddr_[j] ) == local::InvOp );
+        if( p == q )
+            taylor[ C * ind_taddr_[j] + q] = xq[j];
+        else
+        {   for(size_t k = 0; k <= q; k++)
+                taylor[ C * ind_taddr_[j] + k] = xq[ (q+1)*j + k];
+        }
+    }
+
+    // evaluate the derivatives
+    if( q == 0 )
+    {   const addr_t* slot_op  = nullptr;
+        const addr_t* slot_arg = nullptr;
+        if( use_slot )
+        {   slot_op  = slot_op_.data();
+            slot_arg = slot_arg_.data();
+        }
+        local::sweep::forward0(&play_, s, true,
+            n, num_row, C,
+            taylor, work.cskip_op_.data(), work.load_op2var_,
+            compare_change_count_,
+            work.compare_change_number_,
+            work.compare_change_op_index_,
+            slot_op,
+            slot_arg,
+            not_used_rec_base
+        );
+    }
+    else
+    {   // the compare_change information is only for zero order forward
+        size_t compare_change_number   = 0;
+        size_t compare_change_op_index = 0;
+        local::sweep::forward1(&play_, s, true, p, q,
+            n, num_var_tape_, C,
+            taylor, work.cskip_op_.data(), work.load_op2var_,
+            compare_change_count_,
+            compare_change_number,
+            compare_change_op_index,
+            not_used_rec_base
+        );
+        if( p == 0 )
+        {   work.compare_change_number_   = compare_change_number;
+            work.compare_change_op_index_ = compare_change_op_index;
+        }
+    }
+
+    // return Taylor coefficients for dependent variables
+    BaseVector yq;
+    if( use_slot )
+    {   yq.resize(m);
+        for(size_t i = 0; i < m; i++)
+        {   CPPAD_ASSERT_UNKNOWN( slot_dep_[i] < num_slot_  );
+            yq[i] = taylor[ slot_dep_[i] ];
+        }
+    }
+    else if( p == q )
+    {   yq.resize(m);
+        for(size_t i = 0; i < m; i++)
+        {   CPPAD_ASSERT_UNKNOWN( dep_taddr_[i] < num_var_tape_  );
+            yq[i] = taylor[ C * dep_taddr_[i] + q];
+        }
+    }
+    else
+    {   yq.resize(m * (q+1) );
+        for(size_t i = 0; i < m; i++)
+        {   for(size_t k = 0; k <= q; k++)
+                yq[ (q+1) * i + k] = taylor[ C * dep_taddr_[i] + k ];
+        }
+    }
+    CPPAD_ASSERT_KNOWN( ! ( hasnan(yq) && check_for_nan_ ) ,
+        "yq = f.forward(work, q, xq): has a nan."
+    );
+
+    // now we have q + 1 Taylor coefficient orders per variable
+    // (the values in the slots are only valid for zero order forward)
+    if( ! use_slot )
+        work.num_order_ = q + 1;
+
+    return yq;
+}
+
+/*!
+Reverse mode derivatives of the Taylor coefficients stored in a workspace.
+
+\param work
+contains the Taylor coefficients computed by previous calls to
+f.forward(work, q, xq) and is where the partials are stored.
+
+\param q
+is the number of Taylor coefficients that are being differentiated
+(per variable).
+
+\param w
+is the weighting for each of the Taylor coefficients corresponding
+to dependent variables; see f.Reverse(q, w).
+
+\return
+is the derivative of the weighted Taylor coefficients
+w.r.t. the Taylor coefficients for the independent variables;
+see f.Reverse(q, w).
+*/
+// BEGIN_REVERSE_PROTOTYPE
+template <class Base, class RecBase>
+template <class BaseVector>
+BaseVector ADFun<Base,RecBase>::reverse(
+    fun_work<Base>&     work      ,
+    size_t              q         ,
+    const BaseVector&   w         ) const
+// END_REVERSE_PROTOTYPE
+{   // used to identify the RecBase type in calls to sweeps
+    RecBase not_used_rec_base(0.0);
+
+    // number of independent variables
+    size_t n = ind_taddr_.size();
+
+    // number of dependent variables
+    size_t m = dep_taddr_.size();
+
+    // check BaseVector is Simple Vector class with Base type elements
+    CheckSimpleVector<Base, BaseVector>();
+
+    CPPAD_ASSERT_KNOWN(
+        size_t(w.size()) == m || size_t(w.size()) == (m * q),
+        "f.reverse(work, q, w): w.size() is not equal m or m * q."
+    );
+    CPPAD_ASSERT_KNOWN(
+        q > 0,
+        "f.reverse(work, q, w): q is not greater than zero."
+    );
+    CPPAD_ASSERT_KNOWN(
+        work.cskip_op_.size() == play_.num_op_rec() &&
+        work.num_row_ == num_var_tape_ &&
+        work.num_order_ >= q,
+        "f.reverse(work, q, w): Less than q Taylor coefficients are"
+        " stored in work for this function."
+    );
+
+    // initialize entire Partial matrix to zero
+    work.partial_.resize(num_var_tape_ * q);
+    Base* partial = work.partial_.data();
+    for(size_t i = 0; i < num_var_tape_ * q; i++)
+        partial[i] = Base(0);
+
+    // set the dependent variable direction
+    // (use += because two dependent variables can point to same location)
+    for(size_t i = 0; i < m; i++)
+    {   CPPAD_ASSERT_UNKNOWN( dep_taddr_[i] < num_var_tape_  );
+        if( size_t(w.size()) == m )
+            partial[dep_taddr_[i] * q + q - 1] += w[i];
+        else
+        {   for(size_t k = 0; k < q; k++)
+                partial[ dep_taddr_[i] * q + k ] += w[i * q + k ];
+        }
+    }
+
+    // evaluate the derivatives
+    local::play::const_sequential_iterator play_itr = play_.end();
+    local::sweep::reverse(
+        q - 1,
+        n,
+        num_var_tape_,
+        &play_,
+        work.cap_order_,
+        work.taylor_.data(),
+        q,
+        partial,
+        work.cskip_op_.data(),
+        work.load_op2var_,
+        play_itr,
+        not_used_rec_base
+    );
+
+    // return the derivative values
+    BaseVector value(n * q);
+    for(size_t j = 0; j < n; j++)
+    {   CPPAD_ASSERT_UNKNOWN( ind_taddr_[j] < num_var_tape_  );
+
+        // by the Reverse Identity Theorem
+        // partial of y^{(k)} w.r.t. u^{(0)} is equal to
+        // partial of y^{(q-1)} w.r.t. u^{(q - 1 - k)}
+        if( size_t(w.size()) == m )
+        {   for(size_t k = 0; k < q; k++)
+                value[j * q + k ] =
+                    partial[ind_taddr_[j] * q + q - 1 - k];
+        }
+        else
+        {   for(size_t k = 0; k < q; k++)
+                value[j * q + k ] =
+                    partial[ind_taddr_[j] * q + k];
+        }
+    }
+    CPPAD_ASSERT_KNOWN( ! ( hasnan(value) && check_for_nan_ ) ,
+        "dw = f.reverse(work, q, w): has a nan,\n"
+        "but none of its Taylor coefficents are nan."
+    );
+
+    return value;
+}
+
+} // END_CPPAD_NAMESPACE
+# endif
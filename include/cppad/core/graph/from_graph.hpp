@@ -1454,6 +1454,9 @@ void CppAD::ADFun<Base,RecBase>::from_graph(
     // bool values in this object except check_for_nan_
     has_been_optimized_        = false;
     //
+    // this operation sequence has not been optimized
+    optimize_report_.clear();
+    //
     // size_t values in this object
     compare_change_count_      = 1;
     compare_change_number_     = 0;
@@ -1462,6 +1465,7 @@ void CppAD::ADFun<Base,RecBase>::from_graph(
     cap_order_taylor_          = 0;
     num_direction_taylor_      = 0;
     num_var_tape_              = rec.num_var_rec();
+    num_slot_                  = 0;
     //
     // taylor_
     taylor_.resize(0);
@@ -1472,6 +1476,11 @@ void CppAD::ADFun<Base,RecBase>::from_graph(
     // load_op2var_
     load_op2var_.resize( rec.num_var_load_rec() );
     //
+    // slot_op_, slot_arg_, slot_dep_
+    slot_op_.clear();
+    slot_arg_.clear();
+    slot_dep_.clear();
+    //
     // play_
     // Now that each dependent variable has a place in the recording,
     // and there is a EndOp at the end of the record, we can transfer the
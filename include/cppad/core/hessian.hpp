@@ -20,6 +20,7 @@ $spell
     Taylor
     HesLuDet
     const
+    alloc
 $$
 
 
@@ -30,6 +31,8 @@ $icode%hes% = %f%.Hessian(%x%, %w%)
 %$$
 $icode%hes% = %f%.Hessian(%x%, %l%)
 %$$
+$icode%hes% = %f%.Hessian(%x%, %w%, %pool%)
+%$$
 
 
 $head Purpose$$
@@ -89,6 +92,18 @@ and size $latex m$$.
 It specifies the value of $latex w_i$$ in the expression
 for $icode h$$.
 
+$head pool$$
+If the argument $icode pool$$ is present, it has prototype
+$codei%
+    thread_pool& %pool%
+%$$
+The columns of the Hessian are divided between the threads in the
+$cref thread_pool$$.
+Each thread uses its own copy of $icode f$$.
+This syntax must be called in sequential execution mode and
+$cref/parallel_ad/thread_pool/parallel_ad/$$ must have been called
+after $icode pool$$ was created.
+
 $head hes$$
 The result $icode hes$$ has prototype
 $codei%
@@ -133,9 +148,50 @@ They return $code true$$, if they succeed and $code false$$ otherwise.
 $end
 -----------------------------------------------------------------------------
 */
+# include <cppad/local/pool_fun.hpp>
 
 //  BEGIN CppAD namespace
 namespace CppAD {
+namespace local {
+/*!
+Job that computes one column of a Hessian.
+
+The task index is the column index j. The zero order Taylor coefficients
+for the copies of the function must correspond to the argument value.
+*/
+template <class Base, class RecBase, class Vector>
+class hessian_job {
+private:
+    /// copies of the function for each thread
+    pool_fun<Base, RecBase>& fun_;
+    /// weighting vector for the components of the function
+    const Vector&            w_;
+    /// the Hessian (row major order)
+    Vector&                  hes_;
+public:
+    /// constructor
+    hessian_job(pool_fun<Base, RecBase>& fun, const Vector& w, Vector& hes)
+    : fun_(fun), w_(w), hes_(hes)
+    { }
+    /// compute column j of the Hessian
+    void operator()(size_t j, size_t thread)
+    {   ADFun<Base, RecBase>& f( fun_.get(thread) );
+        size_t n = f.Domain();
+        //
+        // partials of entire function w.r.t. j-th coordinate
+        Vector u(n);
+        for(size_t ell = 0; ell < n; ++ell)
+            u[ell] = Base(0.0);
+        u[j] = Base(1.0);
+        f.Forward(1, u);
+        //
+        // derivative of partial corresponding to w^T F
+        Vector ddw = f.Reverse(2, w_);
+        for(size_t k = 0; k < n; ++k)
+            hes_[k * n + j] = ddw[k * 2 + 1];
+    }
+};
+} // END local namespace
 
 template <class Base, class RecBase>
 template <class Vector>
@@ -208,6 +264,57 @@ Vector ADFun<Base,RecBase>::Hessian(const Vector &x, const Vector &w)
     return hes;
 }
 
+/*!
+Hessian using the threads in a thread_pool.
+
+\param x
+is the argument value at which the Hessian is evaluated.
+
+\param w
+is the weighting vector for the components of the function.
+
+\param pool
+is the pool of threads used to compute the columns of the Hessian.
+
+\return
+is the Hessian of w^T F(x) in row major order.
+*/
+template <class Base, class RecBase>
+template <class Vector>
+Vector ADFun<Base,RecBase>::Hessian(
+    const Vector &x, const Vector &w, thread_pool& pool
+)
+{   size_t n = Domain();
+
+    // check Vector is Simple Vector class with Base type elements
+    CheckSimpleVector<Base, Vector>();
+
+    CPPAD_ASSERT_KNOWN(
+        size_t(x.size()) == n,
+        "Hessian: length of x not equal domain dimension for f"
+    );
+    CPPAD_ASSERT_KNOWN(
+        size_t(w.size()) == Range(),
+        "Hessian: length of w not equal range dimension for f"
+    );
+    CPPAD_ASSERT_KNOWN(
+        ! thread_alloc::in_parallel(),
+        "Hessian: pool is present and in parallel mode"
+    );
+
+    // point at which we are evaluating the Hessian
+    // (copies of this function start with these Taylor coefficients)
+    Forward(0, x);
+
+    // each task computes one column of the Hessian
+    Vector hes(n * n);
+    local::pool_fun<Base, RecBase> fun(*this, pool);
+    local::hessian_job<Base, RecBase, Vector> job(fun, w, hes);
+    pool.run(n, job);
+
+    return hes;
+}
+
 } // END CppAD namespace
 
 # endif
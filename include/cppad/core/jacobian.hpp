@@ -21,13 +21,16 @@ $spell
     Jacobian
     DetLu
     const
+    alloc
 $$
 
 
 $section Jacobian: Driver Routine$$
 
 $head Syntax$$
-$icode%jac% = %f%.Jacobian(%x%)%$$
+$icode%jac% = %f%.Jacobian(%x%)
+%$$
+$icode%jac% = %f%.Jacobian(%x%, %pool%)%$$
 
 
 $head Purpose$$
@@ -84,6 +87,18 @@ $icode Base$$.
 The routine $cref CheckSimpleVector$$ will generate an error message
 if this is not the case.
 
+$head pool$$
+If the argument $icode pool$$ is present, it has prototype
+$codei%
+    thread_pool& %pool%
+%$$
+The columns (forward mode) or rows (reverse mode) of the Jacobian
+are divided between the threads in the $cref thread_pool$$.
+Each thread uses its own copy of $icode f$$.
+This syntax must be called in sequential execution mode and
+$cref/parallel_ad/thread_pool/parallel_ad/$$ must have been called
+after $icode pool$$ was created.
+
 $head Forward or Reverse$$
 This will use order zero Forward mode and either
 order one Forward or order one Reverse to compute the Jacobian
@@ -107,9 +122,91 @@ It returns $code true$$, if it succeeds and $code false$$ otherwise.
 $end
 -----------------------------------------------------------------------------
 */
+# include <cppad/local/pool_fun.hpp>
 
 //  BEGIN CppAD namespace
 namespace CppAD {
+namespace local {
+/*!
+Job that computes one column of a Jacobian using forward mode.
+
+The task index is the column index j. The zero order Taylor coefficients
+for the copies of the function must correspond to the argument value.
+*/
+template <class Base, class RecBase, class Vector>
+class jacobian_for_job {
+private:
+    /// copies of the function for each thread
+    pool_fun<Base, RecBase>& fun_;
+    /// the Jacobian (row major order)
+    Vector&                  jac_;
+public:
+    /// constructor
+    jacobian_for_job(pool_fun<Base, RecBase>& fun, Vector& jac)
+    : fun_(fun), jac_(jac)
+    { }
+    /// compute column j of the Jacobian
+    void operator()(size_t j, size_t thread)
+    {   ADFun<Base, RecBase>& f( fun_.get(thread) );
+        size_t n = f.Domain();
+        size_t m = f.Range();
+        //
+        // j-th coordinate direction
+        Vector u(n);
+        for(size_t ell = 0; ell < n; ++ell)
+            u[ell] = Base(0.0);
+        u[j] = Base(1.0);
+        //
+        // partial of f w.r.t. this coordinate direction
+        Vector v = f.Forward(1, u);
+        for(size_t i = 0; i < m; ++i)
+            jac_[ i * n + j ] = v[i];
+    }
+};
+/*!
+Job that computes one row of a Jacobian using reverse mode.
+
+The task index is the row index i. The zero order Taylor coefficients
+for the copies of the function must correspond to the argument value.
+*/
+template <class Base, class RecBase, class Vector>
+class jacobian_rev_job {
+private:
+    /// copies of the function for each thread
+    pool_fun<Base, RecBase>& fun_;
+    /// the Jacobian (row major order)
+    Vector&                  jac_;
+public:
+    /// constructor
+    jacobian_rev_job(pool_fun<Base, RecBase>& fun, Vector& jac)
+    : fun_(fun), jac_(jac)
+    { }
+    /// compute row i of the Jacobian
+    void operator()(size_t i, size_t thread)
+    {   ADFun<Base, RecBase>& f( fun_.get(thread) );
+        size_t n = f.Domain();
+        size_t m = f.Range();
+        //
+        // return zero for this component of f
+        if( f.Parameter(i) )
+        {   for(size_t j = 0; j < n; ++j)
+                jac_[ i * n + j ] = Base(0.0);
+            return;
+        }
+        //
+        // i-th coordinate direction
+        Vector v(m);
+        for(size_t ell = 0; ell < m; ++ell)
+            v[ell] = Base(0.0);
+        v[i] = Base(1.0);
+        //
+        // derivative of this component of f
+        Vector u = f.Reverse(1, v);
+        for(size_t j = 0; j < n; ++j)
+            jac_[ i * n + j ] = u[j];
+    }
+};
+} // END local namespace
 
 template <class Base, class RecBase, class Vector>
 void JacobianFor(ADFun<Base, RecBase> &f, const Vector &x, Vector &jac)
@@ -232,6 +329,68 @@ Vector ADFun<Base,RecBase>::Jacobian(const Vector &x)
     return jac;
 }
 
+/*!
+Jacobian using the threads in a thread_pool.
+
+\param x
+is the argument value at which the Jacobian is evaluated.
+
+\param pool
+is the pool of threads used to compute the columns (forward mode)
+or rows (reverse mode) of the Jacobian.
+
+\return
+is the Jacobian in row major order.
+*/
+template <class Base, class RecBase>
+template <class Vector>
+Vector ADFun<Base,RecBase>::Jacobian(const Vector &x, thread_pool& pool)
+{   size_t i;
+    size_t n = Domain();
+    size_t m = Range();
+
+    CPPAD_ASSERT_KNOWN(
+        size_t(x.size()) == n,
+        "Jacobian: length of x not equal domain dimension for F"
+    );
+    CPPAD_ASSERT_KNOWN(
+        ! thread_alloc::in_parallel(),
+        "Jacobian: pool is present and in parallel mode"
+    );
+
+    // point at which we are evaluating the Jacobian
+    // (copies of this function start with these Taylor coefficients)
+    Forward(0, x);
+
+    // work factor for forward mode
+    size_t workForward = n;
+
+    // work factor for reverse mode
+    size_t workReverse = 0;
+    for(i = 0; i < m; i++)
+    {   if( ! Parameter(i) )
+            ++workReverse;
+    }
+
+    // choose the method with the least work
+    Vector jac( n * m );
+    local::pool_fun<Base, RecBase> fun(*this, pool);
+# ifdef CPPAD_FOR_TMB
+    if( workForward < workReverse )
+# else
+    if( workForward <= workReverse )
+# endif
+    {   local::jacobian_for_job<Base, RecBase, Vector> job(fun, jac);
+        pool.run(n, job);
+    }
+    else
+    {   local::jacobian_rev_job<Base, RecBase, Vector> job(fun, jac);
+        pool.run(m, job);
+    }
+
+    return jac;
+}
+
 } // END CppAD namespace
 
 # endif
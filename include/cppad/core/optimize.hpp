@@ -40,6 +40,8 @@ $icode%f%.optimize(%options%)
 %$$
 $icode%flag% = %f%.exceed_collision_limit()
 %$$
+$icode%report% = %f%.optimize_report()
+%$$
 
 $head Purpose$$
 The operation sequence corresponding to an $cref ADFun$$ object can
@@ -77,6 +79,21 @@ it may save a significant amount of time when
 using $icode f$$ for $cref forward$$ or $cref reverse$$ mode calculations;
 see $cref number_skip$$.
 
+$subhead conditional_skip_threshold=value$$
+If this substring appears,
+where $icode value$$ is a sequence of decimal digits,
+a conditional skip operator is only generated when the number of variables
+that it can skip, for either the true or false case,
+is greater than or equal $icode value$$.
+This avoids the cost of conditional skip operators that only skip a
+small amount of work.
+The operators that are skipped during a zero order forward calculation
+are also skipped during higher order $cref forward$$ mode and
+$cref reverse$$ mode calculations that use the same zero order
+Taylor coefficients.
+The default for $icode value$$ is $code 1$$;
+see $cref optimize_skip_threshold.cpp$$.
+
 $subhead no_compare_op$$
 If the sub-string $code no_compare_op$$ appears in $icode options$$,
 comparison operators will be removed from the optimized function.
@@ -96,6 +113,43 @@ If this sub-string appears,
 no cumulative sum operations will be generated during the optimization; see
 $cref optimize_cumulative_sum.cpp$$.
 
+$subhead zero_order_only$$
+If this sub-string appears,
+the optimizer computes the live range for each variable
+and maps the variables onto a smaller set of zero order Taylor
+coefficient slots that get reused once a variable is no longer needed;
+see $cref optimize_zero_order_only.cpp$$.
+This can greatly reduce the memory, and improve the cache usage,
+for $cref/zero order forward/forward_zero/$$ mode.
+On the other hand, the resulting function object $icode f$$
+can only be used for zero order forward mode; i.e.,
+$cref/f.size_order()/size_order/$$ is zero after $icode%f%.Forward(0, %x%)%$$
+and it is an error to use $icode f$$ for higher orders or reverse mode.
+Optimizing $icode f$$ again, without this option,
+removes this restriction.
+
+$subhead cache_plan$$
+If this sub-string appears,
+the decisions made while analysing the operation sequence
+(which operations are used, which are the same as previous operations,
+and the conditional skip information) are saved in $icode f$$.
+Suppose that $icode f$$ is later re-taped using
+$cref/f.Dependent/Dependent/$$ and the new operation sequence
+has the same structure; i.e., it has the same operations and arguments
+but the values of its constant parameters may be different.
+If $icode%f%.optimize(%options%)%$$ is then called with the same options,
+the saved decisions are used and only the new recording is created.
+This makes re-optimizing linear in the size of the operation sequence.
+If the structure is different, the analysis is done again and the
+saved decisions are replaced.
+This option requires memory for a copy of the un-optimized operation
+sequence.
+It has no effect when the operation sequence contains
+$cref atomic$$ function calls (because their dependency calculations
+may depend on the values of parameters);
+see $cref optimize_cache_plan.cpp$$.
+If this option is not present, any saved decisions are freed.
+
 $subhead collision_limit=value$$
 If this substring appears,
 where $icode value$$ is a sequence of decimal digits,
@@ -106,6 +160,16 @@ The larger $icode value$$, the more identical expressions the optimizer
 can recognize, but the slower the optimizer may run.
 The default for $icode value$$ is $code 10$$.
 
+$head Dynamic Parameters$$
+The optimizer also simplifies the operations that compute the
+$cref/dynamic parameters/glossary/Parameter/Dynamic/$$.
+An operation that is the same as a previous operation is removed,
+an operation that only depends on constants is replaced by its value,
+and an operation that is equal to one of its arguments
+(for example multiplication by one) is replaced by that argument;
+see $cref optimize_dynamic_param.cpp$$.
+This reduces the time required by $cref new_dynamic$$.
+
 $head Re-Optimize$$
 Before 2019-06-28, optimizing twice was not supported and would fail
 if cumulative sum operators were present after the first optimization.
@@ -181,17 +245,27 @@ If the return value $icode flag$$ is true (false),
 the previous call to $icode%f%.optimize%$$ exceed the
 $cref/collision_limit/optimize/options/collision_limit=value/$$.
 
+$head optimize_report$$
+The $cref optimize_report$$ contains the time spent in each phase of the
+previous call to $icode%f%.optimize%$$ and the effect of
+each of its transformations.
+
 $head Examples$$
 $comment childtable without Example instead of Contents for header$$
 $children%
-    example/optimize/optimize_twice.cpp
+    include/cppad/core/optimize_report.hpp
+    %example/optimize/optimize_twice.cpp
     %example/optimize/forward_active.cpp
     %example/optimize/reverse_active.cpp
     %example/optimize/compare_op.cpp
     %example/optimize/print_for.cpp
+    %example/optimize/cache_plan.cpp
     %example/optimize/conditional_skip.cpp
+    %example/optimize/skip_threshold.cpp
     %example/optimize/nest_conditional.cpp
     %example/optimize/cumulative_sum.cpp
+    %example/optimize/dynamic_param.cpp
+    %example/optimize/zero_order_only.cpp
 %$$
 $table
 $rref optimize_twice.cpp$$
@@ -199,15 +273,20 @@ $rref optimize_forward_active.cpp$$
 $rref optimize_reverse_active.cpp$$
 $rref optimize_compare_op.cpp$$
 $rref optimize_print_for.cpp$$
+$rref optimize_cache_plan.cpp$$
 $rref optimize_conditional_skip.cpp$$
+$rref optimize_skip_threshold.cpp$$
 $rref optimize_nest_conditional.cpp$$
 $rref optimize_cumulative_sum.cpp$$
+$rref optimize_dynamic_param.cpp$$
+$rref optimize_zero_order_only.cpp$$
 $tend
 
 $end
 -----------------------------------------------------------------------------
 */
 # include <cppad/local/optimize/optimize_run.hpp>
+# include <cppad/local/optimize/get_var_slot.hpp>
 /*!
 \file optimize.hpp
 Optimize a player object operation sequence
@@ -240,7 +319,16 @@ when compare_change is not used.
 */
 template <class Base, class RecBase>
 void ADFun<Base,RecBase>::optimize(const std::string& options)
-{
+{   // start timing this optimization
+    double start_clock = CppAD::optimize_report::clock();
+    //
+    // size of the operation sequence before optimization
+    optimize_report_.clear();
+    optimize_report_.size_op_before      = size_op();
+    optimize_report_.size_var_before     = size_var();
+    optimize_report_.size_par_before     = size_par();
+    optimize_report_.size_dyn_par_before = size_dyn_par();
+    optimize_report_.size_op_seq_before  = size_op_seq();
 # if CPPAD_CORE_OPTIMIZE_PRINT_RESULT
     // size of operation sequence before optimizatiton
     size_t size_op_before = size_op();
@@ -278,25 +366,32 @@ void ADFun<Base,RecBase>::optimize(const std::string& options)
     }
 # endif
 
+    // plan: cached optimizer decisions if cache_plan is present
+    local::optimize::optimize_plan<Base>* plan = nullptr;
+    if( options.find("cache_plan") != std::string::npos )
+        plan = &optimize_plan_;
+    else
+        optimize_plan_.clear();
+
     // create the optimized recording
     size_t exceed = false;
     switch( play_.address_type() )
     {
         case local::play::unsigned_short_enum:
         exceed = local::optimize::optimize_run<unsigned short>(
-            options, n, dep_taddr_, &play_, &rec
+            options, n, dep_taddr_, &play_, &rec, plan, optimize_report_
         );
         break;
 
         case local::play::unsigned_int_enum:
         exceed = local::optimize::optimize_run<unsigned int>(
-            options, n, dep_taddr_, &play_, &rec
+            options, n, dep_taddr_, &play_, &rec, plan, optimize_report_
         );
         break;
 
         case local::play::size_t_enum:
         exceed = local::optimize::optimize_run<size_t>(
-            options, n, dep_taddr_, &play_, &rec
+            options, n, dep_taddr_, &play_, &rec, plan, optimize_report_
         );
         break;
 
@@ -311,6 +406,17 @@ void ADFun<Base,RecBase>::optimize(const std::string& options)
     // now replace the recording
     play_.get_recording(rec, n);
 
+    // slots used by zero order forward when zero_order_only is present
+    num_slot_ = 0;
+    slot_op_.clear();
+    slot_arg_.clear();
+    slot_dep_.clear();
+    if( options.find("zero_order_only") != std::string::npos )
+    {   num_slot_ = local::optimize::get_var_slot(
+            &play_, dep_taddr_, slot_op_, slot_arg_, slot_dep_
+        );
+    }
+
     // set flag so this function knows it has been optimized
     has_been_optimized_ = true;
 
@@ -336,6 +442,15 @@ void ADFun<Base,RecBase>::optimize(const std::string& options)
         play_.num_var_rec()   // n_var
     );
 
+    // size of the operation sequence after optimization
+    optimize_report_.size_op_after      = size_op();
+    optimize_report_.size_var_after     = size_var();
+    optimize_report_.size_par_after     = size_par();
+    optimize_report_.size_dyn_par_after = size_dyn_par();
+    optimize_report_.size_op_seq_after  = size_op_seq();
+    optimize_report_.time_total = CppAD::optimize_report::clock() - start_clock;
+    optimize_report_.valid      = true;
+
 # ifndef NDEBUG
     if( check_zero_order )
     {   std::stringstream s;
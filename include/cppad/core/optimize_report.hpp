@@ -0,0 +1,288 @@
+# ifndef CPPAD_CORE_OPTIMIZE_REPORT_HPP
+# define CPPAD_CORE_OPTIMIZE_REPORT_HPP
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-22 Bradley M. Bell
+
+CppAD is distributed under the terms of the
+             Eclipse Public License Version 2.0.
+
+This Source Code may also be made available under the following
+Secondary License when the conditions for such availability set forth
+in the Eclipse Public License, Version 2.0 are satisfied:
+      GNU General Public License, Version 2.0 or later.
+---------------------------------------------------------------------------- */
+/*
+$begin optimize_report$$
+$spell
+    const
+    bool
+    op
+    cse
+    csum
+    cskip
+    dyn
+    par
+    seq
+    std
+    os
+    CppAD
+    cppad
+    optimizer
+$$
+
+$section Time and Effect of the Previous Optimization$$
+
+$head Syntax$$
+$icode%report% = %f%.optimize_report()
+%$$
+$icode%os% << %report%
+%$$
+
+$head Purpose$$
+This reports the time spent in each phase of the previous call to
+$cref/f.optimize/optimize/$$, and the number of operations and variables
+that each of its transformations removed.
+It can be used to decide if optimizing a particular function is worth
+the time it takes.
+
+$head f$$
+The object $icode f$$ has prototype
+$codei%
+    const ADFun<%Base%> %f%
+%$$
+
+$head report$$
+The return value has prototype
+$codei%
+    const CppAD::optimize_report& %report%
+%$$
+Its members are described below.
+
+$head valid$$
+$srcthisfile%0%// BEGIN_VALID%// END_VALID%1%$$
+is true (false) if $icode f$$ has (has not) been optimized since
+its operation sequence was created.
+If it is false, all the other members are zero.
+
+$head Time$$
+$srcthisfile%0%// BEGIN_TIME%// END_TIME%1%$$
+These are the elapsed time in seconds spent in the corresponding
+phases of the optimizer:
+
+$table
+$code time_op_usage$$ $cnext
+    determine which operators are used $rnext
+$code time_op_previous$$ $cnext
+    determine which operators are the same as previous operators $rnext
+$code time_cexp_info$$ $cnext
+    determine which operators can be conditionally skipped $rnext
+$code time_par_usage$$ $cnext
+    determine which parameters are used $rnext
+$code time_dyn_previous$$ $cnext
+    determine which dynamic parameters are the same as previous ones $rnext
+$code time_record$$ $cnext
+    create the optimized operation sequence $rnext
+$code time_total$$ $cnext
+    the total time for $icode%f%.optimize%$$
+$tend
+The total time does not include the check that is done when
+$code NDEBUG$$ is not defined; see
+$cref/checking optimization/optimize/Checking Optimization/$$.
+
+$head used_plan$$
+$srcthisfile%0%// BEGIN_USED_PLAN%// END_USED_PLAN%1%$$
+is true if the decisions saved by the
+$cref/cache_plan/optimize/options/cache_plan/$$ option were used.
+In this case the time for all the phases, except $code time_record$$,
+is zero.
+
+$head Removed$$
+$srcthisfile%0%// BEGIN_REMOVED%// END_REMOVED%1%$$
+These are counts for the original operation sequence:
+
+$table
+$code dead_op$$, $code dead_var$$ $cnext
+    operators, and their variables, that do not affect
+    the dependent variables $rnext
+$code cse_op$$, $code cse_var$$ $cnext
+    operators, and their variables, that are replaced by
+    a previous operator that computes the same value $rnext
+$code csum_op$$, $code csum_var$$ $cnext
+    addition and subtraction operators, and their variables,
+    that are combined into cumulative summation operators $rnext
+$code dead_dyn$$ $cnext
+    dynamic parameters that are not used $rnext
+$code cse_dyn$$ $cnext
+    dynamic parameters that are replaced by a previous dynamic parameter $rnext
+$code fold_dyn$$ $cnext
+    dynamic parameters that are replaced by a constant or by one of
+    their arguments
+$tend
+
+$head Conditional Skip$$
+$srcthisfile%0%// BEGIN_CSKIP%// END_CSKIP%1%$$
+The value $code cskip_op$$ is the number of conditional skip operators
+in the optimized operation sequence.
+The value $code cskip_skip$$ is the total number of operators that these
+operators can skip (an operator can be counted more than once).
+
+$head Size$$
+$srcthisfile%0%// BEGIN_SIZE%// END_SIZE%1%$$
+These are the values of
+$cref/size_op/fun_property/size_op/$$,
+$cref/size_var/fun_property/size_var/$$,
+$cref/size_par/fun_property/size_par/$$,
+$cref/size_dyn_par/fun_property/size_dyn_par/$$, and
+$cref/size_op_seq/fun_property/size_op_seq/$$
+before and after the optimization.
+
+$head os$$
+The object $icode os$$ is a $code std::ostream$$.
+The report is written to $icode os$$ in a human readable format.
+
+$children%
+    example/optimize/report.cpp
+%$$
+$head Example$$
+The file $cref optimize_report.cpp$$
+contains an example and test of this operation.
+
+$end
+-------------------------------------------------------------------------------
+*/
+# include <cstddef>
+# include <ostream>
+# include <chrono>
+
+namespace CppAD { // BEGIN_CPPAD_NAMESPACE
+/*!
+\file optimize_report.hpp
+Time and effect of the previous optimization of an ADFun object.
+*/
+
+/// Time and effect of the previous optimization of an ADFun object.
+struct optimize_report {
+    // BEGIN_VALID
+    bool   valid;
+    // END_VALID
+    //
+    // BEGIN_TIME
+    double time_op_usage;
+    double time_op_previous;
+    double time_cexp_info;
+    double time_par_usage;
+    double time_dyn_previous;
+    double time_record;
+    double time_total;
+    // END_TIME
+    //
+    // BEGIN_USED_PLAN
+    bool   used_plan;
+    // END_USED_PLAN
+    //
+    // BEGIN_REMOVED
+    size_t dead_op,  dead_var;
+    size_t cse_op,   cse_var;
+    size_t csum_op,  csum_var;
+    size_t dead_dyn, cse_dyn, fold_dyn;
+    // END_REMOVED
+    //
+    // BEGIN_CSKIP
+    size_t cskip_op, cskip_skip;
+    // END_CSKIP
+    //
+    // BEGIN_SIZE
+    size_t size_op_before,      size_op_after;
+    size_t size_var_before,     size_var_after;
+    size_t size_par_before,     size_par_after;
+    size_t size_dyn_par_before, size_dyn_par_after;
+    size_t size_op_seq_before,  size_op_seq_after;
+    // END_SIZE
+    //
+    /// default constructor
+    optimize_report(void)
+    {   clear(); }
+    //
+    /// set valid to false and all the other values to zero
+    void clear(void)
+    {   valid               = false;
+        time_op_usage       = 0.0;
+        time_op_previous    = 0.0;
+        time_cexp_info      = 0.0;
+        time_par_usage      = 0.0;
+        time_dyn_previous   = 0.0;
+        time_record         = 0.0;
+        time_total          = 0.0;
+        used_plan           = false;
+        dead_op             = 0;
+        dead_var            = 0;
+        cse_op              = 0;
+        cse_var             = 0;
+        csum_op             = 0;
+        csum_var            = 0;
+        dead_dyn            = 0;
+        cse_dyn             = 0;
+        fold_dyn            = 0;
+        cskip_op            = 0;
+        cskip_skip          = 0;
+        size_op_before      = 0;
+        size_op_after       = 0;
+        size_var_before     = 0;
+        size_var_after      = 0;
+        size_par_before     = 0;
+        size_par_after      = 0;
+        size_dyn_par_before = 0;
+        size_dyn_par_after  = 0;
+        size_op_seq_before  = 0;
+        size_op_seq_after   = 0;
+    }
+    //
+    /// current value of the clock used to time the optimizer (in seconds)
+    static double clock(void)
+    {   std::chrono::duration<double> now =
+            std::chrono::steady_clock::now().time_since_epoch();
+        return now.count();
+    }
+};
+
+/// output a report in human readable format
+inline std::ostream& operator<<(std::ostream& os, const optimize_report& r)
+{   if( ! r.valid )
+    {   os << "optimize_report: not valid\n";
+        return os;
+    }
+    os << "optimize_report:";
+    if( r.used_plan )
+        os << " (used plan)";
+    os << "\n";
+    os << "time:    op_usage = " << r.time_op_usage;
+    os << ", op_previous = " << r.time_op_previous;
+    os << ", cexp_info = " << r.time_cexp_info << "\n";
+    os << "         par_usage = " << r.time_par_usage;
+    os << ", dyn_previous = " << r.time_dyn_previous;
+    os << ", record = " << r.time_record;
+    os << ", total = " << r.time_total << "\n";
+    os << "removed: dead_op = " << r.dead_op;
+    os << ", dead_var = " << r.dead_var;
+    os << ", cse_op = " << r.cse_op;
+    os << ", cse_var = " << r.cse_var;
+    os << ", csum_op = " << r.csum_op;
+    os << ", csum_var = " << r.csum_var << "\n";
+    os << "         dead_dyn = " << r.dead_dyn;
+    os << ", cse_dyn = " << r.cse_dyn;
+    os << ", fold_dyn = " << r.fold_dyn << "\n";
+    os << "cskip:   cskip_op = " << r.cskip_op;
+    os << ", cskip_skip = " << r.cskip_skip << "\n";
+    os << "size:    op " << r.size_op_before << " -> " << r.size_op_after;
+    os << ", var " << r.size_var_before << " -> " << r.size_var_after;
+    os << ", par " << r.size_par_before << " -> " << r.size_par_after;
+    os << ", dyn_par " << r.size_dyn_par_before;
+    os << " -> " << r.size_dyn_par_after;
+    os << ", op_seq " << r.size_op_seq_before;
+    os << " -> " << r.size_op_seq_after << "\n";
+    return os;
+}
+
+} // END_CPPAD_NAMESPACE
+
+# endif
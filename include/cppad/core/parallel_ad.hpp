@@ -27,21 +27,29 @@ $codei%parallel_ad<%Base%>()%$$
 $head Purpose$$
 The function
 $codei%parallel_ad<%Base%>()%$$
-must be called before any $codei%AD<%Base>%$$ objects are used
-in $cref/parallel/ta_in_parallel/$$ mode.
-In addition, if this routine is called after one is done using
-parallel mode, it will free extra memory used to keep track of
-the multiple $codei%AD<%Base%>%$$ tapes required for parallel execution.
+initializes, in sequential mode, static variables that are used by
+$codei%AD<%Base>%$$ operations in $cref/parallel/ta_in_parallel/$$ mode.
+
+$head Lazy Initialization$$
+The $codei%AD<%Base%>%$$ tape identifiers and tape handles,
+and the $cref thread_alloc$$ information for each thread,
+are initialized by the first thread that uses them
+(the initialization is thread safe).
+Hence recording and evaluating $codei%AD<%Base%>%$$ operations
+in parallel mode, for example by tasks in a $cref thread_pool$$
+that was created after other threads were done,
+does not require calling $code parallel_ad$$.
+It is still required before using
+$cref/discrete/Discrete/$$ functions in parallel mode because
+each such function adds itself to a global list the first time it is used.
 
 $head Discussion$$
-By default, for each $codei%AD<%Base%>%$$ class there is only one
-tape that records $cref/AD of Base/glossary/AD of Base/$$ operations.
-This tape is a global variable and hence it cannot be used
-by multiple threads at the same time.
+For each $codei%AD<%Base%>%$$ class there is a separate
+tape for each thread that records $cref/AD of Base/glossary/AD of Base/$$
+operations.
 The $cref/parallel_setup/ta_parallel_setup/$$ function informs CppAD of the
-maximum number of threads that can be active in parallel mode.
-This routine does extra setup
-(and teardown) for the particular $icode Base$$ type.
+maximum number of threads that can be active in parallel mode
+and must still be called before entering parallel mode.
 
 $head CheckSimpleVector$$
 This routine has the side effect of calling the routines
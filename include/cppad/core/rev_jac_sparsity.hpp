@@ -188,6 +188,21 @@ void ADFun<Base,RecBase>::rev_jac_sparsity(
     // number of independent variables
     size_t n = Domain();
     //
+    // check if this pattern is in the sparse cache
+    std::string cache_key;
+    if( sparse_cache_ != nullptr && ! sparse_cache_atomic() )
+    {   size_t code = sparse_cache_code();
+        code = sparse_cache::hash(code, size_t( transpose ) );
+        code = sparse_cache::hash(code, size_t( dependency ) );
+        code = sparse_cache::hash(code, nr_in);
+        code = sparse_cache::hash(code, nc_in);
+        code = sparse_cache::hash(code, pattern_in.row() );
+        code = sparse_cache::hash(code, pattern_in.col() );
+        cache_key = sparse_cache::key("rev_jac_sparsity", code);
+        if( sparse_cache_->get_pattern(cache_key, pattern_out) )
+            return;
+    }
+    //
     bool zero_empty  = true;
     bool input_empty = true;
     if( internal_bool )
@@ -252,6 +267,9 @@ void ADFun<Base,RecBase>::rev_jac_sparsity(
             ! transpose, ind_taddr_, internal_jac, pattern_out
         );
     }
+    // put this pattern in the sparse cache
+    if( cache_key != "" )
+        sparse_cache_->set_pattern(cache_key, pattern_out);
     return;
 }
 } // END_CPPAD_NAMESPACE
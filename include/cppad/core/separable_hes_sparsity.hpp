@@ -0,0 +1,253 @@
+# ifndef CPPAD_CORE_SEPARABLE_HES_SPARSITY_HPP
+# define CPPAD_CORE_SEPARABLE_HES_SPARSITY_HPP
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-22 Bradley M. Bell
+
+CppAD is distributed under the terms of the
+             Eclipse Public License Version 2.0.
+
+This Source Code may also be made available under the following
+Secondary License when the conditions for such availability set forth
+in the Eclipse Public License, Version 2.0 are satisfied:
+      GNU General Public License, Version 2.0 or later.
+---------------------------------------------------------------------------- */
+/*
+$begin separable_hes_sparsity$$
+$spell
+    Hessian
+    hes
+    bool
+    const
+    rc
+    cpp
+    subgraph
+    subgraphs
+    CondExp
+    VecAD
+$$
+
+$section Hessian Sparsity Patterns for a Sum of Terms$$
+
+$head Syntax$$
+$icode%f%.separable_hes_sparsity(
+    %select_domain%, %select_range%, %pattern_out%
+)%$$
+
+$head Purpose$$
+We use $latex F : \B{R}^n \rightarrow \B{R}^m$$ to denote the
+$cref/AD function/glossary/AD Function/$$ corresponding to
+the operation sequence stored in $icode f$$.
+Fix a diagonal matrix $latex D \in \B{R}^{n \times n}$$,
+a vector $latex s \in \B{R}^m$$ and define the function
+$latex \[
+    H(x) = D ( s^\R{T} F )^{(2)} ( x ) D
+\] $$
+Given  the sparsity for $latex D$$ and $latex s$$,
+$code separable_hes_sparsity$$ computes a sparsity pattern for $latex H(x)$$.
+It is intended for partially separable functions; i.e.,
+functions that are the sum of a large number of terms where each term
+depends on a small number of the independent variables.
+
+$head Method$$
+Starting at the selected dependent variables,
+the operations that are linear in their variable arguments;
+e.g., addition, subtraction, multiplication by a parameter,
+and the two cases of a $cref CondExp$$,
+are followed backwards.
+The other operations reached in this way are the terms of the sum.
+For each term, a subgraph of the operation sequence is used to
+determine the set of independent variables $latex D_k$$
+that the term depends on.
+The sparsity pattern is the union of $latex D_k \times D_k$$
+for all the terms.
+The work for each term is proportional to the size of its subgraph,
+and sets of size $latex n$$ are not used for the variables
+in the operation sequence.
+
+$head Pattern$$
+The pattern computed by $code separable_hes_sparsity$$
+may contain more entries than the one computed by $cref for_hes_sparsity$$.
+For example, if one of the terms is $latex x_0 * x_1$$,
+the diagonal entries $latex (0, 0)$$ and $latex (1, 1)$$ are included.
+It is still a valid sparsity pattern for $latex H(x)$$
+and can be used to compute Hessians with $cref sparse_hes$$.
+
+$head x$$
+Note that the sparsity pattern $latex H(x)$$ corresponds to the
+operation sequence stored in $icode f$$ and does not depend on
+the argument $icode x$$.
+
+$head BoolVector$$
+The type $icode BoolVector$$ is a $cref SimpleVector$$ class with
+$cref/elements of type/SimpleVector/Elements of Specified Type/$$
+$code bool$$.
+
+$head SizeVector$$
+The type $icode SizeVector$$ is a $cref SimpleVector$$ class with
+$cref/elements of type/SimpleVector/Elements of Specified Type/$$
+$code size_t$$.
+
+$head f$$
+The object $icode f$$ has prototype
+$codei%
+    ADFun<%Base%> %f%
+%$$
+Its operation sequence must not contain any $cref VecAD$$ operations.
+
+$head select_domain$$
+The argument $icode select_domain$$ has prototype
+$codei%
+    const %BoolVector%& %select_domain%
+%$$
+It has size $latex n$$ and specifies which components of the diagonal of
+$latex D$$ are non-zero; i.e., $icode%select_domain%[%j%]%$$ is true
+if and only if $latex D_{j,j}$$ is possibly non-zero.
+
+$head select_range$$
+The argument $icode select_range$$ has prototype
+$codei%
+    const %BoolVector%& %select_range%
+%$$
+It has size $latex m$$ and specifies which components of the vector
+$latex s$$ are non-zero; i.e., $icode%select_range%[%i%]%$$ is true
+if and only if $latex s_i$$ is possibly non-zero.
+
+$head pattern_out$$
+This argument has prototype
+$codei%
+    sparse_rc<%SizeVector%>& %pattern_out%
+%$$
+This input value of $icode pattern_out$$ does not matter.
+Upon return $icode pattern_out$$ is a sparsity pattern for $latex H(x)$$.
+It has $latex n$$ rows and columns and its entries are in row major order.
+
+$head Example$$
+$children%
+    example/sparse/separable_hes_sparsity.cpp
+%$$
+The file
+$cref separable_hes_sparsity.cpp$$
+contains an example and test of this operation.
+
+$end
+-----------------------------------------------------------------------------
+*/
+# include <cppad/core/ad_fun.hpp>
+# include <cppad/local/subgraph/separable.hpp>
+
+namespace CppAD { // BEGIN_CPPAD_NAMESPACE
+
+/*!
+Hessian sparsity pattern for a sum of terms.
+
+\tparam Base
+is the base type for this recording.
+
+\tparam BoolVector
+is the simple vector with elements of type bool that is used for
+the selection vectors.
+
+\tparam SizeVector
+is the simple vector with elements of type size_t that is used for
+row, column index sparsity patterns.
+
+\param select_domain
+is a sparsity pattern for for the diagonal of D.
+
+\param select_range
+is a sparsity pattern for for s.
+
+\param pattern_out
+The return value is a sparsity pattern for H(x) where
+\f[
+    H(x) = D * (s^T F)''(x) * D
+\f]
+Here F is the function corresponding to the operation sequence
+and x is any argument value.
+*/
+template <class Base, class RecBase>
+template <class BoolVector, class SizeVector>
+void ADFun<Base,RecBase>::separable_hes_sparsity(
+    const BoolVector&            select_domain    ,
+    const BoolVector&            select_range     ,
+    sparse_rc<SizeVector>&       pattern_out      )
+{   size_t n = Domain();
+    size_t m = Range();
+    //
+    CPPAD_ASSERT_KNOWN(
+        size_t( select_domain.size() ) == n,
+        "separable_hes_sparsity: size of select_domain is not equal to "
+        "number of independent variables"
+    );
+    CPPAD_ASSERT_KNOWN(
+        size_t( select_range.size() ) == m,
+        "separable_hes_sparsity: size of select_range is not equal to "
+        "number of dependent variables"
+    );
+    CPPAD_ASSERT_KNOWN(
+        play_.num_var_vecad_rec() == 0,
+        "separable_hes_sparsity: the operation sequence "
+        "contains VecAD operations"
+    );
+    //
+    // compute the sparsity pattern
+    local::sparse::list_setvec hes_sparsity;
+    switch( play_.address_type() )
+    {
+        case local::play::unsigned_short_enum:
+        local::subgraph::separable_hes_sparsity<unsigned short>(
+            &play_,
+            subgraph_info_,
+            dep_taddr_,
+            select_domain,
+            select_range,
+            hes_sparsity
+        );
+        break;
+
+        case local::play::unsigned_int_enum:
+        local::subgraph::separable_hes_sparsity<unsigned int>(
+            &play_,
+            subgraph_info_,
+            dep_taddr_,
+            select_domain,
+            select_range,
+            hes_sparsity
+        );
+        break;
+
+        case local::play::size_t_enum:
+        local::subgraph::separable_hes_sparsity<size_t>(
+            &play_,
+            subgraph_info_,
+            dep_taddr_,
+            select_domain,
+            select_range,
+            hes_sparsity
+        );
+        break;
+
+        default:
+        CPPAD_ASSERT_UNKNOWN(false);
+    }
+    //
+    // return the sparsity pattern
+    size_t nnz = 0;
+    for(size_t i = 0; i < n; ++i)
+        nnz += hes_sparsity.number_elements(i);
+    pattern_out.resize(n, n, nnz);
+    size_t k = 0;
+    for(size_t i = 0; i < n; ++i)
+    {   local::sparse::list_setvec::const_iterator itr(hes_sparsity, i);
+        size_t j = *itr;
+        while( j < n )
+        {   pattern_out.set(k++, i, j);
+            j = *(++itr);
+        }
+    }
+    CPPAD_ASSERT_UNKNOWN( k == nnz );
+    return;
+}
+
+} // END_CPPAD_NAMESPACE
+# endif
@@ -14,6 +14,7 @@ in the Eclipse Public License, Version 2.0 are satisfied:
 
 //
 # include <cppad/core/for_jac_sparsity.hpp>
+# include <cppad/core/for_jac_sparsity_block.hpp>
 # include <cppad/core/rev_jac_sparsity.hpp>
 //
 # include <cppad/core/for_hes_sparsity.hpp>
@@ -32,6 +33,7 @@ in the Eclipse Public License, Version 2.0 are satisfied:
 # include <cppad/core/sparse_hessian.hpp>
 //
 # include <cppad/core/subgraph_sparsity.hpp>
+# include <cppad/core/separable_hes_sparsity.hpp>
 # include <cppad/core/subgraph_reverse.hpp>
 # include <cppad/core/subgraph_jac_rev.hpp>
 
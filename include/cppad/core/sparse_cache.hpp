@@ -0,0 +1,361 @@
+# ifndef CPPAD_CORE_SPARSE_CACHE_HPP
+# define CPPAD_CORE_SPARSE_CACHE_HPP
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-22 Bradley M. Bell
+
+CppAD is distributed under the terms of the
+             Eclipse Public License Version 2.0.
+
+This Source Code may also be made available under the following
+Secondary License when the conditions for such availability set forth
+in the Eclipse Public License, Version 2.0 are satisfied:
+      GNU General Public License, Version 2.0 or later.
+---------------------------------------------------------------------------- */
+/*
+$begin sparse_cache$$
+$spell
+    const
+    bool
+    jac
+    hes
+    std
+    CppAD
+    rc
+    nullptr
+$$
+
+$section Cache Sparsity Patterns and Colorings Between Calls$$
+
+$head Syntax$$
+$codei%CppAD::sparse_cache %cache%
+%$$
+$codei%CppAD::sparse_cache %cache%(%file_name%)
+%$$
+$icode%f%.use_sparse_cache(&%cache%)
+%$$
+$icode%ok% = %cache%.write()
+%$$
+$icode%cache%.clear()
+%$$
+$icode%n_entry% = %cache%.size()
+%$$
+$icode%n_hit% = %cache%.n_hit()
+%$$
+
+$head Purpose$$
+Sparsity patterns and the coloring of sparsity patterns
+only depend on the structure of an operation sequence; i.e.,
+the operators, their arguments, and which parameters are dynamic.
+A program that is run many times usually computes the same
+patterns and colorings for the same functions.
+A $code sparse_cache$$ object saves these results,
+in memory and optionally in a file,
+so that they can be reused by the same, or a different, $code ADFun$$ object
+(in the same, or a different, process).
+
+$head Cached Calculations$$
+The following calculations use $icode cache$$
+when it is connected to the $code ADFun$$ object $icode f$$:
+
+$table
+$cref rev_jac_sparsity$$ $cnext
+    the sparsity pattern $icode pattern_out$$ $rnext
+$cref for_hes_sparsity$$ $cnext
+    the sparsity pattern $icode pattern_out$$ $rnext
+$cref/sparse_jac_for/sparse_jac/$$, $cref/sparse_jac_rev/sparse_jac/$$ $cnext
+    the coloring stored in $icode work$$ when it is empty $rnext
+$cref sparse_hes$$ $cnext
+    the coloring stored in $icode work$$ when it is empty
+$tend
+The routines $cref for_jac_sparsity$$ and $cref rev_hes_sparsity$$
+do not use the cache because they store (use) sparsity patterns in
+$icode f$$ that are used by (come from) other calls.
+
+$head Key$$
+Each result is identified by the name of the routine,
+a hash code for the structure of the operation sequence in $icode f$$,
+and a hash code for the arguments that the result depends on; e.g.,
+$icode pattern_in$$, $icode transpose$$, and $icode dependency$$
+for $code rev_jac_sparsity$$.
+The values of the parameters in the operation sequence
+and the point $icode x$$ do not affect the key.
+Sparsity patterns for operation sequences that contain
+$cref atomic$$ function calls are not cached
+(because the sparsity calculations for an atomic function
+may depend on the value of its parameter arguments).
+
+$head cache$$
+The default constructor creates an empty cache that is only stored in memory.
+The object $icode cache$$ must not be used by two threads at the same time.
+
+$head file_name$$
+This argument has prototype
+$codei%
+    const std::string& %file_name%
+%$$
+If this file exists, and was created by $icode%cache%.write()%$$,
+its contents are read by the constructor.
+Otherwise the initial cache is empty.
+
+$head use_sparse_cache$$
+The $code ADFun$$ object $icode f$$ will use $icode cache$$ for the
+calculations above until $icode%f%.use_sparse_cache(nullptr)%$$ is called.
+The cache is not used by default.
+The object $icode cache$$ must not be destroyed while $icode f$$ is using it.
+
+$head write$$
+This writes the contents of the cache to $icode file_name$$.
+The return value $icode ok$$ has prototype
+$codei%
+    bool %ok%
+%$$
+It is false if there is no $icode file_name$$, or the file could not
+be written.
+
+$head clear$$
+This removes all the entries from the cache
+(the file is not changed until $icode%cache%.write()%$$ is called).
+
+$head size$$
+The return value $icode n_entry$$ has prototype
+$codei%
+    size_t %n_entry%
+%$$
+It is the number of results in the cache.
+
+$head n_hit$$
+The return value $icode n_hit$$ has prototype
+$codei%
+    size_t %n_hit%
+%$$
+It is the number of times that a result was found in the cache
+(instead of being computed).
+
+$head Example$$
+$children%
+    example/sparse/sparse_cache.cpp
+%$$
+The file $cref sparse_cache.cpp$$
+contains an example and test of this operation.
+
+$end
+-----------------------------------------------------------------------------
+*/
+# include <map>
+# include <string>
+# include <fstream>
+# include <cppad/utility/vector.hpp>
+# include <cppad/utility/sparse_rc.hpp>
+# include <cppad/utility/to_string.hpp>
+
+namespace CppAD { // BEGIN_CPPAD_NAMESPACE
+/*!
+\file sparse_cache.hpp
+Cache for sparsity patterns and colorings.
+*/
+
+/*!
+Sparsity patterns and colorings that only depend on the structure
+of an operation sequence.
+*/
+class sparse_cache {
+private:
+    /// file where the cache is stored (empty if there is no such file)
+    std::string file_name_;
+    /// maps a key to the result for that key
+    std::map< std::string, vector<size_t> > entry_;
+    /// number of times a result was found in the cache
+    size_t n_hit_;
+public:
+    /// default constructor
+    sparse_cache(void)
+    : n_hit_(0)
+    { }
+    /// constructor that reads the cache from a file
+    sparse_cache(const std::string& file_name)
+    : file_name_(file_name), n_hit_(0)
+    {   std::ifstream file( file_name.c_str() );
+        if( ! file.is_open() )
+            return;
+        std::string version;
+        size_t      n_entry;
+        file >> version >> n_entry;
+        if( file.fail() || version != "cppad_sparse_cache_1" )
+            return;
+        for(size_t i = 0; i < n_entry; ++i)
+        {   std::string key;
+            size_t      size;
+            file >> key >> size;
+            if( file.fail() )
+            {   entry_.clear();
+                return;
+            }
+            vector<size_t> result(size);
+            for(size_t k = 0; k < size; ++k)
+                file >> result[k];
+            if( file.fail() )
+            {   entry_.clear();
+                return;
+            }
+            entry_[key].swap(result);
+        }
+    }
+    /// write the cache to its file
+    bool write(void) const
+    {   if( file_name_ == "" )
+            return false;
+        std::ofstream file( file_name_.c_str() );
+        if( ! file.is_open() )
+            return false;
+        file << "cppad_sparse_cache_1 " << entry_.size() << "\n";
+        std::map< std::string, vector<size_t> >::const_iterator itr;
+        for(itr = entry_.begin(); itr != entry_.end(); ++itr)
+        {   const vector<size_t>& result( itr->second );
+            file << itr->first << " " << result.size();
+            for(size_t k = 0; k < result.size(); ++k)
+                file << " " << result[k];
+            file << "\n";
+        }
+        file.close();
+        return ! file.fail();
+    }
+    /// remove all the entries from the cache
+    void clear(void)
+    {   entry_.clear(); }
+    /// number of entries in the cache
+    size_t size(void) const
+    {   return entry_.size(); }
+    /// number of times a result was found in the cache
+    size_t n_hit(void) const
+    {   return n_hit_; }
+    // ------------------------------------------------------------------------
+    /*!
+    combine a value with a hash code
+
+    \param code
+    is the hash code before the value is included.
+
+    \param value
+    is the value that is combined with the hash code.
+
+    \return
+    is the hash code after the value is included.
+    */
+    static size_t hash(size_t code, size_t value)
+    {   code ^= value + 0x9e3779b9 + (code << 6) + (code >> 2);
+        return code;
+    }
+    /*!
+    combine the elements of a vector with a hash code
+
+    \tparam Vector
+    is a simple vector with elements that can be converted to size_t.
+    */
+    template <class Vector>
+    static size_t hash(size_t code, const Vector& vec)
+    {   size_t n = size_t( vec.size() );
+        code = hash(code, n);
+        for(size_t i = 0; i < n; ++i)
+            code = hash(code, size_t( vec[i] ) );
+        return code;
+    }
+    /*!
+    key corresponding to a routine and a hash code
+
+    \param name
+    is the name of the routine that computes the result
+    (must not contain white space).
+
+    \param code
+    is a hash code for the structure of the operation sequence
+    and the arguments to the routine.
+    */
+    static std::string key(const std::string& name, size_t code)
+    {   return name + "_" + to_string(code); }
+    // ------------------------------------------------------------------------
+    /*!
+    get a result from the cache
+
+    \param key
+    is the key for this result.
+
+    \param result
+    If the return value is true, this is set to the result for the key.
+    Otherwise it is not changed.
+
+    \return
+    is true if the key is in the cache.
+    */
+    bool get(const std::string& key, vector<size_t>& result)
+    {   std::map< std::string, vector<size_t> >::const_iterator itr;
+        itr = entry_.find(key);
+        if( itr == entry_.end() )
+            return false;
+        result = itr->second;
+        ++n_hit_;
+        return true;
+    }
+    /*!
+    set a result in the cache
+
+    \param key
+    is the key for this result.
+
+    \param result
+    is the result for the key (replaces the previous result if there is one).
+    */
+    void set(const std::string& key, const vector<size_t>& result)
+    {   entry_[key] = result; }
+    // ------------------------------------------------------------------------
+    /*!
+    get a sparsity pattern from the cache
+
+    \param key
+    is the key for this sparsity pattern.
+
+    \param pattern
+    If the return value is true, this is set to the pattern for the key.
+    Otherwise it is not changed.
+
+    \return
+    is true if the key is in the cache.
+    */
+    template <class SizeVector>
+    bool get_pattern(const std::string& key, sparse_rc<SizeVector>& pattern)
+    {   vector<size_t> result;
+        if( ! get(key, result) )
+            return false;
+        // result = [ nr, nc, nnz, row[0], col[0], row[1], col[1], ... ]
+        size_t nnz = result[2];
+        CPPAD_ASSERT_UNKNOWN( result.size() == 3 + 2 * nnz );
+        pattern.resize(result[0], result[1], nnz);
+        for(size_t k = 0; k < nnz; ++k)
+            pattern.set(k, result[3 + 2 * k], result[4 + 2 * k]);
+        return true;
+    }
+    /*!
+    set a sparsity pattern in the cache
+
+    \param key
+    is the key for this sparsity pattern.
+
+    \param pattern
+    is the sparsity pattern for the key.
+    */
+    template <class SizeVector>
+    void set_pattern(const std::string& key, const sparse_rc<SizeVector>& pattern)
+    {   size_t nnz = pattern.nnz();
+        vector<size_t> result(3 + 2 * nnz);
+        result[0] = pattern.nr();
+        result[1] = pattern.nc();
+        result[2] = nnz;
+        for(size_t k = 0; k < nnz; ++k)
+        {   result[3 + 2 * k] = pattern.row()[k];
+            result[4 + 2 * k] = pattern.col()[k];
+        }
+        entry_[key].swap(result);
+    }
+};
+
+} // END_CPPAD_NAMESPACE
+# endif
@@ -34,6 +34,10 @@ $section Computing Sparse Hessians$$
 $head Syntax$$
 $icode%n_sweep% = %f%.sparse_hes(
     %x%, %w%, %subset%, %pattern%, %coloring%, %work%
+)
+%$$
+$icode%n_sweep% = %f%.sparse_hes(
+    %x%, %w%, %subset%, %pattern%, %coloring%, %work%, %pool%
 )%$$
 
 $head Purpose$$
@@ -148,6 +152,24 @@ This coloring takes advantage of the fact that the Hessian matrix
 is symmetric when find a coloring that requires fewer
 $cref/sweeps/sparse_hes/n_sweep/$$.
 
+$subhead cppad.star$$
+This is a star coloring; i.e., a symmetric coloring where every path
+of four vertices, in the adjacency graph for the Hessian, uses at least
+three colors.
+Each Hessian value is computed directly from one sweep
+(as in the $code cppad.symmetric$$ method).
+
+$subhead cppad.acyclic$$
+This is an acyclic coloring; i.e., a symmetric coloring where every cycle,
+in the adjacency graph for the Hessian, uses at least three colors.
+This often requires fewer
+$cref/sweeps/sparse_hes/n_sweep/$$ than the other methods; e.g.,
+a tri-diagonal Hessian requires two sweeps.
+The Hessian values are recovered using substitution; i.e.,
+some of the values are computed by subtracting other values
+(that are not necessarily in $icode subset$$)
+from the results of a sweep.
+
 $subhead cppad.general$$
 This is the same as the sparse Jacobian
 $cref/cppad/sparse_jac/coloring/cppad/$$ method
@@ -190,6 +212,24 @@ for $icode f$$ and the sparsity pattern in $icode subset$$ are the same.
 If either of these values change, use $icode%work%.clear()%$$ to
 empty this structure.
 
+$head pool$$
+If the argument $icode pool$$ is present, it has prototype
+$codei%
+    thread_pool& %pool%
+%$$
+and the sweeps for the different colors are divided between the threads
+in the $cref thread_pool$$.
+Each thread uses its own copy of $icode f$$.
+This syntax must be called in sequential execution mode and
+$cref/parallel_ad/thread_pool/parallel_ad/$$ must have been called
+after $icode pool$$ was created.
+If $icode work$$ is empty,
+the pool is not used and the result is the same as when
+$icode pool$$ is not present
+(this computes the information in $icode work$$).
+Thus the pool is used when $icode work$$ is re-used for
+multiple Hessian evaluations.
+
 $head n_sweep$$
 The return value $icode n_sweep$$ has prototype
 $codei%
@@ -218,10 +258,13 @@ All the other forward mode coefficients are unspecified.
 
 $head Example$$
 $children%
-    example/sparse/sparse_hes.cpp
+    example/sparse/sparse_hes.cpp%
+    example/sparse/sparse_coloring.cpp
 %$$
 The files $cref sparse_hes.cpp$$
 is an example and test of $code sparse_hes$$.
+The file $cref sparse_coloring.cpp$$
+compares the number of sweeps for the different coloring methods.
 It returns $code true$$, if it succeeds, and $code false$$ otherwise.
 
 $head Subset Hessian$$
@@ -236,6 +279,7 @@ $end
 # include <cppad/local/sparse/internal.hpp>
 # include <cppad/local/color_general.hpp>
 # include <cppad/local/color_symmetric.hpp>
+# include <cppad/local/pool_fun.hpp>
 
 /*!
 \file sparse_hes.hpp
@@ -257,6 +301,9 @@ class sparse_hes_work {
         CppAD::vector<size_t> order;
         /// results of the coloring algorithm
         CppAD::vector<size_t> color;
+        /// how to recover the values using substitution
+        /// (only used by the cppad.acyclic coloring)
+        local::color_substitution substitution;
 
         /// constructor
         sparse_hes_work(void)
@@ -268,8 +315,80 @@ class sparse_hes_work {
             col.clear();
             order.clear();
             color.clear();
+            substitution.clear();
+        }
+};
+namespace local {
+/*!
+Job that computes the sparse Hessian values for one color.
+
+The task index is the color. The zero order Taylor coefficients
+for the copies of the function must correspond to the argument value.
+*/
+template <class Base, class RecBase, class SizeVector, class BaseVector>
+class sparse_hes_job {
+private:
+    /// copies of the function for each thread
+    pool_fun<Base, RecBase>&              fun_;
+    /// weighting vector for the components of the function
+    const BaseVector&                     w_;
+    /// subset of the Hessian that is computed
+    sparse_rcv<SizeVector, BaseVector>&   subset_;
+    /// information computed by a previous sparse_hes call
+    const sparse_hes_work&                work_;
+    /// the entries order[k] for k in [ start[ell], start[ell+1] )
+    /// have color ell (b values when substitution is used)
+    const vector<size_t>&                 start_;
+    /// value corresponding to each b_row when substitution is used
+    vector<Base>&                         b_;
+public:
+    /// constructor
+    sparse_hes_job(
+        pool_fun<Base, RecBase>&              fun      ,
+        const BaseVector&                     w        ,
+        sparse_rcv<SizeVector, BaseVector>&   subset   ,
+        const sparse_hes_work&                work     ,
+        const vector<size_t>&                 start    ,
+        vector<Base>&                         b        )
+    : fun_(fun), w_(w), subset_(subset), work_(work), start_(start), b_(b)
+    { }
+    /// compute the values corresponding to color ell
+    void operator()(size_t ell, size_t thread)
+    {   // check for a color that is not used
+        if( start_[ell] == start_[ell + 1] )
+            return;
+        //
+        ADFun<Base, RecBase>& f( fun_.get(thread) );
+        size_t n = f.Domain();
+        //
+        // combine all columns with this color
+        BaseVector dx(n);
+        for(size_t j = 0; j < n; j++)
+        {   dx[j] = Base(0.0);
+            if( work_.color[j] == ell )
+                dx[j] = Base(1.0);
+        }
+        // call forward mode for all these rows at once
+        f.Forward(1, dx);
+        //
+        // evaluate derivative of w^T * F'(x) * dx
+        BaseVector ddw = f.Reverse(2, w_);
+        //
+        // set the corresponding components of the result
+        const color_substitution& subst( work_.substitution );
+        if( subst.entry_step.size() != 0 )
+        {   for(size_t t = start_[ell]; t < start_[ell + 1]; ++t)
+                b_[t] = ddw[ subst.b_row[t] * 2 + 1 ];
         }
+        else
+        {   for(size_t k = start_[ell]; k < start_[ell + 1]; ++k)
+            {   size_t index = work_.row[ work_.order[k] ] * 2 + 1;
+                subset_.set(work_.order[k], ddw[index] );
+            }
+        }
+    }
 };
+} // END local namespace
 // ----------------------------------------------------------------------------
 /*!
 Calculate sparse Hessians using forward mode
@@ -304,8 +423,8 @@ where m is number of dependent variables in f.
 
 \param coloring
 determines which coloring algorithm is used.
-This must be cppad.symmetric, cppad.general, colpack.symmetic,
-or colpack.star.
+This must be cppad.symmetric, cppad.star, cppad.acyclic, cppad.general,
+colpack.symmetic, or colpack.star.
 
 \param work
 this structure must be empty, or contain the information stored
@@ -391,6 +510,38 @@ size_t ADFun<Base,RecBase>::sparse_hes(
         }
     }
 # endif
+    //
+    // check if the coloring for this case is in the sparse cache
+    std::string cache_key;
+    // (the substitution information is not cached)
+    if( color.size() == 0 && sparse_cache_ != nullptr &&
+        coloring != "cppad.acyclic"
+    )
+    {   size_t code = sparse_cache_code();
+        code = sparse_cache::hash(code, coloring);
+        code = sparse_cache::hash(code, subset_row);
+        code = sparse_cache::hash(code, subset_col);
+        code = sparse_cache::hash(code, pattern.row() );
+        code = sparse_cache::hash(code, pattern.col() );
+        cache_key = sparse_cache::key("sparse_hes", code);
+        vector<size_t> result;
+        if( sparse_cache_->get(cache_key, result) )
+        {   // result = [ row, col, color, order ]
+            CPPAD_ASSERT_UNKNOWN( result.size() == 3 * K + n );
+            row.resize(K);
+            col.resize(K);
+            color.resize(n);
+            order.resize(K);
+            for(size_t k = 0; k < K; ++k)
+            {   row[k]   = result[k];
+                col[k]   = result[K + k];
+                order[k] = result[2 * K + n + k];
+            }
+            for(size_t j = 0; j < n; ++j)
+                color[j] = result[2 * K + j];
+            cache_key = "";
+        }
+    }
     //
     // check for case where input work is empty
     if( color.size() == 0 )
@@ -434,6 +585,13 @@ size_t ADFun<Base,RecBase>::sparse_hes(
             local::color_general_cppad(internal_pattern, col, row, color);
         else if( coloring == "cppad.symmetric" )
             local::color_symmetric_cppad(internal_pattern, col, row, color);
+        else if( coloring == "cppad.star" )
+            local::color_symmetric_star(internal_pattern, col, row, color);
+        else if( coloring == "cppad.acyclic" )
+        {   local::color_symmetric_acyclic(
+                internal_pattern, col, row, color, work.substitution
+            );
+        }
         else if( coloring == "colpack.general" )
         {
 # if CPPAD_HAS_COLPACK
@@ -473,6 +631,18 @@ size_t ADFun<Base,RecBase>::sparse_hes(
             key[k] = color[ col[k] ];
         index_sort(key, order);
     }
+    // put this coloring in the sparse cache
+    if( cache_key != "" )
+    {   vector<size_t> result(3 * K + n);
+        for(size_t k = 0; k < K; ++k)
+        {   result[k]             = row[k];
+            result[K + k]         = col[k];
+            result[2 * K + n + k] = order[k];
+        }
+        for(size_t j = 0; j < n; ++j)
+            result[2 * K + j] = color[j];
+        sparse_cache_->set(cache_key, result);
+    }
     // Base versions of zero and one
     Base one(1.0);
     Base zero(0.0);
@@ -491,6 +661,52 @@ size_t ADFun<Base,RecBase>::sparse_hes(
     // return values for calls to second order reverse
     BaseVector ddw(2 * n);
     //
+    // check for case where values are recovered using substitution
+    const local::color_substitution& subst( work.substitution );
+    if( subst.entry_step.size() != 0 )
+    {   CPPAD_ASSERT_UNKNOWN( subst.entry_step.size() == K );
+        //
+        // results of the sweeps that are used
+        size_t n_b = subst.b_row.size();
+        vector<Base> b(n_b);
+        size_t t = 0;
+        for(size_t ell = 0; ell < n_color; ell++)
+        {   // combine all columns with this color
+            for(size_t j = 0; j < n; j++)
+            {   dx[j] = zero;
+                if( color[j] == ell )
+                    dx[j] = one;
+            }
+            // call forward mode for all these rows at once
+            Forward(1, dx);
+            //
+            // evaluate derivative of w^T * F'(x) * dx
+            ddw = Reverse(2, w);
+            //
+            // save the results that are used
+            while( t < n_b && subst.b_color[t] == ell )
+            {   b[t] = ddw[ subst.b_row[t] * 2 + 1 ];
+                ++t;
+            }
+        }
+        CPPAD_ASSERT_UNKNOWN( t == n_b );
+        //
+        // value corresponding to each step of the substitution
+        size_t n_step = subst.step_b.size();
+        vector<Base> value(n_step);
+        for(size_t s = 0; s < n_step; ++s)
+        {   value[s] = b[ subst.step_b[s] ];
+            for(size_t q = subst.step_begin[s]; q < subst.step_begin[s+1]; ++q)
+                value[s] -= value[ subst.step_list[q] ];
+        }
+        //
+        // set the result
+        for(size_t k = 0; k < K; k++)
+            subset.set(k, value[ subst.entry_step[k] ] );
+        //
+        return n_color;
+    }
+    //
     // loop over colors
     size_t k = 0;
     for(size_t ell = 0; ell < n_color; ell++)
@@ -538,6 +754,127 @@ size_t ADFun<Base,RecBase>::sparse_hes(
     CPPAD_ASSERT_UNKNOWN( k == K );
     return n_color;
 }
+// ----------------------------------------------------------------------------
+/*!
+Calculate sparse Hessians using the threads in a pool.
+
+If work is empty, this is the same as the version without the pool argument.
+Otherwise the colors are divided between the threads in the pool.
+
+\param pool
+is the pool of threads.
+The other arguments and the return value are the same as for the
+version without the pool argument.
+*/
+template <class Base, class RecBase>
+template <class SizeVector, class BaseVector>
+size_t ADFun<Base,RecBase>::sparse_hes(
+    const BaseVector&                    x        ,
+    const BaseVector&                    w        ,
+    sparse_rcv<SizeVector , BaseVector>& subset   ,
+    const sparse_rc<SizeVector>&         pattern  ,
+    const std::string&                   coloring ,
+    sparse_hes_work&                     work     ,
+    thread_pool&                         pool     )
+{   size_t n = Domain();
+    //
+    CPPAD_ASSERT_KNOWN(
+        ! thread_alloc::in_parallel(),
+        "sparse_hes: pool is present and in parallel mode"
+    );
+    //
+    // work information
+    const vector<size_t>& col(work.col);
+    const vector<size_t>& color(work.color);
+    const vector<size_t>& order(work.order);
+    const local::color_substitution& subst( work.substitution );
+    //
+    // the coloring is computed by the calling thread
+    if( color.size() == 0 )
+        return sparse_hes(x, w, subset, pattern, coloring, work);
+    //
+    CPPAD_ASSERT_KNOWN(
+        subset.nr() == n,
+        "sparse_hes: subset.nr() not equal domain dimension for f"
+    );
+    CPPAD_ASSERT_KNOWN(
+        subset.nc() == n,
+        "sparse_hes: subset.nc() not equal domain dimension for f"
+    );
+    CPPAD_ASSERT_KNOWN(
+        size_t( x.size() ) == n,
+        "sparse_hes: x.size() not equal domain dimension for f"
+    );
+    CPPAD_ASSERT_KNOWN(
+        size_t( w.size() ) == Range(),
+        "sparse_hes: w.size() not equal range dimension for f"
+    );
+    //
+    // point at which we are evaluationg the Hessian
+    // (copies of this function start with these Taylor coefficients)
+    Forward(0, x);
+    //
+    // number of elements in the subset
+    size_t K = subset.nnz();
+    if( K == 0 )
+        return 0;
+    CPPAD_ASSERT_KNOWN(
+        color.size() == n && order.size() == K,
+        "sparse_hes: work is non-empty and conditions have changed"
+    );
+    //
+    size_t n_color = 1;
+    for(size_t j = 0; j < n; j++) if( color[j] < n )
+        n_color = std::max<size_t>(n_color, color[j] + 1);
+    //
+    // initialize the return Hessian values as zero
+    Base zero(0.0);
+    for(size_t k = 0; k < K; k++)
+        subset.set(k, zero);
+    //
+    // start[ell] is the index where values for color ell start
+    // (b values when substitution is used, order indices otherwise)
+    vector<size_t> start(n_color + 1);
+    for(size_t ell = 0; ell <= n_color; ++ell)
+        start[ell] = 0;
+    if( subst.entry_step.size() != 0 )
+    {   for(size_t t = 0; t < subst.b_color.size(); ++t)
+            ++start[ subst.b_color[t] + 1 ];
+    }
+    else
+    {   for(size_t k = 0; k < K; ++k)
+            ++start[ color[ col[ order[k] ] ] + 1 ];
+    }
+    for(size_t ell = 0; ell < n_color; ++ell)
+        start[ell + 1] += start[ell];
+    //
+    // one task for each color
+    vector<Base> b( subst.b_row.size() );
+    local::pool_fun<Base, RecBase> fun(*this, pool);
+    local::sparse_hes_job<Base, RecBase, SizeVector, BaseVector> job(
+        fun, w, subset, work, start, b
+    );
+    pool.run(n_color, job);
+    //
+    // check for case where values are recovered using substitution
+    if( subst.entry_step.size() != 0 )
+    {   CPPAD_ASSERT_UNKNOWN( subst.entry_step.size() == K );
+        //
+        // value corresponding to each step of the substitution
+        size_t n_step = subst.step_b.size();
+        vector<Base> value(n_step);
+        for(size_t s = 0; s < n_step; ++s)
+        {   value[s] = b[ subst.step_b[s] ];
+            for(size_t q = subst.step_begin[s]; q < subst.step_begin[s+1]; ++q)
+                value[s] -= value[ subst.step_list[q] ];
+        }
+        //
+        // set the result
+        for(size_t k = 0; k < K; k++)
+            subset.set(k, value[ subst.entry_step[k] ] );
+    }
+    return n_color;
+}
 
 } // END_CPPAD_NAMESPACE
 
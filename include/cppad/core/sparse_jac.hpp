@@ -39,6 +39,24 @@ $icode%n_color% = %f%.sparse_jac_for(
 %$$
 $icode%n_color% = %f%.sparse_jac_rev(
     %x%, %subset%, %pattern%, %coloring%, %work%
+)
+%$$
+$icode%n_color% = %f%.sparse_jac_for(
+    %group_max%, %x%, %subset%, %pattern%, %coloring%, %work%,
+    %color_begin%, %color_end%
+)
+%$$
+$icode%n_color% = %f%.sparse_jac_rev(
+    %x%, %subset%, %pattern%, %coloring%, %work%,
+    %color_begin%, %color_end%
+)
+%$$
+$icode%n_color% = %f%.sparse_jac_for(
+    %group_max%, %x%, %subset%, %pattern%, %coloring%, %work%, %pool%
+)
+%$$
+$icode%n_color% = %f%.sparse_jac_rev(
+    %x%, %subset%, %pattern%, %coloring%, %work%, %pool%
 )%$$
 
 $head Purpose$$
@@ -98,6 +116,13 @@ the multiple direction for of first order forward mode
 $cref forward_dir$$ is used with one direction for each color.
 This uses separate memory for each direction (more memory),
 but my be significantly faster.
+If $icode group_max$$ is greater than or equal the number of colors,
+all of the colors are computed using one forward sweep of the
+operation sequence.
+In this case, the directions are set and the derivatives are stored
+directly in the Taylor coefficients for $icode f$$ and $icode subset$$
+(no dense vectors of length $icode%n%*%group_max%$$ or
+$icode%m%*%group_max%$$ are used).
 
 $head x$$
 This argument has prototype
@@ -153,6 +178,20 @@ $cref/cmake command/cmake/CMake Command/$$ line,
 you can set $icode coloring$$ to $code colpack$$.
 This uses a general purpose coloring algorithm that is part of Colpack.
 
+$subhead cppad.bidirectional$$
+This coloring uses first order forward sweeps to compute some of the
+Jacobian values and first order reverse sweeps to compute the others.
+The result is the same for $code sparse_jac_for$$ and $code sparse_jac_rev$$.
+An entry is computed using a reverse sweep if its row has more
+possibly non-zero entries than its column; e.g.,
+the dense row and dense column of an arrow shaped Jacobian.
+If only forward sweeps, or only reverse sweeps, use fewer colors,
+they are used instead.
+In this case $icode group_max$$ is not used,
+the forward colors come before the reverse colors
+(this matters when $icode color_begin$$ and $icode color_end$$ are present),
+and $icode n_color$$ is the number of forward plus reverse sweeps.
+
 $head work$$
 This argument has prototype
 $codei%
@@ -171,6 +210,70 @@ for $icode f$$ and the sparsity pattern in $icode subset$$ are the same.
 If any of these values change, use $icode%work%.clear()%$$ to
 empty this structure.
 
+$head color_begin$$
+This argument has prototype
+$codei%
+    size_t %color_begin%
+%$$
+If it is present, only the colors
+$icode%color_begin%, ... , %color_end%-1%$$ are used to compute
+the Jacobian values in $icode subset$$; i.e.,
+only the forward (reverse) sweeps for these colors are done.
+The other values in $icode subset$$ are set to zero.
+If it is not present, all the colors are used.
+
+$head color_end$$
+This argument has prototype
+$codei%
+    size_t %color_end%
+%$$
+and must be greater than or equal $icode color_begin$$.
+If it is greater than $icode n_color$$, $icode n_color$$ is used in its place.
+
+$head Parallel Mode$$
+The colors are independent and can be divided among
+different threads as follows:
+$list number$$
+Call $code sparse_jac_for$$ or $code sparse_jac_rev$$ in sequential mode
+with $icode%color_begin% = %color_end% = 0%$$.
+This computes the coloring and stores it in $icode work$$
+(the return value $icode n_color$$ is the total number of colors).
+$lnext
+Each thread uses its own copy of $icode f$$,
+created in sequential mode using the $cref/assignment/FunConstruct/Assignment Operator/$$
+$icode%f_thread% = %f%$$,
+and its own copy of $icode subset$$.
+Note that $cref parallel_ad$$ must be called before $icode f_thread$$
+is used in parallel mode.
+$lnext
+Each thread calls the same routine
+(with the same $icode x$$, $icode pattern$$, $icode coloring$$ and
+$icode work$$) for a different range of colors.
+The object $icode work$$ is not modified (and can be shared)
+because it is not empty.
+$lnext
+The sum of the values in the thread copies of $icode subset$$
+are the values for the entire subset.
+$lend
+See $cref sparse_jac_color.cpp$$ for an example.
+
+$head pool$$
+If the argument $icode pool$$ is present, it has prototype
+$codei%
+    thread_pool& %pool%
+%$$
+and the steps in $cref/parallel mode/sparse_jac/Parallel Mode/$$
+are done using the threads in the $cref thread_pool$$.
+The colors are divided into ranges,
+several for each thread so that threads that finish early can steal work.
+For $code sparse_jac_for$$,
+the size of each range is a multiple of $icode group_max$$.
+This syntax must be called in sequential execution mode and
+$cref/parallel_ad/thread_pool/parallel_ad/$$ must have been called
+after $icode pool$$ was created.
+If $icode work$$ is empty, the coloring is computed
+by the calling thread before the threads in the pool are used.
+
 $head n_color$$
 The return value $icode n_color$$ has prototype
 $codei%
@@ -202,9 +305,11 @@ All the other forward mode coefficients are unspecified.
 $head Example$$
 $children%
     example/sparse/sparse_jac_for.cpp%
-    example/sparse/sparse_jac_rev.cpp
+    example/sparse/sparse_jac_rev.cpp%
+    example/sparse/sparse_jac_color.cpp
 %$$
-The files $cref sparse_jac_for.cpp$$ and $cref sparse_jac_rev.cpp$$
+The files $cref sparse_jac_for.cpp$$, $cref sparse_jac_rev.cpp$$ and
+$cref sparse_jac_color.cpp$$
 are examples and tests of $code sparse_jac_for$$ and $code sparse_jac_rev$$.
 They return $code true$$, if they succeed, and $code false$$ otherwise.
 
@@ -213,6 +318,7 @@ $end
 # include <cppad/core/cppad_assert.hpp>
 # include <cppad/local/sparse/internal.hpp>
 # include <cppad/local/color_general.hpp>
+# include <cppad/local/pool_fun.hpp>
 # include <cppad/utility/vector.hpp>
 
 /*!
@@ -230,6 +336,9 @@ class sparse_jac_work {
         CppAD::vector<size_t> order;
         /// results of the coloring algorithm
         CppAD::vector<size_t> color;
+        /// color used to compute each element of the subset
+        /// (only used by the cppad.bidirectional coloring)
+        CppAD::vector<size_t> entry_color;
         //
         /// constructor
         sparse_jac_work(void)
@@ -239,8 +348,152 @@ class sparse_jac_work {
         void clear(void)
         {   order.clear();
             color.clear();
+            entry_color.clear();
         }
 };
+namespace local {
+/*!
+Job that computes the sparse Jacobian values for a range of colors.
+
+The task index determines the range of colors.
+The values for the colors are computed using a copy of the function and
+a copy of the subset, and then stored in the subset.
+The subset values must be zero on input.
+*/
+template <class Base, class RecBase, class SizeVector, class BaseVector>
+class sparse_jac_job {
+private:
+    /// copies of the function for each thread
+    pool_fun<Base, RecBase>&              fun_;
+    /// use sparse_jac_for (otherwise sparse_jac_rev)
+    const bool                            forward_;
+    /// group_max for sparse_jac_for
+    const size_t                          group_max_;
+    /// point at which the Jacobian is evaluated
+    const BaseVector&                     x_;
+    /// subset of the Jacobian that is computed
+    sparse_rcv<SizeVector, BaseVector>&   subset_;
+    /// sparsity pattern for the Jacobian
+    const sparse_rc<SizeVector>&          pattern_;
+    /// coloring method
+    const std::string&                    coloring_;
+    /// information computed by a previous sparse Jacobian call
+    sparse_jac_work&                      work_;
+    /// number of colors in each task (except perhaps the last)
+    const size_t                          n_chunk_;
+    /// total number of colors
+    const size_t                          n_color_;
+public:
+    /// constructor
+    sparse_jac_job(
+        pool_fun<Base, RecBase>&              fun        ,
+        bool                                  forward    ,
+        size_t                                group_max  ,
+        const BaseVector&                     x          ,
+        sparse_rcv<SizeVector, BaseVector>&   subset     ,
+        const sparse_rc<SizeVector>&          pattern    ,
+        const std::string&                    coloring   ,
+        sparse_jac_work&                      work       ,
+        size_t                                n_chunk    ,
+        size_t                                n_color    )
+    : fun_(fun)
+    , forward_(forward)
+    , group_max_(group_max)
+    , x_(x)
+    , subset_(subset)
+    , pattern_(pattern)
+    , coloring_(coloring)
+    , work_(work)
+    , n_chunk_(n_chunk)
+    , n_color_(n_color)
+    { }
+    /// compute the values for the colors corresponding to this task
+    void operator()(size_t task, size_t thread)
+    {   ADFun<Base, RecBase>& f( fun_.get(thread) );
+        size_t color_begin = task * n_chunk_;
+        size_t color_end   = std::min(color_begin + n_chunk_, n_color_);
+        //
+        // values for this range of colors (zero for the other colors)
+        sparse_rcv<SizeVector, BaseVector> subset( subset_.pat() );
+        if( forward_ ) f.sparse_jac_for(group_max_,
+            x_, subset, pattern_, coloring_, work_, color_begin, color_end
+        );
+        else f.sparse_jac_rev(
+            x_, subset, pattern_, coloring_, work_, color_begin, color_end
+        );
+        //
+        // each value is computed by only one task
+        const BaseVector& val( subset.val() );
+        for(size_t k = 0; k < subset.nnz(); ++k)
+        {   if( ! IdenticalZero( val[k] ) )
+                subset_.set(k, val[k]);
+        }
+    }
+};
+/*!
+Calculate sparse Jacobians using the threads in a thread_pool.
+
+\param fun
+copies of the function for each thread.
+
+\param forward
+if true (false), sparse_jac_for (sparse_jac_rev) is used.
+
+\param group_max
+is the group_max argument for sparse_jac_for (one for sparse_jac_rev).
+
+\param x
+is the point at which the Jacobian is evaluated.
+
+\param subset
+is the subset of the Jacobian that is computed.
+Its values must be zero on input.
+
+\param pattern
+is the sparsity pattern for the Jacobian.
+
+\param coloring
+is the coloring method.
+
+\param work
+must contain the information computed by a previous call with
+the same function and subset (it is not modified).
+
+\param n_color
+is the number of colors in work.
+
+\param pool
+is the pool of threads.
+*/
+template <class Base, class RecBase, class SizeVector, class BaseVector>
+void sparse_jac_pool(
+    pool_fun<Base, RecBase>&              fun        ,
+    bool                                  forward    ,
+    size_t                                group_max  ,
+    const BaseVector&                     x          ,
+    sparse_rcv<SizeVector, BaseVector>&   subset     ,
+    const sparse_rc<SizeVector>&          pattern    ,
+    const std::string&                    coloring   ,
+    sparse_jac_work&                      work       ,
+    size_t                                n_color    ,
+    thread_pool&                          pool       )
+{   if( n_color == 0 )
+        return;
+    //
+    // several tasks for each thread so that work can be stolen
+    size_t n_task  = std::min<size_t>(n_color, 4 * pool.num_threads());
+    size_t n_chunk = (n_color + n_task - 1) / n_task;
+    //
+    // use full groups for the forward mode sweeps
+    n_chunk = ( (n_chunk + group_max - 1) / group_max ) * group_max;
+    n_task  = (n_color + n_chunk - 1) / n_chunk;
+    //
+    sparse_jac_job<Base, RecBase, SizeVector, BaseVector> job(fun,
+        forward, group_max, x, subset, pattern, coloring, work, n_chunk, n_color
+    );
+    pool.run(n_task, job);
+}
+} // END local namespace
 // ----------------------------------------------------------------------------
 /*!
 Calculate sparse Jacobains using forward mode
@@ -275,7 +528,7 @@ where m is number of dependent variables in f.
 
 \param coloring
 determines which coloring algorithm is used.
-This must be cppad or colpack.
+This must be cppad, colpack, or cppad.bidirectional.
 
 \param work
 this structure must be empty, or contain the information stored
@@ -283,8 +536,16 @@ by a previous call to sparse_jac_for.
 The previous call must be for the same ADFun object f
 and the same subset.
 
+\param color_begin
+is the first color that is used to compute the Jacobian values.
+
+\param color_end
+is one more than the last color that is used to compute the Jacobian values.
+The subset values corresponding to other colors are zero.
+
 \return
-This is the number of first order forward sweeps used to compute
+This is the total number of colors. If all the colors are used,
+it is the number of first order forward sweeps used to compute
 the Jacobian.
 */
 template <class Base, class RecBase>
@@ -295,10 +556,17 @@ size_t ADFun<Base,RecBase>::sparse_jac_for(
     sparse_rcv<SizeVector, BaseVector>&  subset     ,
     const sparse_rc<SizeVector>&         pattern    ,
     const std::string&                   coloring   ,
-    sparse_jac_work&                     work       )
+    sparse_jac_work&                     work       ,
+    size_t                               color_begin,
+    size_t                               color_end  )
 {   size_t m = Range();
     size_t n = Domain();
     //
+    CPPAD_ASSERT_KNOWN(
+        color_begin <= color_end,
+        "sparse_jac_for: color_begin is greater than color_end"
+    );
+    //
     CPPAD_ASSERT_KNOWN(
         subset.nr() == m,
         "sparse_jac_for: subset.nr() not equal range dimension for f"
@@ -308,6 +576,12 @@ size_t ADFun<Base,RecBase>::sparse_jac_for(
         "sparse_jac_for: subset.nc() not equal domain dimension for f"
     );
     //
+    // check for bidirectional coloring
+    if( coloring == "cppad.bidirectional" || work.entry_color.size() != 0 )
+        return sparse_jac_bidirectional(
+            x, subset, pattern, work, color_begin, color_end
+        );
+    //
     // row and column vectors in subset
     const SizeVector& row( subset.row() );
     const SizeVector& col( subset.col() );
@@ -318,6 +592,10 @@ size_t ADFun<Base,RecBase>::sparse_jac_for(
         color.size() == 0 || color.size() == n,
         "sparse_jac_for: work is non-empty and conditions have changed"
     );
+    CPPAD_ASSERT_KNOWN(
+        color.size() != 0 || ! thread_alloc::in_parallel(),
+        "sparse_jac_for: work is empty and in parallel mode"
+    );
     //
     // point at which we are evaluationg the Jacobian
     Forward(0, x);
@@ -330,6 +608,30 @@ size_t ADFun<Base,RecBase>::sparse_jac_for(
     if( K == 0 )
         return 0;
     //
+    // check if the coloring for this case is in the sparse cache
+    std::string cache_key;
+    if( color.size() == 0 && sparse_cache_ != nullptr )
+    {   size_t code = sparse_cache_code();
+        code = sparse_cache::hash(code, coloring);
+        code = sparse_cache::hash(code, row);
+        code = sparse_cache::hash(code, col);
+        code = sparse_cache::hash(code, pattern.row() );
+        code = sparse_cache::hash(code, pattern.col() );
+        cache_key = sparse_cache::key("sparse_jac_for", code);
+        vector<size_t> result;
+        if( sparse_cache_->get(cache_key, result) )
+        {   // result = [ color, order ]
+            CPPAD_ASSERT_UNKNOWN( result.size() == n + K );
+            color.resize(n);
+            order.resize(K);
+            for(size_t ell = 0; ell < n; ++ell)
+                color[ell] = result[ell];
+            for(size_t k = 0; k < K; ++k)
+                order[k] = result[n + k];
+            cache_key = "";
+        }
+    }
+    //
     // check for case where input work is empty
     if( color.size() == 0 )
     {   // compute work color and order vectors
@@ -384,6 +686,15 @@ size_t ADFun<Base,RecBase>::sparse_jac_for(
             key[k] = color[ col[k] ];
         index_sort(key, order);
     }
+    // put this coloring in the sparse cache
+    if( cache_key != "" )
+    {   vector<size_t> result(n + K);
+        for(size_t ell = 0; ell < n; ++ell)
+            result[ell] = color[ell];
+        for(size_t k = 0; k < K; ++k)
+            result[n + k] = order[k];
+        sparse_cache_->set(cache_key, result);
+    }
     // Base versions of zero and one
     Base one(1.0);
     Base zero(0.0);
@@ -396,14 +707,29 @@ size_t ADFun<Base,RecBase>::sparse_jac_for(
     for(size_t k = 0; k < K; k++)
         subset.set(k, zero);
     //
-    // index in subset
+    // one more than the last color computed by this call
+    size_t color_last = std::min<size_t>(color_end, n_color);
+    //
+    // index in subset of first element with color greater or equal begin
     size_t k = 0;
+    while( k < K && color[ col[ order[k] ] ] < color_begin )
+        ++k;
     // number of colors computed so far
-    size_t color_count = 0;
+    size_t color_count = std::min<size_t>(color_begin, color_last);
     //
-    while( color_count < n_color )
+    while( color_count < color_last )
     {   // number of colors that will be in this group
-        size_t group_size = std::min<size_t>(group_max, n_color - color_count);
+        size_t group_size =
+            std::min<size_t>(group_max, color_last - color_count);
+        //
+        if( group_size > 1 )
+        {   // multiple direction sweep that uses taylor_ for input and output
+            k = sparse_jac_forward_dir(
+                color_count, group_size, color, order, k, subset
+            );
+            color_count += group_size;
+            continue;
+        }
         //
         // forward mode values for independent and dependent variables
         BaseVector dx(n * group_size), dy(m * group_size);
@@ -417,10 +743,7 @@ size_t ADFun<Base,RecBase>::sparse_jac_for(
                     dx[j * group_size + ell] = one;
             }
         }
-        if( group_size == 1 )
-            dy = Forward(1, dx);
-        else
-            dy = Forward(1, group_size, dx);
+        dy = Forward(1, dx);
         //
         // store results in subset
         for(size_t ell = 0; ell < group_size; ell++)
@@ -435,10 +758,148 @@ size_t ADFun<Base,RecBase>::sparse_jac_for(
         // advance color count
         color_count += group_size;
     }
-    CPPAD_ASSERT_UNKNOWN( color_count == n_color );
+    CPPAD_ASSERT_UNKNOWN( color_count == color_last );
     //
     return n_color;
 }
+/*!
+Compute the Jacobian values for a group of colors using one multiple
+direction first order forward sweep.
+
+The directions are set directly in taylor_ and the results are moved
+directly from taylor_ to subset; i.e., there are no dense vectors
+with size equal the number of directions times the domain (range) dimension.
+
+\tparam SizeVector
+a simple vector class with elements of type size_t.
+
+\tparam BaseVector
+a simple vector class with elements of type Base.
+
+\param color_begin
+is the first color in this group.
+
+\param group_size
+is the number of colors (directions) in this group.
+
+\param color
+is the color for each of the independent variables
+(color[j] >= Domain() if column j is not in the subset).
+
+\param order
+is the order of the subset elements sorted by color.
+
+\param k
+is the index in order of the first subset element with color greater than
+or equal color_begin.
+
+\param subset
+the values corresponding to this group of colors are set.
+
+\return
+is the index in order of the first subset element with color greater than
+or equal color_begin + group_size.
+
+\par Taylor Coefficients
+The zero order Taylor coefficients must correspond to the point
+at which the Jacobian is being evaluated.
+Upon return, there are two orders and group_size directions in taylor_.
+*/
+template <class Base, class RecBase>
+template <class SizeVector, class BaseVector>
+size_t ADFun<Base,RecBase>::sparse_jac_forward_dir(
+    size_t                               color_begin ,
+    size_t                               group_size  ,
+    const vector<size_t>&                color       ,
+    const vector<size_t>&                order       ,
+    size_t                               k           ,
+    sparse_rcv<SizeVector, BaseVector>&  subset      )
+{   // used to identify the RecBase type in calls to sweeps
+    RecBase not_used_rec_base(0.0);
+    //
+    size_t n = Domain();
+    size_t r = group_size;
+    size_t K = subset.nnz();
+    const SizeVector& row( subset.row() );
+    const SizeVector& col( subset.col() );
+    CPPAD_ASSERT_UNKNOWN( 1 < r );
+    CPPAD_ASSERT_UNKNOWN( num_order_taylor_ >= 1 );
+    //
+    // make sure taylor_ has capacity for first order and r directions
+    if( cap_order_taylor_ < 2 || num_direction_taylor_ != r )
+    {   num_order_taylor_ = 1;
+        size_t c = std::max<size_t>(2, cap_order_taylor_);
+        capacity_order(c, r);
+    }
+    CPPAD_ASSERT_UNKNOWN( num_direction_taylor_ == r );
+    //
+    // short hand notation for order capacity and Taylor coefficients
+    size_t c       = cap_order_taylor_;
+    Base*  taylor  = taylor_.data();
+    //
+    // set first order Taylor coefficients for independent variables
+    Base one(1.0);
+    Base zero(0.0);
+    for(size_t j = 0; j < n; j++)
+    {   CPPAD_ASSERT_UNKNOWN( ind_taddr_[j] < num_var_tape_  );
+        size_t index = ((c-1)*r + 1) * ind_taddr_[j] + 1;
+        for(size_t ell = 0; ell < r; ell++)
+            taylor[index + ell] = zero;
+        if( color_begin <= color[j] && color[j] < color_begin + r )
+            taylor[index + color[j] - color_begin] = one;
+    }
+    //
+    // evaluate the derivatives
+    CPPAD_ASSERT_UNKNOWN( cskip_op_.size() == play_.num_op_rec() );
+    CPPAD_ASSERT_UNKNOWN( load_op2var_.size()  == play_.num_var_load_rec() );
+    local::sweep::forward2(
+        &play_,
+        1,
+        r,
+        n,
+        num_var_tape_,
+        c,
+        taylor,
+        cskip_op_.data(),
+        load_op2var_,
+        not_used_rec_base
+    );
+    num_order_taylor_ = 2;
+    //
+    // store results in subset
+    while( k < K && color[ col[ order[k] ] ] < color_begin + r )
+    {   size_t ell   = color[ col[ order[k] ] ] - color_begin;
+        size_t i     = row[ order[k] ];
+        size_t index = ((c-1)*r + 1) * dep_taddr_[i] + 1 + ell;
+        CPPAD_ASSERT_KNOWN( ! ( check_for_nan_ && CppAD::isnan(taylor[index]) ),
+            "sparse_jac_for: a Jacobian value is nan"
+        );
+        subset.set( order[k], taylor[index] );
+        ++k;
+    }
+    return k;
+}
+/*!
+Calculate sparse Jacobains using forward mode and all the colors.
+
+This is the same as the version with color_begin equal to zero and
+color_end equal to the number of independent plus dependent variables.
+*/
+template <class Base, class RecBase>
+template <class SizeVector, class BaseVector>
+size_t ADFun<Base,RecBase>::sparse_jac_for(
+    size_t                               group_max  ,
+    const BaseVector&                    x          ,
+    sparse_rcv<SizeVector, BaseVector>&  subset     ,
+    const sparse_rc<SizeVector>&         pattern    ,
+    const std::string&                   coloring   ,
+    sparse_jac_work&                     work       )
+{   size_t color_begin = 0;
+    size_t color_end   = Domain() + Range();
+    return sparse_jac_for(
+        group_max, x, subset, pattern, coloring, work, color_begin, color_end
+    );
+}
 // ----------------------------------------------------------------------------
 /*!
 Calculate sparse Jacobains using reverse mode
@@ -477,21 +938,36 @@ by a previous call to sparse_jac_rev.
 The previous call must be for the same ADFun object f
 and the same subset.
 
+\param color_begin
+is the first color that is used to compute the Jacobian values.
+
+\param color_end
+is one more than the last color that is used to compute the Jacobian values.
+The subset values corresponding to other colors are zero.
+
 \return
-This is the number of first order reverse sweeps used to compute
+This is the total number of colors. If all the colors are used,
+it is the number of first order reverse sweeps used to compute
 the Jacobian.
 */
 template <class Base, class RecBase>
 template <class SizeVector, class BaseVector>
 size_t ADFun<Base,RecBase>::sparse_jac_rev(
-    const BaseVector&                    x        ,
-    sparse_rcv<SizeVector, BaseVector>&  subset   ,
-    const sparse_rc<SizeVector>&         pattern  ,
-    const std::string&                   coloring ,
-    sparse_jac_work&                     work     )
+    const BaseVector&                    x           ,
+    sparse_rcv<SizeVector, BaseVector>&  subset      ,
+    const sparse_rc<SizeVector>&         pattern     ,
+    const std::string&                   coloring    ,
+    sparse_jac_work&                     work        ,
+    size_t                               color_begin ,
+    size_t                               color_end   )
 {   size_t m = Range();
     size_t n = Domain();
     //
+    CPPAD_ASSERT_KNOWN(
+        color_begin <= color_end,
+        "sparse_jac_rev: color_begin is greater than color_end"
+    );
+    //
     CPPAD_ASSERT_KNOWN(
         subset.nr() == m,
         "sparse_jac_rev: subset.nr() not equal range dimension for f"
@@ -501,6 +977,12 @@ size_t ADFun<Base,RecBase>::sparse_jac_rev(
         "sparse_jac_rev: subset.nc() not equal domain dimension for f"
     );
     //
+    // check for bidirectional coloring
+    if( coloring == "cppad.bidirectional" || work.entry_color.size() != 0 )
+        return sparse_jac_bidirectional(
+            x, subset, pattern, work, color_begin, color_end
+        );
+    //
     // row and column vectors in subset
     const SizeVector& row( subset.row() );
     const SizeVector& col( subset.col() );
@@ -511,6 +993,10 @@ size_t ADFun<Base,RecBase>::sparse_jac_rev(
         color.size() == 0 || color.size() == m,
         "sparse_jac_rev: work is non-empty and conditions have changed"
     );
+    CPPAD_ASSERT_KNOWN(
+        color.size() != 0 || ! thread_alloc::in_parallel(),
+        "sparse_jac_rev: work is empty and in parallel mode"
+    );
     //
     // point at which we are evaluationg the Jacobian
     Forward(0, x);
@@ -523,6 +1009,30 @@ size_t ADFun<Base,RecBase>::sparse_jac_rev(
     if( K == 0 )
         return 0;
     //
+    // check if the coloring for this case is in the sparse cache
+    std::string cache_key;
+    if( color.size() == 0 && sparse_cache_ != nullptr )
+    {   size_t code = sparse_cache_code();
+        code = sparse_cache::hash(code, coloring);
+        code = sparse_cache::hash(code, row);
+        code = sparse_cache::hash(code, col);
+        code = sparse_cache::hash(code, pattern.row() );
+        code = sparse_cache::hash(code, pattern.col() );
+        cache_key = sparse_cache::key("sparse_jac_rev", code);
+        vector<size_t> result;
+        if( sparse_cache_->get(cache_key, result) )
+        {   // result = [ color, order ]
+            CPPAD_ASSERT_UNKNOWN( result.size() == m + K );
+            color.resize(m);
+            order.resize(K);
+            for(size_t ell = 0; ell < m; ++ell)
+                color[ell] = result[ell];
+            for(size_t k = 0; k < K; ++k)
+                order[k] = result[m + k];
+            cache_key = "";
+        }
+    }
+    //
     // check for case where input work is empty
     if( color.size() == 0 )
     {   // compute work color and order vectors
@@ -576,6 +1086,15 @@ size_t ADFun<Base,RecBase>::sparse_jac_rev(
             key[k] = color[ row[k] ];
         index_sort(key, order);
     }
+    // put this coloring in the sparse cache
+    if( cache_key != "" )
+    {   vector<size_t> result(m + K);
+        for(size_t ell = 0; ell < m; ++ell)
+            result[ell] = color[ell];
+        for(size_t k = 0; k < K; ++k)
+            result[m + k] = order[k];
+        sparse_cache_->set(cache_key, result);
+    }
     // Base versions of zero and one
     Base one(1.0);
     Base zero(0.0);
@@ -591,9 +1110,16 @@ size_t ADFun<Base,RecBase>::sparse_jac_rev(
     // weighting vector and return values for calls to Reverse
     BaseVector w(m), dw(n);
     //
-    // loop over colors
+    // one more than the last color computed by this call
+    size_t color_last = std::min<size_t>(color_end, n_color);
+    //
+    // index in subset of first element with color greater or equal begin
     size_t k = 0;
-    for(size_t ell = 0; ell < n_color; ell++)
+    while( k < K && color[ row[ order[k] ] ] < color_begin )
+        ++k;
+    //
+    // loop over colors
+    for(size_t ell = color_begin; ell < color_last; ell++)
     if( k  == K )
     {   // kludge because colpack returns colors that are not used
         // (it does not know about the subset corresponding to row, col)
@@ -624,6 +1150,333 @@ size_t ADFun<Base,RecBase>::sparse_jac_rev(
     }
     return n_color;
 }
+/*!
+Calculate sparse Jacobains using reverse mode and all the colors.
+
+This is the same as the version with color_begin equal to zero and
+color_end equal to the number of independent plus dependent variables.
+*/
+template <class Base, class RecBase>
+template <class SizeVector, class BaseVector>
+size_t ADFun<Base,RecBase>::sparse_jac_rev(
+    const BaseVector&                    x        ,
+    sparse_rcv<SizeVector, BaseVector>&  subset   ,
+    const sparse_rc<SizeVector>&         pattern  ,
+    const std::string&                   coloring ,
+    sparse_jac_work&                     work     )
+{   size_t color_begin = 0;
+    size_t color_end   = Domain() + Range();
+    return sparse_jac_rev(
+        x, subset, pattern, coloring, work, color_begin, color_end
+    );
+}
+// ----------------------------------------------------------------------------
+/*!
+Calculate sparse Jacobains using forward mode and the threads in a pool.
+
+The coloring is computed (if work is empty) by the calling thread,
+then the colors are divided between the threads in the pool.
+
+\param pool
+is the pool of threads.
+The other arguments and the return value are the same as for the
+version without the pool argument.
+*/
+template <class Base, class RecBase>
+template <class SizeVector, class BaseVector>
+size_t ADFun<Base,RecBase>::sparse_jac_for(
+    size_t                               group_max  ,
+    const BaseVector&                    x          ,
+    sparse_rcv<SizeVector, BaseVector>&  subset     ,
+    const sparse_rc<SizeVector>&         pattern    ,
+    const std::string&                   coloring   ,
+    sparse_jac_work&                     work       ,
+    thread_pool&                         pool       )
+{   CPPAD_ASSERT_KNOWN(
+        ! thread_alloc::in_parallel(),
+        "sparse_jac_for: pool is present and in parallel mode"
+    );
+    CPPAD_ASSERT_KNOWN(
+        group_max > 0,
+        "sparse_jac_for: group_max is zero"
+    );
+    // compute work (if necessary), set subset values to zero
+    size_t n_color = sparse_jac_for(
+        group_max, x, subset, pattern, coloring, work, 0, 0
+    );
+    local::pool_fun<Base, RecBase> fun(*this, pool);
+    bool forward = true;
+    local::sparse_jac_pool(fun,
+        forward, group_max, x, subset, pattern, coloring, work, n_color, pool
+    );
+    return n_color;
+}
+/*!
+Calculate sparse Jacobains using reverse mode and the threads in a pool.
+
+The coloring is computed (if work is empty) by the calling thread,
+then the colors are divided between the threads in the pool.
+
+\param pool
+is the pool of threads.
+The other arguments and the return value are the same as for the
+version without the pool argument.
+*/
+template <class Base, class RecBase>
+template <class SizeVector, class BaseVector>
+size_t ADFun<Base,RecBase>::sparse_jac_rev(
+    const BaseVector&                    x        ,
+    sparse_rcv<SizeVector, BaseVector>&  subset   ,
+    const sparse_rc<SizeVector>&         pattern  ,
+    const std::string&                   coloring ,
+    sparse_jac_work&                     work     ,
+    thread_pool&                         pool     )
+{   CPPAD_ASSERT_KNOWN(
+        ! thread_alloc::in_parallel(),
+        "sparse_jac_rev: pool is present and in parallel mode"
+    );
+    // compute work (if necessary), set subset values to zero
+    size_t n_color = sparse_jac_rev(
+        x, subset, pattern, coloring, work, 0, 0
+    );
+    local::pool_fun<Base, RecBase> fun(*this, pool);
+    bool   forward   = false;
+    size_t group_max = 1;
+    local::sparse_jac_pool(fun,
+        forward, group_max, x, subset, pattern, coloring, work, n_color, pool
+    );
+    return n_color;
+}
+// ----------------------------------------------------------------------------
+/*!
+Calculate sparse Jacobains using both forward and reverse mode
+(the cppad.bidirectional coloring).
+
+\tparam Base
+the base type for the recording that is stored in the ADFun object.
+
+\tparam SizeVector
+a simple vector class with elements of type size_t.
+
+\tparam BaseVector
+a simple vector class with elements of type Base.
+
+\param x
+a vector of length n, the number of independent variables in f
+(this ADFun object).
+
+\param subset
+specifices the subset of the sparsity pattern where the Jacobian is evaluated.
+subset.nr() == m,
+subset.nc() == n.
+
+\param pattern
+is a sparsity pattern for the Jacobian of f;
+pattern.nr() == m,
+pattern.nc() == n,
+where m is number of dependent variables in f.
+
+\param work
+this structure must be empty, or contain the information stored
+by a previous call to sparse_jac_bidirectional.
+The previous call must be for the same ADFun object f
+and the same subset.
+The vector work.color has size n + m.
+The first n (last m) elements are the color for each column (row)
+and the row colors come after the column colors.
+If a column (row) is not used, its color is n + m.
+
+\param color_begin
+is the first color that is used to compute the Jacobian values.
+
+\param color_end
+is one more than the last color that is used to compute the Jacobian values.
+The subset values corresponding to other colors are zero.
+
+\return
+This is the total number of colors. If all the colors are used,
+it is the number of first order forward sweeps plus the number of
+first order reverse sweeps used to compute the Jacobian.
+*/
+template <class Base, class RecBase>
+template <class SizeVector, class BaseVector>
+size_t ADFun<Base,RecBase>::sparse_jac_bidirectional(
+    const BaseVector&                    x           ,
+    sparse_rcv<SizeVector, BaseVector>&  subset      ,
+    const sparse_rc<SizeVector>&         pattern     ,
+    sparse_jac_work&                     work        ,
+    size_t                               color_begin ,
+    size_t                               color_end   )
+{   size_t m = Range();
+    size_t n = Domain();
+    //
+    // row and column vectors in subset
+    const SizeVector& row( subset.row() );
+    const SizeVector& col( subset.col() );
+    //
+    vector<size_t>& color(work.color);
+    vector<size_t>& order(work.order);
+    vector<size_t>& entry_color(work.entry_color);
+    CPPAD_ASSERT_KNOWN(
+        color.size() == 0 || color.size() == n + m,
+        "sparse_jac: work is non-empty and conditions have changed"
+    );
+    CPPAD_ASSERT_KNOWN(
+        color.size() != 0 || ! thread_alloc::in_parallel(),
+        "sparse_jac: work is empty and in parallel mode"
+    );
+    //
+    // point at which we are evaluationg the Jacobian
+    Forward(0, x);
+    //
+    // number of elements in the subset
+    size_t K = subset.nnz();
+    //
+    // check for case were there is nothing to do
+    // (except for call to Forward(0, x)
+    if( K == 0 )
+        return 0;
+    //
+    // check for case where input work is empty
+    if( color.size() == 0 )
+    {   // compute work color, entry_color, and order vectors
+        CPPAD_ASSERT_KNOWN(
+            pattern.nr() == m,
+            "sparse_jac: pattern.nr() not equal range dimension for f"
+        );
+        CPPAD_ASSERT_KNOWN(
+            pattern.nc() == n,
+            "sparse_jac: pattern.nc() not equal domain dimension for f"
+        );
+        //
+        // convert pattern to an internal version
+        local::pod_vector<size_t> internal_index(m);
+        for(size_t i = 0; i < m; i++)
+            internal_index[i] = i;
+        bool transpose   = false;
+        bool zero_empty  = false;
+        bool input_empty = true;
+        local::sparse::list_setvec internal_pattern;
+        internal_pattern.resize(m, n);
+        local::sparse::set_internal_pattern(zero_empty, input_empty,
+            transpose, internal_index, internal_pattern, pattern
+        );
+        //
+        // convert pattern to an internal version of its transpose
+        internal_index.resize(n);
+        for(size_t j = 0; j < n; j++)
+            internal_index[j] = j;
+        transpose = true;
+        local::sparse::list_setvec pattern_transpose;
+        pattern_transpose.resize(n, m);
+        local::sparse::set_internal_pattern(zero_empty, input_empty,
+            transpose, internal_index, pattern_transpose, pattern
+        );
+        //
+        // execute coloring algorithm
+        vector<size_t> row_color(m), col_color(n);
+        vector<bool>   use_row(K);
+        local::color_bidirectional_cppad(
+            internal_pattern, pattern_transpose,
+            row, col, row_color, col_color, use_row
+        );
+        //
+        // number of column colors
+        size_t n_col_color = 0;
+        for(size_t j = 0; j < n; j++) if( col_color[j] < n )
+            n_col_color = std::max<size_t>(n_col_color, col_color[j] + 1);
+        //
+        // column colors followed by row colors
+        color.resize(n + m);
+        for(size_t j = 0; j < n; j++)
+        {   color[j] = n + m;
+            if( col_color[j] < n )
+                color[j] = col_color[j];
+        }
+        for(size_t i = 0; i < m; i++)
+        {   color[n + i] = n + m;
+            if( row_color[i] < m )
+                color[n + i] = n_col_color + row_color[i];
+        }
+        //
+        // color used to compute each element of the subset
+        entry_color.resize(K);
+        for(size_t k = 0; k < K; k++)
+        {   if( use_row[k] )
+                entry_color[k] = color[n + row[k] ];
+            else
+                entry_color[k] = color[ col[k] ];
+        }
+        //
+        // put sorting indices in color order
+        order.resize(K);
+        index_sort(entry_color, order);
+    }
+    // Base versions of zero and one
+    Base one(1.0);
+    Base zero(0.0);
+    //
+    // number of column colors and total number of colors
+    size_t n_col_color = 0;
+    for(size_t j = 0; j < n; j++) if( color[j] < n + m )
+        n_col_color = std::max<size_t>(n_col_color, color[j] + 1);
+    size_t n_color = n_col_color;
+    for(size_t i = 0; i < m; i++) if( color[n + i] < n + m )
+        n_color = std::max<size_t>(n_color, color[n + i] + 1);
+    //
+    // initialize the return Jacobian values as zero
+    for(size_t k = 0; k < K; k++)
+        subset.set(k, zero);
+    //
+    // direction, weighting, and return values for calls to Forward, Reverse
+    BaseVector dx(n), dy(m), w(m), dw(n);
+    //
+    // one more than the last color computed by this call
+    size_t color_last = std::min<size_t>(color_end, n_color);
+    //
+    // index in subset of first element with color greater or equal begin
+    size_t k = 0;
+    while( k < K && entry_color[ order[k] ] < color_begin )
+        ++k;
+    //
+    // loop over colors
+    for(size_t ell = color_begin; ell < color_last; ell++)
+    {   CPPAD_ASSERT_UNKNOWN( entry_color[ order[k] ] == ell );
+        if( ell < n_col_color )
+        {   // combine all columns with this color
+            for(size_t j = 0; j < n; j++)
+            {   dx[j] = zero;
+                if( color[j] == ell )
+                    dx[j] = one;
+            }
+            // call forward mode for all these columns at once
+            dy = Forward(1, dx);
+            //
+            // set the corresponding components of the result
+            while( k < K && entry_color[ order[k] ] == ell )
+            {   subset.set(order[k], dy[row[order[k]]] );
+                k++;
+            }
+        }
+        else
+        {   // combine all rows with this color
+            for(size_t i = 0; i < m; i++)
+            {   w[i] = zero;
+                if( color[n + i] == ell )
+                    w[i] = one;
+            }
+            // call reverse mode for all these rows at once
+            dw = Reverse(1, w);
+            //
+            // set the corresponding components of the result
+            while( k < K && entry_color[ order[k] ] == ell )
+            {   subset.set(order[k], dw[col[order[k]]] );
+                k++;
+            }
+        }
+    }
+    return n_color;
+}
 
 } // END_CPPAD_NAMESPACE
 # endif
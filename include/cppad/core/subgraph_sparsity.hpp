@@ -27,6 +27,10 @@ $section Subgraph Dependency Sparsity Patterns$$
 $head Syntax$$
 $icode%f%.subgraph_sparsity(
     %select_domain%, %select_range%, %transpose%, %pattern_out%
+)
+%$$
+$icode%f%.subgraph_sparsity(
+    %select_domain%, %select_range%, %row_callback%
 )%$$
 
 $head See Also$$
@@ -122,13 +126,34 @@ $latex \[
 where $latex D$$ ($latex R$$) is the diagonal matrix corresponding
 to $icode select_domain$$ ($icode select_range$$).
 
+$head row_callback$$
+This argument is a function object with the syntax
+$codei%
+    %row_callback%(%i%, %col%)
+%$$
+where $icode i$$ has type $code size_t$$ and
+$icode col$$ has type $code const CppAD::vector<size_t>&$$.
+In this case, the sparsity pattern is not stored.
+Instead, $icode row_callback$$ is called once for each $icode i$$
+such that $icode%select_range%[%i%]%$$ is true (in increasing order of
+$icode i$$) as soon as the corresponding row of the pattern is known.
+The vector $icode col$$ contains the column indices $icode j$$
+such that $latex (i, j)$$ is in the pattern described under
+$cref/pattern_out/subgraph_sparsity/pattern_out/$$ above
+(in no particular order).
+The memory for $icode col$$ is reused for the next row.
+Thus the memory used by this calculation does not grow with the
+number of elements in the sparsity pattern; e.g.,
+$icode row_callback$$ could write the pattern to a file.
+
 $head Example$$
 $children%
-    example/sparse/subgraph_sparsity.cpp
+    example/sparse/subgraph_sparsity.cpp%
+    example/sparse/subgraph_row_callback.cpp
 %$$
-The file
-$cref subgraph_sparsity.cpp$$
-contains an example and test of this operation.
+The files
+$cref subgraph_sparsity.cpp$$ and $cref subgraph_row_callback.cpp$$
+contain examples and tests of this operation.
 
 $end
 -----------------------------------------------------------------------------
@@ -176,6 +201,7 @@ void ADFun<Base,RecBase>::subgraph_sparsity(
     // compute the sparsity pattern in row, col
     local::pod_vector<size_t> row;
     local::pod_vector<size_t> col;
+    local::subgraph::append_row row_callback(row, col);
 
     // create the optimized recording
     switch( play_.address_type() )
@@ -187,8 +213,7 @@ void ADFun<Base,RecBase>::subgraph_sparsity(
             dep_taddr_,
             select_domain,
             select_range,
-            row,
-            col
+            row_callback
         );
         break;
 
@@ -199,8 +224,7 @@ void ADFun<Base,RecBase>::subgraph_sparsity(
             dep_taddr_,
             select_domain,
             select_range,
-            row,
-            col
+            row_callback
         );
         break;
 
@@ -211,8 +235,7 @@ void ADFun<Base,RecBase>::subgraph_sparsity(
             dep_taddr_,
             select_domain,
             select_range,
-            row,
-            col
+            row_callback
         );
         break;
 
@@ -238,5 +261,76 @@ void ADFun<Base,RecBase>::subgraph_sparsity(
     }
     return;
 }
+/*!
+Subgraph sparsity patterns reported one row at a time.
+
+\tparam Base
+is the base type for this recording.
+
+\tparam BoolVector
+is the simple vector with elements of type bool that is used for
+sparsity for the vector F(x).
+
+\tparam RowCallback
+is a function object that is called for each selected row.
+
+\param select_domain
+sparsity pattern for the diagonal of the square matrix D.
+
+\param select_range
+sparsity pattern for the diagnal of the square matrix R
+
+\param row_callback
+For each i such that select_range[i] is true,
+the syntax row_callback(i, col) is used to report the column indices
+for the i-th row of the sparsity pattern for R * F'(x) * D.
+*/
+template <class Base, class RecBase>
+template <class BoolVector, class RowCallback>
+void ADFun<Base,RecBase>::subgraph_sparsity(
+    const BoolVector&            select_domain    ,
+    const BoolVector&            select_range     ,
+    RowCallback&                 row_callback     )
+{
+    switch( play_.address_type() )
+    {
+        case local::play::unsigned_short_enum:
+        local::subgraph::subgraph_sparsity<unsigned short>(
+            &play_,
+            subgraph_info_,
+            dep_taddr_,
+            select_domain,
+            select_range,
+            row_callback
+        );
+        break;
+
+        case local::play::unsigned_int_enum:
+        local::subgraph::subgraph_sparsity<unsigned int>(
+            &play_,
+            subgraph_info_,
+            dep_taddr_,
+            select_domain,
+            select_range,
+            row_callback
+        );
+        break;
+
+        case local::play::size_t_enum:
+        local::subgraph::subgraph_sparsity<size_t>(
+            &play_,
+            subgraph_info_,
+            dep_taddr_,
+            select_domain,
+            select_range,
+            row_callback
+        );
+        break;
+
+        default:
+        CPPAD_ASSERT_UNKNOWN(false);
+    }
+    return;
+}
 } // END_CPPAD_NAMESPACE
 # endif
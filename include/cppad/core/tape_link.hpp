@@ -15,9 +15,7 @@ in the Eclipse Public License, Version 2.0 are satisfied:
 # include <cppad/local/define.hpp>
 # include <cppad/utility/thread_alloc.hpp>
 # include <cppad/core/cppad_assert.hpp>
-
-// needed before one can use CPPAD_ASSERT_FIRST_CALL_NOT_PARALLEL
-# include <cppad/utility/thread_alloc.hpp>
+# include <atomic>
 
 namespace CppAD { // BEGIN_CPPAD_NAMESPACE
 /*!
@@ -42,15 +40,21 @@ is the thread number. The following condition must hold
 
 \return
 is a pointer to the tape identifier for this thread and AD<Base> class.
+
+\par Parallel Mode
+The static registry is initialized by the first call to this routine
+(C++11 guarantees this is thread safe) and the element for each thread
+is allocated the first time it is used. Hence this routine can be
+called in parallel mode without first calling parallel_ad.
 */
 template <class Base>
 tape_id_t* AD<Base>::tape_id_ptr(size_t thread)
-{   CPPAD_ASSERT_FIRST_CALL_NOT_PARALLEL;
-    static tape_id_t tape_id_table[CPPAD_MAX_NUM_THREADS];
+{   static local::thread_registry<tape_id_t>* tape_id_table =
+        new local::thread_registry<tape_id_t>();
     CPPAD_ASSERT_UNKNOWN(
         (! thread_alloc::in_parallel()) || thread == thread_alloc::thread_num()
     );
-    return tape_id_table + thread;
+    return &(*tape_id_table)[thread];
 }
 
 /*!
@@ -68,15 +72,110 @@ is the thread number; i.e.,
 
 \return
 is a handle for the tape for this AD<Base> class and the specified thread.
+
+\par Parallel Mode
+see tape_id_ptr.
 */
 template <class Base>
 local::ADTape<Base>** AD<Base>::tape_handle(size_t thread)
-{   CPPAD_ASSERT_FIRST_CALL_NOT_PARALLEL;
-    static local::ADTape<Base>* tape_table[CPPAD_MAX_NUM_THREADS];
+{   static local::thread_registry<local::ADTape<Base>*>* tape_table =
+        new local::thread_registry<local::ADTape<Base>*>();
+    CPPAD_ASSERT_UNKNOWN(
+        (! thread_alloc::in_parallel()) || thread == thread_alloc::thread_num()
+    );
+    return &(*tape_table)[thread];
+}
+
+/*!
+Record the use of a tape identifier.
+
+\tparam Base
+is the base type for this AD<Base> class.
+
+\param tape_id
+is a tape identifier that is being used by one of the threads.
+
+\return
+is the maximum tape identifier used so far (by any thread).
+*/
+template <class Base>
+size_t AD<Base>::tape_id_max(size_t tape_id)
+{   static std::atomic<size_t> max_id(0);
+    size_t current = max_id.load(std::memory_order_acquire);
+    while( current < tape_id )
+    {   // if this fails, current is set to the new value of max_id
+        if( max_id.compare_exchange_weak(
+            current, tape_id, std::memory_order_acq_rel
+        ) )
+            current = tape_id;
+    }
+    return current;
+}
+
+/*!
+Make the tape identifier for a thread correspond to the
+current maximum number of threads.
+
+\tparam Base
+is the base type for this AD<Base> class.
+
+\param thread
+is the current thread; i.e., thread_alloc::thread_num().
+
+\par modulus
+The tape identifier for this thread satisfies
+\code
+    thread == tape_id % modulus
+\endcode
+where modulus is the value of thread_alloc::max_num_threads()
+the last time this routine changed the tape identifier for this thread.
+If this is the first call for this thread, or
+thread_alloc::max_num_threads() has increased, the tape identifier
+for this thread is changed to a value that is greater than all the
+tape identifiers used so far and that corresponds to the new modulus.
+Hence all the AD<Base> objects from previous tapes remain parameters.
+
+\par Parallel Mode
+Each thread only changes its own tape identifier.
+Hence this is done lazily, the first time each thread creates a tape,
+and it does not require calling parallel_ad.
+
+\par Restrictions
+If the tape identifier is changed,
+there cannot be a tape recording AD<Base> operations for this thread.
+*/
+template <class Base>
+void AD<Base>::tape_id_rebase(size_t thread)
+{   // The registry is never deleted for the same reason as in tape_id_ptr
+    static local::thread_registry<size_t>* modulus_table =
+        new local::thread_registry<size_t>();
     CPPAD_ASSERT_UNKNOWN(
         (! thread_alloc::in_parallel()) || thread == thread_alloc::thread_num()
     );
-    return tape_table + thread;
+    //
+    size_t& modulus    = (*modulus_table)[thread];
+    size_t new_modulus = thread_alloc::max_num_threads();
+    if( modulus == new_modulus )
+        return;
+    CPPAD_ASSERT_UNKNOWN( modulus < new_modulus );
+    CPPAD_ASSERT_KNOWN(
+        *tape_handle(thread) == nullptr ,
+        "parallel_setup increased max_num_threads while "
+        "a tape was recording AD<Base> operations"
+    );
+    //
+    // new tape identifier is greater than all the previous ones
+    tape_id_t* tape_id_p = tape_id_ptr(thread);
+    size_t     max_id    = tape_id_max( size_t( *tape_id_p ) );
+    size_t     new_id    = (max_id / new_modulus + 1) * new_modulus + thread;
+    CPPAD_ASSERT_KNOWN(
+        size_t( std::numeric_limits<tape_id_t>::max() ) >= new_id,
+        "cppad_tape_id_type maximum value has been exceeded"
+    );
+    *tape_id_p = static_cast<tape_id_t>( new_id );
+    tape_id_max(new_id);
+    //
+    modulus = new_modulus;
 }
 
 /*!
@@ -113,7 +212,7 @@ is the identifier for the tape that is currently recording
 AD<Base> operations for the current thread.
 It must hold that the current thread is
 \code
-    thread = size_t( tape_id % CPPAD_MAX_NUM_THREADS )
+    thread = size_t( tape_id % thread_alloc::max_num_threads() )
 \endcode
 and that there is a tape recording AD<Base> operations
 for this thread.
@@ -131,7 +230,7 @@ for the specified thread.
 */
 template <class Base>
 local::ADTape<Base>* AD<Base>::tape_ptr(tape_id_t tape_id)
-{   size_t thread = size_t( tape_id % CPPAD_MAX_NUM_THREADS );
+{   size_t thread = size_t( tape_id % thread_alloc::max_num_threads() );
     CPPAD_ASSERT_KNOWN(
         thread == thread_alloc::thread_num(),
         "Attempt to use an AD variable with two different threads."
@@ -166,7 +265,7 @@ for this thread when tape_manage is called.
 It is assumed that there is a tape recording AD<Base> operations
 for this thread when tape_manage is called.
 The value of <tt>*tape_id_ptr(thread)</tt> will be advanced by
- CPPAD_MAX_NUM_THREADS.
+thread_alloc::max_num_threads().
 
 
 \return
@@ -180,6 +279,7 @@ local::ADTape<Base>*  AD<Base>::tape_manage(tape_manage_enum job)
         job == new_tape_manage || job == delete_tape_manage
     );
     // thread, tape_id, and tape for this call
+    size_t                modulus    = thread_alloc::max_num_threads();
     size_t                thread     = thread_alloc::thread_num();
     tape_id_t*            tape_id_p  = tape_id_ptr(thread);
     local::ADTape<Base>** tape_h     = tape_handle(thread);
@@ -192,22 +292,16 @@ local::ADTape<Base>*  AD<Base>::tape_manage(tape_manage_enum job)
         // tape for this thread must be null at the start
         CPPAD_ASSERT_UNKNOWN( *tape_h  == nullptr );
 
+        // tape identifier must correspond to the maximum number of threads
+        // (this also initializes it the first time this thread uses a tape)
+        tape_id_rebase(thread);
+
         // allocate separate memroy to avoid false sharing
         *tape_h = new local::ADTape<Base>();
 
-        // if tape id is zero, initialize it so that
-        // thread == tape id % CPPAD_MAX_NUM_THREADS
-        if( *tape_id_p == 0 )
-        {   size_t new_tape_id = thread + CPPAD_MAX_NUM_THREADS;
-            CPPAD_ASSERT_KNOWN(
-                size_t( std::numeric_limits<tape_id_t>::max() ) >= new_tape_id,
-                "cppad_tape_id_type maximum value has been exceeded"
-            );
-            *tape_id_p = static_cast<tape_id_t>( new_tape_id );
-        }
         // make sure tape_id value is valid for this thread
         CPPAD_ASSERT_UNKNOWN(
-            size_t( *tape_id_p % CPPAD_MAX_NUM_THREADS ) == thread
+            size_t( *tape_id_p % modulus ) == thread
         );
         // set the tape_id for this tape
         (*tape_h)->id_ = *tape_id_p;
@@ -222,12 +316,18 @@ local::ADTape<Base>*  AD<Base>::tape_manage(tape_manage_enum job)
         //
         // advance tape_id so that all AD<Base> variables become parameters
         CPPAD_ASSERT_KNOWN(
-            std::numeric_limits<CPPAD_TAPE_ID_TYPE>::max()
-            - CPPAD_MAX_NUM_THREADS > *tape_id_p,
+            size_t( *tape_id_p % modulus ) == thread,
+            "parallel_setup increased max_num_threads while "
+            "a tape was recording AD<Base> operations"
+        );
+        CPPAD_ASSERT_KNOWN(
+            size_t( std::numeric_limits<CPPAD_TAPE_ID_TYPE>::max() )
+            - modulus > size_t( *tape_id_p ),
             "To many different tapes given the type used for "
             "CPPAD_TAPE_ID_TYPE"
         );
-        *tape_id_p  += CPPAD_MAX_NUM_THREADS;
+        *tape_id_p  = static_cast<tape_id_t>( *tape_id_p + modulus );
+        tape_id_max( size_t( *tape_id_p ) );
     }
     // -----------------------------------------------------------------------
     return *tape_h;
@@ -242,7 +342,7 @@ is the base type corresponding to AD<Base> operations.
 \par thread
 The current thread must be given by
 \code
-    thread = this->tape_id_ % CPPAD_MAX_NUM_THREADS
+    thread = this->tape_id_ % thread_alloc::max_num_threads()
 \endcode
 
 \return
@@ -255,7 +355,7 @@ recording AD<Base> operations for this thread.
 template <class Base>
 local::ADTape<Base> *AD<Base>::tape_this(void) const
 {
-    size_t thread = size_t( tape_id_ % CPPAD_MAX_NUM_THREADS );
+    size_t thread = size_t( tape_id_ % thread_alloc::max_num_threads() );
     CPPAD_ASSERT_UNKNOWN( tape_id_ == *tape_id_ptr(thread) );
     CPPAD_ASSERT_UNKNOWN( *tape_handle(thread) != nullptr );
     return *tape_handle(thread);
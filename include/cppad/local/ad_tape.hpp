@@ -109,9 +109,9 @@ private:
     // private data
     /*!
     Unique identifier for this tape.  It is always greater than
-    CPPAD_MAX_NUM_THREADS, and different for every tape (even ones that have
-    been deleted). In addition, id_ % CPPAD_MAX_NUM_THREADS is the thread
-    number for this tape. Set by Independent and effectively const
+    thread_alloc::max_num_threads(), and different for every tape (even ones
+    that have been deleted). In addition, id_ % thread_alloc::max_num_threads()
+    is the thread number for this tape. Set by Independent and effectively const
     */
     tape_id_t                    id_;
     /// Number of independent variables in this tapes reconding.
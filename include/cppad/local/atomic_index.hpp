@@ -41,6 +41,15 @@ the number of atomic functions stored in $codei%atomic_index<%Base%>%$$
 and no information is stored or changed.
 In this case, the atomic functions correspond to $icode index_in$$ from
 one to $icode index_out$$ inclusive.
+If an atomic function constructor is running in another thread,
+a call for the corresponding $icode index_in$$ waits for it to finish
+storing its information.
+
+$head Parallel Mode$$
+The information is stored in a $code thread_registry$$, which never moves
+its elements, and the indices are assigned using an atomic counter.
+Hence atomic function constructors and destructors can be called in
+parallel mode, and retrieving information does not use a lock.
 
 $head set_null$$
 If this is not the special case:
@@ -97,15 +106,20 @@ Otherwise, $index_out$$ is zero.
 
 $end
 */
-# include <vector>
-# include <cppad/utility/thread_alloc.hpp>
+# include <atomic>
+# include <string>
+# include <thread>
+# include <cppad/core/cppad_assert.hpp>
+# include <cppad/local/thread_registry.hpp>
 
 namespace CppAD { namespace local { // BEGIN_CPPAD_LOCAL_NAMESPACE
 
 struct atomic_index_info {
-    size_t      type;
-    std::string name;
-    void*       ptr;
+    size_t             type;
+    std::string        name;
+    std::atomic<void*> ptr;
+    /// type, name, and the initial ptr have been set
+    std::atomic<bool>  ready;
 };
 
 // BEGIN_ATOMIC_INDEX
@@ -118,44 +132,49 @@ size_t atomic_index(
     void*&             ptr           )
 // END_PROTOTYPE
 {   //
-    // information for each index
-    static std::vector<atomic_index_info> vec;
-# ifndef NDEBUG
-    if( index_in == 0 || set_null )
-    {   CPPAD_ASSERT_KNOWN( ! thread_alloc::in_parallel(),
-        "calling atomic function constructor or destructor in parallel mode"
-        );
-    }
-# endif
+    // information for each index (index_in - 1 is the registry index).
+    // The registry never moves its elements so no lock is necessary.
+    static thread_registry<atomic_index_info> registry;
+    //
+    // number of indices that have been assigned
+    static std::atomic<size_t> n_index(0);
+    //
     if( set_null & (index_in == 0) )
-        return vec.size();
+        return n_index.load(std::memory_order_acquire);
     //
     // case were we are retreving informaiton for an atomic function
     if( 0 < index_in )
-    {   CPPAD_ASSERT_UNKNOWN( index_in <= vec.size() )
+    {   CPPAD_ASSERT_UNKNOWN(
+            index_in <= n_index.load(std::memory_order_acquire)
+        );
+        atomic_index_info& entry = registry[index_in - 1];
+        //
+        // the constructor for this atomic function may still be running
+        // in another thread; e.g., if index_in came from the special case
+        while( ! entry.ready.load(std::memory_order_acquire) )
+            std::this_thread::yield();
         //
         // case where we are setting the pointer to null
         if( set_null )
-            vec[index_in-1].ptr = nullptr;
+            entry.ptr.store(nullptr, std::memory_order_release);
         //
-        atomic_index_info& entry = vec[index_in - 1];
         type = entry.type;
-        ptr  = entry.ptr;
+        ptr  = entry.ptr.load(std::memory_order_acquire);
         if( name != nullptr )
             *name  = entry.name;
         return 0;
     }
     //
     // case where we are storing information for an atomic function
-    atomic_index_info entry;
+    size_t index = n_index.fetch_add(1, std::memory_order_acq_rel);
+    atomic_index_info& entry = registry[index];
     entry.type = type;
     entry.name = *name;
-    entry.ptr  = ptr;
-    vec.push_back(entry);
+    entry.ptr.store(ptr, std::memory_order_relaxed);
+    entry.ready.store(true, std::memory_order_release);
     //
-    return vec.size();
+    return index + 1;
 }
-
 } } // END_CPPAD_LOCAL_NAMESPACE
 
 # endif
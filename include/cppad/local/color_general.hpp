@@ -203,6 +203,143 @@ void color_general_cppad(
     }
     return;
 }
+// --------------------------------------------------------------------------
+/*!
+Determine which rows and which columns of a general sparse matrix can be
+computed together when both row (reverse) and column (forward) sweeps
+are used.
+
+\tparam SetVector
+is vector_of_sets class.
+
+\tparam SizeVector
+is a simple vector class with elements of type size_t.
+
+\param pattern [in]
+Is a representation of the sparsity pattern for the matrix
+(it has m sets with end equal to n).
+
+\param pattern_transpose [in]
+Is a representation of the transpose of the sparsity pattern for the matrix
+(it has n sets with end equal to m).
+
+\param row [in]
+is a vector specifying which row indices to compute.
+
+\param col [in]
+is a vector, with the same size as row,
+that specifies which column indices to compute.
+For each  valid index k, the index pair
+<code>(row[k], col[k])</code> must be present in the sparsity pattern.
+
+\param row_color [out]
+is a vector with size m.
+Upon return, it is a coloring for the rows used by the row sweeps.
+If <code>row_color[i] == m</code>, row i is not used by the row sweeps.
+
+\param col_color [out]
+is a vector with size n.
+Upon return, it is a coloring for the columns used by the column sweeps.
+If <code>col_color[j] == n</code>, column j is not used by the column sweeps.
+
+\param use_row [out]
+is a vector with size equal to the size of row.
+If use_row[k] is true (false), the entry <code>(row[k], col[k])</code>
+is computed using the row (column) sweep corresponding to
+row_color[ row[k] ] (col_color[ col[k] ]).
+
+\return
+is the total number of colors; i.e., the number of row colors plus
+the number of column colors.
+
+\par Partial Bidirectional Coloring
+Each entry is assigned to the row sweeps if its row has more
+possibly non-zero entries than its column, otherwise it is assigned to the
+column sweeps.
+The entries assigned to the row (column) sweeps are colored using
+color_general_cppad. Because the rows (columns) that are not used
+by the row (column) sweeps are not included in those sweeps,
+each entry is recovered directly.
+If using only row sweeps, or only column sweeps, requires fewer colors,
+that choice is returned instead.
+*/
+template <class SetVector, class SizeVector>
+size_t color_bidirectional_cppad(
+    const SetVector&        pattern           ,
+    const SetVector&        pattern_transpose ,
+    const SizeVector&       row               ,
+    const SizeVector&       col               ,
+    CppAD::vector<size_t>&  row_color         ,
+    CppAD::vector<size_t>&  col_color         ,
+    CppAD::vector<bool>&    use_row           )
+{
+    size_t K = row.size();
+    size_t m = pattern.n_set();
+    size_t n = pattern.end();
+    CPPAD_ASSERT_UNKNOWN( size_t( col.size() )     == K );
+    CPPAD_ASSERT_UNKNOWN( pattern_transpose.n_set() == n );
+    CPPAD_ASSERT_UNKNOWN( pattern_transpose.end()   == m );
+    //
+    // number of possibly non-zero entries in each row and column
+    CppAD::vector<size_t> row_count(m), col_count(n);
+    for(size_t i = 0; i < m; i++)
+        row_count[i] = pattern.number_elements(i);
+    for(size_t j = 0; j < n; j++)
+        col_count[j] = pattern_transpose.number_elements(j);
+    //
+    // information for the current choice of directions
+    CppAD::vector<bool>   try_use_row(K);
+    CppAD::vector<size_t> try_row_color(m), try_col_color(n);
+    CppAD::vector<size_t> r_row, r_col, c_row, c_col;
+    //
+    size_t n_color = 0;
+    row_color.resize(m);
+    col_color.resize(n);
+    use_row.resize(K);
+    //
+    // choice = 0: only column sweeps, 1: only row sweeps, 2: both
+    for(size_t choice = 0; choice < 3; choice++)
+    {   r_row.resize(0);
+        r_col.resize(0);
+        c_row.resize(0);
+        c_col.resize(0);
+        for(size_t k = 0; k < K; k++)
+        {   if( choice == 2 )
+                try_use_row[k] = row_count[ row[k] ] > col_count[ col[k] ];
+            else
+                try_use_row[k] = choice == 1;
+            if( try_use_row[k] )
+            {   r_row.push_back( row[k] );
+                r_col.push_back( col[k] );
+            }
+            else
+            {   c_row.push_back( row[k] );
+                c_col.push_back( col[k] );
+            }
+        }
+        // row and column colorings
+        color_general_cppad(pattern, r_row, r_col, try_row_color);
+        color_general_cppad(pattern_transpose, c_col, c_row, try_col_color);
+        //
+        // total number of colors
+        size_t n_row_color = 0;
+        for(size_t i = 0; i < m; i++) if( try_row_color[i] < m )
+            n_row_color = std::max(n_row_color, try_row_color[i] + 1);
+        size_t n_col_color = 0;
+        for(size_t j = 0; j < n; j++) if( try_col_color[j] < n )
+            n_col_color = std::max(n_col_color, try_col_color[j] + 1);
+        size_t try_n_color = n_row_color + n_col_color;
+        //
+        // use this choice if it is better
+        if( choice == 0 || try_n_color < n_color )
+        {   n_color = try_n_color;
+            row_color.swap(try_row_color);
+            col_color.swap(try_col_color);
+            use_row.swap(try_use_row);
+        }
+    }
+    return n_color;
+}
 
 # if CPPAD_HAS_COLPACK
 /*!
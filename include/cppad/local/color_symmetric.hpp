@@ -2,6 +2,8 @@
 # define CPPAD_LOCAL_COLOR_SYMMETRIC_HPP
 # include <cppad/configure.hpp>
 # include <cppad/local/cppad_colpack.hpp>
+# include <map>
+# include <set>
 
 /* --------------------------------------------------------------------------
 CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-17 Bradley M. Bell
@@ -304,6 +306,590 @@ void color_symmetric_colpack(
 # endif // CPPAD_HAS_COLPACK
 }
 
+// --------------------------------------------------------------------------
+/*!
+Determine the adjacency graph for a symmetric sparse matrix restricted
+to the indices that appear in a subset of the matrix.
+
+\tparam SetVector
+is a vector_of_sets class.
+
+\param pattern [in]
+Is a representation of the sparsity pattern for the matrix.
+
+\param row [in]
+is a vector specifying which row indices to compute.
+
+\param col [in]
+is a vector, with the same size as row,
+that specifies which column indices to compute.
+
+\param appear [out]
+is a vector with size m.
+Upon return, appear[i] is true if i appears in row or col.
+
+\param adjacent [out]
+is a vector with size m.
+Upon return, adjacent[i] is the set of indices i1 != i such that
+both i and i1 appear and (i, i1) or (i1, i) is in the sparsity pattern.
+*/
+template <class SetVector>
+void color_symmetric_graph(
+    const SetVector&                     pattern   ,
+    const CppAD::vector<size_t>&         row       ,
+    const CppAD::vector<size_t>&         col       ,
+    CppAD::vector<bool>&                 appear    ,
+    CppAD::vector< std::set<size_t> >&   adjacent  )
+{   size_t K = row.size();
+    size_t m = pattern.n_set();
+    CPPAD_ASSERT_UNKNOWN( m == pattern.end() );
+    CPPAD_ASSERT_UNKNOWN( col.size()      == K );
+    CPPAD_ASSERT_UNKNOWN( appear.size()   == m );
+    CPPAD_ASSERT_UNKNOWN( adjacent.size() == m );
+    //
+    for(size_t i = 0; i < m; i++)
+    {   appear[i] = false;
+        adjacent[i].clear();
+    }
+    for(size_t k = 0;  k < K; k++)
+    {   CPPAD_ASSERT_UNKNOWN( pattern.is_element(row[k], col[k]) );
+        appear[ row[k] ] = true;
+        appear[ col[k] ] = true;
+    }
+    for(size_t i1 = 0; i1 < m; i1++) if( appear[i1] )
+    {   typename SetVector::const_iterator pattern_itr(pattern, i1);
+        size_t i2 = *pattern_itr;
+        while( i2 != pattern.end() )
+        {   if( i2 != i1 && appear[i2] )
+            {   adjacent[i1].insert(i2);
+                adjacent[i2].insert(i1);
+            }
+            i2 = *(++pattern_itr);
+        }
+    }
+    return;
+}
+// --------------------------------------------------------------------------
+/*!
+Determine a smallest last ordering for the vertices of a graph.
+
+\param appear [in]
+is a vector with size m. Only the vertices i for which appear[i] is true
+are included in the ordering.
+
+\param adjacent [in]
+is a vector with size m.
+The set adjacent[i] contains the vertices that are adjacent to vertex i.
+
+\param order [out]
+Upon return, order contains the vertices i for which appear[i] is true.
+The last vertex has the smallest degree, the next to last vertex
+has the smallest degree when the last vertex is removed from the graph,
+and so on.
+*/
+inline void color_smallest_last(
+    const CppAD::vector<bool>&                appear    ,
+    const CppAD::vector< std::set<size_t> >&  adjacent  ,
+    CppAD::vector<size_t>&                    order     )
+{   typedef std::pair<size_t, size_t> size_pair;
+    size_t m = appear.size();
+    CPPAD_ASSERT_UNKNOWN( adjacent.size() == m );
+    //
+    // current degree for each vertex that has not been removed
+    CppAD::vector<size_t> degree(m);
+    std::set<size_pair>   degree_vertex;
+    size_t n_appear = 0;
+    for(size_t i = 0; i < m; i++) if( appear[i] )
+    {   degree[i] = adjacent[i].size();
+        degree_vertex.insert( size_pair(degree[i], i) );
+        ++n_appear;
+    }
+    //
+    // remove the vertex with smallest degree and put it at the end
+    order.resize(n_appear);
+    CppAD::vector<bool> removed(m);
+    for(size_t i = 0; i < m; i++)
+        removed[i] = false;
+    for(size_t ell = n_appear; ell > 0; --ell)
+    {   size_t i1 = degree_vertex.begin()->second;
+        degree_vertex.erase( degree_vertex.begin() );
+        removed[i1]    = true;
+        order[ell - 1] = i1;
+        std::set<size_t>::const_iterator itr = adjacent[i1].begin();
+        for(; itr != adjacent[i1].end(); ++itr)
+        {   size_t i2 = *itr;
+            if( ! removed[i2] )
+            {   degree_vertex.erase( size_pair(degree[i2], i2) );
+                --degree[i2];
+                degree_vertex.insert( size_pair(degree[i2], i2) );
+            }
+        }
+    }
+    return;
+}
+// --------------------------------------------------------------------------
+/*!
+Star coloring algorithm for determining which rows of a symmetric sparse
+matrix can be computed together.
+
+\copydetails CppAD::local::color_symmetric_cppad
+
+\par Star Coloring
+This is a distance one coloring of the adjacency graph for the matrix,
+restricted to the indices that appear in row and col,
+such that every path with four vertices uses at least three colors.
+The rows are colored in smallest last order; see
+Algorithm 4.1 of
+What Color Is Your Jacobian? Graph Coloring for Computing Derivatives,
+Assefaw Gebremedhin, Fredrik Maane, Alex Pothen, SIAM Review 2005.
+It follows that each entry can be recovered directly from
+the sweep for its row color, or the sweep for its column color.
+Colors that are not used by any of the return values of row are removed.
+*/
+template <class SetVector>
+void color_symmetric_star(
+    const SetVector&        pattern   ,
+    CppAD::vector<size_t>&  row       ,
+    CppAD::vector<size_t>&  col       ,
+    CppAD::vector<size_t>&  color     )
+{
+    size_t K = row.size();
+    size_t m = pattern.n_set();
+    CPPAD_ASSERT_UNKNOWN( m == pattern.end() );
+    CPPAD_ASSERT_UNKNOWN( color.size() == m );
+    CPPAD_ASSERT_UNKNOWN( col.size()   == K );
+    //
+    // adjacency graph for the indices that appear
+    CppAD::vector<bool>               appear(m);
+    CppAD::vector< std::set<size_t> > adjacent(m);
+    color_symmetric_graph(pattern, row, col, appear, adjacent);
+    std::set<size_t>::const_iterator itr1, itr2, itr3;
+    //
+    // order in which the rows are colored
+    CppAD::vector<size_t> order2row;
+    color_smallest_last(appear, adjacent, order2row);
+    //
+    // initialize all rows as not colored
+    for(size_t i1 = 0; i1 < m; i1++)
+        color[i1] = m;
+    //
+    // forbidden[c] == i1 if color c is forbidden for row i1
+    CppAD::vector<size_t> forbidden(m);
+    for(size_t c = 0; c < m; c++)
+        forbidden[c] = m;
+    //
+    for(size_t o1 = 0; o1 < order2row.size(); o1++)
+    {   size_t i1 = order2row[o1];
+        for(itr1 = adjacent[i1].begin(); itr1 != adjacent[i1].end(); ++itr1)
+        {   size_t i2 = *itr1;
+            // distance one coloring
+            if( color[i2] < m )
+                forbidden[ color[i2] ] = i1;
+            for(itr2 = adjacent[i2].begin(); itr2 != adjacent[i2].end(); ++itr2)
+            {   size_t i3 = *itr2;
+                if( color[i3] < m )
+                {   if( color[i2] == m )
+                    {   // path i1, i2, i3 with i2 not colored
+                        forbidden[ color[i3] ] = i1;
+                    }
+                    else
+                    {   // path i1, i2, i3, i4 with colors c1, c2, c1, c2
+                        itr3 = adjacent[i3].begin();
+                        while( itr3 != adjacent[i3].end() )
+                        {   size_t i4 = *itr3;
+                            if( i4 != i2 && color[i4] == color[i2] )
+                            {   forbidden[ color[i3] ] = i1;
+                                itr3 = adjacent[i3].end();
+                            }
+                            else
+                                ++itr3;
+                        }
+                    }
+                }
+            }
+        }
+        // pick the color with smallest index
+        size_t c1 = 0;
+        while( forbidden[c1] == i1 )
+            c1++;
+        CPPAD_ASSERT_UNKNOWN( c1 < m );
+        color[i1] = c1;
+    }
+    //
+    // Reflect entries (i1, j1) where j1 has another adjacent row with the
+    // same color as i1. In this case, the row color for j1 can be used.
+    CppAD::vector<bool> used(m);
+    for(size_t i1 = 0; i1 < m; i1++)
+        used[i1] = false;
+    for(size_t k = 0; k < K; k++)
+    {   size_t i1 = row[k];
+        size_t j1 = col[k];
+        bool reflect = false;
+        if( i1 != j1 )
+        {   itr1 = adjacent[j1].begin();
+            while( itr1 != adjacent[j1].end() )
+            {   size_t i2 = *itr1++;
+                reflect |= i2 != i1 && color[i2] == color[i1];
+            }
+        }
+        if( reflect )
+        {   row[k] = j1;
+            col[k] = i1;
+# ifndef NDEBUG
+            itr1 = adjacent[i1].begin();
+            while( itr1 != adjacent[i1].end() )
+            {   size_t i2 = *itr1++;
+                CPPAD_ASSERT_UNKNOWN( i2 == j1 || color[i2] != color[j1] );
+            }
+# endif
+        }
+        used[ row[k] ] = true;
+    }
+    //
+    // Rows that are not used do not need to be included in the sweeps.
+    // Renumber the colors that are used so they are 0, 1, ...
+    CppAD::vector<size_t> new_color(m);
+    for(size_t c = 0; c < m; c++)
+        new_color[c] = m;
+    for(size_t i1 = 0; i1 < m; i1++)
+    {   if( ! used[i1] )
+            color[i1] = m;
+        else
+            new_color[ color[i1] ] = 0;
+    }
+    size_t n_color = 0;
+    for(size_t c = 0; c < m; c++)
+        if( new_color[c] == 0 )
+            new_color[c] = n_color++;
+    for(size_t i1 = 0; i1 < m; i1++)
+        if( color[i1] < m )
+            color[i1] = new_color[ color[i1] ];
+    //
+    return;
+}
+// --------------------------------------------------------------------------
+/*!
+Information used to recover the entries of a symmetric matrix
+from the sweeps corresponding to an acyclic coloring.
+
+Suppose that B[i, c] denotes the i-th component of the sweep for color c;
+i.e., the sum of the entries (i, j) in the matrix for which color[j] == c.
+*/
+struct color_substitution {
+    /// row index for each B value that is used
+    CppAD::vector<size_t> b_row;
+    /// color index for each B value that is used (in increasing order)
+    CppAD::vector<size_t> b_color;
+    /// for each step s, index in b_row of the B value that starts step s
+    CppAD::vector<size_t> step_b;
+    /// the steps that are subtracted during step s are
+    /// step_list[ step_begin[s] ], ... , step_list[ step_begin[s+1] - 1 ]
+    CppAD::vector<size_t> step_begin;
+    /// list of the previous steps that are subtracted for each step
+    CppAD::vector<size_t> step_list;
+    /// for each entry k in the subset, the step that computes its value
+    CppAD::vector<size_t> entry_step;
+    /// remove all the information
+    void clear(void)
+    {   b_row.clear();
+        b_color.clear();
+        step_b.clear();
+        step_begin.clear();
+        step_list.clear();
+        entry_step.clear();
+    }
+};
+// --------------------------------------------------------------------------
+/*!
+Acyclic coloring algorithm for determining which rows of a symmetric sparse
+matrix can be computed together, and how to recover the matrix entries
+using substitution.
+
+\tparam SetVector
+is a vector_of_sets class.
+
+\param pattern [in]
+Is a representation of the sparsity pattern for the matrix.
+
+\param row [in]
+is a vector specifying which row indices to compute.
+
+\param col [in]
+is a vector, with the same size as row,
+that specifies which column indices to compute.
+For each  valid index k, the index pair
+<code>(row[k], col[k])</code> must be present in the sparsity pattern.
+
+\param color [out]
+is a vector with size m.
+The input value of its elements does not matter.
+Upon return, it is a coloring for the rows of the sparse matrix.
+If color[i] == m, the i-th row does not appear in row or col.
+Otherwise, color[i] < m.
+
+\param subst [out]
+The input value of its elements does not matter.
+Upon return, it contains the information necessary to recover the
+entries in the subset from the sweeps for each color.
+The value for step s is
+\code
+    B[ b_row[ step_b[s] ], b_color[ step_b[s] ] ]
+\endcode
+minus the sum of the value for the steps in step_list between
+step_begin[s] and step_begin[s+1]; note that these steps are less than s.
+
+\par Acyclic Coloring
+This is a distance one coloring of the adjacency graph for the matrix,
+restricted to the indices that appear in row and col,
+such that every cycle uses at least three colors.
+The rows are colored in smallest last order; see
+Graph Coloring in Optimization Revisited,
+Assefaw Gebremedhin, Fredrik Maane, Alex Pothen.
+The subgraph corresponding to each pair of colors is a forest and
+the off diagonal entries corresponding to each tree in the forest are
+recovered starting at the leaves of the tree.
+*/
+template <class SetVector>
+void color_symmetric_acyclic(
+    const SetVector&              pattern   ,
+    const CppAD::vector<size_t>&  row       ,
+    const CppAD::vector<size_t>&  col       ,
+    CppAD::vector<size_t>&        color     ,
+    color_substitution&           subst     )
+{   typedef std::pair<size_t, size_t> size_pair;
+    //
+    size_t K = row.size();
+    size_t m = pattern.n_set();
+    CPPAD_ASSERT_UNKNOWN( m == pattern.end() );
+    CPPAD_ASSERT_UNKNOWN( color.size() == m );
+    CPPAD_ASSERT_UNKNOWN( col.size()   == K );
+    //
+    // adjacency graph for the indices that appear
+    CppAD::vector<bool>               appear(m);
+    CppAD::vector< std::set<size_t> > adjacent(m);
+    color_symmetric_graph(pattern, row, col, appear, adjacent);
+    std::set<size_t>::const_iterator itr1, itr2;
+    //
+    // order in which the rows are colored
+    CppAD::vector<size_t> order2row;
+    color_smallest_last(appear, adjacent, order2row);
+    //
+    // initialize all rows as not colored
+    for(size_t i1 = 0; i1 < m; i1++)
+        color[i1] = m;
+    //
+    // forbidden[c] == i1 if color c is forbidden for row i1
+    CppAD::vector<size_t> forbidden(m);
+    for(size_t c = 0; c < m; c++)
+        forbidden[c] = m;
+    //
+    // parent[ (c1 * m + c2, i) ] is the parent of row i in the disjoint set
+    // forest for the subgraph with colors c1 < c2 (not present for a root).
+    std::map<size_pair, size_t> parent;
+    //
+    for(size_t o1 = 0; o1 < order2row.size(); o1++)
+    {   size_t i1 = order2row[o1];
+        //
+        // distance one coloring
+        for(itr1 = adjacent[i1].begin(); itr1 != adjacent[i1].end(); ++itr1)
+        {   size_t i2 = *itr1;
+            if( color[i2] < m )
+                forbidden[ color[i2] ] = i1;
+        }
+        //
+        // pick the color with smallest index that does not create a
+        // two colored cycle
+        size_t c1   = 0;
+        bool   done = false;
+        while( ! done )
+        {   while( forbidden[c1] == i1 )
+                c1++;
+            CPPAD_ASSERT_UNKNOWN( c1 < m );
+            //
+            // a cycle is created if two rows adjacent to i1 with color c2
+            // are in the same tree for colors c1, c2
+            std::set<size_pair> tree;
+            done = true;
+            itr1 = adjacent[i1].begin();
+            while( done && itr1 != adjacent[i1].end() )
+            {   size_t i2 = *itr1++;
+                size_t c2 = color[i2];
+                if( c2 < m )
+                {   size_t two = std::min(c1, c2) * m + std::max(c1, c2);
+                    size_t root = i2;
+                    std::map<size_pair, size_t>::iterator map_itr =
+                        parent.find( size_pair(two, root) );
+                    while( map_itr != parent.end() )
+                    {   root    = map_itr->second;
+                        map_itr = parent.find( size_pair(two, root) );
+                    }
+                    done = tree.insert( size_pair(c2, root) ).second;
+                }
+            }
+            if( ! done )
+                forbidden[c1] = i1;
+        }
+        color[i1] = c1;
+        //
+        // join the trees that are connected by i1
+        for(itr1 = adjacent[i1].begin(); itr1 != adjacent[i1].end(); ++itr1)
+        {   size_t i2 = *itr1;
+            size_t c2 = color[i2];
+            if( c2 < m )
+            {   size_t two = std::min(c1, c2) * m + std::max(c1, c2);
+                size_t root = i2;
+                std::map<size_pair, size_t>::iterator map_itr =
+                    parent.find( size_pair(two, root) );
+                while( map_itr != parent.end() )
+                {   root    = map_itr->second;
+                    map_itr = parent.find( size_pair(two, root) );
+                }
+                parent[ size_pair(two, root) ] = i1;
+            }
+        }
+    }
+    // ------------------------------------------------------------------------
+    // recovery
+    subst.clear();
+    subst.step_begin.push_back(0);
+    //
+    // index in b_row for each (row, color) pair
+    std::map<size_pair, size_t> b_index;
+    //
+    // step for each diagonal entry
+    CppAD::vector<size_t> diagonal_step(m);
+    for(size_t i1 = 0; i1 < m; i1++)
+    {   diagonal_step[i1] = m;
+        if( appear[i1] )
+        {   size_t t = subst.b_row.size();
+            b_index[ size_pair(i1, color[i1]) ] = t;
+            subst.b_row.push_back(i1);
+            subst.b_color.push_back( color[i1] );
+            //
+            diagonal_step[i1] = subst.step_b.size();
+            subst.step_b.push_back(t);
+            subst.step_begin.push_back( subst.step_list.size() );
+        }
+    }
+    //
+    // edges for each pair of colors
+    std::map< size_t, CppAD::vector<size_pair> > two_edge;
+    for(size_t i1 = 0; i1 < m; i1++)
+    {   for(itr1 = adjacent[i1].begin(); itr1 != adjacent[i1].end(); ++itr1)
+        {   size_t i2 = *itr1;
+            if( i1 < i2 )
+            {   size_t c1  = std::min(color[i1], color[i2]);
+                size_t c2  = std::max(color[i1], color[i2]);
+                two_edge[ c1 * m + c2 ].push_back( size_pair(i1, i2) );
+            }
+        }
+    }
+    //
+    // step for each edge (i1, i2) with i1 < i2
+    std::map<size_pair, size_t> edge_step;
+    //
+    // for each pair of colors
+    std::map< size_t, CppAD::vector<size_pair> >::const_iterator two_itr;
+    for(two_itr = two_edge.begin(); two_itr != two_edge.end(); ++two_itr)
+    {   const CppAD::vector<size_pair>& edge( two_itr->second );
+        //
+        // adjacency for this forest
+        std::map< size_t, CppAD::vector<size_t> > forest;
+        for(size_t e = 0; e < edge.size(); e++)
+        {   forest[ edge[e].first ].push_back( edge[e].second );
+            forest[ edge[e].second ].push_back( edge[e].first );
+        }
+        //
+        // breadth first order for each tree in the forest
+        std::map<size_t, size_t> tree_parent;
+        CppAD::vector<size_t>    bfs_order;
+        std::map< size_t, CppAD::vector<size_t> >::const_iterator forest_itr;
+        for(forest_itr = forest.begin(); forest_itr != forest.end(); ++forest_itr)
+        if( tree_parent.find( forest_itr->first ) == tree_parent.end() )
+        {   size_t root = forest_itr->first;
+            tree_parent[root] = m;
+            size_t start = bfs_order.size();
+            bfs_order.push_back(root);
+            while( start < bfs_order.size() )
+            {   size_t i1 = bfs_order[start++];
+                const CppAD::vector<size_t>& next( forest[i1] );
+                for(size_t ell = 0; ell < next.size(); ell++)
+                {   size_t i2 = next[ell];
+                    if( tree_parent.find(i2) == tree_parent.end() )
+                    {   tree_parent[i2] = i1;
+                        bfs_order.push_back(i2);
+                    }
+                }
+            }
+        }
+        //
+        // process rows from the leaves to the roots
+        for(size_t ell = bfs_order.size(); ell > 0; --ell)
+        {   size_t i1 = bfs_order[ell - 1];
+            size_t i2 = tree_parent[i1];
+            if( i2 < m )
+            {   // B[i1, color[i2]] is the sum of entry (i1, i2) and the
+                // entries (i1, i3) where i3 is a child of i1 in this tree
+                size_pair b_pair(i1, color[i2]);
+                std::map<size_pair, size_t>::iterator b_itr;
+                b_itr = b_index.find(b_pair);
+                size_t t;
+                if( b_itr != b_index.end() )
+                    t = b_itr->second;
+                else
+                {   t = subst.b_row.size();
+                    b_index[b_pair] = t;
+                    subst.b_row.push_back(i1);
+                    subst.b_color.push_back( color[i2] );
+                }
+                const CppAD::vector<size_t>& next( forest[i1] );
+                for(size_t e = 0; e < next.size(); e++)
+                {   size_t i3 = next[e];
+                    if( i3 != i2 )
+                    {   CPPAD_ASSERT_UNKNOWN( tree_parent[i3] == i1 );
+                        size_pair child( std::min(i1, i3), std::max(i1, i3) );
+                        subst.step_list.push_back( edge_step[child] );
+                    }
+                }
+                edge_step[ size_pair( std::min(i1, i2), std::max(i1, i2) ) ] =
+                    subst.step_b.size();
+                subst.step_b.push_back(t);
+                subst.step_begin.push_back( subst.step_list.size() );
+            }
+        }
+    }
+    //
+    // sort the B values by color
+    size_t n_b = subst.b_row.size();
+    CppAD::vector<size_t> b_order(n_b), b_new(n_b);
+    CppAD::index_sort(subst.b_color, b_order);
+    CppAD::vector<size_t> b_row(n_b), b_color(n_b);
+    for(size_t t = 0; t < n_b; t++)
+    {   b_row[t]   = subst.b_row[ b_order[t] ];
+        b_color[t] = subst.b_color[ b_order[t] ];
+        b_new[ b_order[t] ] = t;
+    }
+    subst.b_row.swap(b_row);
+    subst.b_color.swap(b_color);
+    for(size_t s = 0; s < subst.step_b.size(); s++)
+        subst.step_b[s] = b_new[ subst.step_b[s] ];
+    //
+    // step for each entry in the subset
+    subst.entry_step.resize(K);
+    for(size_t k = 0; k < K; k++)
+    {   size_t i1 = row[k];
+        size_t i2 = col[k];
+        if( i1 == i2 )
+            subst.entry_step[k] = diagonal_step[i1];
+        else
+        {   size_pair edge( std::min(i1, i2), std::max(i1, i2) );
+            CPPAD_ASSERT_UNKNOWN( edge_step.find(edge) != edge_step.end() );
+            subst.entry_step[k] = edge_step[edge];
+        }
+    }
+    return;
+}
+
 } } // END_CPPAD_LOCAL_NAMESPACE
 
 # endif
@@ -11,6 +11,7 @@ Secondary License when the conditions for such availability set forth
 in the Eclipse Public License, Version 2.0 are satisfied:
       GNU General Public License, Version 2.0 or later.
 ---------------------------------------------------------------------------- */
+# include <atomic>
 
 namespace CppAD { namespace local { // BEGIN_CPPAD_LOCAL_NAMESPACE
 /*!
@@ -241,8 +242,7 @@ $end
 // BEGIN_NUM_ARG_DYN_PROTOTYPE
 inline size_t num_arg_dyn(op_code_dyn op)
 // END_NUM_ARG_DYN_PROTOTYPE
-{   CPPAD_ASSERT_FIRST_CALL_NOT_PARALLEL;
-
+{
     // BEGIN_SORT_THIS_LINE_PLUS_2
     static const size_t num_arg_table[] = {
         /* abs_dyn */      1,
@@ -283,12 +283,12 @@ inline size_t num_arg_dyn(op_code_dyn op)
     };
     // END_SORT_THIS_LINE_MINUS_3
     //
-    static bool first = true;
-    if( first )
+    static std::atomic<bool> first(true);
+    if( first.load(std::memory_order_relaxed) )
     {   CPPAD_ASSERT_UNKNOWN(
         size_t(number_dyn)+1 == sizeof(num_arg_table)/sizeof(num_arg_table[0])
         );
-        first = false;
+        first.store(false, std::memory_order_relaxed);
     }
     return num_arg_table[op];
 }
@@ -331,8 +331,7 @@ $end
 // BEGIN_OP_NAME_DYN_PROTOTYPE
 inline const char* op_name_dyn(op_code_dyn op)
 // END_OP_NAME_DYN_PROTOTYPE
-{   CPPAD_ASSERT_FIRST_CALL_NOT_PARALLEL;
-
+{
     // BEGIN_SORT_THIS_LINE_PLUS_2
     static const char* op_name_table[] = {
         /* abs_dyn */      "abs",
@@ -372,12 +371,12 @@ inline const char* op_name_dyn(op_code_dyn op)
         /* number_dyn */   "number"
     };
     // END_SORT_THIS_LINE_MINUS_3
-    static bool first = true;
-    if( first )
+    static std::atomic<bool> first(true);
+    if( first.load(std::memory_order_relaxed) )
     {   CPPAD_ASSERT_UNKNOWN(
         size_t(number_dyn)+1 == sizeof(op_name_table)/sizeof(op_name_table[0])
         );
-        first = false;
+        first.store(false, std::memory_order_relaxed);
     }
     return op_name_table[op];
 }
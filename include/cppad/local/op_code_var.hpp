@@ -14,13 +14,13 @@ in the Eclipse Public License, Version 2.0 are satisfied:
 # include <string>
 # include <sstream>
 # include <iomanip>
+# include <atomic>
 
 # include <cppad/local/atomic_index.hpp>
 # include <cppad/local/define.hpp>
 # include <cppad/core/cppad_assert.hpp>
 # include <cppad/local/pod_vector.hpp>
 
-// needed before one can use CPPAD_ASSERT_FIRST_CALL_NOT_PARALLEL
 # include <cppad/utility/thread_alloc.hpp>
 
 namespace CppAD { namespace local { // BEGIN_CPPAD_LOCAL_NAMESPACE
@@ -506,8 +506,7 @@ AcoshOp  2                1  index of variable we are taking acosh of
 Note that the meaning of the arguments depends on the operator.
 */
 inline size_t NumArg( OpCode op)
-{   CPPAD_ASSERT_FIRST_CALL_NOT_PARALLEL;
-
+{
     // agreement with OpCode is checked by bin/check_op_code.sh
     static const size_t NumArgTable[] = {
         1, // AbsOp
@@ -586,9 +585,10 @@ inline size_t NumArg( OpCode op)
     };
 # ifndef NDEBUG
     // only do these checks once to save time
-    static bool first = true;
-    if( first )
-    {   first = false;
+    // (atomic so that the first call can be in parallel mode)
+    static std::atomic<bool> first(true);
+    if( first.load(std::memory_order_relaxed) )
+    {   first.store(false, std::memory_order_relaxed);
         // check that NumberOp is last value in op code table
         CPPAD_ASSERT_UNKNOWN(
             size_t(NumberOp) + 1 == sizeof(NumArgTable)/sizeof(NumArgTable[0])
@@ -625,8 +625,7 @@ AcoshOp  2                2  acosh(x) and sqrt(x*x-1) are required for this op
 \endverbatim
 */
 inline size_t NumRes(OpCode op)
-{   CPPAD_ASSERT_FIRST_CALL_NOT_PARALLEL;
-
+{
     // agreement with OpCode is checked by bin/check_op_code.sh
     static const size_t NumResTable[] = {
         1, // AbsOp
@@ -1464,10 +1463,10 @@ void arg_is_variable(
         CPPAD_ASSERT_UNKNOWN( NumArg(op) == 6 );
         is_variable[0] = false;
         is_variable[1] = false;
-        is_variable[2] = (arg[0] & 1) != 0;
-        is_variable[3] = (arg[0] & 2) != 0;
-        is_variable[4] = (arg[0] & 4) != 0;
-        is_variable[5] = (arg[0] & 8) != 0;
+        is_variable[2] = (arg[1] & 1) != 0;
+        is_variable[3] = (arg[1] & 2) != 0;
+        is_variable[4] = (arg[1] & 4) != 0;
+        is_variable[5] = (arg[1] & 8) != 0;
         break;
 
         // -------------------------------------------------------------------
@@ -0,0 +1,341 @@
+# ifndef CPPAD_LOCAL_OPTIMIZE_FOLD_DYN_HPP
+# define CPPAD_LOCAL_OPTIMIZE_FOLD_DYN_HPP
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-22 Bradley M. Bell
+
+CppAD is distributed under the terms of the
+             Eclipse Public License Version 2.0.
+
+This Source Code may also be made available under the following
+Secondary License when the conditions for such availability set forth
+in the Eclipse Public License, Version 2.0 are satisfied:
+      GNU General Public License, Version 2.0 or later.
+---------------------------------------------------------------------------- */
+/*!
+\file fold_dyn.hpp
+Simplify a dynamic parameter operator using its constant arguments.
+*/
+# include <cppad/local/op_code_dyn.hpp>
+# include <cppad/core/discrete/discrete.hpp>
+
+// BEGIN_CPPAD_LOCAL_OPTIMIZE_NAMESPACE
+namespace CppAD { namespace local { namespace optimize {
+
+enum enum_fold_dyn {
+    /// This operator cannot be simplified.
+    no_fold_dyn,
+
+    /// The result of this operator is the constant fold_value.
+    con_fold_dyn,
+
+    /// The result of this operator is equal to the parameter fold_par.
+    par_fold_dyn
+};
+
+/*!
+Determine if a dynamic parameter operator can be replaced by a constant,
+or by one of its arguments.
+
+\tparam Base
+base type for the operator; i.e., this operation was recorded
+using AD< Base > and computations by this routine are done using type
+ Base.
+
+\param op
+is the operator for this dynamic parameter. It is not
+ind_dyn, atom_dyn, or result_dyn.
+
+\param arg
+is the arguments for this operator in the old recording;
+i.e., arg[j] for j = num_non_par_arg_dyn(op), ... , num_arg_dyn(op)-1
+are old parameter indices.
+
+\param new_par
+is the mapping from old parameter indices to new parameter indices.
+It is only used to check if two arguments are the same in the new recording
+and is only defined for the parameter arguments for this operator.
+
+\param con_par
+The j-th element is true (false) if the old parameter with index j
+is (is not) a constant in the new recording. This is true for constant
+parameters and dynamic parameters that have been folded into constants.
+It is only defined for the parameter arguments for this operator.
+
+\param con_value
+If con_par[j] is true, con_value[j] is the value for the
+old parameter with index j.
+
+\param fold_par
+If the return value is par_fold_dyn, fold_par is set to the old parameter
+index for the argument that can be used in place of this operator.
+Otherwise it is not modified.
+
+\param fold_value
+If the return value is con_fold_dyn, fold_value is set to the constant
+value that can be used in place of this operator.
+Otherwise it is not modified.
+
+\return
+is no_fold_dyn, con_fold_dyn, or par_fold_dyn; see above.
+
+\par Identities
+The identities used to replace an operator by one of its arguments
+are the same as those used when recording variables; e.g.,
+p * 1 = p, p + 0 = p, p - 0 = p, p / 1 = p, azmul(0, p) = 0.
+A conditional expression is replaced by one of its cases if
+the left and right operands are constants,
+or if the true and false cases are the same.
+*/
+template <class Base>
+enum_fold_dyn fold_dyn(
+    op_code_dyn                 op         ,
+    const addr_t*               arg        ,
+    const pod_vector<addr_t>&   new_par    ,
+    const pod_vector<bool>&     con_par    ,
+    const vector<Base>&         con_value  ,
+    addr_t&                     fold_par   ,
+    Base&                       fold_value )
+{   CPPAD_ASSERT_UNKNOWN( op != ind_dyn );
+    CPPAD_ASSERT_UNKNOWN( op != atom_dyn );
+    CPPAD_ASSERT_UNKNOWN( op != result_dyn );
+    //
+    // number of arguments and offset for first parameter argument
+    size_t n_arg  = num_arg_dyn(op);
+    size_t offset = num_non_par_arg_dyn(op);
+    CPPAD_ASSERT_UNKNOWN( 0 < n_arg && n_arg <= 5 );
+    //
+    // check if all the parameter arguments are constants
+    bool all_con = true;
+    for(size_t j = offset; j < n_arg; ++j)
+        all_con &= con_par[ arg[j] ];
+    //
+    // x: value of the arguments when they are constants
+    Base x[5];
+    for(size_t j = offset; j < n_arg; ++j)
+    {   if( con_par[ arg[j] ] )
+            x[j] = con_value[ arg[j] ];
+    }
+    //
+    if( all_con ) switch( op )
+    {
+        // ------------------------------------------------------------------
+        // unary operators
+        case abs_dyn:
+        fold_value = fabs( x[0] );
+        return con_fold_dyn;
+
+        case acos_dyn:
+        fold_value = acos( x[0] );
+        return con_fold_dyn;
+
+        case acosh_dyn:
+        fold_value = acosh( x[0] );
+        return con_fold_dyn;
+
+        case asin_dyn:
+        fold_value = asin( x[0] );
+        return con_fold_dyn;
+
+        case asinh_dyn:
+        fold_value = asinh( x[0] );
+        return con_fold_dyn;
+
+        case atan_dyn:
+        fold_value = atan( x[0] );
+        return con_fold_dyn;
+
+        case atanh_dyn:
+        fold_value = atanh( x[0] );
+        return con_fold_dyn;
+
+        case cos_dyn:
+        fold_value = cos( x[0] );
+        return con_fold_dyn;
+
+        case cosh_dyn:
+        fold_value = cosh( x[0] );
+        return con_fold_dyn;
+
+        case erf_dyn:
+        fold_value = erf( x[0] );
+        return con_fold_dyn;
+
+        case erfc_dyn:
+        fold_value = erfc( x[0] );
+        return con_fold_dyn;
+
+        case exp_dyn:
+        fold_value = exp( x[0] );
+        return con_fold_dyn;
+
+        case expm1_dyn:
+        fold_value = expm1( x[0] );
+        return con_fold_dyn;
+
+        case fabs_dyn:
+        fold_value = fabs( x[0] );
+        return con_fold_dyn;
+
+        case log_dyn:
+        fold_value = log( x[0] );
+        return con_fold_dyn;
+
+        case log1p_dyn:
+        fold_value = log1p( x[0] );
+        return con_fold_dyn;
+
+        case neg_dyn:
+        fold_value = - x[0];
+        return con_fold_dyn;
+
+        case sign_dyn:
+        fold_value = sign( x[0] );
+        return con_fold_dyn;
+
+        case sin_dyn:
+        fold_value = sin( x[0] );
+        return con_fold_dyn;
+
+        case sinh_dyn:
+        fold_value = sinh( x[0] );
+        return con_fold_dyn;
+
+        case sqrt_dyn:
+        fold_value = sqrt( x[0] );
+        return con_fold_dyn;
+
+        case tan_dyn:
+        fold_value = tan( x[0] );
+        return con_fold_dyn;
+
+        case tanh_dyn:
+        fold_value = tanh( x[0] );
+        return con_fold_dyn;
+
+        // ------------------------------------------------------------------
+        // binary operators
+        case add_dyn:
+        fold_value = x[0] + x[1];
+        return con_fold_dyn;
+
+        case div_dyn:
+        fold_value = x[0] / x[1];
+        return con_fold_dyn;
+
+        case mul_dyn:
+        fold_value = x[0] * x[1];
+        return con_fold_dyn;
+
+        case pow_dyn:
+        fold_value = pow( x[0], x[1] );
+        return con_fold_dyn;
+
+        case sub_dyn:
+        fold_value = x[0] - x[1];
+        return con_fold_dyn;
+
+        case zmul_dyn:
+        fold_value = azmul( x[0], x[1] );
+        return con_fold_dyn;
+
+        // ------------------------------------------------------------------
+        // discrete(index, argument)
+        case dis_dyn:
+        fold_value = discrete<Base>::eval( size_t(arg[0]), x[1] );
+        return con_fold_dyn;
+
+        // ------------------------------------------------------------------
+        // cond_exp(cop, left, right, if_true, if_false)
+        case cond_exp_dyn:
+        fold_value = CondExpOp(
+            CompareOp( arg[0] ), x[1], x[2], x[3], x[4]
+        );
+        return con_fold_dyn;
+
+        // ------------------------------------------------------------------
+        default:
+        CPPAD_ASSERT_UNKNOWN(false);
+        break;
+    }
+    //
+    // some of the arguments are dynamic parameters
+    switch( op )
+    {
+        // p + 0 = 0 + p = p
+        case add_dyn:
+        if( con_par[ arg[0] ] && IdenticalZero( x[0] ) )
+        {   fold_par = arg[1];
+            return par_fold_dyn;
+        }
+        if( con_par[ arg[1] ] && IdenticalZero( x[1] ) )
+        {   fold_par = arg[0];
+            return par_fold_dyn;
+        }
+        break;
+
+        // p - 0 = p
+        case sub_dyn:
+        if( con_par[ arg[1] ] && IdenticalZero( x[1] ) )
+        {   fold_par = arg[0];
+            return par_fold_dyn;
+        }
+        break;
+
+        // p * 1 = 1 * p = p
+        case mul_dyn:
+        if( con_par[ arg[0] ] && IdenticalOne( x[0] ) )
+        {   fold_par = arg[1];
+            return par_fold_dyn;
+        }
+        if( con_par[ arg[1] ] && IdenticalOne( x[1] ) )
+        {   fold_par = arg[0];
+            return par_fold_dyn;
+        }
+        break;
+
+        // p / 1 = p
+        case div_dyn:
+        if( con_par[ arg[1] ] && IdenticalOne( x[1] ) )
+        {   fold_par = arg[0];
+            return par_fold_dyn;
+        }
+        break;
+
+        // azmul(0, p) = 0
+        case zmul_dyn:
+        if( con_par[ arg[0] ] && IdenticalZero( x[0] ) )
+        {   fold_par = arg[0];
+            return par_fold_dyn;
+        }
+        break;
+
+        // cond_exp(cop, left, right, if_true, if_false)
+        case cond_exp_dyn:
+        if( new_par[ arg[3] ] == new_par[ arg[4] ] )
+        {   fold_par = arg[3];
+            return par_fold_dyn;
+        }
+        if( con_par[ arg[1] ] && con_par[ arg[2] ] )
+        {   Base flag = CondExpOp(
+                CompareOp( arg[0] ), x[1], x[2], Base(1), Base(0)
+            );
+            if( IdenticalOne(flag) )
+            {   fold_par = arg[3];
+                return par_fold_dyn;
+            }
+            if( IdenticalZero(flag) )
+            {   fold_par = arg[4];
+                return par_fold_dyn;
+            }
+        }
+        break;
+
+        default:
+        break;
+    }
+    return no_fold_dyn;
+}
+
+} } } // END_CPPAD_LOCAL_OPTIMIZE_NAMESPACE
+
+# endif
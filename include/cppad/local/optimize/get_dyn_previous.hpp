@@ -37,6 +37,10 @@ is the mapping from dynamic parameter index to parameter index
 i-th element is true (false) if i-th parameter is (is not) dynamic
 (size is number of parameters).
 
+\param dyn_par_op
+i-th element is the operator for the i-th dynamic parameter
+(size is number of dynamic parameters).
+
 \param dyn_arg_offset
 j-th element is the offset in dyn_par_arg of the first argument for j-th
 dynamic parameter's operator (size is number of dynamic parameters).
@@ -63,12 +67,15 @@ Upn return it containts the parameter indices for the arguments
 to use when matching this operator
 Arguments that are dynamic prarameters, and have previous matches,
 have been replaced by their previous matches.
+The leading arguments that are not parameter indices; e.g.,
+the comparison operator for cond_exp_dyn, are not changed.
 */
 inline void dyn_arg_match(
-    size_t                    i_dyn           ,
-    const pod_vector<addr_t>& dyn_ind2par_ind ,
-    const pod_vector<bool>  & dyn_par_is      ,
-    const pod_vector<addr_t>& dyn_arg_offset  ,
+    size_t                      i_dyn           ,
+    const pod_vector<addr_t>&   dyn_ind2par_ind ,
+    const pod_vector<bool>  &   dyn_par_is      ,
+    const pod_vector<opcode_t>& dyn_par_op      ,
+    const pod_vector<addr_t>&   dyn_arg_offset  ,
     const pod_vector<addr_t>& dyn_par_arg     ,
     const pod_vector<addr_t>& par_ind2dyn_ind ,
     const pod_vector<addr_t>& dyn_previous    ,
@@ -88,8 +95,15 @@ inline void dyn_arg_match(
     // index in dyn_par_arg of first argument for this operator
     addr_t i_arg = dyn_arg_offset[i_dyn];
     //
-    // loop over arguments for this operator
-    for(addr_t j = 0; j < n_arg; ++j)
+    // arguments that are not parameter indices come first
+    op_code_dyn op     = op_code_dyn( dyn_par_op[i_dyn] );
+    addr_t  n_non_par  = addr_t( num_non_par_arg_dyn(op) );
+    CPPAD_ASSERT_UNKNOWN( op != atom_dyn && n_non_par <= n_arg );
+    for(addr_t j = 0; j < n_non_par; ++j)
+        arg_match[j] = dyn_par_arg[i_arg + j];
+    //
+    // loop over parameter arguments for this operator
+    for(addr_t j = n_non_par; j < n_arg; ++j)
     {   // parameter index for this argument
         addr_t j_par = dyn_par_arg[i_arg + j];
         CPPAD_ASSERT_UNKNOWN( j_par < dyn_ind2par_ind[i_dyn] );
@@ -177,6 +191,11 @@ void get_dyn_previous(
     // mapping from dynamic parameter index to first argument index
     pod_vector<addr_t> dyn_arg_offset(num_dynamic_par);
 
+    // arguments used to match each dynamic parameter operator; i.e.,
+    // same as dyn_par_arg with dynamic parameter arguments replaced by
+    // their previous matches (only defined for operators that are hashed)
+    pod_vector<addr_t> dyn_match_arg( dyn_par_arg.size() );
+
     // ----------------------------------------------------------------------
     // compute dyn_previous
     // ----------------------------------------------------------------------
@@ -266,12 +285,15 @@ void get_dyn_previous(
                     i_dyn,
                     dyn_ind2par_ind,
                     dyn_par_is,
+                    dyn_par_op,
                     dyn_arg_offset,
                     dyn_par_arg,
                     par_ind2dyn_ind,
                     dyn_previous,
                     arg_match
                 );
+                for(size_t j = 0; j < num_arg; ++j)
+                    dyn_match_arg[i_arg + j] = arg_match[j];
                 opcode_t op_t  = opcode_t(op);
                 code           = optimize_hash_code(
                     op_t, num_arg, arg_match.data()
@@ -294,7 +316,7 @@ void get_dyn_previous(
                     addr_t k_arg   = dyn_arg_offset[k_dyn];
                     //
                     match  = op_t == dyn_par_op[k_dyn];
-                    match &= arg_match[0] == dyn_par_arg[k_arg + 0];
+                    match &= arg_match[0] == dyn_match_arg[k_arg + 0];
                     if( ! match )
                         ++itr;
                 }
@@ -334,12 +356,15 @@ void get_dyn_previous(
                     i_dyn,
                     dyn_ind2par_ind,
                     dyn_par_is,
+                    dyn_par_op,
                     dyn_arg_offset,
-                    dyn_par_arg   ,
+                    dyn_par_arg,
                     par_ind2dyn_ind,
                     dyn_previous,
                     arg_match
                 );
+                for(size_t j = 0; j < num_arg; ++j)
+                    dyn_match_arg[i_arg + j] = arg_match[j];
                 opcode_t op_t  = opcode_t(op);
                 code           = optimize_hash_code(
                     op_t, num_arg, arg_match.data()
@@ -361,8 +386,8 @@ void get_dyn_previous(
                     addr_t k_arg   = dyn_arg_offset[k_dyn];
                     //
                     match  = op_t == dyn_par_op[k_dyn];
-                    match &= arg_match[0] == dyn_par_arg[k_arg + 0];
-                    match &= arg_match[1] == dyn_par_arg[k_arg + 1];
+                    match &= arg_match[0] == dyn_match_arg[k_arg + 0];
+                    match &= arg_match[1] == dyn_match_arg[k_arg + 1];
                     if( ! match )
                         ++itr;
                 }
@@ -394,8 +419,8 @@ void get_dyn_previous(
                     addr_t k_arg   = dyn_arg_offset[k_dyn];
                     //
                     match  = op_t == dyn_par_op[k_dyn];
-                    match &= arg_match[0] == dyn_par_arg[k_arg + 0];
-                    match &= arg_match[1] == dyn_par_arg[k_arg + 1];
+                    match &= arg_match[0] == dyn_match_arg[k_arg + 0];
+                    match &= arg_match[1] == dyn_match_arg[k_arg + 1];
                     if( ! match )
                         ++itr;
                 }
@@ -416,11 +441,77 @@ void get_dyn_previous(
                 // this code before adding another element for this code.
                 hash_table_dyn.add_element(code, i_dyn);
             }
+            break;
 
-            // --------------------------------------------------------------
-            // skipping these cases for now
+            // ---------------------------------------------------------------
+            // operators that have a non-parameter first argument
             case dis_dyn:
             case cond_exp_dyn:
+            CPPAD_ASSERT_UNKNOWN( num_non_par_arg_dyn(op) == 1 );
+            CPPAD_ASSERT_UNKNOWN( dyn_par_is[i_par] );
+            {   size_t num_arg = num_arg_dyn(op);
+                arg_match.resize(num_arg);
+                dyn_arg_match(
+                    i_dyn,
+                    dyn_ind2par_ind,
+                    dyn_par_is,
+                    dyn_par_op,
+                    dyn_arg_offset,
+                    dyn_par_arg,
+                    par_ind2dyn_ind,
+                    dyn_previous,
+                    arg_match
+                );
+                for(size_t j = 0; j < num_arg; ++j)
+                    dyn_match_arg[i_arg + j] = arg_match[j];
+                opcode_t op_t  = opcode_t(op);
+                code           = optimize_hash_code(
+                    op_t, num_arg, arg_match.data()
+                );
+                //
+                // iterator for the set with this hash code
+                sparse::list_setvec_const_iterator itr(hash_table_dyn, code);
+                //
+                // check for a match
+                count = 0;
+                match = false;
+                while( ! match && *itr != num_dynamic_par )
+                {   ++count;
+                    //
+                    // candidate for current dynamic parameter
+                    size_t  k_dyn  = *itr;
+                    CPPAD_ASSERT_UNKNOWN( k_dyn < i_dyn );
+                    //
+                    // argument offset for the candidate
+                    addr_t k_arg   = dyn_arg_offset[k_dyn];
+                    //
+                    // the discrete function index, or the comparison
+                    // operator, is compared the same as the other arguments
+                    match  = op_t == dyn_par_op[k_dyn];
+                    for(size_t j = 0; j < num_arg; ++j)
+                        match &= arg_match[j] == dyn_match_arg[k_arg + j];
+                    if( ! match )
+                        ++itr;
+                }
+                if( match )
+                {   size_t  k_dyn  = *itr;
+                    CPPAD_ASSERT_UNKNOWN( k_dyn < i_dyn );
+                    dyn_previous[i_dyn] = addr_t( k_dyn );
+                }
+                else
+                {   CPPAD_ASSERT_UNKNOWN( count < 11 );
+                    if( count == 10 )
+                    {   // restart list for this hash code
+                        hash_table_dyn.clear(code);
+                    }
+                    // Add this entry to hash table.
+                    hash_table_dyn.add_element(code, i_dyn);
+                }
+            }
+            break;
+
+            // --------------------------------------------------------------
+            // skipping these cases for now
             case atom_dyn:
             case result_dyn:
             break;
@@ -0,0 +1,354 @@
+# ifndef CPPAD_LOCAL_OPTIMIZE_GET_VAR_SLOT_HPP
+# define CPPAD_LOCAL_OPTIMIZE_GET_VAR_SLOT_HPP
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-22 Bradley M. Bell
+
+CppAD is distributed under the terms of the
+             Eclipse Public License Version 2.0.
+
+This Source Code may also be made available under the following
+Secondary License when the conditions for such availability set forth
+in the Eclipse Public License, Version 2.0 are satisfied:
+      GNU General Public License, Version 2.0 or later.
+---------------------------------------------------------------------------- */
+# include <set>
+# include <cppad/local/play/player.hpp>
+
+// BEGIN_CPPAD_LOCAL_OPTIMIZE_NAMESPACE
+namespace CppAD { namespace local { namespace optimize {
+/*
+$begin optimize_get_var_slot$$
+$spell
+    num
+    op
+    arg
+    dep
+    taddr
+    Taylor
+    Ld
+    CSum
+    CSkip
+    Funrv
+    AFun
+    Stpv
+    Stvv
+    Inv
+    VecAD
+$$
+
+$section Map Variables to Reusable Zero Order Taylor Coefficient Slots$$
+
+$head Syntax$$
+$icode%num_slot% = get_var_slot(
+    %play%, %dep_taddr%, %slot_op%, %slot_arg%, %slot_dep%
+)%$$
+
+$head Prototype$$
+$srcthisfile%
+    0%// BEGIN_PROTOTYPE%// END_PROTOTYPE%1
+%$$
+
+$head Purpose$$
+Most variables on a tape are only used by a few operators that come
+soon after the operator that creates them.
+This routine computes the live range for each variable; i.e.,
+from the operator that creates it to the last operator that uses it.
+It then maps the variables onto a set of slots where a slot is reused
+once the live ranges of all the variables that were in it have ended.
+This is done by a linear scan of the operation sequence.
+The result can only be used for zero order forward mode because the
+variable values are overwritten once they are no longer needed.
+
+$head Base$$
+base type for the operator; i.e., this operation was recorded
+using AD<Base> and computations by this routine are done using type Base.
+
+$head play$$
+is the operation sequence.
+
+$head dep_taddr$$
+is the variable index for each of the dependent variables.
+The live range for these variables extends to the end of the tape.
+
+$head slot_op$$
+The input size of this vector does not matter.
+Upon return it has size $icode%play%->num_op_rec()%$$.
+If the $th i$$ operator has a result,
+$icode%slot_op%[%i%]%$$ is the slot for its primary (last) result.
+The other results for the operator are in the slots directly before
+the primary result.
+If the operator does not have a result,
+$icode%slot_op%[%i%]%$$ is $icode%num_slot%-1%$$.
+
+$head slot_arg$$
+The input size of this vector does not matter.
+Upon return it has size $icode%play%->num_op_arg_rec()%$$.
+It is the same as the argument vector for the operation sequence
+except that variable indices have been replaced by the corresponding
+slot indices.
+
+$head slot_dep$$
+The input size of this vector does not matter.
+Upon return it has the same size as $icode dep_taddr$$ and
+$icode%slot_dep%[%i%]%$$ is the slot for the $th i$$ dependent variable.
+
+$head num_slot$$
+is the number of slots; i.e.,
+the number of zero order Taylor coefficients that are required.
+
+$head Assumptions$$
+$list number$$
+The slot for the BeginOp result is zero
+and no other variable is mapped to slot zero.
+$lnext
+The slot for each independent variable is equal to its variable index;
+i.e., the $code InvOp$$ results are in slots one through $icode n$$.
+$lnext
+An operator's result slots are never equal to the slots for its arguments.
+$lnext
+The $code CSumOp$$ result slot is greater than its argument slots,
+and the $code LdpOp$$, $code LdvOp$$ results always get a new slot.
+This agrees with the assumptions made by the corresponding operator
+routines.
+$lnext
+The values stored in a VecAD vector by $code StpvOp$$ and $code StvvOp$$
+are live until the end of the tape.
+$lnext
+The $code FunrvOp$$ results for an atomic function call
+are live at least until the $code AFunOp$$ at the end of the call
+(where their values get set).
+$lend
+
+$end
+*/
+
+// BEGIN_PROTOTYPE
+template <class Base>
+size_t get_var_slot(
+    const player<Base>*          play      ,
+    const pod_vector<size_t>&    dep_taddr ,
+    pod_vector<addr_t>&          slot_op   ,
+    pod_vector<addr_t>&          slot_arg  ,
+    pod_vector<size_t>&          slot_dep  )
+// END_PROTOTYPE
+{   //
+    // number of operators, variables, and arguments in the tape
+    const size_t num_op  = play->num_op_rec();
+    const size_t num_var = play->num_var_rec();
+    const size_t num_arg = play->num_op_arg_rec();
+    //
+    // last use for variables that are live until the end of the tape
+    const size_t end_of_tape = num_op;
+    //
+    // work space used by arg_is_variable
+    pod_vector<bool> is_variable;
+    //
+    // information for current operator
+    OpCode        op;
+    const addr_t* arg;
+    size_t        i_var;
+    // -----------------------------------------------------------------------
+    // last_use
+    // index of the last operator that uses each variable
+    pod_vector<size_t> last_use(num_var);
+    for(size_t j_var = 0; j_var < num_var; ++j_var)
+        last_use[j_var] = 0;
+    last_use[0] = end_of_tape;
+    for(size_t i = 0; i < dep_taddr.size(); ++i)
+        last_use[ dep_taddr[i] ] = end_of_tape;
+    //
+    // variable results for the current atomic function call
+    pod_vector<size_t> atom_res;
+    bool in_atom = false;
+    //
+    play::const_sequential_iterator itr = play->begin();
+    itr.op_info(op, arg, i_var);
+    CPPAD_ASSERT_UNKNOWN( op == BeginOp );
+    bool more_operators = true;
+    while( more_operators )
+    {   (++itr).op_info(op, arg, i_var);
+        size_t i_op = itr.op_index();
+        switch( op )
+        {   case EndOp:
+            more_operators = false;
+            break;
+
+            case AFunOp:
+            if( in_atom )
+            {   // results get set by the AFunOp at the end of the call
+                for(size_t k = 0; k < atom_res.size(); ++k)
+                {   if( last_use[ atom_res[k] ] < i_op )
+                        last_use[ atom_res[k] ] = i_op;
+                }
+            }
+            atom_res.resize(0);
+            in_atom = ! in_atom;
+            break;
+
+            case FunrvOp:
+            atom_res.push_back(i_var);
+            break;
+
+            case StpvOp:
+            case StvvOp:
+            // the load operators get the value from this variable
+            last_use[ arg[2] ] = end_of_tape;
+            break;
+
+            default:
+            break;
+        }
+        arg_is_variable(op, arg, is_variable);
+        for(size_t j = 0; j < is_variable.size(); ++j)
+        {   if( is_variable[j] )
+            {   size_t j_var = size_t( arg[j] );
+                if( last_use[j_var] < i_op )
+                    last_use[j_var] = i_op;
+            }
+        }
+        if( op == CSumOp || op == CSkipOp )
+            itr.correct_before_increment();
+    }
+    // -----------------------------------------------------------------------
+    // maximum number of results for any operator
+    size_t max_num_res = 0;
+    for(size_t i = 0; i < size_t(NumberOp); ++i)
+        max_num_res = std::max(max_num_res, NumRes( OpCode(i) ) );
+    //
+    // slot for each variable
+    pod_vector<addr_t> var2slot(num_var);
+    //
+    // free single slots (ordered so can search for slot above an argument)
+    std::set<addr_t> free_one;
+    //
+    // free_block[k]: first slot for free blocks of k contiguous slots
+    vector< pod_vector<addr_t> > free_block(max_num_res + 1);
+    //
+    // first_dead[i], next_dead[j]:
+    // linked list of operators whose results are no longer needed after
+    // the i-th operator. Zero (the BeginOp) is used to terminate the lists
+    // because its result is never free.
+    pod_vector<addr_t> first_dead(num_op);
+    pod_vector<addr_t> next_dead(num_op);
+    for(size_t i = 0; i < num_op; ++i)
+    {   first_dead[i] = 0;
+        next_dead[i]  = 0;
+    }
+    //
+    slot_op.resize(num_op);
+    slot_arg.resize(num_arg);
+    //
+    // BeginOp
+    itr = play->begin();
+    itr.op_info(op, arg, i_var);
+    const addr_t* arg_0 = arg;
+    CPPAD_ASSERT_NARG_NRES(op, 1, 1);
+    var2slot[0] = 0;
+    slot_op[0]  = 0;
+    slot_arg[0] = arg[0];
+    size_t num_slot = 1;
+    //
+    more_operators = true;
+    while( more_operators )
+    {   (++itr).op_info(op, arg, i_var);
+        size_t i_op = itr.op_index();
+        more_operators = op != EndOp;
+        //
+        // is_variable
+        arg_is_variable(op, arg, is_variable);
+        //
+        // result slots
+        size_t n_res = NumRes(op);
+        if( n_res > 0 )
+        {   size_t start = num_slot;
+            if( op == CSumOp )
+            {   size_t max_arg_slot = 0;
+                for(size_t j = 0; j < is_variable.size(); ++j)
+                {   if( is_variable[j] ) max_arg_slot = std::max(
+                        max_arg_slot, size_t( var2slot[ arg[j] ] )
+                    );
+                }
+                std::set<addr_t>::iterator itr_one =
+                    free_one.upper_bound( addr_t(max_arg_slot) );
+                if( itr_one != free_one.end() )
+                {   start = size_t( *itr_one );
+                    free_one.erase(itr_one);
+                }
+            }
+            else if( op != InvOp && op != LdpOp && op != LdvOp )
+            {   if( n_res == 1 && ! free_one.empty() )
+                {   start = size_t( *free_one.begin() );
+                    free_one.erase( free_one.begin() );
+                }
+                else if( n_res > 1 && free_block[n_res].size() > 0 )
+                {   size_t n_free = free_block[n_res].size();
+                    start = size_t( free_block[n_res][n_free - 1] );
+                    free_block[n_res].resize(n_free - 1);
+                }
+            }
+            if( start == num_slot )
+                num_slot += n_res;
+            //
+            // end of the live range for the results of this operator
+            size_t dead = i_op;
+            for(size_t k = 0; k < n_res; ++k)
+            {   size_t j_var   = i_var + 1 - n_res + k;
+                var2slot[j_var] = addr_t( start + k );
+                dead           = std::max(dead, last_use[j_var]);
+            }
+            slot_op[i_op] = addr_t( start + n_res - 1 );
+            CPPAD_ASSERT_UNKNOWN(
+                op != InvOp || size_t( var2slot[i_var] ) == i_var
+            );
+            if( dead < end_of_tape )
+            {   next_dead[i_op]  = first_dead[dead];
+                first_dead[dead] = addr_t( i_op );
+            }
+        }
+        //
+        // argument slots
+        size_t n_arg  = is_variable.size();
+        if( op == CSumOp )
+            ++n_arg; // last argument is a repeat of arg[4]
+        size_t offset = size_t(arg - arg_0);
+        CPPAD_ASSERT_UNKNOWN( offset + n_arg <= num_arg );
+        for(size_t j = 0; j < n_arg; ++j)
+        {   if( j < is_variable.size() && is_variable[j] )
+                slot_arg[offset + j] = var2slot[ arg[j] ];
+            else
+                slot_arg[offset + j] = arg[j];
+        }
+        if( op == CSumOp || op == CSkipOp )
+            itr.correct_before_increment();
+        //
+        // free the slots for results that are no longer needed
+        size_t j_op = size_t( first_dead[i_op] );
+        while( j_op != 0 )
+        {   size_t n_free = NumRes( play->GetOp(j_op) );
+            size_t last   = size_t( slot_op[j_op] );
+            if( n_free == 1 )
+                free_one.insert( addr_t(last) );
+            else
+                free_block[n_free].push_back( addr_t(last + 1 - n_free) );
+            j_op = size_t( next_dead[j_op] );
+        }
+    }
+    CPPAD_ASSERT_UNKNOWN( num_slot <= num_var );
+    //
+    // slot_op for operators that do not have results
+    for(size_t i_op = 0; i_op < num_op; ++i_op)
+    {   if( NumRes( play->GetOp(i_op) ) == 0 )
+            slot_op[i_op] = addr_t( num_slot - 1 );
+    }
+    //
+    // slot_dep
+    slot_dep.resize( dep_taddr.size() );
+    for(size_t i = 0; i < dep_taddr.size(); ++i)
+        slot_dep[i] = size_t( var2slot[ dep_taddr[i] ] );
+    //
+    return num_slot;
+}
+
+} } } // END_CPPAD_LOCAL_OPTIMIZE_NAMESPACE
+
+# endif
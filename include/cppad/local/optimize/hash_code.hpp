@@ -41,11 +41,11 @@ inline size_t optimize_hash_code(
     opcode_t      op      ,
     size_t        num_arg ,
     const addr_t* arg     )
-{   CPPAD_ASSERT_UNKNOWN( num_arg < 4 );
+{   CPPAD_ASSERT_UNKNOWN( num_arg < 6 );
     size_t prime = 1;
     size_t sum   = prime * size_t(op);
     for(size_t i = 0; i < num_arg; i++)
-    {   prime    = prime + 2;  // 3, 5, 7 in that order
+    {   prime    = prime + 2;  // 3, 5, 7, 9, 11 in that order
         sum += prime * size_t(arg[i]);
     }
     //
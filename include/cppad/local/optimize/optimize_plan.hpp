@@ -0,0 +1,213 @@
+# ifndef CPPAD_LOCAL_OPTIMIZE_OPTIMIZE_PLAN_HPP
+# define CPPAD_LOCAL_OPTIMIZE_OPTIMIZE_PLAN_HPP
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-22 Bradley M. Bell
+
+CppAD is distributed under the terms of the
+             Eclipse Public License Version 2.0.
+
+This Source Code may also be made available under the following
+Secondary License when the conditions for such availability set forth
+in the Eclipse Public License, Version 2.0 are satisfied:
+      GNU General Public License, Version 2.0 or later.
+---------------------------------------------------------------------------- */
+# include <cppad/local/play/player.hpp>
+# include <cppad/local/sparse/list_setvec.hpp>
+# include <cppad/local/optimize/usage.hpp>
+# include <cppad/local/optimize/cexp_info.hpp>
+
+// BEGIN_CPPAD_LOCAL_OPTIMIZE_NAMESPACE
+namespace CppAD { namespace local { namespace optimize {
+/*
+$begin optimize_plan$$
+$spell
+    bool
+    const
+    dep
+    taddr
+    cexp
+    vecad
+    dyn
+    op
+    cskip
+    struct
+    setvec
+$$
+
+$section Decisions Made by the Optimizer for an Operation Sequence$$
+
+$head Syntax$$
+$codei%optimize_plan<%Base%> %plan%
+%$$
+$icode%plan%.clear()
+%$$
+$icode%plan%.swap(%other%)
+%$$
+$icode%plan% = %other%
+%$$
+$icode%match% = %plan%.match(%key%, %dep_taddr%, %play%)
+%$$
+
+$head Purpose$$
+The analysis done by $cref optimize_run$$ (which operators are used,
+which operators can be replaced by previous operators,
+and the conditional skip information) only depends on the structure
+of the operation sequence; i.e., the operators, their arguments,
+and which parameters are dynamic.
+It does not depend on the value of the parameters.
+(Calls to atomic functions are an exception because their dependency
+calculations get the value of the parameters.)
+This class saves the result of the analysis together with a copy of
+the operation sequence so that it can be used for another
+operation sequence that has the same structure.
+
+$head Key$$
+The following members identify the operation sequence and options
+that the plan corresponds to:
+$srcthisfile%0%// BEGIN_KEY%// END_KEY%1%$$
+
+$subhead valid$$
+is this plan valid; i.e., has it been computed.
+If it is false, none of the other members are defined.
+
+$subhead key$$
+is the options that affect the analysis; e.g.,
+$code no_conditional_skip$$, and the collision limit.
+It is created by $code optimize_run$$ and its contents are not specified.
+
+$subhead hash_code$$
+is $icode%play%.structure_hash()%$$ for the operation sequence.
+
+$subhead dep_taddr$$
+is the variable index for each dependent variable
+in the operation sequence (before optimization).
+
+$subhead play$$
+is a copy of the operation sequence (before optimization).
+
+$head Decisions$$
+The following members are the results of the analysis:
+$srcthisfile%0%// BEGIN_DECISION%// END_DECISION%1%$$
+See $cref optimize_get_op_usage$$, $cref optimize_get_op_previous$$,
+$cref optimize_get_cexp_info.hpp$$, $cref optimize_get_par_usage$$,
+and $code get_dyn_previous$$ for the meaning of each of these values.
+
+$head clear$$
+This sets $icode valid$$ to false and frees the memory used by the plan.
+
+$head swap$$
+Exchanges the contents of $icode plan$$ and $icode other$$.
+
+$head Assignment$$
+Copies the contents of $icode other$$ to $icode plan$$.
+
+$head match$$
+The return value $icode match$$ is true if $icode plan$$ is valid
+and it can be used for the operation sequence $icode play$$,
+the dependent variables $icode dep_taddr$$, and the options in $icode key$$.
+
+$end
+*/
+template <class Base>
+class optimize_plan {
+public:
+    // BEGIN_KEY
+    bool                       valid;
+    std::string                key;
+    size_t                     hash_code;
+    pod_vector<size_t>         dep_taddr;
+    player<Base>               play;
+    // END_KEY
+    //
+    // BEGIN_DECISION
+    bool                       exceed_collision_limit;
+    pod_vector<usage_t>        op_usage;
+    pod_vector<addr_t>         op_previous;
+    pod_vector<bool>           vecad_used;
+    vector<struct_cexp_info>   cexp_info;
+    sparse::list_setvec        skip_op_true;
+    sparse::list_setvec        skip_op_false;
+    pod_vector<bool>           par_usage;
+    pod_vector<addr_t>         dyn_previous;
+    // END_DECISION
+    //
+    /// default constructor
+    optimize_plan(void)
+    : valid(false), hash_code(0), exceed_collision_limit(false)
+    { }
+    /// free all the memory used by this plan
+    void clear(void)
+    {   valid     = false;
+        key       = "";
+        hash_code = 0;
+        dep_taddr.clear();
+        player<Base> empty;
+        play.swap(empty);
+        exceed_collision_limit = false;
+        op_usage.clear();
+        op_previous.clear();
+        vecad_used.clear();
+        cexp_info.clear();
+        skip_op_true.resize(0, 0);
+        skip_op_false.resize(0, 0);
+        par_usage.clear();
+        dyn_previous.clear();
+    }
+    /// exchange the contents of this plan with another plan
+    void swap(optimize_plan& other)
+    {   std::swap(valid, other.valid);
+        key.swap(other.key);
+        std::swap(hash_code, other.hash_code);
+        dep_taddr.swap(other.dep_taddr);
+        play.swap(other.play);
+        std::swap(exceed_collision_limit, other.exceed_collision_limit);
+        op_usage.swap(other.op_usage);
+        op_previous.swap(other.op_previous);
+        vecad_used.swap(other.vecad_used);
+        cexp_info.swap(other.cexp_info);
+        skip_op_true.swap(other.skip_op_true);
+        skip_op_false.swap(other.skip_op_false);
+        par_usage.swap(other.par_usage);
+        dyn_previous.swap(other.dyn_previous);
+    }
+    /// copy another plan to this plan
+    void operator=(const optimize_plan& other)
+    {   valid                  = other.valid;
+        key                    = other.key;
+        hash_code              = other.hash_code;
+        dep_taddr              = other.dep_taddr;
+        play                   = other.play;
+        exceed_collision_limit = other.exceed_collision_limit;
+        op_usage               = other.op_usage;
+        op_previous            = other.op_previous;
+        vecad_used             = other.vecad_used;
+        cexp_info              = other.cexp_info;
+        skip_op_true           = other.skip_op_true;
+        skip_op_false          = other.skip_op_false;
+        par_usage              = other.par_usage;
+        dyn_previous           = other.dyn_previous;
+    }
+    /// can this plan be used for the specified operation sequence
+    bool match(
+        const std::string&         other_key       ,
+        const pod_vector<size_t>&  other_dep_taddr ,
+        const player<Base>*        other_play      ) const
+    {   if( ! valid )
+            return false;
+        if( key != other_key )
+            return false;
+        if( dep_taddr.size() != other_dep_taddr.size() )
+            return false;
+        for(size_t i = 0; i < dep_taddr.size(); ++i)
+        {   if( dep_taddr[i] != other_dep_taddr[i] )
+                return false;
+        }
+        if( hash_code != other_play->structure_hash() )
+            return false;
+        return play.same_structure( *other_play );
+    }
+};
+
+} } } // END_CPPAD_LOCAL_OPTIMIZE_NAMESPACE
+
+# endif
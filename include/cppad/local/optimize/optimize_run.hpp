@@ -17,6 +17,8 @@ in the Eclipse Public License, Version 2.0 are satisfied:
 # include <cppad/local/optimize/get_op_usage.hpp>
 # include <cppad/local/optimize/get_par_usage.hpp>
 # include <cppad/local/optimize/get_dyn_previous.hpp>
+# include <cppad/local/optimize/fold_dyn.hpp>
+# include <cppad/local/optimize/optimize_plan.hpp>
 # include <cppad/local/optimize/get_op_previous.hpp>
 # include <cppad/local/optimize/get_cexp_info.hpp>
 # include <cppad/local/optimize/size_pair.hpp>
@@ -26,6 +28,7 @@ in the Eclipse Public License, Version 2.0 are satisfied:
 # include <cppad/local/optimize/record_vp.hpp>
 # include <cppad/local/optimize/record_vv.hpp>
 # include <cppad/local/optimize/record_csum.hpp>
+# include <cppad/core/optimize_report.hpp>
 
 // BEGIN_CPPAD_LOCAL_OPTIMIZE_NAMESPACE
 namespace CppAD { namespace local { namespace optimize  {
@@ -45,7 +48,7 @@ $section Convert a player object to an optimized recorder object $$
 
 $head Syntax$$
 $codei%exceed_collision_limit% = local::optimize::optimize_run(
-    %options%, %n%, %dep_taddr%, %play%, %rec%
+    %options%, %n%, %dep_taddr%, %play%, %rec%, %plan%, %report%
 )%$$
 
 $head Prototype$$
@@ -89,6 +92,22 @@ If this sub-string appears,
 no cumulative sum operations will be generated during the optimization; see
 $cref optimize_cumulative_sum.cpp$$.
 
+$subhead zero_order_only$$
+This option is ignored by $code optimize_run$$; see
+$cref/zero_order_only/optimize/options/zero_order_only/$$.
+
+$subhead cache_plan$$
+This option is ignored by $code optimize_run$$; see
+$cref/cache_plan/optimize/options/cache_plan/$$ and $icode plan$$ below.
+
+$subhead conditional_skip_threshold=value$$
+If this substring appears,
+where $icode value$$ is a sequence of decimal digits,
+a conditional skip operator is only generated if the number of variables
+it can skip, for either the true or false case, is greater than or equal
+$icode value$$.
+The default for $icode value$$ is $code 1$$.
+
 $subhead collision_limit=value$$
 If this substring appears,
 where $icode value$$ is a sequence of decimal digits,
@@ -119,6 +138,24 @@ it corresponds to directly after the default constructor.
 Upon return, it contains an optimized version of the
 operation sequence corresponding to $icode play$$.
 
+$head plan$$
+If $icode plan$$ is the null pointer, it is not used.
+Otherwise, if $icode%plan%->match%$$ is true for the options,
+$icode dep_taddr$$ and $icode play$$,
+the decisions in $icode plan$$ are used instead of analysing $icode play$$.
+If it does not match, the analysis is done and its results are stored
+in $icode plan$$.
+If $icode play$$ contains calls to atomic functions,
+$icode plan$$ is cleared and not used.
+
+$head report$$
+The input value of this $cref optimize_report$$ does not matter.
+Upon return, the time for each phase of the optimizer,
+the number of operators and variables removed by each transformation,
+and the conditional skip information have been set.
+The $icode time_total$$ and size values are not modified
+(they are set by $cref/f.optimize/optimize/$$).
+
 $head exceed_collision_limit$$
 If the $icode collision_limit$$ is exceeded (is not exceeded),
 the return value is true (false).
@@ -130,7 +167,9 @@ $childtable%
     include/cppad/local/optimize/get_par_usage.hpp%
     include/cppad/local/optimize/record_csum.hpp%
     include/cppad/local/optimize/match_op.hpp%
-    include/cppad/local/optimize/get_op_previous.hpp
+    include/cppad/local/optimize/get_op_previous.hpp%
+    include/cppad/local/optimize/get_var_slot.hpp%
+    include/cppad/local/optimize/optimize_plan.hpp
 %$$
 
 $end
@@ -143,9 +182,31 @@ bool optimize_run(
     size_t                                     n          ,
     pod_vector<size_t>&                        dep_taddr  ,
     player<Base>*                              play       ,
-    recorder<Base>*                            rec        )
+    recorder<Base>*                            rec        ,
+    optimize_plan<Base>*                       plan       ,
+    CppAD::optimize_report&                    report     )
 // END_PROTOTYPE
 {   bool exceed_collision_limit = false;
+    //
+    // initialize the values that are set by this routine
+    report.time_op_usage     = 0.0;
+    report.time_op_previous  = 0.0;
+    report.time_cexp_info    = 0.0;
+    report.time_par_usage    = 0.0;
+    report.time_dyn_previous = 0.0;
+    report.time_record       = 0.0;
+    report.used_plan         = false;
+    report.dead_op           = 0;
+    report.dead_var          = 0;
+    report.cse_op            = 0;
+    report.cse_var           = 0;
+    report.csum_op           = 0;
+    report.csum_var          = 0;
+    report.dead_dyn          = 0;
+    report.cse_dyn           = 0;
+    report.fold_dyn          = 0;
+    report.cskip_op          = 0;
+    report.cskip_skip        = 0;
     //
     // check that recorder is empty
     CPPAD_ASSERT_UNKNOWN( rec->num_op_rec() == 0 );
@@ -160,6 +221,7 @@ bool optimize_run(
     bool print_for_op        = true;
     bool cumulative_sum_op   = true;
     size_t collision_limit   = 10;
+    size_t skip_threshold    = 1;
     size_t index = 0;
     while( index < options.size() )
     {   while( index < options.size() && options[index] == ' ' )
@@ -176,6 +238,27 @@ bool optimize_run(
                 print_for_op = false;
             else if( option == "no_cumulative_sum_op" )
                 cumulative_sum_op = false;
+            else if( option == "zero_order_only" )
+            {   // This option is used by ADFun<Base>::optimize
+                // after the optimized recording has been created.
+            }
+            else if( option == "cache_plan" )
+            {   // This option is used by ADFun<Base>::optimize
+                // to determine the plan argument.
+            }
+            else if( option.substr(0, 27) == "conditional_skip_threshold=" )
+            {   std::string value = option.substr(27, option.size());
+                bool value_ok = value.size() > 0;
+                for(size_t i = 0; i < value.size(); ++i)
+                {   value_ok &= '0' <= value[i];
+                    value_ok &= value[i] <= '9';
+                }
+                if( ! value_ok )
+                {   option += " value is not a sequence of decimal digits";
+                    CPPAD_ASSERT_KNOWN( false , option.c_str() );
+                }
+                skip_threshold = size_t( std::atoi( value.c_str() ) );
+            }
             else if( option.substr(0, 16)  == "collision_limit=" )
             {   std::string value = option.substr(16, option.size());
                 bool value_ok = value.size() > 0;
@@ -231,72 +314,182 @@ bool optimize_run(
     // number of dynamic parameters
     CPPAD_ASSERT_UNKNOWN( num_dynamic_ind <= play->num_dynamic_par () );
 
+    // -----------------------------------------------------------------------
+    // plan_key: options that affect the analysis of the operation sequence
+    std::string plan_key;
+    plan_key += conditional_skip  ? '1' : '0';
+    plan_key += compare_op        ? '1' : '0';
+    plan_key += print_for_op      ? '1' : '0';
+    plan_key += cumulative_sum_op ? '1' : '0';
+    plan_key += " " + to_string(collision_limit);
+    //
+    // The dependency calculations for atomic functions use the value
+    // of parameters, so in this case the analysis is not cached.
+    if( plan != nullptr )
+    {   bool atomic = false;
+        for(size_t i_op = 0; i_op < num_op; ++i_op)
+            atomic |= play->GetOp(i_op) == AFunOp;
+        for(size_t i_dyn = 0; i_dyn < num_dynamic_par; ++i_dyn)
+            atomic |= op_code_dyn( play->dyn_par_op()[i_dyn] ) == atom_dyn;
+        if( atomic )
+        {   plan->clear();
+            plan = nullptr;
+        }
+    }
+    //
+    // use_plan: use the cached plan instead of analysing the operation
+    // sequence again
+    bool use_plan = false;
+    if( plan != nullptr )
+        use_plan = plan->match(plan_key, dep_taddr, play);
     // -----------------------------------------------------------------------
     // operator information
     pod_vector<addr_t>        cexp2op;
     sparse::list_setvec       cexp_set;
     pod_vector<bool>          vecad_used;
     pod_vector<usage_t>       op_usage;
-    get_op_usage(
-        conditional_skip,
-        compare_op,
-        print_for_op,
-        cumulative_sum_op,
-        play,
-        random_itr,
-        dep_taddr,
-        cexp2op,
-        cexp_set,
-        vecad_used,
-        op_usage
-    );
     pod_vector<addr_t>        op_previous;
-    exceed_collision_limit |= get_op_previous(
-        collision_limit,
-        play,
-        random_itr,
-        cexp_set,
-        op_previous,
-        op_usage
-    );
-    size_t num_cexp = cexp2op.size();
-    CPPAD_ASSERT_UNKNOWN( conditional_skip || num_cexp == 0 );
     vector<struct_cexp_info>  cexp_info; // struct_cexp_info not POD
     sparse::list_setvec       skip_op_true;
     sparse::list_setvec       skip_op_false;
-    //
-    if( cexp2op.size() > 0 ) get_cexp_info(
-        play,
-        random_itr,
-        op_previous,
-        op_usage,
-        cexp2op,
-        cexp_set,
-        cexp_info,
-        skip_op_true,
-        skip_op_false
-    );
+    pod_vector<bool>          par_usage;
+    pod_vector<addr_t>        dyn_previous;
+    size_t                    num_cexp;
+    if( use_plan )
+    {   // apply the cached plan
+        exceed_collision_limit = plan->exceed_collision_limit;
+        vecad_used             = plan->vecad_used;
+        op_usage               = plan->op_usage;
+        op_previous            = plan->op_previous;
+        cexp_info              = plan->cexp_info;
+        skip_op_true           = plan->skip_op_true;
+        skip_op_false          = plan->skip_op_false;
+        par_usage              = plan->par_usage;
+        dyn_previous           = plan->dyn_previous;
+        num_cexp               = cexp_info.size();
+        report.used_plan       = true;
+    }
+    else
+    {   // clock value at the end of the previous phase
+        double clock = CppAD::optimize_report::clock();
+        //
+        if( plan != nullptr )
+        {   // key for the plan
+            plan->valid     = false;
+            plan->key       = plan_key;
+            plan->hash_code = play->structure_hash();
+            plan->dep_taddr = dep_taddr;
+        }
+        get_op_usage(
+            conditional_skip,
+            compare_op,
+            print_for_op,
+            cumulative_sum_op,
+            play,
+            random_itr,
+            dep_taddr,
+            cexp2op,
+            cexp_set,
+            vecad_used,
+            op_usage
+        );
+        report.time_op_usage    = CppAD::optimize_report::clock() - clock;
+        clock                  += report.time_op_usage;
+        //
+        exceed_collision_limit |= get_op_previous(
+            collision_limit,
+            play,
+            random_itr,
+            cexp_set,
+            op_previous,
+            op_usage
+        );
+        report.time_op_previous = CppAD::optimize_report::clock() - clock;
+        clock                  += report.time_op_previous;
+        //
+        num_cexp = cexp2op.size();
+        CPPAD_ASSERT_UNKNOWN( conditional_skip || num_cexp == 0 );
+        //
+        if( cexp2op.size() > 0 ) get_cexp_info(
+            play,
+            random_itr,
+            op_previous,
+            op_usage,
+            cexp2op,
+            cexp_set,
+            cexp_info,
+            skip_op_true,
+            skip_op_false
+        );
 
-    // We no longer need cexp_set, and cexp2op, so free their memory
-    cexp_set.resize(0, 0);
-    cexp2op.clear();
+        // We no longer need cexp_set, and cexp2op, so free their memory
+        cexp_set.resize(0, 0);
+        cexp2op.clear();
+        report.time_cexp_info   = CppAD::optimize_report::clock() - clock;
+        clock                  += report.time_cexp_info;
+        // -------------------------------------------------------------------
+        // dynamic parameter information
+        get_par_usage(
+            play,
+            random_itr,
+            op_usage,
+            vecad_used,
+            par_usage
+        );
+        report.time_par_usage   = CppAD::optimize_report::clock() - clock;
+        clock                  += report.time_par_usage;
+        //
+        get_dyn_previous(
+            play                ,
+            random_itr          ,
+            par_usage           ,
+            dyn_previous
+        );
+        report.time_dyn_previous = CppAD::optimize_report::clock() - clock;
+        //
+        if( plan != nullptr )
+        {   // save the plan (op_previous is overwritten below)
+            plan->play                   = *play;
+            plan->exceed_collision_limit = exceed_collision_limit;
+            plan->vecad_used             = vecad_used;
+            plan->op_usage               = op_usage;
+            plan->op_previous            = op_previous;
+            plan->cexp_info              = cexp_info;
+            plan->skip_op_true           = skip_op_true;
+            plan->skip_op_false          = skip_op_false;
+            plan->par_usage              = par_usage;
+            plan->dyn_previous           = dyn_previous;
+            plan->valid                  = true;
+        }
+    }
+    // start of the record phase
+    double record_clock = CppAD::optimize_report::clock();
     // -----------------------------------------------------------------------
-    // dynamic parameter information
-    pod_vector<bool> par_usage;
-    get_par_usage(
-        play,
-        random_itr,
-        op_usage,
-        vecad_used,
-        par_usage
-    );
-    pod_vector<addr_t> dyn_previous;
-    get_dyn_previous(
-        play                ,
-        random_itr          ,
-        par_usage           ,
-        dyn_previous
-    );
+    // operators and variables removed by each transformation
+    for(size_t i_op = 0; i_op < num_op; ++i_op)
+    {   size_t n_res = NumRes( play->GetOp(i_op) );
+        if( op_usage[i_op] == usage_t(no_usage) )
+        {   ++report.dead_op;
+            report.dead_var += n_res;
+        }
+        else if( op_usage[i_op] == usage_t(csum_usage) )
+        {   ++report.csum_op;
+            report.csum_var += n_res;
+        }
+        else if( op_previous[i_op] != 0 )
+        {   ++report.cse_op;
+            report.cse_var += n_res;
+        }
+    }
+    // dynamic parameters removed because they are not used or are the same
+    // as a previous dynamic parameter
+    for(size_t i_dyn = num_dynamic_ind; i_dyn < num_dynamic_par; ++i_dyn)
+    {   size_t i_par = size_t( play->dyn_ind2par_ind()[i_dyn] );
+        if( ! par_usage[i_par] )
+            ++report.dead_dyn;
+        else if( size_t( dyn_previous[i_dyn] ) != num_dynamic_par )
+            ++report.cse_dyn;
+    }
     // -----------------------------------------------------------------------
     // conditional expression information
     //
@@ -373,6 +566,17 @@ bool optimize_run(
         }
     }
 
+    // con_par[i_par]: is the old parameter i_par a constant in new recording
+    // con_value[i_par]: value of the old parameter when con_par[i_par] true
+    // (dynamic parameters that get folded become constants)
+    pod_vector<bool> con_par( num_par );
+    vector<Base>     con_value( num_par );
+    for(size_t i_par = 0; i_par < num_par; ++i_par)
+    {   con_par[i_par] = ! dyn_par_is[i_par];
+        if( con_par[i_par] )
+            con_value[i_par] = play->GetPar(i_par);
+    }
+
     // index corresponding to the parameter zero
     addr_t zero_par_index = rec->put_con_par( Base(0) );
 
@@ -470,13 +674,45 @@ bool optimize_run(
             {   size_t j_par = size_t( dyn_ind2par_ind[j_dyn] );
                 CPPAD_ASSERT_UNKNOWN( j_par < i_par );
                 new_par[i_par] = new_par[j_par];
+                con_par[i_par] = con_par[j_par];
+                if( con_par[i_par] )
+                    con_value[i_par] = con_value[j_par];
             }
             else
             {
                 // value of this parameter
                 Base par       = play->GetPar(i_par);
                 //
-                if( op == cond_exp_dyn )
+                // check if this operator can be folded into a constant
+                // or replaced by one of its arguments
+                enum_fold_dyn fold = no_fold_dyn;
+                addr_t fold_par    = 0;
+                if( op != ind_dyn ) fold = fold_dyn(
+                    op,
+                    dyn_par_arg.data() + i_arg,
+                    new_par,
+                    con_par,
+                    con_value,
+                    fold_par,
+                    par
+                );
+                if( fold != no_fold_dyn )
+                    ++report.fold_dyn;
+                if( fold == con_fold_dyn )
+                {   // par is the value of this constant
+                    new_par[i_par]   = rec->put_con_par(par);
+                    con_par[i_par]   = true;
+                    con_value[i_par] = par;
+                }
+                else if( fold == par_fold_dyn )
+                {   // use fold_par in place of this parameter
+                    CPPAD_ASSERT_UNKNOWN( size_t(fold_par) < i_par );
+                    new_par[i_par] = new_par[fold_par];
+                    con_par[i_par] = con_par[fold_par];
+                    if( con_par[i_par] )
+                        con_value[i_par] = con_value[fold_par];
+                }
+                else if( op == cond_exp_dyn )
                 {   // cond_exp_dyn
                     CPPAD_ASSERT_UNKNOWN( num_dynamic_ind <= i_par );
                     CPPAD_ASSERT_UNKNOWN( n_arg == 5 );
@@ -637,6 +873,26 @@ bool optimize_run(
                 size_t n_true   = skip_op_true.number_elements(j);
                 size_t n_false  = skip_op_false.number_elements(j);
                 skip &= n_true > 0 || n_false > 0;
+                //
+                // cost model: the work saved by this skip is proportional
+                // to the number of variables in the case that is skipped
+                if( skip && skip_threshold > 1 )
+                {   size_t var_true  = 0;
+                    size_t var_false = 0;
+                    sparse::list_setvec::const_iterator
+                        itr_true(skip_op_true, j);
+                    while( *itr_true != skip_op_true.end() )
+                    {   var_true += NumRes( play->GetOp(*itr_true) );
+                        ++itr_true;
+                    }
+                    sparse::list_setvec::const_iterator
+                        itr_false(skip_op_false, j);
+                    while( *itr_false != skip_op_false.end() )
+                    {   var_false += NumRes( play->GetOp(*itr_false) );
+                        ++itr_false;
+                    }
+                    skip &= skip_threshold <= std::max(var_true, var_false);
+                }
                 if( skip )
                 {   CPPAD_ASSERT_UNKNOWN( NumRes(CSkipOp) == 0 );
                     size_t n_arg   = 7 + size_t(n_true) + size_t(n_false);
@@ -1313,6 +1569,8 @@ bool optimize_run(
             struct_cexp_info info = cexp_info[i];
             addr_t n_true  = addr_t( skip_op_true.number_elements(i) );
             addr_t n_false = addr_t( skip_op_false.number_elements(i) );
+            ++report.cskip_op;
+            report.cskip_skip += size_t(n_true) + size_t(n_false);
             i_arg          = cskip_new[i].i_arg;
             addr_t left    = addr_t( cskip_new[i].left );
             addr_t right   = addr_t( cskip_new[i].right );
@@ -1347,6 +1605,7 @@ bool optimize_run(
 # endif
         }
     }
+    report.time_record = CppAD::optimize_report::clock() - record_clock;
     return exceed_collision_limit;
 }
 
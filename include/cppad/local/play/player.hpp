@@ -521,6 +521,78 @@ public:
         all_par_vec_        = play.all_par_vec_;
     }
     // ===============================================================
+private:
+    /// add a value to a structure hash code
+    static size_t structure_hash(size_t code, size_t value)
+    {   code ^= value + 0x9e3779b9 + (code << 6) + (code >> 2);
+        return code;
+    }
+    /// add the elements of a pod_vector to a structure hash code
+    template <class Type>
+    static size_t structure_hash(size_t code, const pod_vector<Type>& vec)
+    {   code = structure_hash(code, vec.size() );
+        for(size_t i = 0; i < vec.size(); ++i)
+            code = structure_hash(code, size_t( vec[i] ) );
+        return code;
+    }
+    /// check if two pod_vectors are equal
+    template <class Type>
+    static bool same_structure(
+        const pod_vector<Type>& left, const pod_vector<Type>& right
+    )
+    {   bool same = left.size() == right.size();
+        for(size_t i = 0; same && i < left.size(); ++i)
+            same = left[i] == right[i];
+        return same;
+    }
+public:
+    /*!
+    Hash code for the structure of this operation sequence.
+
+    \return
+    is a hash code that depends on the operators, their arguments,
+    and which parameters are dynamic. It does not depend on the value of
+    the parameters, or the text in the recording.
+    */
+    size_t structure_hash(void) const
+    {   size_t code = num_dynamic_ind_;
+        code = structure_hash(code, num_var_rec_);
+        code = structure_hash(code, num_var_load_rec_);
+        code = structure_hash(code, num_var_vecad_rec_);
+        code = structure_hash(code, op_vec_);
+        code = structure_hash(code, arg_vec_);
+        code = structure_hash(code, all_var_vecad_ind_);
+        code = structure_hash(code, dyn_par_is_);
+        code = structure_hash(code, dyn_par_op_);
+        code = structure_hash(code, dyn_par_arg_);
+        return code;
+    }
+    /*!
+    Check if another player has the same structure as this player.
+
+    \param play
+    is the other player.
+
+    \return
+    is true if the operators, their arguments, and which parameters
+    are dynamic are the same for both players (the value of the parameters
+    and the text in the recordings may be different).
+    */
+    bool same_structure(const player& play) const
+    {   bool same = true;
+        same &= num_dynamic_ind_   == play.num_dynamic_ind_;
+        same &= num_var_rec_       == play.num_var_rec_;
+        same &= num_var_load_rec_  == play.num_var_load_rec_;
+        same &= num_var_vecad_rec_ == play.num_var_vecad_rec_;
+        same &= same_structure(op_vec_, play.op_vec_);
+        same &= same_structure(arg_vec_, play.arg_vec_);
+        same &= same_structure(all_var_vecad_ind_, play.all_var_vecad_ind_);
+        same &= same_structure(dyn_par_is_, play.dyn_par_is_);
+        same &= same_structure(dyn_par_op_, play.dyn_par_op_);
+        same &= same_structure(dyn_par_arg_, play.dyn_par_arg_);
+        return same;
+    }
+    // ===============================================================
     /// Create a player< AD<Base> > from this player<Base>
     player< AD<Base> > base2ad(void) const
     {   player< AD<Base> > play;
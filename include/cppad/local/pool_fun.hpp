@@ -0,0 +1,84 @@
+# ifndef CPPAD_LOCAL_POOL_FUN_HPP
+# define CPPAD_LOCAL_POOL_FUN_HPP
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-22 Bradley M. Bell
+
+CppAD is distributed under the terms of the
+             Eclipse Public License Version 2.0.
+
+This Source Code may also be made available under the following
+Secondary License when the conditions for such availability set forth
+in the Eclipse Public License, Version 2.0 are satisfied:
+      GNU General Public License, Version 2.0 or later.
+---------------------------------------------------------------------------- */
+# include <vector>
+# include <cppad/utility/thread_pool.hpp>
+
+namespace CppAD { namespace local { // BEGIN_CPPAD_LOCAL_NAMESPACE
+/*!
+\file pool_fun.hpp
+Copies of an ADFun object for each thread in a thread_pool.
+*/
+
+/*!
+Copies of an ADFun object for each thread in a thread_pool.
+
+The source function is not changed while the copies exist,
+so the threads can make their copies at the same time.
+Each copy is made by the thread that uses it
+(so its memory is allocated by that thread's thread_alloc information).
+The copies are deleted by the destructor, which must be called in
+sequential execution mode.
+
+\tparam Base
+is the base type for the function.
+
+\tparam RecBase
+is the base type used when recording the function.
+*/
+template <class Base, class RecBase>
+class pool_fun {
+private:
+    /// function that is copied
+    const ADFun<Base, RecBase>&          source_;
+    /// copy of the function for each thread (nullptr if not yet created)
+    std::vector< ADFun<Base, RecBase>* > copy_;
+public:
+    /*!
+    constructor
+
+    \param source
+    is the function that is copied.
+
+    \param pool
+    is the pool of threads that will use the copies.
+    */
+    pool_fun(const ADFun<Base, RecBase>& source, const thread_pool& pool)
+    : source_(source), copy_(pool.num_threads(), nullptr)
+    {   CPPAD_ASSERT_UNKNOWN( ! thread_alloc::in_parallel() ); }
+    /// destructor
+    ~pool_fun(void)
+    {   CPPAD_ASSERT_UNKNOWN( ! thread_alloc::in_parallel() );
+        for(size_t thread = 0; thread < copy_.size(); ++thread)
+            delete copy_[thread];
+    }
+    /*!
+    copy of the function for the current thread
+
+    \param thread
+    is the pool thread number for the current thread.
+    The first time this thread number is used, the copy is created.
+    */
+    ADFun<Base, RecBase>& get(size_t thread)
+    {   CPPAD_ASSERT_UNKNOWN( thread < copy_.size() );
+        if( copy_[thread] == nullptr )
+        {   copy_[thread] = new ADFun<Base, RecBase>();
+            *copy_[thread] = source_;
+        }
+        return *copy_[thread];
+    }
+};
+
+} } // END_CPPAD_LOCAL_NAMESPACE
+
+# endif
@@ -41,7 +41,7 @@ If set is true, then parallel_new is becomes the most
 recent setting for this set_get_in_parallel.
 In this case, it is assumed that we are currently in sequential execution mode.
 */
-static bool set_get_in_parallel(
+inline bool set_get_in_parallel(
     bool (*in_parallel_new)(void) ,
     bool set = false           )
 {   static bool (*in_parallel_user)(void) = nullptr;
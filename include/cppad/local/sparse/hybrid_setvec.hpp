@@ -0,0 +1,1342 @@
+# ifndef CPPAD_LOCAL_SPARSE_HYBRID_SETVEC_HPP
+# define CPPAD_LOCAL_SPARSE_HYBRID_SETVEC_HPP
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-22 Bradley M. Bell
+
+CppAD is distributed under the terms of the
+             Eclipse Public License Version 2.0.
+
+This Source Code may also be made available under the following
+Secondary License when the conditions for such availability set forth
+in the Eclipse Public License, Version 2.0 are satisfied:
+      GNU General Public License, Version 2.0 or later.
+---------------------------------------------------------------------------- */
+# include <algorithm>
+# include <cppad/local/define.hpp>
+# include <cppad/local/pod_vector.hpp>
+# include <cppad/local/sparse/pack_setvec.hpp>
+
+// BEGIN_CPPAD_LOCAL_SPARSE_NAMESPACE
+namespace CppAD { namespace local { namespace sparse {
+
+/*!
+\file hybrid_setvec.hpp
+Vector of sets of positive integers where each set is stored using
+the container (array, runs, or bitmap) that requires the least memory.
+*/
+class hybrid_setvec_const_iterator;
+
+// =========================================================================
+/*!
+Vector of sets of positive integers, each set stored as an array,
+a vector of runs, or a bitmap.
+
+All the public members for this class are also in the
+sparse::pack_setvec and sparse::list_setvec classes.
+This defines the CppAD vector_of_sets concept.
+
+\par Containers
+Each non-empty set is stored in one of the following containers:
+\li
+array_kind: the elements of the set in increasing order.
+This requires one word per element.
+\li
+run_kind: the set is the union of intervals [first, last)
+stored as pairs in increasing order.
+This requires two words per interval.
+\li
+bitmap_kind: one bit for each of the possible elements 0, ..., end_ - 1.
+This requires n_pack_ words.
+After each operation that changes a set, the container that
+requires the fewest words is used for the result.
+Dense sets use a bitmap, sets that are mostly contiguous use runs,
+and sparse sets use an array.
+*/
+class hybrid_setvec {
+    friend class hybrid_setvec_const_iterator;
+private:
+    /// Type used to pack elements in a bitmap
+    typedef size_t Pack;
+
+    /// container kinds
+    enum kind_enum { array_kind = 0, run_kind = 1, bitmap_kind = 2 };
+
+    /// Number of bits per Pack value
+    const size_t n_bit_;
+
+    /// Possible elements in each set are 0, 1, ..., end_ - 1;
+    size_t end_;
+
+    /// Number of Pack values used by a bitmap container
+    size_t n_pack_;
+
+    /// number of elements in data_ that have been allocated
+    /// and are no longer being used.
+    size_t data_not_used_;
+
+    /// The data for all the sets and all the posts
+    pod_vector<size_t> data_;
+
+    /*!
+    Starting point for i-th set is start_[i].
+
+    \li
+    If the i-th set has no elements, start_[i] is zero.
+    Othersize the conditions below hold.
+
+    \li
+    data_[ start_[i] ] is the container kind for this set.
+
+    \li
+    data_[ start_[i] + 1 ] is the number of elements in this set.
+
+    \li
+    data_[ start_[i] + 2 ] is the number of words, n_word, in the container.
+
+    \li
+    data_[ start_[i] + 3 + k ] for k = 0, ..., n_word - 1
+    are the words in the container.
+    */
+    pod_vector<size_t> start_;
+
+    /*!
+    Vectors of elements that have not yet been added to corresponding sets.
+
+    \li
+    If all the post_element calls for the i-th set have been added,
+    post_[i] is zero. Otherwise the conditions below hold.
+
+    \li
+    data_[ post_[i] ]  the number of elements that have been posted,
+    but not yet added, to set i.
+
+    \li
+    data_[ post_[i] + 1 ] is the capacity for holding elements
+    which is greater than or equal the number of elements.
+
+    \li
+    data_[ post_[i] + 2 + k ] for k less than the number of elements
+    are the elements that have been posted, but not yet added, to set i.
+    */
+    pod_vector<size_t> post_;
+
+    /// work space used for the runs of a left operand
+    pod_vector<size_t> run_left_;
+
+    /// work space used for the runs of a right operand
+    pod_vector<size_t> run_right_;
+
+    /// work space used for the runs of a result
+    pod_vector<size_t> run_result_;
+
+    /// work space used for the bitmap of a result
+    pod_vector<Pack>   bitmap_result_;
+    // -----------------------------------------------------------------
+    /*!
+    Number of data_ entries used by the container for a set.
+
+    \param i
+    is the index of the set.
+
+    \return
+    is zero if the set is empty. Otherwise it is the number of entries,
+    including the three header entries.
+    */
+    size_t number_used(size_t i) const
+    {   size_t start = start_[i];
+        if( start == 0 )
+            return 0;
+        return 3 + data_[start + 2];
+    }
+    // -----------------------------------------------------------------
+    /*!
+    Drop the container and posts for a set.
+
+    \param i
+    is the index of the set that will be dropped.
+    Upon return, start_[i] and post_[i] are zero.
+
+    \par data_not_used_
+    is incremented by the number of data_ elements that are lost.
+    Garbage collection is not done by this routine.
+    */
+    void drop(size_t i)
+    {   size_t number_lost = number_used(i);
+        start_[i]          = 0;
+        //
+        size_t post = post_[i];
+        if( post != 0 )
+        {   number_lost += data_[post + 1] + 2;
+            post_[i]     = 0;
+        }
+        data_not_used_ += number_lost;
+    }
+    // -----------------------------------------------------------------
+    /*!
+    Checks data structure
+    */
+# ifdef NDEBUG
+    void check_data_structure(void) const
+    {   return; }
+# else
+    void check_data_structure(void) const
+    {   // number of sets
+        CPPAD_ASSERT_UNKNOWN( post_.size() == start_.size() );
+        size_t n_set = start_.size();
+        if( n_set == 0 )
+        {   CPPAD_ASSERT_UNKNOWN( end_ == 0 );
+            CPPAD_ASSERT_UNKNOWN( data_not_used_ == 0 );
+            CPPAD_ASSERT_UNKNOWN( data_.size() == 0 );
+            return;
+        }
+        size_t data_used = 0;
+        for(size_t i = 0; i < n_set; i++)
+        {   size_t start = start_[i];
+            if( start != 0 )
+            {   size_t kind   = data_[start];
+                size_t count  = data_[start + 1];
+                size_t n_word = data_[start + 2];
+                CPPAD_ASSERT_UNKNOWN( 0 < count && count <= end_ );
+                CPPAD_ASSERT_UNKNOWN(
+                    kind != array_kind || n_word == count
+                );
+                CPPAD_ASSERT_UNKNOWN(
+                    kind != run_kind || (n_word > 0 && n_word % 2 == 0)
+                );
+                CPPAD_ASSERT_UNKNOWN(
+                    kind != bitmap_kind || n_word == n_pack_
+                );
+                CPPAD_ASSERT_UNKNOWN( kind <= bitmap_kind );
+                data_used += 3 + n_word;
+            }
+            size_t post = post_[i];
+            if( post != 0 )
+            {   CPPAD_ASSERT_UNKNOWN( data_[post] > 0 );
+                CPPAD_ASSERT_UNKNOWN( data_[post] <= data_[post + 1] );
+                data_used += data_[post + 1] + 2;
+            }
+        }
+        CPPAD_ASSERT_UNKNOWN( data_used + data_not_used_ == data_.size() );
+        return;
+    }
+# endif
+    // -----------------------------------------------------------------
+    /*!
+    Does garbage collection when indicated.
+
+    This routine should be called when more entries are not being used.
+    If a significant propotion are not being used, the data structure
+    will be compacted.
+    Note that data_[0] never gets used.
+    */
+    void collect_garbage(void)
+    {   if( data_not_used_ < data_.size() / 2 +  100)
+            return;
+        check_data_structure();
+        //
+        size_t n_set = start_.size();
+        pod_vector<size_t> data_tmp(1); // data_tmp[0] will not be used
+        for(size_t i = 0; i < n_set; i++)
+        {   size_t start = start_[i];
+            if( start != 0 )
+            {   size_t length    = 3 + data_[start + 2];
+                size_t start_tmp = data_tmp.extend(length);
+                for(size_t k = 0; k < length; ++k)
+                    data_tmp[start_tmp + k] = data_[start + k];
+                start_[i] = start_tmp;
+            }
+            size_t post = post_[i];
+            if( post != 0 )
+            {   size_t length    = 2 + data_[post + 1];
+                size_t post_tmp  = data_tmp.extend(length);
+                for(size_t k = 0; k < length; ++k)
+                    data_tmp[post_tmp + k] = data_[post + k];
+                post_[i] = post_tmp;
+            }
+        }
+        data_.swap(data_tmp);
+        //
+        // all of the elements, except the first, are used
+        data_not_used_ = 1;
+    }
+    // -----------------------------------------------------------------
+    /*!
+    Index of the next one bit in a bitmap.
+
+    \param bitmap
+    is the bitmap we are searching.
+
+    \param n_pack
+    is the number of Pack values in the bitmap.
+
+    \param n_bit
+    is the number of bits in each Pack value.
+
+    \param end
+    is the value returned if there is no such bit.
+
+    \param p
+    is the index where the search starts.
+
+    \param one
+    if true (false) we are searching for a one (zero) bit.
+
+    \return
+    is the smallest index greater than or equal p for a one (zero) bit.
+    If there is no such index less than end, the return value is end.
+    */
+    static size_t next_bit(
+        const Pack* bitmap ,
+        size_t      n_pack ,
+        size_t      n_bit  ,
+        size_t      end    ,
+        size_t      p      ,
+        bool        one    )
+    {   if( p >= end )
+            return end;
+        Pack flip = one ? Pack(0) : ~ Pack(0);
+        size_t j  = p / n_bit;
+        Pack unit = (bitmap[j] ^ flip) & ( ~ Pack(0) << (p % n_bit) );
+        while( unit == Pack(0) )
+        {   if( ++j == n_pack )
+                return end;
+            unit = bitmap[j] ^ flip;
+        }
+        size_t index = j * n_bit + pack_setvec::low_bit(unit);
+        return std::min(index, end);
+    }
+    // -----------------------------------------------------------------
+    /*!
+    Get the runs corresponding to a set.
+
+    \param vec
+    is the vector of sets (may be this object).
+
+    \param i
+    is the index of the set in vec.
+
+    \param runs
+    The input value does not matter.
+    Upon return, for k = 0, ..., runs.size()/2 - 1,
+    [ runs[2*k], runs[2*k+1] ) are the disjoint and non-adjacent intervals,
+    in increasing order, whose union is the set.
+    */
+    static void get_runs(
+        const hybrid_setvec& vec, size_t i, pod_vector<size_t>& runs)
+    {   runs.resize(0);
+        size_t start = vec.start_[i];
+        if( start == 0 )
+            return;
+        size_t kind        = vec.data_[start];
+        size_t n_word      = vec.data_[start + 2];
+        const size_t* word = vec.data_.data() + start + 3;
+        switch( kind )
+        {   case array_kind:
+            for(size_t k = 0; k < n_word; ++k)
+            {   size_t element = word[k];
+                size_t n_run   = runs.size();
+                if( n_run > 0 && runs[n_run - 1] == element )
+                    runs[n_run - 1] = element + 1;
+                else
+                {   runs.push_back(element);
+                    runs.push_back(element + 1);
+                }
+            }
+            break;
+
+            case run_kind:
+            runs.resize(n_word);
+            for(size_t k = 0; k < n_word; ++k)
+                runs[k] = word[k];
+            break;
+
+            default:
+            CPPAD_ASSERT_UNKNOWN( kind == bitmap_kind );
+            {   size_t p = 0;
+                while( p < vec.end_ )
+                {   size_t first = next_bit(
+                        word, n_word, vec.n_bit_, vec.end_, p, true
+                    );
+                    if( first < vec.end_ )
+                    {   p = next_bit(
+                            word, n_word, vec.n_bit_, vec.end_, first, false
+                        );
+                        runs.push_back(first);
+                        runs.push_back(p);
+                    }
+                    else
+                        p = vec.end_;
+                }
+            }
+            break;
+        }
+    }
+    // -----------------------------------------------------------------
+    /*!
+    Set run_result_ to the union of run_left_ and run_right_.
+    */
+    void run_union(void)
+    {   run_result_.resize(0);
+        size_t n_left  = run_left_.size();
+        size_t n_right = run_right_.size();
+        size_t k_left  = 0;
+        size_t k_right = 0;
+        while( k_left < n_left || k_right < n_right )
+        {   // next run in increasing order of its first element
+            size_t first, last;
+            bool use_left = k_right == n_right || (
+                k_left < n_left && run_left_[k_left] <= run_right_[k_right]
+            );
+            if( use_left )
+            {   first   = run_left_[k_left];
+                last    = run_left_[k_left + 1];
+                k_left += 2;
+            }
+            else
+            {   first    = run_right_[k_right];
+                last     = run_right_[k_right + 1];
+                k_right += 2;
+            }
+            // merge with the previous run if they overlap or are adjacent
+            size_t n_result = run_result_.size();
+            if( n_result > 0 && first <= run_result_[n_result - 1] )
+            {   if( last > run_result_[n_result - 1] )
+                    run_result_[n_result - 1] = last;
+            }
+            else
+            {   run_result_.push_back(first);
+                run_result_.push_back(last);
+            }
+        }
+    }
+    // -----------------------------------------------------------------
+    /*!
+    Set run_result_ to the intersection of run_left_ and run_right_.
+    */
+    void run_intersection(void)
+    {   run_result_.resize(0);
+        size_t n_left  = run_left_.size();
+        size_t n_right = run_right_.size();
+        size_t k_left  = 0;
+        size_t k_right = 0;
+        while( k_left < n_left && k_right < n_right )
+        {   size_t first = std::max(run_left_[k_left], run_right_[k_right]);
+            size_t last_left  = run_left_[k_left + 1];
+            size_t last_right = run_right_[k_right + 1];
+            size_t last       = std::min(last_left, last_right);
+            if( first < last )
+            {   run_result_.push_back(first);
+                run_result_.push_back(last);
+            }
+            // advance the run that ends first
+            if( last_left <= last_right )
+                k_left += 2;
+            if( last_right <= last_left )
+                k_right += 2;
+        }
+    }
+    // -----------------------------------------------------------------
+    /*!
+    Choose the container kind that uses the fewest words.
+
+    \param count
+    is the number of elements in the set (must be non-zero).
+
+    \param n_run
+    is the number of runs in the set.
+    */
+    size_t choose_kind(size_t count, size_t n_run) const
+    {   CPPAD_ASSERT_UNKNOWN( count > 0 && n_run > 0 );
+        if( count <= 2 * n_run && count <= n_pack_ )
+            return array_kind;
+        if( 2 * n_run <= n_pack_ )
+            return run_kind;
+        return bitmap_kind;
+    }
+    // -----------------------------------------------------------------
+    /*!
+    Start a new container for a set.
+
+    \param i
+    is the index of the set. Its previous value is dropped.
+
+    \param kind
+    is the container kind for the new value.
+
+    \param count
+    is the number of elements in the new value (must be non-zero).
+
+    \param n_word
+    is the number of words in the new container.
+
+    \return
+    is the index in data_ of the first word in the new container.
+    */
+    size_t new_container(size_t i, size_t kind, size_t count, size_t n_word)
+    {   drop(i);
+        size_t start     = data_.extend(3 + n_word);
+        start_[i]        = start;
+        data_[start]     = kind;
+        data_[start + 1] = count;
+        data_[start + 2] = n_word;
+        return start + 3;
+    }
+    // -----------------------------------------------------------------
+    /*!
+    Store a set using its runs.
+
+    \param i
+    is the index of the set we are storing.
+
+    \param runs
+    are the runs for the new value of the set
+    (must not be any of this objects data_).
+    */
+    void store_runs(size_t i, const pod_vector<size_t>& runs)
+    {   size_t n_run = runs.size() / 2;
+        size_t count = 0;
+        for(size_t k = 0; k < n_run; ++k)
+            count += runs[2 * k + 1] - runs[2 * k];
+        if( count == 0 )
+        {   drop(i);
+            collect_garbage();
+            return;
+        }
+        size_t kind = choose_kind(count, n_run);
+        switch( kind )
+        {   case array_kind:
+            {   size_t index = new_container(i, kind, count, count);
+                for(size_t k = 0; k < n_run; ++k)
+                {   for(size_t j = runs[2 * k]; j < runs[2 * k + 1]; ++j)
+                        data_[index++] = j;
+                }
+            }
+            break;
+
+            case run_kind:
+            {   size_t index = new_container(i, kind, count, 2 * n_run);
+                for(size_t k = 0; k < 2 * n_run; ++k)
+                    data_[index + k] = runs[k];
+            }
+            break;
+
+            default:
+            CPPAD_ASSERT_UNKNOWN( kind == bitmap_kind );
+            {   size_t index = new_container(i, kind, count, n_pack_);
+                Pack*  unit  = data_.data() + index;
+                for(size_t k = 0; k < n_pack_; ++k)
+                    unit[k] = Pack(0);
+                for(size_t k = 0; k < n_run; ++k)
+                {   for(size_t j = runs[2 * k]; j < runs[2 * k + 1]; ++j)
+                        unit[j / n_bit_] |= Pack(1) << (j % n_bit_);
+                }
+            }
+            break;
+        }
+        collect_garbage();
+    }
+    // -----------------------------------------------------------------
+    /*!
+    Store a set using its bitmap.
+
+    \param i
+    is the index of the set we are storing.
+
+    \param bitmap
+    is the bitmap for the new value of the set
+    (must not be any of this objects data_).
+    */
+    void store_bitmap(size_t i, const pod_vector<Pack>& bitmap)
+    {   CPPAD_ASSERT_UNKNOWN( bitmap.size() == n_pack_ );
+        //
+        // count and n_run
+        size_t count = 0;
+        size_t n_run = 0;
+        Pack   carry = Pack(0);
+        for(size_t k = 0; k < n_pack_; ++k)
+        {   Pack unit = bitmap[k];
+            count    += pack_setvec::bit_count(unit);
+            // a run starts where a one bit follows a zero bit
+            Pack previous = (unit << 1) | carry;
+            n_run        += pack_setvec::bit_count(unit & ~previous);
+            carry         = unit >> (n_bit_ - 1);
+        }
+        if( count == 0 )
+        {   drop(i);
+            collect_garbage();
+            return;
+        }
+        size_t kind = choose_kind(count, n_run);
+        if( kind == bitmap_kind )
+        {   size_t index = new_container(i, kind, count, n_pack_);
+            for(size_t k = 0; k < n_pack_; ++k)
+                data_[index + k] = bitmap[k];
+            collect_garbage();
+            return;
+        }
+        // convert the bitmap to runs
+        run_result_.resize(0);
+        size_t p = 0;
+        while( p < end_ )
+        {   size_t first = next_bit(
+                bitmap.data(), n_pack_, n_bit_, end_, p, true
+            );
+            if( first < end_ )
+            {   p = next_bit(
+                    bitmap.data(), n_pack_, n_bit_, end_, first, false
+                );
+                run_result_.push_back(first);
+                run_result_.push_back(p);
+            }
+            else
+                p = end_;
+        }
+        store_runs(i, run_result_);
+    }
+    // -----------------------------------------------------------------
+    /*!
+    Is a set stored as a bitmap.
+
+    \param i
+    is the index of the set.
+    */
+    bool is_bitmap(size_t i) const
+    {   size_t start = start_[i];
+        return start != 0 && data_[start] == bitmap_kind;
+    }
+public:
+    /// declare a const iterator
+    typedef hybrid_setvec_const_iterator const_iterator;
+    // -----------------------------------------------------------------
+    /*!
+    Default constructor (no sets)
+    */
+    hybrid_setvec(void) :
+    n_bit_( std::numeric_limits<Pack>::digits ),
+    end_(0)            ,
+    n_pack_(0)         ,
+    data_not_used_(0)  ,
+    data_(0)           ,
+    start_(0)          ,
+    post_(0)
+    { }
+    // -----------------------------------------------------------------
+    /// Destructor
+    ~hybrid_setvec(void)
+    {   check_data_structure();
+    }
+    // -----------------------------------------------------------------
+    /*!
+    Using copy constructor is a programing (not user) error
+
+    \param v
+    vector of sets that we are attempting to make a copy of.
+    */
+    hybrid_setvec(const hybrid_setvec& v)
+    : n_bit_( std::numeric_limits<Pack>::digits )
+    {   // Error: Probably a hybrid_setvec argument has been passed by value
+        CPPAD_ASSERT_UNKNOWN(false);
+    }
+    // -----------------------------------------------------------------
+    /*!
+    Assignement operator.
+
+    \param other
+    this hybrid_setvec with be set to a deep copy of other.
+    */
+    void operator=(const hybrid_setvec& other)
+    {   end_           = other.end_;
+        n_pack_        = other.n_pack_;
+        data_not_used_ = other.data_not_used_;
+        data_          = other.data_;
+        start_         = other.start_;
+        post_          = other.post_;
+    }
+    // -----------------------------------------------------------------
+    /*!
+    swap
+
+    \param other
+    this hybrid_setvec with be swapped with other.
+    */
+    void swap(hybrid_setvec& other)
+    {   // size_t objects
+        std::swap(end_             , other.end_);
+        std::swap(n_pack_          , other.n_pack_);
+        std::swap(data_not_used_   , other.data_not_used_);
+
+        // pod_vectors
+        data_.swap(       other.data_);
+        start_.swap(      other.start_);
+        post_.swap(       other.post_);
+    }
+    // -----------------------------------------------------------------
+    /*!
+    Start a new vector of sets.
+
+    \param n_set
+    is the number of sets in this vector of sets.
+    \li
+    If n_set is zero, any memory currently allocated for this object
+    is freed.
+    \li
+    If n_set is non-zero, a vector of n_set sets is created and all
+    the sets are initilaized as empty.
+
+    \param end
+    is the maximum element plus one (the minimum element is 0).
+    If n_set is zero, end must also be zero.
+    */
+    void resize(size_t n_set, size_t end)
+    {   check_data_structure();
+
+        if( n_set == 0 )
+        {   CPPAD_ASSERT_UNKNOWN(end == 0 );
+            //
+            // restore object to start after constructor
+            // (no memory allocated for this object)
+            data_.clear();
+            start_.clear();
+            post_.clear();
+            run_left_.clear();
+            run_right_.clear();
+            run_result_.clear();
+            bitmap_result_.clear();
+            data_not_used_  = 0;
+            end_            = 0;
+            n_pack_         = 0;
+            //
+            return;
+        }
+        end_    = end;
+        n_pack_ = ( 1 + (end - 1) / n_bit_ );
+        if( end == 0 )
+            n_pack_ = 0;
+        //
+        start_.resize(n_set);
+        post_.resize(n_set);
+        for(size_t i = 0; i < n_set; i++)
+        {   start_[i] = 0;
+            post_[i]  = 0;
+        }
+        //
+        data_.resize(1);     // first element is not used
+        data_not_used_  = 1;
+    }
+    // -----------------------------------------------------------------
+    /*!
+    Return number of elements in a set.
+
+    \param i
+    is the index of the set we are checking number of the elements of.
+    */
+    size_t number_elements(size_t i) const
+    {   CPPAD_ASSERT_UNKNOWN( post_[i] == 0 );
+        //
+        size_t start = start_[i];
+        if( start == 0 )
+            return 0;
+        return data_[start + 1];
+    }
+    // ------------------------------------------------------------------
+    /*!
+    Post an element for delayed addition to a set.
+
+    \param i
+    is the index for this set in the vector of sets.
+
+    \param element
+    is the value of the element that we are posting.
+    The same element may be posted multiple times.
+
+    \par
+    It is faster to post multiple elements to set i and then call
+    process_post(i) then to add each element individually.
+    It is an error to call any member function,
+    that depends on the value of set i,
+    before processing the posts to set i.
+    */
+    void post_element(size_t i, size_t element)
+    {   CPPAD_ASSERT_UNKNOWN( i < start_.size() );
+        CPPAD_ASSERT_UNKNOWN( element < end_ );
+
+        size_t post = post_[i];
+        if( post == 0 )
+        {   // minimum capacity for an post vector
+            size_t min_capacity = 10;
+            size_t post_new = data_.extend(min_capacity + 2);
+            data_[post_new]     = 1;            // length
+            data_[post_new + 1] = min_capacity; // capacity
+            data_[post_new + 2] = element;
+            post_[i]            = post_new;
+        }
+        else
+        {   size_t length   = data_[post];
+            size_t capacity = data_[post + 1];
+            if( length == capacity )
+            {
+                size_t post_new = data_.extend( 2 * capacity + 2 );
+                //
+                data_[post_new]     = length + 1;
+                data_[post_new + 1] = 2 * capacity;
+                //
+                for(size_t j = 0; j < length; j++)
+                    data_[post_new + 2 + j] = data_[post + 2 + j];
+                data_[post_new + 2 + length] = element;
+                //
+                post_[i]            = post_new;
+                size_t number_lost = capacity + 2;
+                data_not_used_    += number_lost;
+            }
+            else
+            {   data_[post]              = length + 1;
+                data_[post + 2 + length] = element;
+            }
+        }
+
+        // check amount of data_not_used_
+        collect_garbage();
+
+        return;
+    }
+    // -----------------------------------------------------------------
+    /*!
+    process post entries for a specific set.
+
+    \param i
+    index of the set for which we are processing the post entries.
+
+    \par post_
+    Upon call, post_[i] is location in data_ of the elements that get
+    added to the i-th set.  Upon return, post_[i] is zero.
+    */
+    void process_post(size_t i)
+    {   size_t post = post_[i];
+        //
+        // check if there are no elements to process
+        if( post == 0 )
+            return;
+        //
+        // sort the elements that need to be processed
+        size_t  length_post   = data_[post];
+        size_t  capacity_post = data_[post + 1];
+        size_t* first_post    = data_.data() + post + 2;
+        size_t* last_post     = first_post + length_post;
+        std::sort(first_post, last_post);
+        //
+        // runs for the posted elements
+        run_right_.resize(0);
+        for(size_t k = 0; k < length_post; ++k)
+        {   size_t element = data_[post + 2 + k];
+            size_t n_run   = run_right_.size();
+            if( n_run > 0 && run_right_[n_run - 1] >= element )
+                run_right_[n_run - 1] = element + 1;
+            else
+            {   run_right_.push_back(element);
+                run_right_.push_back(element + 1);
+            }
+        }
+        //
+        // drop the posts for this set
+        post_[i]        = 0;
+        data_not_used_ += capacity_post + 2;
+        //
+        // union with the current set
+        get_runs(*this, i, run_left_);
+        run_union();
+        store_runs(i, run_result_);
+    }
+    // -----------------------------------------------------------------
+    /*!
+    Add one element to a set.
+
+    \param i
+    is the index for this set in the vector of sets.
+
+    \param element
+    is the element we are adding to the set.
+    */
+    void add_element(size_t i, size_t element)
+    {   CPPAD_ASSERT_UNKNOWN( i   < start_.size() );
+        CPPAD_ASSERT_UNKNOWN( element < end_ );
+
+        // check if element is already in the set
+        if( is_element(i, element) )
+            return;
+
+        // a bitmap is changed in place
+        if( is_bitmap(i) )
+        {   size_t start = start_[i];
+            data_[start + 1]++;
+            data_[start + 3 + element / n_bit_] |=
+                Pack(1) << (element % n_bit_);
+            return;
+        }
+        //
+        run_right_.resize(2);
+        run_right_[0] = element;
+        run_right_[1] = element + 1;
+        get_runs(*this, i, run_left_);
+        run_union();
+        store_runs(i, run_result_);
+    }
+    // -----------------------------------------------------------------
+    /*!
+    Check if an element is in a set.
+
+    \param i
+    is the index for this set in the vector of sets.
+
+    \param element
+    is the element we are checking to see if it is in the set.
+    */
+    bool is_element(size_t i, size_t element) const
+    {   CPPAD_ASSERT_UNKNOWN( post_[i] == 0 );
+        CPPAD_ASSERT_UNKNOWN( element < end_ );
+        //
+        size_t start = start_[i];
+        if( start == 0 )
+            return false;
+        //
+        size_t kind         = data_[start];
+        size_t n_word       = data_[start + 2];
+        const size_t* first = data_.data() + start + 3;
+        switch( kind )
+        {   case array_kind:
+            return std::binary_search(first, first + n_word, element);
+
+            case run_kind:
+            {   // number of runs with first element less than or equal element
+                size_t lower = 0;
+                size_t upper = n_word / 2;
+                while( lower < upper )
+                {   size_t middle = (lower + upper) / 2;
+                    if( first[2 * middle] <= element )
+                        lower = middle + 1;
+                    else
+                        upper = middle;
+                }
+                return lower > 0 && element < first[2 * lower - 1];
+            }
+
+            default:
+            CPPAD_ASSERT_UNKNOWN( kind == bitmap_kind );
+            break;
+        }
+        Pack unit = first[element / n_bit_];
+        return ( unit & ( Pack(1) << (element % n_bit_) ) ) != Pack(0);
+    }
+    // -----------------------------------------------------------------
+    /*!
+    Assign the empty set to one of the sets.
+
+    \param target
+    is the index of the set we are setting to the empty set.
+
+    \par data_not_used_
+    increments this value by number of data_ elements that are lost
+    (unlinked) by this operation.
+    */
+    void clear(size_t target)
+    {   drop(target);
+        collect_garbage();
+    }
+    // -----------------------------------------------------------------
+    /*!
+    Assign one set equal to another set.
+
+    \param this_target
+    is the index in this hybrid_setvec object of the set being assinged.
+
+    \param other_source
+    is the index in the other hybrid_setvec object of the
+    set that we are using as the value to assign to the target set.
+
+    \param other
+    is the other hybrid_setvec object (which may be the same as this
+    hybrid_setvec object). This must have the same value for end_.
+    */
+    void assignment(
+        size_t                  this_target  ,
+        size_t                  other_source ,
+        const hybrid_setvec&    other        )
+    {   CPPAD_ASSERT_UNKNOWN( other.post_[ other_source ] == 0 );
+        //
+        CPPAD_ASSERT_UNKNOWN( this_target  <   start_.size()        );
+        CPPAD_ASSERT_UNKNOWN( other_source <   other.start_.size()  );
+        CPPAD_ASSERT_UNKNOWN( end_        == other.end_   );
+
+        // check if we are assigning a set to itself
+        if( (this == &other) & (this_target == other_source) )
+            return;
+        //
+        size_t other_start = other.start_[other_source];
+        if( other_start == 0 )
+        {   clear(this_target);
+            return;
+        }
+        size_t kind   = other.data_[other_start];
+        size_t count  = other.data_[other_start + 1];
+        size_t n_word = other.data_[other_start + 2];
+        //
+        // other.data_ may be reallocated if this is the same object,
+        // so get its words after the new container is created
+        size_t index = new_container(this_target, kind, count, n_word);
+        for(size_t k = 0; k < n_word; ++k)
+            data_[index + k] = other.data_[other_start + 3 + k];
+        collect_garbage();
+    }
+    // -----------------------------------------------------------------
+    /*!
+    Assign a set equal to the union of two other sets.
+
+    \param this_target
+    is the index in this hybrid_setvec object of the set being assinged.
+
+    \param this_left
+    is the index in this hybrid_setvec object of the
+    left operand for the union operation.
+    It is OK for this_target and this_left to be the same value.
+
+    \param other_right
+    is the index in the other hybrid_setvec object of the
+    right operand for the union operation.
+    It is OK for this_target and other_right to be the same value.
+
+    \param other
+    is the other hybrid_setvec object (which may be the same as this
+    hybrid_setvec object).
+    */
+    void binary_union(
+        size_t                  this_target  ,
+        size_t                  this_left    ,
+        size_t                  other_right  ,
+        const hybrid_setvec&    other        )
+    {   CPPAD_ASSERT_UNKNOWN( post_[this_left] == 0 );
+        CPPAD_ASSERT_UNKNOWN( other.post_[ other_right ] == 0 );
+        //
+        CPPAD_ASSERT_UNKNOWN( this_target < start_.size()         );
+        CPPAD_ASSERT_UNKNOWN( this_left   < start_.size()         );
+        CPPAD_ASSERT_UNKNOWN( other_right < other.start_.size()   );
+        CPPAD_ASSERT_UNKNOWN( end_        == other.end_           );
+        //
+        // case where one of the operands is empty
+        if( other.start_[other_right] == 0 )
+        {   assignment(this_target, this_left, *this);
+            return;
+        }
+        if( start_[this_left] == 0 )
+        {   assignment(this_target, other_right, other);
+            return;
+        }
+        //
+        // case where both operands are bitmaps
+        if( is_bitmap(this_left) & other.is_bitmap(other_right) )
+        {   const Pack* left  = data_.data() + start_[this_left] + 3;
+            const Pack* right =
+                other.data_.data() + other.start_[other_right] + 3;
+            bitmap_result_.resize(n_pack_);
+            Pack* result = bitmap_result_.data();
+            for(size_t k = 0; k < n_pack_; ++k)
+                result[k] = left[k] | right[k];
+            store_bitmap(this_target, bitmap_result_);
+            return;
+        }
+        //
+        // general case
+        get_runs(*this, this_left, run_left_);
+        get_runs(other, other_right, run_right_);
+        run_union();
+        store_runs(this_target, run_result_);
+    }
+    // -----------------------------------------------------------------
+    /*!
+    Assign a set equal to the intersection of two other sets.
+
+    \param this_target
+    is the index in this hybrid_setvec object of the set being assinged.
+
+    \param this_left
+    is the index in this hybrid_setvec object of the
+    left operand for the intersection operation.
+    It is OK for this_target and this_left to be the same value.
+
+    \param other_right
+    is the index in the other hybrid_setvec object of the
+    right operand for the intersection operation.
+    It is OK for this_target and other_right to be the same value.
+
+    \param other
+    is the other hybrid_setvec object (which may be the same as this
+    hybrid_setvec object).
+    */
+    void binary_intersection(
+        size_t                  this_target  ,
+        size_t                  this_left    ,
+        size_t                  other_right  ,
+        const hybrid_setvec&    other        )
+    {   CPPAD_ASSERT_UNKNOWN( post_[this_left] == 0 );
+        CPPAD_ASSERT_UNKNOWN( other.post_[ other_right ] == 0 );
+        //
+        CPPAD_ASSERT_UNKNOWN( this_target < start_.size()         );
+        CPPAD_ASSERT_UNKNOWN( this_left   < start_.size()         );
+        CPPAD_ASSERT_UNKNOWN( other_right < other.start_.size()   );
+        CPPAD_ASSERT_UNKNOWN( end_        == other.end_           );
+        //
+        // case where one of the operands is empty
+        if( start_[this_left] == 0 || other.start_[other_right] == 0 )
+        {   clear(this_target);
+            return;
+        }
+        //
+        // case where both operands are bitmaps
+        if( is_bitmap(this_left) & other.is_bitmap(other_right) )
+        {   const Pack* left  = data_.data() + start_[this_left] + 3;
+            const Pack* right =
+                other.data_.data() + other.start_[other_right] + 3;
+            bitmap_result_.resize(n_pack_);
+            Pack* result = bitmap_result_.data();
+            for(size_t k = 0; k < n_pack_; ++k)
+                result[k] = left[k] & right[k];
+            store_bitmap(this_target, bitmap_result_);
+            return;
+        }
+        //
+        // general case
+        get_runs(*this, this_left, run_left_);
+        get_runs(other, other_right, run_right_);
+        run_intersection();
+        store_runs(this_target, run_result_);
+    }
+    // -----------------------------------------------------------------
+    /*! Fetch n_set for vector of sets object.
+
+    \return
+    Number of from sets for this vector of sets object
+    */
+    size_t n_set(void) const
+    {   return start_.size(); }
+    // -----------------------------------------------------------------
+    /*! Fetch end for this vector of sets object.
+
+    \return
+    is the maximum element value plus one (the minimum element value is 0).
+    */
+    size_t end(void) const
+    {   return end_; }
+    // -----------------------------------------------------------------
+    /*! Amount of memory used by this vector of sets
+
+    \return
+    The amount of memory in units of type unsigned char memory.
+    */
+    size_t memory(void) const
+    {   size_t capacity = data_.capacity() + start_.capacity();
+        capacity       += post_.capacity() + run_left_.capacity();
+        capacity       += run_right_.capacity() + run_result_.capacity();
+        capacity       += bitmap_result_.capacity();
+        return capacity * sizeof(size_t);
+    }
+    /*!
+    Print the vector of sets (used for debugging)
+    */
+    void print(void) const;
+};
+// =========================================================================
+/*!
+cons_iterator for one set of positive integers in a hybrid_setvec object.
+
+All the public member functions for this class are also in the
+sparse::pack_setvec_const_iterator and sparse::list_setvec_const_iterator
+classes. This defines the CppAD vector_of_sets iterator concept.
+*/
+class hybrid_setvec_const_iterator {
+private:
+    /// data for the entire vector of sets
+    const pod_vector<size_t>& data_;
+
+    /// Number of bits per Pack value
+    const size_t                   n_bit_;
+
+    /// Possible elements in a list are 0, 1, ..., end_ - 1;
+    const size_t                   end_;
+
+    /// container kind for this set
+    size_t                         kind_;
+
+    /// data index of the first word in the container for this set
+    size_t                         index_;
+
+    /// number of words in the container for this set
+    size_t                         n_word_;
+
+    /// index of current word in the container
+    /// (for a run container it is the index of the current run first)
+    size_t                         current_;
+
+    /// current element value, end_ for no more elements
+    size_t                         element_;
+public:
+    /// construct a const_iterator for a set in a hybrid_setvec object
+    hybrid_setvec_const_iterator (const hybrid_setvec& vec_set, size_t i)
+    :
+    data_( vec_set.data_ )   ,
+    n_bit_( vec_set.n_bit_ ) ,
+    end_ ( vec_set.end_ )    ,
+    kind_(0)                 ,
+    index_(0)                ,
+    n_word_(0)               ,
+    current_(0)              ,
+    element_( vec_set.end_ )
+    {   CPPAD_ASSERT_UNKNOWN( vec_set.post_[i] == 0 );
+        //
+        size_t start = vec_set.start_[i];
+        if( start == 0 )
+            return;
+        kind_   = data_[start];
+        n_word_ = data_[start + 2];
+        index_  = start + 3;
+        if( kind_ == hybrid_setvec::bitmap_kind )
+        {   element_ = hybrid_setvec::next_bit(
+                data_.data() + index_, n_word_, n_bit_, end_, 0, true
+            );
+        }
+        else
+            element_ = data_[index_];
+        CPPAD_ASSERT_UNKNOWN( element_ < end_ );
+    }
+
+    /// advance to next element in this set
+    hybrid_setvec_const_iterator& operator++(void)
+    {   if( element_ == end_ )
+            return *this;
+        switch( kind_ )
+        {   case hybrid_setvec::array_kind:
+            if( ++current_ < n_word_ )
+                element_ = data_[index_ + current_];
+            else
+                element_ = end_;
+            break;
+
+            case hybrid_setvec::run_kind:
+            if( ++element_ == data_[index_ + current_ + 1] )
+            {   current_ += 2;
+                if( current_ < n_word_ )
+                    element_ = data_[index_ + current_];
+                else
+                    element_ = end_;
+            }
+            break;
+
+            default:
+            CPPAD_ASSERT_UNKNOWN( kind_ == hybrid_setvec::bitmap_kind );
+            element_ = hybrid_setvec::next_bit(
+                data_.data() + index_, n_word_, n_bit_, end_, element_ + 1, true
+            );
+            break;
+        }
+        return *this;
+    }
+
+    /// obtain value of this element of the set of positive integers
+    /// (end_ for no such element)
+    size_t operator*(void)
+    {   return element_; }
+};
+// =========================================================================
+/*!
+Print the vector of sets (used for debugging)
+*/
+inline void hybrid_setvec::print(void) const
+{   std::cout << "hybrid_setvec:\n";
+    for(size_t i = 0; i < n_set(); i++)
+    {   std::cout << "set[" << i << "] = {";
+        const_iterator itr(*this, i);
+        while( *itr != end() )
+        {   std::cout << *itr;
+            if( *(++itr) != end() )
+                std::cout << ",";
+        }
+        std::cout << "}\n";
+    }
+    return;
+}
+
+/*!
+Copy a user vector of sets sparsity pattern to an internal hybrid_setvec object.
+
+\tparam SetVector
+is a simple vector with elements of type std::set<size_t>.
+
+\param internal
+The input value of sparisty does not matter.
+Upon return it contains the same sparsity pattern as user
+(or the transposed sparsity pattern).
+
+\param user
+sparsity pattern that we are placing internal.
+
+\param n_set
+number of sets (rows) in the internal sparsity pattern.
+
+\param end
+end of set value (number of columns) in the interanl sparsity pattern.
+
+\param transpose
+if true, the user sparsity patter is the transposed.
+
+\param error_msg
+is the error message to display if some values in the user sparstiy
+pattern are not valid.
+*/
+template<class SetVector>
+void sparsity_user2internal(
+    hybrid_setvec&          internal  ,
+    const SetVector&        user      ,
+    size_t                  n_set     ,
+    size_t                  end       ,
+    bool                    transpose ,
+    const char*             error_msg )
+{
+# ifndef NDEBUG
+    if( transpose )
+        CPPAD_ASSERT_KNOWN( end == size_t( user.size() ), error_msg);
+    if( ! transpose )
+        CPPAD_ASSERT_KNOWN( n_set == size_t( user.size() ), error_msg);
+# endif
+
+    // iterator for user set
+    std::set<size_t>::const_iterator itr;
+
+    // size of internal sparsity pattern
+    internal.resize(n_set, end);
+
+    if( transpose )
+    {   // transposed pattern case
+        for(size_t j = 0; j < end; j++)
+        {   itr = user[j].begin();
+            while(itr != user[j].end())
+            {   size_t i = *itr++;
+                CPPAD_ASSERT_KNOWN(i < n_set, error_msg);
+                internal.post_element(i, j);
+            }
+        }
+        for(size_t i = 0; i < n_set; i++)
+            internal.process_post(i);
+    }
+    else
+    {   for(size_t i = 0; i < n_set; i++)
+        {   itr = user[i].begin();
+            while(itr != user[i].end())
+            {   size_t j = *itr++;
+                CPPAD_ASSERT_KNOWN( j < end, error_msg);
+                internal.post_element(i, j);
+            }
+            internal.process_post(i);
+        }
+    }
+    return;
+}
+
+} } } // END_CPPAD_LOCAL_SPARSE_NAMESPACE
+# endif
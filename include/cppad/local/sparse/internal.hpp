@@ -17,6 +17,7 @@ in the Eclipse Public License, Version 2.0 are satisfied:
 # include <cppad/local/sparse/pack_setvec.hpp>
 # include <cppad/local/sparse/list_setvec.hpp>
 # include <cppad/local/sparse/svec_setvec.hpp>
+# include <cppad/local/sparse/hybrid_setvec.hpp>
 
 // BEGIN_CPPAD_LOCAL_SPARSE_NAMESPACE
 namespace CppAD { namespace local { namespace sparse {
@@ -11,6 +11,7 @@ Secondary License when the conditions for such availability set forth
 in the Eclipse Public License, Version 2.0 are satisfied:
       GNU General Public License, Version 2.0 or later.
 ---------------------------------------------------------------------------- */
+# include <bitset>
 # include <cppad/core/cppad_assert.hpp>
 # include <cppad/local/pod_vector.hpp>
 
@@ -73,6 +74,45 @@ private:
 /* %$$
 $end
 -----------------------------------------------------------------------------
+$begin pack_setvec_bit_count$$
+$spell
+    setvec
+    popcount
+$$
+
+$section class pack_setvec: Number of Non-Zero Bits in a Pack Value$$
+
+$head Syntax$$
+$icode%count% = pack_setvec::bit_count(%unit%)
+%$$
+$icode%index% = pack_setvec::low_bit(%unit%)
+%$$
+
+$head bit_count$$
+The return value $icode count$$ is the number of bits that are
+non-zero in $icode unit$$.
+It uses $code std::bitset$$ so that the compiler can use
+a population count instruction when it is available.
+
+$head low_bit$$
+The value $icode unit$$ must not be zero and
+the return value $icode index$$ is the index of its lowest order
+non-zero bit.
+
+$head Implementation$$
+$srccode%hpp% */
+public:
+    static size_t bit_count(Pack unit)
+    {   return std::bitset< std::numeric_limits<Pack>::digits >(unit).count();
+    }
+    static size_t low_bit(Pack unit)
+    {   CPPAD_ASSERT_UNKNOWN( unit != 0 );
+        // the bits below the lowest order non-zero bit
+        return bit_count( (unit & (~unit + 1)) - 1 );
+    }
+/* %$$
+$end
+-----------------------------------------------------------------------------
 $begin pack_setvec_vec_memory$$
 $spell
     setvec
@@ -359,36 +399,21 @@ $end
             return size_t( data_[i] );
         }
         //
-        // initialize count of non-zero bits in this set
-        size_t count = 0;
-        //
-        // mask corresonding to first bit in Pack
-        Pack mask = one_;
-        //
         // number of bits in last Packing unit
         size_t n_last = (end_ - 1) % n_bit_ + 1;
         //
+        // mask for the bits in the last unit that are less than end_
+        Pack mask = ~zero_;
+        if( n_last < n_bit_ )
+            mask = (one_ << n_last) - one_;
+        //
         // count bits in last unit
-        Pack unit = data_[(i + 1) * n_pack_ - 1];
-        for(size_t bit = 0; bit < n_last; ++bit)
-        {   CPPAD_ASSERT_UNKNOWN( mask >= one_ );
-            if( mask & unit )
-                ++count;
-            mask = mask << 1;
-        }
-        if( n_pack_ == 1 )
-            return count;
+        const Pack* unit = data_.data() + i * n_pack_;
+        size_t count     = bit_count( unit[n_pack_ - 1] & mask );
         //
         // count bits in other units
-        for(size_t bit = 0; bit < n_bit_; ++bit)
-        {   CPPAD_ASSERT_UNKNOWN( mask >= one_ );
-            size_t k = n_pack_;
-            while(--k)
-            {   if( data_[i * n_pack_ + k] & mask )
-                    ++count;
-            }
-            mask = mask << 1;
-        }
+        for(size_t k = 0; k < n_pack_ - 1; ++k)
+            count += bit_count( unit[k] );
         return count;
     }
 /*
@@ -508,11 +533,9 @@ public:
 $end
 */
     {   CPPAD_ASSERT_UNKNOWN( target < n_set_ );
-        size_t t = target * n_pack_;
-
-        size_t j = n_pack_;
-        while(j--)
-            data_[t++] = zero_;
+        Pack* t = data_.data() + target * n_pack_;
+        for(size_t k = 0; k < n_pack_; ++k)
+            t[k] = zero_;
     }
 /*
 -------------------------------------------------------------------------------
@@ -539,12 +562,14 @@ $end
     {   CPPAD_ASSERT_UNKNOWN( this_target  <   n_set_        );
         CPPAD_ASSERT_UNKNOWN( other_value  <   other.n_set_  );
         CPPAD_ASSERT_UNKNOWN( n_pack_      ==  other.n_pack_ );
-        size_t t = this_target * n_pack_;
-        size_t v = other_value * n_pack_;
-
-        size_t j = n_pack_;
-        while(j--)
-            data_[t++] = other.data_[v++];
+        Pack*       t = data_.data() + this_target * n_pack_;
+        const Pack* v = other.data_.data() + other_value * n_pack_;
+        //
+        // t and v are either equal or do not overlap
+        if( t == v )
+            return;
+        for(size_t k = 0; k < n_pack_; ++k)
+            t[k] = v[k];
     }
 /*
 -------------------------------------------------------------------------------
@@ -574,13 +599,20 @@ $end
         CPPAD_ASSERT_UNKNOWN( other_right < other.n_set_   );
         CPPAD_ASSERT_UNKNOWN( n_pack_    ==  other.n_pack_ );
 
-        size_t t  = this_target * n_pack_;
-        size_t l  = this_left  * n_pack_;
-        size_t r  = other_right * n_pack_;
-
-        size_t j = n_pack_;
-        while(j--)
-            data_[t++] = ( data_[l++] | other.data_[r++] );
+        // The element by element loops below are written so the compiler
+        // can use vector instructions; t, l, and r are either equal or
+        // do not overlap.
+        Pack*       t = data_.data() + this_target * n_pack_;
+        const Pack* l = data_.data() + this_left   * n_pack_;
+        const Pack* r = other.data_.data() + other_right * n_pack_;
+        if( t == l )
+        {   for(size_t k = 0; k < n_pack_; ++k)
+                t[k] |= r[k];
+        }
+        else
+        {   for(size_t k = 0; k < n_pack_; ++k)
+                t[k] = l[k] | r[k];
+        }
     }
 /*
 -------------------------------------------------------------------------------
@@ -610,13 +642,18 @@ $end
         CPPAD_ASSERT_UNKNOWN( other_right < other.n_set_   );
         CPPAD_ASSERT_UNKNOWN( n_pack_    ==  other.n_pack_ );
 
-        size_t t  = this_target * n_pack_;
-        size_t l  = this_left  * n_pack_;
-        size_t r  = other_right * n_pack_;
-
-        size_t j = n_pack_;
-        while(j--)
-            data_[t++] = ( data_[l++] & other.data_[r++] );
+        // see binary_union for the loops below
+        Pack*       t = data_.data() + this_target * n_pack_;
+        const Pack* l = data_.data() + this_left   * n_pack_;
+        const Pack* r = other.data_.data() + other_right * n_pack_;
+        if( t == l )
+        {   for(size_t k = 0; k < n_pack_; ++k)
+                t[k] &= r[k];
+        }
+        else
+        {   for(size_t k = 0; k < n_pack_; ++k)
+                t[k] = l[k] & r[k];
+        }
     }
 // ==========================================================================
 }; // END_CLASS_PACK_SETVEC
@@ -773,29 +810,24 @@ $end
         if( bit == 0 )
             ++data_index_;
         //
-        // initialize mask
-        size_t mask = one_ << bit;
+        // bits in this unit that correspond to next_element_ and above
+        Pack unit = data_[data_index_] >> bit;
         //
-        while( next_element_ < end_ )
-        {   // check if this element is in the set
-            if( data_[data_index_] & mask )
+        // skip units that are zero
+        while( unit == 0 )
+        {   next_element_ += n_bit_ - bit;
+            if( next_element_ >= end_ )
+            {   next_element_ = end_;
                 return *this;
-            //
-            // try next larger element
-            ++next_element_;
-            ++bit;
-            mask <<= 1;
-            //
-            // check if we must go to next packed data index
-            CPPAD_ASSERT_UNKNOWN( bit <= n_bit_ );
-            if( bit == n_bit_ )
-            {   // get next packed value
-                bit   = 0;
-                mask  = one_;
-                ++data_index_;
             }
+            bit  = 0;
+            unit = data_[++data_index_];
         }
-        CPPAD_ASSERT_UNKNOWN( next_element_ == end_ );
+        //
+        // lowest order non-zero bit
+        next_element_ += pack_setvec::low_bit(unit);
+        if( next_element_ > end_ )
+            next_element_ = end_;
         return *this;
     }
 // =========================================================================
@@ -12,15 +12,16 @@ in the Eclipse Public License, Version 2.0 are satisfied:
       GNU General Public License, Version 2.0 or later.
 ---------------------------------------------------------------------------- */
 
+# include <set>
 # include <cppad/local/define.hpp>
-
-// needed before one can use CPPAD_ASSERT_FIRST_CALL_NOT_PARALLEL
 # include <cppad/utility/thread_alloc.hpp>
 
 namespace CppAD { namespace local { // BEGIN_CPPAD_LOCAL_NAMESPACE
 /*!
 \file std_set.hpp
 Two constant standard sets (currently used for concept checking).
+The sets are constructed during the initialization of function scope
+statics, so the first call can be in parallel mode.
 */
 
 /*!
@@ -28,10 +29,8 @@ A standard set with one element.
 */
 template <class Scalar>
 const std::set<Scalar>& one_element_std_set(void)
-{   CPPAD_ASSERT_FIRST_CALL_NOT_PARALLEL;
-    static std::set<Scalar> one;
-    if( one.empty() )
-        one.insert(1);
+{   static const Scalar element[] = { Scalar(1) };
+    static const std::set<Scalar> one(element, element + 1);
     return one;
 }
 /*!
@@ -39,12 +38,8 @@ A standard set with a two elements.
 */
 template <class Scalar>
 const std::set<Scalar>& two_element_std_set(void)
-{   CPPAD_ASSERT_FIRST_CALL_NOT_PARALLEL;
-    static std::set<Scalar> two;
-    if( two.empty() )
-    {   two.insert(1);
-        two.insert(2);
-    }
+{   static const Scalar element[] = { Scalar(1), Scalar(2) };
+    static const std::set<Scalar> two(element, element + 2);
     return two;
 }
 
@@ -0,0 +1,310 @@
+# ifndef CPPAD_LOCAL_SUBGRAPH_SEPARABLE_HPP
+# define CPPAD_LOCAL_SUBGRAPH_SEPARABLE_HPP
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-22 Bradley M. Bell
+
+CppAD is distributed under the terms of the
+             Eclipse Public License Version 2.0.
+
+This Source Code may also be made available under the following
+Secondary License when the conditions for such availability set forth
+in the Eclipse Public License, Version 2.0 are satisfied:
+      GNU General Public License, Version 2.0 or later.
+---------------------------------------------------------------------------- */
+
+# include <cppad/local/pod_vector.hpp>
+# include <cppad/local/subgraph/arg_variable.hpp>
+# include <cppad/local/subgraph/info.hpp>
+# include <cppad/local/sparse/list_setvec.hpp>
+
+// BEGIN_CPPAD_LOCAL_SUBGRAPH_NAMESPACE
+namespace CppAD { namespace local { namespace subgraph {
+/*!
+\file separable.hpp
+Compute Hessian sparsity pattern for a sum of terms using subgraph technique.
+*/
+// ===========================================================================
+/*!
+Variables that are arguments to an operator and that affect the value
+of its second derivative.
+
+\tparam Addr
+type used for indices in random iterator
+(must correspond to play->addr_type())
+
+\param random_itr
+is a random iterator for this operation sequence.
+
+\param i_op
+is the operator index. If this operator is an atomic function call,
+it must be the first AFunOp in the call.
+
+\param variable
+The input size and contents of this vector do not matter.
+Upon return it contains the tape index for the variables that are arguments
+for this operator and have a non-zero derivative.
+This is the same as get_argument_variable except that
+the comparison arguments for CExpOp are not included,
+and SignOp and DisOp have no such arguments (their derivative is zero).
+
+\param work
+this is work space used by get_argument_variable.
+*/
+template <class Addr>
+void get_derivative_variable(
+    const play::const_random_iterator<Addr>& random_itr  ,
+    size_t                                   i_op        ,
+    pod_vector<size_t>&                      variable    ,
+    pod_vector<bool>&                        work        )
+{   OpCode op = random_itr.get_op(i_op);
+    switch( op )
+    {   case SignOp:
+        case DisOp:
+        variable.resize(0);
+        break;
+
+        case CExpOp:
+        {   variable.resize(0);
+            OpCode        op_tmp;
+            const addr_t* op_arg;
+            size_t        i_var;
+            random_itr.op_info(i_op, op_tmp, op_arg, i_var);
+            if( op_arg[1] & 4 )
+                variable.push_back( size_t( op_arg[4] ) );
+            if( op_arg[1] & 8 )
+                variable.push_back( size_t( op_arg[5] ) );
+        }
+        break;
+
+        default:
+        get_argument_variable(random_itr, i_op, variable, work);
+        break;
+    }
+}
+// ===========================================================================
+/*!
+Compute a Hessian sparsity pattern for the sum of the selected dependent
+variables treating the sum as a sum of terms.
+
+\tparam Addr
+type used for indices in random iterator
+(must correspond to play->addr_type())
+
+\tparam Base
+the operation sequence was recorded using AD<Base>.
+
+\tparam BoolVector
+a simple vector class with elements of type bool.
+
+\param play
+is the operation sequence corresponding to the ADFun<Base> function.
+It is effectively const except that play->setup_random() is called.
+It must not contain any VecAD operations.
+
+\param sub_info
+is the subgraph information for this ADFun object.
+Only its map_user_op is used (and set if it has size zero).
+
+\param dep_taddr
+mapping from user dependent variable index to variable index in play
+(must have size sub_info.n_dep()).
+
+\param select_domain
+only the selected independent variables will be included in the sparsity
+pattern (must have size sub_info.n_ind()).
+
+\param select_range
+the Hessian is for the sum of the selected dependent variables
+(must have size sub_info.n_dep()).
+
+\param hes_sparsity
+The input value does not matter.
+Upon return it has n_set and end equal to the number of independent
+variables and it is the sparsity pattern for the Hessian.
+
+\par Terms
+Starting at the selected dependent variables, the operators that are linear
+functions of their variable arguments
+(and the if true and if false cases of conditional expressions)
+are followed backwards.
+The other operators reached this way are the terms in the sum.
+For each term, its subgraph is used to determine the set of
+independent variables D_k that it depends on.
+The Hessian sparsity pattern is the union of D_k x D_k for all the terms.
+*/
+template <class Addr, class Base, class BoolVector>
+void separable_hes_sparsity(
+    player<Base>*                              play          ,
+    subgraph_info&                             sub_info      ,
+    const pod_vector<size_t>&                  dep_taddr     ,
+    const BoolVector&                          select_domain ,
+    const BoolVector&                          select_range  ,
+    sparse::list_setvec&                       hes_sparsity  )
+{
+    // get random access iterator for this player
+    play->template setup_random<Addr>();
+    local::play::const_random_iterator<Addr> random_itr =
+        play->template get_random<Addr>();
+
+    // check dimension assumptions
+    CPPAD_ASSERT_UNKNOWN(
+        dep_taddr.size() == sub_info.n_dep()
+    );
+    CPPAD_ASSERT_UNKNOWN(
+        size_t(select_domain.size()) == sub_info.n_ind()
+    );
+    CPPAD_ASSERT_UNKNOWN(
+        size_t(select_range.size()) == sub_info.n_dep()
+    );
+    CPPAD_ASSERT_UNKNOWN( play->num_var_vecad_rec() == 0 );
+
+    // number of independent, dependent variables, and operators
+    size_t n_ind = sub_info.n_ind();
+    size_t n_dep = dep_taddr.size();
+    size_t n_op  = play->num_op_rec();
+
+    // start with an empty sparsity pattern
+    hes_sparsity.resize(n_ind, n_ind);
+
+    // map_user_op
+    if( sub_info.map_user_op().size() == 0 )
+        sub_info.set_map_user_op(play);
+    else
+    {   CPPAD_ASSERT_UNKNOWN( sub_info.check_map_user_op(play) );
+    }
+    const pod_vector<addr_t>& map_user_op( sub_info.map_user_op() );
+    CPPAD_ASSERT_UNKNOWN( map_user_op.size() == n_op );
+
+    // space used to return set of arguments that are variables
+    pod_vector<size_t> argument_variable;
+
+    // temporary space used by get_argument_variable
+    pod_vector<bool> work;
+
+    // stack of operators that have not yet been processed
+    pod_vector<size_t> stack;
+    // -----------------------------------------------------------------------
+    // terms
+    // -----------------------------------------------------------------------
+    // operators that have already been reached from the dependent variables
+    pod_vector<bool> in_sum(n_op);
+    for(size_t i_op = 0; i_op < n_op; ++i_op)
+        in_sum[i_op] = false;
+    //
+    // operator index for each of the terms
+    pod_vector<size_t> term;
+    //
+    for(size_t i_dep = 0; i_dep < n_dep; ++i_dep) if( select_range[i_dep] )
+    {   size_t i_op = random_itr.var2op( dep_taddr[i_dep] );
+        i_op        = size_t( map_user_op[i_op] );
+        if( ! in_sum[i_op] )
+        {   in_sum[i_op] = true;
+            stack.push_back(i_op);
+        }
+    }
+    while( stack.size() > 0 )
+    {   size_t i_op = stack[ stack.size() - 1 ];
+        stack.resize( stack.size() - 1 );
+        //
+        OpCode op = random_itr.get_op(i_op);
+        bool linear = false;
+        switch( op )
+        {   // operators that are linear in their variable arguments
+            case AbsOp:
+            case AddpvOp:
+            case AddvvOp:
+            case CExpOp:
+            case CSumOp:
+            case DivvpOp:
+            case MulpvOp:
+            case NegOp:
+            case SubpvOp:
+            case SubvpOp:
+            case SubvvOp:
+            case ZmulpvOp:
+            case ZmulvpOp:
+            linear = true;
+            break;
+
+            // operators with a zero second derivative and no arguments
+            // that are variables with non-zero derivatives
+            case BeginOp:
+            case DisOp:
+            case InvOp:
+            case ParOp:
+            case SignOp:
+            break;
+
+            default:
+            term.push_back(i_op);
+            break;
+        }
+        if( linear )
+        {   get_derivative_variable(
+                random_itr, i_op, argument_variable, work
+            );
+            for(size_t j = 0; j < argument_variable.size(); ++j)
+            {   size_t j_op = random_itr.var2op( argument_variable[j] );
+                j_op        = size_t( map_user_op[j_op] );
+                if( ! in_sum[j_op] )
+                {   in_sum[j_op] = true;
+                    stack.push_back(j_op);
+                }
+            }
+        }
+    }
+    // -----------------------------------------------------------------------
+    // Hessian sparsity for each term
+    // -----------------------------------------------------------------------
+    // in_term[i_op] == k + 1 if i_op is in the subgraph for the k-th term
+    pod_vector<size_t> in_term(n_op);
+    for(size_t i_op = 0; i_op < n_op; ++i_op)
+        in_term[i_op] = 0;
+    //
+    // selected independent variables that the current term depends on
+    pod_vector<size_t> domain;
+    //
+    for(size_t k = 0; k < term.size(); ++k)
+    {   domain.resize(0);
+        stack.push_back( term[k] );
+        in_term[ term[k] ] = k + 1;
+        while( stack.size() > 0 )
+        {   size_t i_op = stack[ stack.size() - 1 ];
+            stack.resize( stack.size() - 1 );
+            //
+            OpCode op = random_itr.get_op(i_op);
+            if( op == InvOp )
+            {   // i_var is equal i_op becasue BeginOp and InvOp have 1 result
+                CPPAD_ASSERT_UNKNOWN( random_itr.var2op(i_op) == i_op );
+                size_t i_ind = i_op - 1;
+                if( select_domain[i_ind] )
+                    domain.push_back(i_ind);
+            }
+            else
+            {   get_derivative_variable(
+                    random_itr, i_op, argument_variable, work
+                );
+                for(size_t j = 0; j < argument_variable.size(); ++j)
+                {   size_t j_op = random_itr.var2op( argument_variable[j] );
+                    j_op        = size_t( map_user_op[j_op] );
+                    if( in_term[j_op] != k + 1 )
+                    {   in_term[j_op] = k + 1;
+                        stack.push_back(j_op);
+                    }
+                }
+            }
+        }
+        // post domain x domain to the sparsity pattern
+        for(size_t i = 0; i < domain.size(); ++i)
+        {   for(size_t j = 0; j < domain.size(); ++j)
+                hes_sparsity.post_element(domain[i], domain[j]);
+        }
+    }
+    // process the posts
+    for(size_t i_ind = 0; i_ind < n_ind; ++i_ind)
+        hes_sparsity.process_post(i_ind);
+}
+
+} } } // END_CPPAD_LOCAL_SUBGRAPH_NAMESPACE
+
+# endif
@@ -16,6 +16,7 @@ in the Eclipse Public License, Version 2.0 are satisfied:
 # include <cppad/local/subgraph/arg_variable.hpp>
 # include <cppad/local/subgraph/info.hpp>
 # include <cppad/local/subgraph/entire_call.hpp>
+# include <cppad/utility/vector.hpp>
 
 // BEGIN_CPPAD_LOCAL_SUBGRAPH_NAMESPACE
 namespace CppAD { namespace local { namespace subgraph {
@@ -25,6 +26,47 @@ Compute dependency sparsity pattern using subgraph technique.
 */
 // ===========================================================================
 /*!
+Row callback that appends each row of a sparsity pattern to
+row and column index vectors.
+*/
+class append_row {
+private:
+    /// row index for each element of the sparsity pattern
+    pod_vector<size_t>& row_out_;
+    /// column index for each element of the sparsity pattern
+    pod_vector<size_t>& col_out_;
+public:
+    /*!
+    constructor
+
+    \param row_out
+    row index vector that this object appends to
+    (the input value of this vector is not changed by the constructor).
+
+    \param col_out
+    column index vector that this object appends to.
+    */
+    append_row(pod_vector<size_t>& row_out, pod_vector<size_t>& col_out)
+    : row_out_(row_out), col_out_(col_out)
+    { }
+    /*!
+    append one row of the sparsity pattern
+
+    \param i
+    is the row index.
+
+    \param col
+    is the column index for each element of row i.
+    */
+    void operator()(size_t i, const vector<size_t>& col)
+    {   for(size_t k = 0; k < col.size(); ++k)
+        {   row_out_.push_back(i);
+            col_out_.push_back( col[k] );
+        }
+    }
+};
+// ===========================================================================
+/*!
 Compute dependency sparsity pattern for an ADFun<Base> function.
 
 \tparam Addr
@@ -37,6 +79,9 @@ the operation sequence was recorded using AD<Base>.
 \tparam BoolVector
 a simple vector class with elements of type bool.
 
+\tparam RowCallback
+is a function object that is called for each selected row; see row_callback.
+
 \param play
 is the operation sequence corresponding to the ADFun<Base> function.
 It is effectively const except that play->setup_random() is called.
@@ -57,27 +102,17 @@ pattern (must have size sub_info.n_ind()).
 only the selected dependent variables will be included in the sparsity pattern
 (must have size sub_info.n_dep()).
 
-\param row_out
-The input size and elements of row_out do not matter.
-We use number of non-zeros (nnz) to denote the number of elements
-in row_out. For k = 0 , ... , nnz-1, row_out[k] is the row index
-of the k-th no-zero element of the dependency sparsitiy pattern for
-the function corresponding to the recording.
-\code
-    0 <= row_out[k] < dep_taddr.size()
-    select_range[ row_out[k] ] == true
-\endcode
-
-\param col_out
-The input size and elements of col_out do not matter.
-Upon return is has the same size as row_out; i.e., nnz.
-For k = 0 , ... , nnz-1, col_out[k] is the column index
-of the k-th no-zero element of the dependency sparsitiy pattern for
-the function corresponding to the recording.
+\param row_callback
+For each selected dependent variable (row) i, the syntax
 \code
-    0 <= col_out[k] < sub_info.n_ind()
-    select_domain[ col_out[k] ] == true
+    row_callback(i, col)
 \endcode
+is used to report the i-th row of the dependency sparsity pattern.
+Here col is a const vector<size_t>& and contains the column index
+(independent variable index) for each element of the row.
+The rows are reported in increasing order.
+The memory used by col is reused for the next row,
+so the memory for the entire sparsity pattern is never allocated.
 
 \par AFunOp
 All of the inputs and outputs for an atomic function call are considered
@@ -86,15 +121,14 @@ to be connected.
 to to make the sparsity pattern more efficient.
 */
 
-template <class Addr, class Base, class BoolVector>
+template <class Addr, class Base, class BoolVector, class RowCallback>
 void subgraph_sparsity(
     player<Base>*                              play          ,
     subgraph_info&                             sub_info      ,
     const pod_vector<size_t>&                  dep_taddr     ,
     const BoolVector&                          select_domain ,
     const BoolVector&                          select_range  ,
-    pod_vector<size_t>&                        row_out       ,
-    pod_vector<size_t>&                        col_out       )
+    RowCallback&                               row_callback  )
 {
     // get random access iterator for this player
     play->template setup_random<Addr>();
@@ -116,9 +150,8 @@ void subgraph_sparsity(
     size_t n_dep = dep_taddr.size();
     CPPAD_ASSERT_UNKNOWN( size_t(select_range.size()) == n_dep );
 
-    // start with an empty sparsity pattern
-    row_out.resize(0);
-    col_out.resize(0);
+    // column indices for the current row of the sparsity pattern
+    vector<size_t> col;
 
     // map_user_op
     if( sub_info.map_user_op().size() == 0 )
@@ -159,6 +192,7 @@ void subgraph_sparsity(
             random_itr, dep_taddr, addr_t(i_dep), subgraph
         );
         //
+        col.resize(0);
         for(size_t k = 0; k < subgraph.size(); k++)
         {   size_t i_op = size_t( subgraph[k] );
             //
@@ -178,11 +212,12 @@ void subgraph_sparsity(
                 CPPAD_ASSERT_UNKNOWN( random_itr.var2op(i_var) == i_op );
                 CPPAD_ASSERT_UNKNOWN( select_domain[i_ind] );
                 //
-                // put this pair in the sparsity pattern
-                row_out.push_back(i_dep);
-                col_out.push_back(i_ind);
+                // put this column in the current row
+                col.push_back(i_ind);
             }
         }
+        // report this row of the sparsity pattern
+        row_callback(i_dep, col);
     }
 }
 
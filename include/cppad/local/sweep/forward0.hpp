@@ -34,6 +34,8 @@ $spell
     Pri
     num
     Vec
+    arg
+    VecAD
 $$
 $section Compute Zero Order Forward Mode Taylor Coefficients$$
 
@@ -51,6 +53,8 @@ $codei% forward0(
     %compare_change_count%,
     %compare_change_number%,
     %compare_change_op_index%,
+    %slot_op%,
+    %slot_arg%,
     %not_used_rec_base%
 )%$$
 
@@ -78,9 +82,10 @@ $head n$$
 is the number of independent variables on the tape.
 
 $head numvar$$
-is the total number of variables on the tape.
-This is also equal to the number of rows in the matrix taylor; i.e.,
-$icode%play%->num_var_rec()%$$.
+is the number of rows in the matrix taylor.
+If $icode slot_op$$ is null, this is the total number of variables on the
+tape; i.e., $icode%play%->num_var_rec()%$$.
+Otherwise it is the number of slots; see $cref optimize_get_var_slot$$.
 
 $head play$$
 The information stored in play
@@ -146,6 +151,23 @@ play was recorded.
 This is not the first comparison that is different,
 but rather the $icode compare_change_count$$ comparison.
 
+$head slot_op$$
+If this is null, the row index in $icode taylor$$ for a variable is its
+index on the tape.
+Otherwise, $icode%slot_op%[%i%]%$$ is the row index in $icode taylor$$
+for the primary result of the $th i$$ operator; see
+$cref/slot_op/optimize_get_var_slot/slot_op/$$.
+In this case only the values for the independent variables,
+the dependent variables, and the variables stored in VecAD vectors
+are valid upon return.
+
+$head slot_arg$$
+If $icode slot_op$$ is null, this must also be null.
+Otherwise, it has the same size as the argument vector for $icode play$$
+and the variable indices have been replaced by the corresponding row indices
+in $icode taylor$$; see
+$cref/slot_arg/optimize_get_var_slot/slot_arg/$$.
+
 $head not_used_rec_base$$
 Specifies $icode RecBase$$ for this call.
 
@@ -166,10 +188,13 @@ void forward0(
     size_t                     compare_change_count,
     size_t&                    compare_change_number,
     size_t&                    compare_change_op_index,
+    const addr_t*              slot_op,
+    const addr_t*              slot_arg,
     const RecBase&             not_used_rec_base
 )
 {   CPPAD_ASSERT_UNKNOWN( J >= 1 );
-    CPPAD_ASSERT_UNKNOWN( play->num_var_rec() == numvar );
+    CPPAD_ASSERT_UNKNOWN( (slot_op == nullptr) == (slot_arg == nullptr) );
+    CPPAD_ASSERT_UNKNOWN( slot_op != nullptr || play->num_var_rec() == numvar );
 
     // use p, q, r so other forward sweeps can use code defined here
     size_t p = 0;
@@ -251,6 +276,9 @@ void forward0(
     itr.op_info(op, arg, i_var);
     CPPAD_ASSERT_UNKNOWN( op == BeginOp );
     //
+    // first argument for the BeginOp (used to index into slot_arg)
+    const Addr* arg_0 = arg;
+    //
 # if CPPAD_FORWARD0_TRACE
     std::cout << std::endl;
 # endif
@@ -294,6 +322,12 @@ void forward0(
             (++itr).op_info(op, arg, i_var);
         }
 
+        // map arguments and result to slots
+        if( slot_op != nullptr )
+        {   arg   = slot_arg + (arg - arg_0);
+            i_var = size_t( slot_op[ itr.op_index() ] );
+        }
+
         // action to take depends on the case
         switch( op )
         {
@@ -0,0 +1,139 @@
+# ifndef CPPAD_LOCAL_THREAD_REGISTRY_HPP
+# define CPPAD_LOCAL_THREAD_REGISTRY_HPP
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-22 Bradley M. Bell
+
+CppAD is distributed under the terms of the
+             Eclipse Public License Version 2.0.
+
+This Source Code may also be made available under the following
+Secondary License when the conditions for such availability set forth
+in the Eclipse Public License, Version 2.0 are satisfied:
+      GNU General Public License, Version 2.0 or later.
+---------------------------------------------------------------------------- */
+# include <atomic>
+# include <cstddef>
+# include <cassert>
+
+namespace CppAD { namespace local { // BEGIN_CPPAD_LOCAL_NAMESPACE
+/*!
+\file thread_registry.hpp
+Growable array of per-thread values.
+*/
+
+/*!
+Growable array with one element for each thread.
+
+The elements are stored in segments that are never moved or freed
+(until the registry is destroyed). Segment s has n_first_ * 2^s elements,
+so a small number of segments covers any number of threads.
+A segment is allocated the first time one of its elements is accessed.
+Different threads can access the registry at the same time
+(and cause segments to be allocated) without using a lock.
+
+\tparam Type
+is the type of the elements. It must have a default constructor,
+and value initialization is used for the elements; e.g.,
+pointers are initialized as nullptr and integers as zero.
+*/
+template <class Type>
+class thread_registry {
+private:
+    /// number of elements in the first segment
+    static const size_t n_first_ = 16;
+    /// maximum number of segments
+    static const size_t n_segment_ = 32;
+    /// pointer to each segment (nullptr if not yet allocated)
+    std::atomic<Type*> segment_[n_segment_];
+    // ------------------------------------------------------------------------
+    /// number of elements in segment s
+    static size_t segment_size(size_t s)
+    {   return n_first_ << s; }
+    /// index of the first element in segment s
+    static size_t segment_start(size_t s)
+    {   return n_first_ * ( (size_t(1) << s) - 1 ); }
+    /*!
+    pointer to a segment, allocating it if necessary
+
+    \param s
+    is the segment index.
+
+    \return
+    is a pointer to the first element of the segment.
+    */
+    Type* get_segment(size_t s)
+    {   Type* ptr = segment_[s].load(std::memory_order_acquire);
+        if( ptr != nullptr )
+            return ptr;
+        //
+        // allocate the lower segments first so the allocated elements
+        // are always the first size() elements
+        if( s > 0 )
+            get_segment(s - 1);
+        //
+        Type* new_ptr = new Type[ segment_size(s) ]();
+        if( segment_[s].compare_exchange_strong(
+            ptr, new_ptr, std::memory_order_acq_rel, std::memory_order_acquire
+        ) )
+            return new_ptr;
+        //
+        // another thread allocated this segment first
+        delete [] new_ptr;
+        return ptr;
+    }
+public:
+    /// constructor
+    thread_registry(void)
+    {   for(size_t s = 0; s < n_segment_; ++s)
+            segment_[s].store(nullptr, std::memory_order_relaxed);
+    }
+    /// destructor
+    ~thread_registry(void)
+    {   for(size_t s = 0; s < n_segment_; ++s)
+            delete [] segment_[s].load(std::memory_order_relaxed);
+    }
+    /// the segments are owned by this object
+    thread_registry(const thread_registry& other) = delete;
+    thread_registry& operator=(const thread_registry& other) = delete;
+    // ------------------------------------------------------------------------
+    /*!
+    number of elements that have been allocated
+
+    \return
+    the elements with index less than the return value have been allocated.
+    Accessing them does not allocate memory.
+    */
+    size_t size(void) const
+    {   size_t s = 0;
+        while( s < n_segment_ &&
+            segment_[s].load(std::memory_order_acquire) != nullptr
+        )   ++s;
+        return segment_start(s);
+    }
+    /*!
+    element corresponding to a thread
+
+    \param thread
+    is the index of the element. If this element has not yet been allocated,
+    it is allocated with value initialization.
+
+    \return
+    is a reference to the element. Different threads must not access the same
+    element at the same time, unless they are all only reading its value.
+    */
+    Type& operator[](size_t thread)
+    {   if( thread < n_first_ )
+            return get_segment(0)[thread];
+        //
+        // segment containing this thread
+        size_t s = 0;
+        while( segment_start(s + 1) <= thread )
+            ++s;
+        assert( s < n_segment_ );
+        return get_segment(s)[ thread - segment_start(s) ];
+    }
+};
+
+} } // END_CPPAD_LOCAL_NAMESPACE
+
+# endif
@@ -39,6 +39,7 @@ in the Eclipse Public License, Version 2.0 are satisfied:
 # include <cppad/utility/speed_test.hpp>
 # include <cppad/utility/test_boolofvoid.hpp>
 # include <cppad/utility/thread_alloc.hpp>
+# include <cppad/utility/thread_pool.hpp>
 # include <cppad/utility/time_test.hpp>
 # include <cppad/utility/to_string.hpp>
 # include <cppad/utility/track_new_del.hpp>
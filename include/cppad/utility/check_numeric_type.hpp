@@ -75,10 +75,8 @@ namespace CppAD {
 # else
     template <class NumericType>
     NumericType CheckNumericType(void)
-    {   // Section 3.6.2 of ISO/IEC 14882:1998(E) states: "The storage for
-        // objects with static storage duration (3.7.1) shall be zero-
-        // initialized (8.5) before any other initialization takes place."
-        static size_t count[CPPAD_MAX_NUM_THREADS];
+    {   // the elements of count are initialized as zero
+        static local::thread_registry<size_t> count;
         size_t thread = thread_alloc::thread_num();
         if( count[thread] > 0  )
             return NumericType(0);
@@ -97,6 +97,7 @@ $end
 */
 
 # include <cstddef>
+# include <atomic>
 # include <cppad/core/cppad_assert.hpp>
 # include <cppad/local/define.hpp>
 # include <cppad/utility/thread_alloc.hpp>
@@ -119,11 +120,12 @@ namespace CppAD {
 
     template <class Scalar, class Vector>
     void CheckSimpleVector(const Scalar& x, const Scalar& y)
-    {   CPPAD_ASSERT_FIRST_CALL_NOT_PARALLEL
-        static size_t count;
-        if( count > 0  )
+    {   // only do these checks once to save time
+        // (atomic so that the first call can be in parallel mode)
+        static std::atomic<bool> checked(false);
+        if( checked.load(std::memory_order_relaxed) )
             return;
-        count++;
+        checked.store(true, std::memory_order_relaxed);
 
         // value_type must be type of elements of Vector
         typedef typename Vector::value_type value_type;
@@ -183,7 +183,7 @@ inline bool memory_leak(size_t add_static = 0)
         cout << "thread zero: available    = ";
         cout << num_bytes << endl;
     }
-    for(thread = 1; thread < CPPAD_MAX_NUM_THREADS; thread++)
+    for(thread = 1; thread < thread_alloc::max_num_threads(); thread++)
     {
         // check that no memory is currently in use for this thread
         num_bytes = thread_alloc::inuse(thread);
@@ -417,7 +417,7 @@ $end
 
     \param thread [in]
     Thread for which we are determining the amount of memory
-    (must be < CPPAD_MAX_NUM_THREADS).
+    (must be < thread_alloc::max_num_threads()).
     Durring parallel execution, this must be the thread
     that is currently executing.
 
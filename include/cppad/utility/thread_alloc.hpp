@@ -15,6 +15,9 @@ in the Eclipse Public License, Version 2.0 are satisfied:
 # include <sstream>
 # include <limits>
 # include <memory>
+# include <atomic>
+# include <new>
+# include <vector>
 
 
 # ifdef _MSC_VER
@@ -24,9 +27,20 @@ in the Eclipse Public License, Version 2.0 are satisfied:
 # pragma warning(disable:4345)
 # endif
 
+# include <cppad/configure.hpp>
 # include <cppad/core/cppad_assert.hpp>
 # include <cppad/local/define.hpp>
 # include <cppad/local/set_get_in_parallel.hpp>
+# include <cppad/local/thread_registry.hpp>
+
+# if CPPAD_HAS_MBIND || CPPAD_HAS_HUGEPAGE
+# include <unistd.h>
+# include <sys/mman.h>
+# endif
+# if CPPAD_HAS_MBIND
+# include <sys/syscall.h>
+# include <linux/mempolicy.h>
+# endif
 namespace CppAD { // BEGIN_CPPAD_NAMESPACE
 /*!
 \file thread_alloc.hpp
@@ -36,9 +50,10 @@ File used to define the CppAD multi-threading allocator class
 /*!
 \def CPPAD_MAX_NUM_CAPACITY
 Maximum number of different capacities the allocator will attempt.
-This must be larger than the log base two of numeric_limit<size_t>::max().
+This must be larger than the number of capacities in any ladder
+that capacity_ladder can create.
 */
-# define CPPAD_MAX_NUM_CAPACITY 100
+# define CPPAD_MAX_NUM_CAPACITY 300
 
 /*!
 \def CPPAD_MIN_DOUBLE_CAPACITY
@@ -62,6 +77,22 @@ that correspond to this thead and capacity CPPAD_TRACE_CAPACITY.
 */
 # define CPPAD_TRACE_THREAD 0
 
+/*!
+\def CPPAD_MIN_MAP_BYTES
+If numa_bind is true, blocks with at least this many bytes
+(including the block_t information) are obtained using mmap
+and bound to the NUMA node for the thread.
+This is large so that the rounding up to full pages wastes little memory.
+*/
+# define CPPAD_MIN_MAP_BYTES 65536
+
+/*!
+\def CPPAD_HUGE_PAGE_BYTES
+Size of a huge page. Blocks that use huge pages are rounded up to
+(and aligned at) a multiple of this size.
+*/
+# define CPPAD_HUGE_PAGE_BYTES 2097152
+
 /*
 Note that Section 3.6.2 of ISO/IEC 14882:1998(E) states: "The storage for
 objects with static storage duration (3.7.1) shall be zero-initialized
@@ -80,6 +111,31 @@ Allocator class that works well with an multi-threading environment.
 */
 class thread_alloc{
 // ============================================================================
+public:
+    /// Telemetry for one capacity and thread; see ta_telemetry
+    struct telemetry_t {
+        /// number of bytes in each block with this capacity
+        size_t capacity;
+        /// number of calls to get_memory
+        size_t num_get;
+        /// number of calls to get_memory that used available memory
+        size_t num_hit;
+        /// number of blocks returned
+        size_t num_return;
+        /// number of blocks returned by other threads during parallel mode
+        size_t num_remote;
+        /// number of bytes currently in use
+        size_t inuse_bytes;
+        /// maximum value of inuse_bytes
+        size_t peak_bytes;
+        /// total number of bytes wasted by rounding up to capacity
+        size_t waste_bytes;
+    };
+    /// Type of a routine that reports telemetry; see ta_telemetry
+    typedef void (*telemetry_report_t)(
+        size_t thread, const std::vector<telemetry_t>& snapshot
+    );
+// ============================================================================
 private:
 
     class capacity_t {
@@ -95,13 +151,42 @@ private:
             //    ! thread_alloc::in_parallel() , "thread_alloc: "
             //    "parallel mode and parallel_setup not yet called."
             // );
+            set( std::numeric_limits<size_t>::max(), 50 );
+        }
+        /*!
+        set the capacity values
+
+        \param large_bytes [in]
+        capacities that are greater than or equal large_bytes,
+        and less than 2^40, grow by percent.
+        The other capacities grow by a factor of 3/2.
+
+        \param percent [in]
+        is the percent growth for large capacities
+        (must be between 10 and 50).
+        */
+        void set(size_t large_bytes, size_t percent)
+        {   CPPAD_ASSERT_UNKNOWN( 10 <= percent && percent <= 50 );
             number           = 0;
             size_t capacity  = CPPAD_MIN_DOUBLE_CAPACITY * sizeof(double);
             while( capacity < std::numeric_limits<size_t>::max() / 2 )
             {   CPPAD_ASSERT_UNKNOWN( number < CPPAD_MAX_NUM_CAPACITY );
                 value[number++] = capacity;
-                // next capactiy is 3/2 times the current one
-                capacity        = 3 * ( (capacity + 1) / 2 );
+                bool large = large_bytes <= capacity;
+                large     &= capacity / 1024 < (size_t(1) << 30);
+                if( large )
+                {   // next capacity is 1 + percent / 100 times current one
+                    capacity = capacity + (capacity / 100) * percent;
+                }
+                else
+                {   // next capactiy is 3/2 times the current one
+                    size_t next = 3 * ( (capacity + 1) / 2 );
+                    //
+                    // large capacities start at large_bytes
+                    if( capacity < large_bytes && large_bytes < next )
+                        next = large_bytes;
+                    capacity = next;
+                }
             }
             CPPAD_ASSERT_UNKNOWN( number > 0 );
         }
@@ -115,18 +200,26 @@ private:
         size_t             tc_index_;
         /// pointer to the next memory allocation with the same tc_index_
         void*              next_;
+        /// pointer to the next block in the owner's remote free queue
+        /// (separate from next_ which links the owner's inuse list)
+        void*              remote_next_;
+        /// number of bytes obtained using mmap (zero for operator new)
+        size_t             map_bytes_;
         // -----------------------------------------------------------------
         /// make default constructor private. It is only used by constructor
         /// for `root arrays below.
-        block_t(void) : extra_(0), tc_index_(0), next_(nullptr)
+        block_t(void)
+        : extra_(0), tc_index_(0), next_(nullptr), remote_next_(nullptr)
+        , map_bytes_(0)
         { }
     };
 
     // ---------------------------------------------------------------------
-    /// Vector of fixed capacity values for this allocator
-    static const capacity_t* capacity_info(void)
-    {   CPPAD_ASSERT_FIRST_CALL_NOT_PARALLEL;
-        static const capacity_t capacity;
+    /// Vector of capacity values for this allocator
+    /// (only changed by capacity_ladder)
+    static capacity_t* capacity_info(void)
+    {   // C++11 guarantees this is initialized once (even in parallel mode)
+        static capacity_t capacity;
         return &capacity;
     }
     // ---------------------------------------------------------------------
@@ -145,6 +238,15 @@ private:
         for the next thread.
         */
         block_t root_inuse_[CPPAD_MAX_NUM_CAPACITY];
+        /*!
+        Blocks owned by this thread that were returned by other threads
+        during parallel mode. Other threads push onto this list and
+        only the owner removes elements (the entire list at once).
+        */
+        std::atomic<void*> remote_free_;
+        /// NUMA node for this thread's mapped blocks
+        /// (max size_t if it has not yet been determined)
+        size_t             numa_node_;
     };
     // ---------------------------------------------------------------------
     /*!
@@ -168,6 +270,190 @@ private:
     }
     // ---------------------------------------------------------------------
     /*!
+    Set and Get NUMA bind flag.
+
+    \param set [in]
+    if true, the value returned by this return is changed.
+
+    \param new_value [in]
+    if set is true, this is the new value returned by this routine.
+    Otherwise, new_value is ignored.
+
+    \return
+    the current setting for this routine (which is initially false).
+    */
+    static bool set_get_numa_bind(bool set, bool new_value = false)
+    {   static bool value = false;
+        if( set )
+            value = new_value;
+        return value;
+    }
+    // ---------------------------------------------------------------------
+    /*!
+    Set and Get minimum capacity for huge pages.
+
+    \param set [in]
+    if true, the value returned by this return is changed.
+
+    \param new_value [in]
+    if set is true, this is the new value returned by this routine.
+    Otherwise, new_value is ignored.
+
+    \return
+    the current setting for this routine (which is initially zero).
+    */
+    static size_t set_get_huge_pages(bool set, size_t new_value = 0)
+    {   static size_t value = 0;
+        if( set )
+            value = new_value;
+        return value;
+    }
+    // ---------------------------------------------------------------------
+    /*!
+    Set and Get telemetry flag.
+
+    \param set [in]
+    if true, the value returned by this return is changed.
+
+    \param new_value [in]
+    if set is true, this is the new value returned by this routine.
+    Otherwise, new_value is ignored.
+
+    \return
+    the current setting for this routine (which is initially false).
+    */
+    static bool set_get_telemetry(bool set, bool new_value = false)
+    {   static bool value = false;
+        if( set )
+            value = new_value;
+        return value;
+    }
+    // ---------------------------------------------------------------------
+    /*!
+    Set and Get telemetry report routine.
+
+    \param set [in]
+    if true, the value returned by this return is changed.
+
+    \param new_value [in]
+    if set is true, this is the new value returned by this routine.
+    Otherwise, new_value is ignored.
+
+    \return
+    the current setting for this routine (which is initially nullptr).
+    */
+    static telemetry_report_t set_get_telemetry_report(
+        bool set, telemetry_report_t new_value = nullptr
+    )
+    {   static telemetry_report_t value = nullptr;
+        if( set )
+            value = new_value;
+        return value;
+    }
+    // ---------------------------------------------------------------------
+    /*!
+    Get telemetry for a thread.
+
+    \param thread [in]
+    Is the thread number for this telemetry.
+
+    \param create [in]
+    If create is true and there is no telemetry for this thread,
+    telemetry with all its counters zero is created.
+
+    \return
+    is a reference to the pointer to the telemetry for this thread.
+    It is nullptr if there is no telemetry for this thread.
+    Otherwise it points to an array with CPPAD_MAX_NUM_CAPACITY elements
+    (one for each capacity index).
+    */
+    static telemetry_t*& thread_telemetry(size_t thread, bool create)
+    {   // The registry is never deleted for the same reason as in thread_info
+        static local::thread_registry<telemetry_t*>* all_telemetry =
+            new local::thread_registry<telemetry_t*>();
+        CPPAD_ASSERT_UNKNOWN( thread < max_num_threads() );
+
+        telemetry_t*& telemetry = (*all_telemetry)[thread];
+        if( create && telemetry == nullptr )
+        {   size_t size = CPPAD_MAX_NUM_CAPACITY * sizeof(telemetry_t);
+            void* v_ptr = ::operator new(size);
+            telemetry   = reinterpret_cast<telemetry_t*>(v_ptr);
+            for(size_t c = 0; c < CPPAD_MAX_NUM_CAPACITY; ++c)
+            {   telemetry_t& t = telemetry[c];
+                t.capacity     = 0;
+                t.num_get      = 0;
+                t.num_hit      = 0;
+                t.num_return   = 0;
+                t.num_remote   = 0;
+                t.inuse_bytes  = 0;
+                t.peak_bytes   = 0;
+                t.waste_bytes  = 0;
+            }
+        }
+        return telemetry;
+    }
+    // ---------------------------------------------------------------------
+    /*!
+    Count a call to get_memory (if telemetry is on).
+
+    \param thread [in]
+    thread that is getting the memory (must be currently executing).
+
+    \param c_index [in]
+    capacity index for the memory.
+
+    \param min_bytes [in]
+    number of bytes requested.
+
+    \param hit [in]
+    true if available memory was used for this request.
+    */
+    static void count_get(
+        size_t thread, size_t c_index, size_t min_bytes, bool hit
+    )
+    {   if( ! set_get_telemetry(false) )
+            return;
+        size_t capacity = capacity_info()->value[c_index];
+        telemetry_t& t  = thread_telemetry(thread, true)[c_index];
+        ++t.num_get;
+        if( hit )
+            ++t.num_hit;
+        t.waste_bytes  += capacity - min_bytes;
+        t.inuse_bytes  += capacity;
+        if( t.peak_bytes < t.inuse_bytes )
+            t.peak_bytes = t.inuse_bytes;
+    }
+    // ---------------------------------------------------------------------
+    /*!
+    Count a block that is returned to its owner (if telemetry is on).
+
+    \param thread [in]
+    thread that owns the block.
+    Either it is currently executing, or we are in sequential mode.
+
+    \param c_index [in]
+    capacity index for the block.
+
+    \param remote [in]
+    true if the block was returned by a different thread during parallel
+    execution mode.
+    */
+    static void count_return(size_t thread, size_t c_index, bool remote)
+    {   if( ! set_get_telemetry(false) )
+            return;
+        size_t capacity = capacity_info()->value[c_index];
+        telemetry_t& t  = thread_telemetry(thread, true)[c_index];
+        ++t.num_return;
+        if( remote )
+            ++t.num_remote;
+        // block may have been obtained before telemetry was turned on
+        if( capacity <= t.inuse_bytes )
+            t.inuse_bytes -= capacity;
+        else
+            t.inuse_bytes = 0;
+    }
+    // ---------------------------------------------------------------------
+    /*!
     Get pointer to the information for this thread.
 
     \param thread [in]
@@ -194,14 +480,15 @@ private:
     static thread_alloc_info* thread_info(
         size_t             thread          ,
         bool               clear = false   )
-    {   static thread_alloc_info* all_info[CPPAD_MAX_NUM_THREADS];
+    {   // The registry is never deleted because static objects that are
+        // destroyed after it may return memory to thread_alloc.
+        static local::thread_registry<thread_alloc_info*>* all_info =
+            new local::thread_registry<thread_alloc_info*>();
         static thread_alloc_info  zero_info;
 
-        CPPAD_ASSERT_FIRST_CALL_NOT_PARALLEL;
+        CPPAD_ASSERT_UNKNOWN( thread < max_num_threads() );
 
-        CPPAD_ASSERT_UNKNOWN( thread < CPPAD_MAX_NUM_THREADS );
-
-        thread_alloc_info* info = all_info[thread];
+        thread_alloc_info*& info = (*all_info)[thread];
         if( clear )
         {   if( info != nullptr )
             {
@@ -220,7 +507,6 @@ private:
                 if( thread != 0 )
                     ::operator delete( reinterpret_cast<void*>(info) );
                 info             = nullptr;
-                all_info[thread] = info;
             }
         }
         else if( info == nullptr )
@@ -231,7 +517,6 @@ private:
                 void* v_ptr = ::operator new(size);
                 info        = reinterpret_cast<thread_alloc_info*>(v_ptr);
             }
-            all_info[thread] = info;
 
             // initialize the information record
             for(size_t c = 0; c < CPPAD_MAX_NUM_CAPACITY; c++)
@@ -240,6 +525,8 @@ private:
             }
             info->count_inuse_     = 0;
             info->count_available_ = 0;
+            new( &info->remote_free_ ) std::atomic<void*>(nullptr);
+            info->numa_node_       = std::numeric_limits<size_t>::max();
         }
         return info;
     }
@@ -280,7 +567,7 @@ private:
     */
     static void inc_available(size_t inc, size_t thread)
     {
-        CPPAD_ASSERT_UNKNOWN( thread < CPPAD_MAX_NUM_THREADS);
+        CPPAD_ASSERT_UNKNOWN( thread < max_num_threads() );
         CPPAD_ASSERT_UNKNOWN(
             thread == thread_num() || (! in_parallel())
         );
@@ -328,7 +615,7 @@ private:
     */
     static void dec_available(size_t dec, size_t thread)
     {
-        CPPAD_ASSERT_UNKNOWN( thread < CPPAD_MAX_NUM_THREADS);
+        CPPAD_ASSERT_UNKNOWN( thread < max_num_threads() );
         CPPAD_ASSERT_UNKNOWN(
             thread == thread_num() || (! in_parallel())
         );
@@ -355,7 +642,7 @@ private:
     static size_t set_get_num_threads(size_t number_new)
     {   static size_t number_user = 1;
 
-        CPPAD_ASSERT_UNKNOWN( number_new <= CPPAD_MAX_NUM_THREADS );
+        CPPAD_ASSERT_UNKNOWN( number_new <= max_num_threads() );
         CPPAD_ASSERT_UNKNOWN( ! in_parallel() || (number_new == 0) );
 
         // case where we are changing the number of threads
@@ -365,6 +652,28 @@ private:
         return number_user;
     }
     /*!
+    Set and get the maximum number of threads.
+
+    \param number_new
+    If number_new is less than or equal the current maximum,
+    we are only retrieving the current maximum.
+    Otherwise, the maximum is increased to number_new.
+
+    \return
+    the maximum number of threads (after the possible increase).
+    */
+    static size_t set_get_max_num_threads(size_t number_new)
+    {   static size_t number_max = CPPAD_MAX_NUM_THREADS;
+
+        // case where we are increasing the maximum number of threads
+        if( number_new > number_max )
+        {   CPPAD_ASSERT_UNKNOWN( ! in_parallel() );
+            number_max = number_new;
+        }
+
+        return number_max;
+    }
+    /*!
     Set and call the routine that determine the current thread number.
 
     \return
@@ -404,6 +713,289 @@ private:
         );
         return thread;
     }
+# if CPPAD_HAS_MBIND
+    // -----------------------------------------------------------------------
+    /*!
+    Bind pages to the NUMA node for a thread.
+
+    \param thread [in]
+    is the thread that will own the pages. This must be the thread that
+    is currently executing. Its NUMA node is determined by the first
+    call to this routine for the thread.
+
+    \param v_ptr [in]
+    is the beginning of the pages (which have not yet been touched).
+
+    \param num_bytes [in]
+    is the number of bytes in the pages.
+    */
+    static void bind_node(size_t thread, void* v_ptr, size_t num_bytes)
+    {   thread_alloc_info* info = thread_info(thread);
+        if( info->numa_node_ == std::numeric_limits<size_t>::max() )
+        {   unsigned cpu, node;
+            if( syscall(SYS_getcpu, &cpu, &node, nullptr) == 0 )
+                info->numa_node_ = size_t(node);
+        }
+        //
+        // prefer the node for this thread (if the binding fails
+        // the pages use the system default policy)
+        const size_t n_bit  = 8 * sizeof(unsigned long);
+        const size_t n_word = 16;
+        size_t node = info->numa_node_;
+        if( node < n_bit * n_word )
+        {   unsigned long mask[n_word];
+            for(size_t i = 0; i < n_word; ++i)
+                mask[i] = 0;
+            mask[node / n_bit] = 1UL << (node % n_bit);
+            syscall(SYS_mbind, v_ptr, num_bytes,
+                MPOL_PREFERRED, mask, n_bit * n_word + 1, 0
+            );
+        }
+    }
+# endif
+# if CPPAD_HAS_MBIND || CPPAD_HAS_HUGEPAGE
+    // -----------------------------------------------------------------------
+    /*!
+    Get a new block from the system using mmap.
+
+    \param thread [in]
+    is the thread that will own the block. This must be the thread that
+    is currently executing.
+
+    \param num_bytes [in]
+    is the number of bytes in the block (including the block_t information).
+
+    \param numa [in]
+    if true, the pages are bound to the NUMA node for this thread.
+
+    \param huge [in]
+    if true, huge pages are used for the block.
+
+    \return
+    is the new block (nullptr if mmap fails).
+    Only its map_bytes_ field has been set.
+    */
+    static block_t* system_map(
+        size_t thread, size_t num_bytes, bool numa, bool huge
+    )
+    {   void*  v_node    = MAP_FAILED;
+        size_t map_bytes = 0;
+# if CPPAD_HAS_HUGEPAGE
+        if( huge )
+        {   const size_t huge_page = CPPAD_HUGE_PAGE_BYTES;
+            map_bytes = ( (num_bytes + huge_page - 1) / huge_page ) * huge_page;
+            //
+            // huge pages reserved by the system
+            v_node = mmap(
+                nullptr, map_bytes, PROT_READ | PROT_WRITE,
+                MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0
+            );
+            if( v_node == MAP_FAILED )
+            {   // transparent huge pages (mapping must be aligned)
+                void* v_extra = mmap(
+                    nullptr, map_bytes + huge_page, PROT_READ | PROT_WRITE,
+                    MAP_PRIVATE | MAP_ANONYMOUS, -1, 0
+                );
+                if( v_extra != MAP_FAILED )
+                {   char*  extra  = reinterpret_cast<char*>(v_extra);
+                    size_t offset = reinterpret_cast<size_t>(extra) % huge_page;
+                    offset        = (huge_page - offset) % huge_page;
+                    if( offset > 0 )
+                        munmap(extra, offset);
+                    munmap(extra + offset + map_bytes, huge_page - offset);
+                    v_node = reinterpret_cast<void*>(extra + offset);
+                    madvise(v_node, map_bytes, MADV_HUGEPAGE);
+                }
+            }
+        }
+# endif
+        if( v_node == MAP_FAILED )
+        {   size_t page = size_t( sysconf(_SC_PAGESIZE) );
+            map_bytes   = ( (num_bytes + page - 1) / page ) * page;
+            v_node      = mmap(
+                nullptr, map_bytes, PROT_READ | PROT_WRITE,
+                MAP_PRIVATE | MAP_ANONYMOUS, -1, 0
+            );
+            if( v_node == MAP_FAILED )
+                return nullptr;
+        }
+# if CPPAD_HAS_MBIND
+        if( numa )
+            bind_node(thread, v_node, map_bytes);
+# endif
+        block_t* block    = reinterpret_cast<block_t*>(v_node);
+        block->map_bytes_ = map_bytes;
+        return block;
+    }
+# endif
+    // -----------------------------------------------------------------------
+    /*!
+    Get a new block from the system.
+
+    \param thread [in]
+    is the thread that will own the block. This must be the thread that
+    is currently executing.
+
+    \param num_bytes [in]
+    is the number of bytes in the block (including the block_t information).
+
+    \return
+    is the new block. Only its map_bytes_ field has been set.
+    If numa_bind is true and num_bytes is at least CPPAD_MIN_MAP_BYTES,
+    the pages for the block are bound to the NUMA node for this thread
+    before they are touched.
+    If huge_pages is non-zero and the capacity for the block is at least
+    its value, the block uses huge pages.
+    */
+    static block_t* system_new(size_t thread, size_t num_bytes)
+    {   CPPAD_ASSERT_UNKNOWN( thread == thread_num() );
+# if CPPAD_HAS_MBIND || CPPAD_HAS_HUGEPAGE
+        bool numa = false;
+        bool huge = false;
+# if CPPAD_HAS_MBIND
+        numa = set_get_numa_bind(false) && CPPAD_MIN_MAP_BYTES <= num_bytes;
+# endif
+# if CPPAD_HAS_HUGEPAGE
+        size_t huge_min = set_get_huge_pages(false);
+        huge = huge_min != 0 && huge_min <= num_bytes - sizeof(block_t);
+# endif
+        if( numa || huge )
+        {   block_t* block = system_map(thread, num_bytes, numa, huge);
+            if( block != nullptr )
+                return block;
+        }
+# endif
+        void* v_node      = ::operator new(num_bytes);
+        CPPAD_ASSERT_UNKNOWN( v_node != nullptr );
+        block_t* block    = reinterpret_cast<block_t*>(v_node);
+        block->map_bytes_ = 0;
+        return block;
+    }
+    // -----------------------------------------------------------------------
+    /*!
+    Return a block to the system.
+
+    \param block [in]
+    is a block that was obtained using system_new.
+    */
+    static void system_delete(block_t* block)
+    {
+# if CPPAD_HAS_MBIND || CPPAD_HAS_HUGEPAGE
+        if( block->map_bytes_ != 0 )
+        {   munmap( reinterpret_cast<void*>(block), block->map_bytes_ );
+            return;
+        }
+# endif
+        CPPAD_ASSERT_UNKNOWN( block->map_bytes_ == 0 );
+        ::operator delete( reinterpret_cast<void*>(block) );
+    }
+    // -----------------------------------------------------------------------
+    /*!
+    Return a block to the thread that owns it.
+
+    \param node [in]
+    is the thread_alloc information at the front of the block.
+    Its tc_index_ determines the thread and capacity for the block.
+    The block must be in use.
+    We must either be in sequential execution mode,
+    or the current thread must be the owner of the block.
+
+    \param remote [in]
+    true if the block was returned by a different thread than its owner
+    during parallel execution mode.
+    */
+    static void return_local(block_t* node, bool remote)
+    {   size_t num_cap   = capacity_info()->number;
+
+        size_t tc_index  = node->tc_index_;
+        size_t thread    = tc_index / num_cap;
+        size_t c_index   = tc_index % num_cap;
+        size_t capacity  = capacity_info()->value[c_index];
+
+        CPPAD_ASSERT_UNKNOWN( thread < max_num_threads() );
+        CPPAD_ASSERT_UNKNOWN( thread == thread_num() || (! in_parallel()) );
+
+        thread_alloc_info* info = thread_info(thread);
+# ifndef NDEBUG
+        // pointer returned by get_memory for this block
+        void* v_ptr          = reinterpret_cast<void*>(node + 1);
+# ifndef CPPAD_DEBUG_AND_RELEASE
+        // remove node from inuse list
+        void* v_node         = reinterpret_cast<void*>(node);
+        block_t* inuse_root  = info->root_inuse_ + c_index;
+        block_t* previous    = inuse_root;
+        while( (previous->next_ != nullptr) & (previous->next_ != v_node) )
+            previous = reinterpret_cast<block_t*>(previous->next_);
+
+        // check that v_ptr is valid
+        if( previous->next_ != v_node )
+        {   using std::endl;
+            std::ostringstream oss;
+            oss << "return_memory: attempt to return memory not in use";
+            oss << endl;
+            oss << "v_ptr    = " << v_ptr    << endl;
+            oss << "thread   = " << thread   << endl;
+            oss << "capacity = " << capacity << endl;
+            oss << "See CPPAD_TRACE_THREAD & CPPAD_TRACE_CAPACITY in";
+            oss << endl << "# include <cppad/utility/thread_alloc.hpp>" << endl;
+            // oss.str() returns a string object with a copy of the current
+            // contents in the stream buffer.
+            std::string msg_str       = oss.str();
+            // msg_str.c_str() returns a pointer to the c-string
+            // representation of the string object's value.
+            const char* msg_char_star = msg_str.c_str();
+            CPPAD_ASSERT_KNOWN(false, msg_char_star );
+        }
+        // remove v_ptr from inuse list
+        previous->next_  = node->next_;
+# endif
+        // trace option
+        if( capacity==CPPAD_TRACE_CAPACITY && thread==CPPAD_TRACE_THREAD )
+        {   std::cout << "return_memory: v_ptr = " << v_ptr << std::endl; }
+
+# endif
+        // capacity bytes are removed from the inuse pool
+        dec_inuse(capacity, thread);
+        count_return(thread, c_index, remote);
+
+        // check for case where we just return the memory to the system
+        if( ! set_get_hold_memory(false) )
+        {   system_delete(node);
+            return;
+        }
+
+        // add this node to available list for this thread and capacity
+        block_t* available_root = info->root_available_ + c_index;
+        node->next_             = available_root->next_;
+        available_root->next_   = reinterpret_cast<void*>(node);
+
+        // capacity bytes are added to the available pool
+        inc_available(capacity, thread);
+    }
+    // -----------------------------------------------------------------------
+    /*!
+    Return the blocks in a thread's remote free queue.
+
+    \param info [in]
+    is the information for the thread that owns the queue.
+    We must either be in sequential execution mode,
+    or the current thread must be the owner of the queue.
+    */
+    static void drain_remote(thread_alloc_info* info)
+    {   // quick check without a read-modify-write operation
+        if( info->remote_free_.load(std::memory_order_relaxed) == nullptr )
+            return;
+        //
+        // take the entire queue; i.e., the blocks pushed so far
+        void* v_node = info->remote_free_.exchange(
+            nullptr, std::memory_order_acquire
+        );
+        while( v_node != nullptr )
+        {   block_t* node = reinterpret_cast<block_t*>(v_node);
+            v_node        = node->remote_next_;
+            return_local(node, true);
+        }
+    }
 // ============================================================================
 public:
 /*
@@ -445,6 +1037,14 @@ and must be greater than zero.
 It specifies the number of threads that are sharing memory.
 The case $icode%num_threads% == 1%$$ is a special case that is
 used to terminate a multi-threading environment.
+There is no compile time limit on $icode num_threads$$.
+If it is greater than
+$cref/max_num_threads/ta_max_num_threads/$$,
+the maximum number of threads is increased to $icode num_threads$$.
+In this case, there cannot be a tape recording $codei%AD<%Base%>%$$
+operations when $code parallel_setup$$ is called and
+$cref parallel_ad$$ must be called (for each $icode Base$$)
+before using $codei%AD<%Base%>%$$ in parallel mode.
 
 $head in_parallel$$
 This function has prototype
@@ -524,10 +1124,6 @@ $end
             return;
         }
 
-        CPPAD_ASSERT_KNOWN(
-            num_threads <= CPPAD_MAX_NUM_THREADS ,
-            "parallel_setup: num_threads is too large"
-        );
         CPPAD_ASSERT_KNOWN(
             num_threads != 0 ,
             "parallel_setup: num_threads == zero"
@@ -541,6 +1137,9 @@ $end
             "parallel_setup: num_threads != 1 and thread_num == nullptr"
         );
 
+        // per thread information is sized by max_num_threads
+        set_get_max_num_threads(num_threads);
+
         // Make sure that constructors for all static variables in this file
         // are called in sequential mode.
         for(size_t thread = 0; thread < num_threads; thread++)
@@ -566,29 +1165,70 @@ $end
 /*
 $begin ta_num_threads$$
 $spell
-    inv
-    CppAD
+    inv
+    CppAD
+    num
+    alloc
+$$
+$section Get Number of Threads$$
+
+
+$head Syntax$$
+$icode%number% = thread_alloc::num_threads()%$$
+
+$head Purpose$$
+Determine the number of threads as set during $cref/parallel_setup/ta_parallel_setup/$$.
+
+$head number$$
+The return value $icode number$$ has prototype
+$codei%
+    size_t %number%
+%$$
+and is equal to the value of
+$cref/num_threads/ta_parallel_setup/num_threads/$$
+in the previous call to $icode parallel_setup$$.
+If there was no such previous call, the value one is returned.
+
+$head Example$$
+The example and test $cref thread_alloc.cpp$$ uses this routine.
+
+$end
+*/
+    /*!
+    Get the current number of threads that thread_alloc can use.
+    */
+    static size_t num_threads(void)
+    {   return set_get_num_threads(0); }
+/* -----------------------------------------------------------------------
+$begin ta_max_num_threads$$
+$spell
     num
     alloc
+    CppAD
 $$
-$section Get Number of Threads$$
-
+$section Get Maximum Number of Threads$$
 
 $head Syntax$$
-$icode%number% = thread_alloc::num_threads()%$$
+$icode%number% = thread_alloc::max_num_threads()%$$
 
 $head Purpose$$
-Determine the number of threads as set during $cref/parallel_setup/ta_parallel_setup/$$.
+The information that CppAD keeps for each thread
+is stored in arrays that grow when they are first used by a thread.
+This routine returns an upper bound for the thread numbers that
+can be used with this information.
 
 $head number$$
 The return value $icode number$$ has prototype
 $codei%
     size_t %number%
 %$$
-and is equal to the value of
+It is the maximum of
+$cref/CPPAD_MAX_NUM_THREADS/multi_thread/CPPAD_MAX_NUM_THREADS/$$
+and the values of
 $cref/num_threads/ta_parallel_setup/num_threads/$$
-in the previous call to $icode parallel_setup$$.
-If there was no such previous call, the value one is returned.
+in all the previous calls to $code parallel_setup$$.
+It is always greater than or equal
+$cref/num_threads/ta_num_threads/$$.
 
 $head Example$$
 The example and test $cref thread_alloc.cpp$$ uses this routine.
@@ -596,10 +1236,10 @@ The example and test $cref thread_alloc.cpp$$ uses this routine.
 $end
 */
     /*!
-    Get the current number of threads that thread_alloc can use.
+    Get the maximum number of threads that thread_alloc can use.
     */
-    static size_t num_threads(void)
-    {   return set_get_num_threads(0); }
+    static size_t max_num_threads(void)
+    {   return set_get_max_num_threads(0); }
 /* -----------------------------------------------------------------------
 $begin ta_in_parallel$$
 
@@ -762,10 +1402,7 @@ $end
     pointer to the beginning of the memory allocated for use.
     */
     static void* get_memory(size_t min_bytes, size_t& cap_bytes)
-    {   // see first_trace below
-        CPPAD_ASSERT_FIRST_CALL_NOT_PARALLEL;
-
-        // check that number of requested bytes is not to large
+    {   // check that number of requested bytes is not to large
         CPPAD_ASSERT_KNOWN(
             min_bytes < std::numeric_limits<size_t>::max() / 2 ,
             "get_memory(min_bytes, cap_bytes): min_bytes is too large"
@@ -789,6 +1426,9 @@ $end
         size_t tc_index          = thread * num_cap + c_index;
         thread_alloc_info* info  = thread_info(thread);
 
+        // blocks returned by other threads become available to this thread
+        drain_remote(info);
+
 # ifndef NDEBUG
         // trace allocation
         static bool first_trace = true;
@@ -836,6 +1476,7 @@ $end
             // adjust counts
             inc_inuse(cap_bytes, thread);
             dec_available(cap_bytes, thread);
+            count_get(thread, c_index, min_bytes, true);
 
             // return pointer to memory, do not inclue thread_alloc information
             return v_ptr;
@@ -844,9 +1485,8 @@ $end
         // Create a new node with thread_alloc information at front.
         // This uses the system allocator, which is thread safe, but slower,
         // because the thread might wait for a lock on the allocator.
-        v_node          = ::operator new(sizeof(block_t) + cap_bytes);
-        CPPAD_ASSERT_UNKNOWN( v_node != nullptr );
-        node            = reinterpret_cast<block_t*>(v_node);
+        node            = system_new(thread, sizeof(block_t) + cap_bytes);
+        v_node          = reinterpret_cast<void*>(node);
         node->tc_index_ = tc_index;
         void* v_ptr     = reinterpret_cast<void*>(node + 1);
 
@@ -865,6 +1505,7 @@ $end
 
         // adjust counts
         inc_inuse(cap_bytes, thread);
+        count_get(thread, c_index, min_bytes, false);
 
         return v_ptr;
     }
@@ -899,10 +1540,21 @@ obtained by a previous call to
 $cref/get_memory/ta_get_memory/$$ and not yet returned.
 
 $head Thread$$
-Either the $cref/current thread/ta_thread_num/$$ must be the same as during
+If the $cref/current thread/ta_thread_num/$$ is the same as during
 the corresponding call to $cref/get_memory/ta_get_memory/$$,
-or the current execution mode must be sequential
-(not $cref/parallel/ta_in_parallel/$$).
+or the current execution mode is sequential
+(not $cref/parallel/ta_in_parallel/$$),
+the memory is returned as described above.
+
+$subhead Other Threads$$
+Otherwise, the memory is placed in a lock free queue for the thread
+that allocated it (and no locks are used).
+That thread returns the memory in its queue during its next call to
+$code get_memory$$ or $cref/free_available/ta_free_available/$$.
+Until then, the memory is still counted as $cref/inuse/ta_inuse/$$
+for that thread.
+The function $cref/free_all/ta_free_all/$$ also returns the memory
+in the queue for every thread.
 
 $head NDEBUG$$
 If $code NDEBUG$$ is defined, $icode v_ptr$$ is not checked (this is faster).
@@ -926,79 +1578,32 @@ $end
     After this call, this pointer will available (and not in use).
 
     \par
-    We must either be in sequential (not parallel) execution mode,
-    or the current thread must be the same as for the corresponding call
-    to get_memory.
+    If we are in parallel execution mode and the current thread is not the
+    same as for the corresponding call to get_memory, the memory is placed
+    in the remote free queue for that thread.
     */
     static void return_memory(void* v_ptr)
     {   size_t num_cap   = capacity_info()->number;
 
         block_t* node    = reinterpret_cast<block_t*>(v_ptr) - 1;
-        size_t tc_index  = node->tc_index_;
-        size_t thread    = tc_index / num_cap;
-        size_t c_index   = tc_index % num_cap;
-        size_t capacity  = capacity_info()->value[c_index];
-
-        CPPAD_ASSERT_UNKNOWN( thread < CPPAD_MAX_NUM_THREADS );
-        CPPAD_ASSERT_KNOWN(
-            thread == thread_num() || (! in_parallel()),
-            "Attempt to return memory for a different thread "
-            "while in parallel mode"
-        );
-
-        thread_alloc_info* info = thread_info(thread);
-# ifndef NDEBUG
-# ifndef CPPAD_DEBUG_AND_RELEASE
-        // remove node from inuse list
-        void* v_node         = reinterpret_cast<void*>(node);
-        block_t* inuse_root  = info->root_inuse_ + c_index;
-        block_t* previous    = inuse_root;
-        while( (previous->next_ != nullptr) & (previous->next_ != v_node) )
-            previous = reinterpret_cast<block_t*>(previous->next_);
-
-        // check that v_ptr is valid
-        if( previous->next_ != v_node )
-        {   using std::endl;
-            std::ostringstream oss;
-            oss << "return_memory: attempt to return memory not in use";
-            oss << endl;
-            oss << "v_ptr    = " << v_ptr    << endl;
-            oss << "thread   = " << thread   << endl;
-            oss << "capacity = " << capacity << endl;
-            oss << "See CPPAD_TRACE_THREAD & CPPAD_TRACE_CAPACITY in";
-            oss << endl << "# include <cppad/utility/thread_alloc.hpp>" << endl;
-            // oss.str() returns a string object with a copy of the current
-            // contents in the stream buffer.
-            std::string msg_str       = oss.str();
-            // msg_str.c_str() returns a pointer to the c-string
-            // representation of the string object's value.
-            const char* msg_char_star = msg_str.c_str();
-            CPPAD_ASSERT_KNOWN(false, msg_char_star );
-        }
-        // remove v_ptr from inuse list
-        previous->next_  = node->next_;
-# endif
-        // trace option
-        if( capacity==CPPAD_TRACE_CAPACITY && thread==CPPAD_TRACE_THREAD )
-        {   std::cout << "return_memory: v_ptr = " << v_ptr << std::endl; }
-
-# endif
-        // capacity bytes are removed from the inuse pool
-        dec_inuse(capacity, thread);
+        size_t thread    = node->tc_index_ / num_cap;
+        CPPAD_ASSERT_UNKNOWN( thread < max_num_threads() );
 
-        // check for case where we just return the memory to the system
-        if( ! set_get_hold_memory(false) )
-        {   ::operator delete( reinterpret_cast<void*>(node) );
+        if( thread == thread_num() || (! in_parallel()) )
+        {   return_local(node, false);
             return;
         }
 
-        // add this node to available list for this thread and capacity
-        block_t* available_root = info->root_available_ + c_index;
-        node->next_             = available_root->next_;
-        available_root->next_   = reinterpret_cast<void*>(node);
-
-        // capacity bytes are added to the available pool
-        inc_available(capacity, thread);
+        // push this node onto the remote free queue for its owner
+        // (the owner's counts and lists are changed when it drains the queue)
+        thread_alloc_info* info = thread_info(thread);
+        void* v_node = reinterpret_cast<void*>(node);
+        void* head   = info->remote_free_.load(std::memory_order_relaxed);
+        do
+            node->remote_next_ = head;
+        while( ! info->remote_free_.compare_exchange_weak(
+            head, v_node, std::memory_order_release, std::memory_order_relaxed
+        ) );
     }
 /* -----------------------------------------------------------------------
 $begin ta_free_available$$
@@ -1053,8 +1658,8 @@ $end
     */
     static void free_available(size_t thread)
     {   CPPAD_ASSERT_KNOWN(
-            thread < CPPAD_MAX_NUM_THREADS,
-            "Attempt to free memory for a thread >= CPPAD_MAX_NUM_THREADS"
+            thread < max_num_threads(),
+            "Attempt to free memory for a thread >= max_num_threads()"
         );
         CPPAD_ASSERT_KNOWN(
             thread == thread_num() || (! in_parallel()),
@@ -1068,6 +1673,10 @@ $end
         const size_t*     capacity_vec  = capacity_info()->value;
         size_t c_index;
         thread_alloc_info* info = thread_info(thread);
+        //
+        // memory returned by other threads
+        drain_remote(info);
+        //
         for(c_index = 0; c_index < num_cap; c_index++)
         {   size_t capacity = capacity_vec[c_index];
             block_t* available_root = info->root_available_ + c_index;
@@ -1075,7 +1684,7 @@ $end
             while( v_ptr != nullptr )
             {   block_t* node = reinterpret_cast<block_t*>(v_ptr);
                 void* next    = node->next_;
-                ::operator delete(v_ptr);
+                system_delete(node);
                 v_ptr         = next;
 
                 dec_available(capacity, thread);
@@ -1132,6 +1741,424 @@ $end
     {   bool set = true;
         set_get_hold_memory(set, value);
     }
+/* -----------------------------------------------------------------------
+$begin ta_numa_bind$$
+$spell
+    alloc
+    numa
+    mbind
+    mmap
+    getcpu
+$$
+
+$section Bind Large thread_alloc Blocks to the NUMA Node of a Thread$$
+
+$head Syntax$$
+$codei%thread_alloc::numa_bind(%value%)%$$
+
+$head Purpose$$
+On a machine with more than one NUMA node,
+memory is faster for a thread when it is on the node that the thread runs on.
+Calling $code numa_bind$$ with $icode value$$ equal to true,
+instructs $code thread_alloc$$ to bind the large blocks
+that it obtains from the system to the NUMA node for the thread that
+called $cref/get_memory/ta_get_memory/$$.
+The pages for these blocks are bound before they are touched,
+so they are node local for the thread even if another thread
+is the first to write to them.
+
+$head value$$
+If $icode value$$ is true,
+future large blocks obtained from the system are bound to a NUMA node.
+If it is false, future blocks use the system default policy
+(the pages are placed on the node of the thread that first touches them).
+By default (when $code numa_bind$$ has not been called)
+the blocks are not bound.
+
+$head NUMA Node$$
+The NUMA node for a thread is the node it is running on
+when it first obtains a large block from the system with
+$icode value$$ equal to true.
+The same node is used for all its large blocks after that
+(even if the operating system moves the thread to a different node).
+Threads should be pinned to processors for best results.
+
+$head Large Blocks$$
+A block is large if it is at least 64 kilobytes.
+These blocks are obtained from the system using $code mmap$$
+(which rounds up to a whole number of pages)
+and bound using $code mbind$$.
+Smaller blocks are obtained using the C++ $code new$$ operator.
+
+$head hold_memory$$
+If $cref/hold_memory/ta_hold_memory/$$ is true,
+the memory returned by a thread
+(and by other threads for this thread, see
+$cref/return_memory/ta_return_memory/Thread/Other Threads/$$)
+is held for future use by the same thread.
+Hence its bound blocks are reused on the same NUMA node.
+
+$head CPPAD_HAS_MBIND$$
+The $code mmap$$, $code mbind$$, and $code getcpu$$ system calls
+are only used if the preprocessor symbol
+$cref/CPPAD_HAS_MBIND/configure.hpp/CPPAD_HAS_MBIND/$$ is true.
+If it is false, $code numa_bind$$ has no effect.
+
+$end
+*/
+    /*!
+    Change the thread_alloc NUMA bind setting.
+
+    \param value [in]
+    New value for the thread_alloc NUMA bind setting.
+    */
+    static void numa_bind(bool value)
+    {   CPPAD_ASSERT_KNOWN(
+            ! in_parallel(),
+            "numa_bind cannot be used while in parallel execution"
+        );
+        bool set = true;
+        set_get_numa_bind(set, value);
+    }
+/* -----------------------------------------------------------------------
+$begin ta_huge_pages$$
+$spell
+    alloc
+    mmap
+    madvise
+    hugepage
+    hugetlb
+    tlb
+    numa
+$$
+
+$section Use Huge Pages for Large thread_alloc Blocks$$
+
+$head Syntax$$
+$codei%thread_alloc::huge_pages(%min_bytes%)%$$
+
+$head Purpose$$
+Very large arrays (for example the Taylor coefficients of a large
+$cref ADFun$$ object) span many pages of memory.
+Using huge pages for these arrays reduces the number of
+translation lookaside buffer (TLB) misses when they are accessed.
+
+$head min_bytes$$
+This argument has prototype
+$codei%
+    size_t %min_bytes%
+%$$
+If it is zero, huge pages are not used
+(this is the default when $code huge_pages$$ has not been called).
+Otherwise, future blocks obtained from the system with a
+$cref/capacity/ta_get_memory/cap_bytes/$$
+greater than or equal $icode min_bytes$$ use huge pages.
+Blocks that were obtained before this call are not affected.
+
+$head Huge Pages$$
+The blocks that use huge pages are obtained from the system using
+$code mmap$$ and their size is rounded up to a multiple of two megabytes.
+Huge pages that have been reserved by the system
+($code MAP_HUGETLB$$) are used when they are available.
+Otherwise, transparent huge pages are requested for the block
+($code madvise$$ with $code MADV_HUGEPAGE$$).
+If $cref/numa_bind/ta_numa_bind/$$ is true,
+these huge pages are also bound to the NUMA node for the thread.
+
+$head Capacities$$
+Huge blocks should also use a finer
+$cref/capacity_ladder/ta_capacity_ladder/$$
+so that the rounding up to a capacity does not waste much memory.
+
+$head CPPAD_HAS_HUGEPAGE$$
+The system calls above are only used if the preprocessor symbol
+$cref/CPPAD_HAS_HUGEPAGE/configure.hpp/CPPAD_HAS_HUGEPAGE/$$ is true.
+If it is false, $code huge_pages$$ has no effect.
+
+$end
+*/
+    /*!
+    Change the thread_alloc minimum capacity for huge pages.
+
+    \param min_bytes [in]
+    New value for the minimum capacity (zero for no huge pages).
+    */
+    static void huge_pages(size_t min_bytes)
+    {   CPPAD_ASSERT_KNOWN(
+            ! in_parallel(),
+            "huge_pages cannot be used while in parallel execution"
+        );
+        bool set = true;
+        set_get_huge_pages(set, min_bytes);
+    }
+/* -----------------------------------------------------------------------
+$begin ta_capacity_ladder$$
+$spell
+    alloc
+    bool
+    inuse
+$$
+
+$section Change the Capacities Used by thread_alloc$$
+
+$head Syntax$$
+$icode%ok% = thread_alloc::capacity_ladder(%large_bytes%, %percent%)%$$
+
+$head Purpose$$
+The $cref/get_memory/ta_get_memory/$$ routine rounds each request
+up to the next capacity in a ladder of capacities.
+By default, each capacity is 3/2 times the previous one;
+i.e., up to one half of the requested memory may be wasted.
+This routine makes the ladder finer for large capacities.
+
+$head large_bytes$$
+This argument has prototype
+$codei%
+    size_t %large_bytes%
+%$$
+Capacities greater than or equal $icode large_bytes$$,
+and less than one terabyte,
+grow by $icode percent$$ percent.
+The other capacities grow by a factor of 3/2
+(this limits the number of capacities).
+
+$head percent$$
+This argument has prototype
+$codei%
+    size_t %percent%
+%$$
+It must be between 10 and 50.
+The memory wasted by rounding a large request up to its capacity
+is at most $icode percent$$ percent of the request.
+
+$head ok$$
+The return value has prototype
+$codei%
+    bool %ok%
+%$$
+If memory is $cref/inuse/ta_inuse/$$ for any thread,
+the capacities cannot be changed and $icode ok$$ is false.
+Otherwise all the memory that is
+$cref/available/ta_available/$$ for any thread is returned to the system
+(as by $cref/free_all/ta_free_all/$$),
+the capacities are changed, and $icode ok$$ is true.
+Hence this routine is usually called at the beginning of a program.
+
+$head Default$$
+The default ladder is restored by the call
+$codei%
+    thread_alloc::capacity_ladder(std::numeric_limits<size_t>::max(), 50)
+%$$
+
+$head Restrictions$$
+This function cannot be called while in parallel mode.
+
+$end
+*/
+    /*!
+    Change the capacities used by thread_alloc.
+
+    \param large_bytes [in]
+    capacities greater than or equal large_bytes (and less than 2^40)
+    grow by percent.
+
+    \param percent [in]
+    percent growth for large capacities (between 10 and 50).
+
+    \return
+    is true if no memory was in use and the capacities were changed.
+    */
+    static bool capacity_ladder(size_t large_bytes, size_t percent)
+    {   CPPAD_ASSERT_KNOWN(
+            ! in_parallel(),
+            "capacity_ladder cannot be used while in parallel execution"
+        );
+        CPPAD_ASSERT_KNOWN(
+            10 <= percent && percent <= 50,
+            "capacity_ladder: percent is not between 10 and 50"
+        );
+        if( ! free_all() )
+            return false;
+        capacity_info()->set(large_bytes, percent);
+        return true;
+    }
+/* -----------------------------------------------------------------------
+$begin ta_telemetry$$
+$spell
+    alloc
+    num
+    const
+    bool
+    inuse
+    std
+$$
+
+$section Memory Allocation Telemetry for thread_alloc$$
+
+$head Syntax$$
+$codei%thread_alloc::telemetry_enable(%value%)
+%$$
+$icode%snapshot% = thread_alloc::telemetry_snapshot(%thread%)
+%$$
+$codei%thread_alloc::telemetry_report(%report%)%$$
+
+$head Purpose$$
+The $cref/inuse/ta_inuse/$$ and $cref/available/ta_available/$$ functions
+only report the total memory for each thread.
+The telemetry counts the memory allocations for each thread and capacity.
+It can be used to decide if memory should be held
+(see $cref/hold_memory/ta_hold_memory/$$)
+and to find which allocations use the most memory.
+
+$head value$$
+This argument has prototype
+$codei%
+    bool %value%
+%$$
+If it is true (false) the counting is turned on (off).
+By default (when $code telemetry_enable$$ has not been called)
+there is no counting.
+This routine cannot be called while in parallel mode.
+
+$head thread$$
+This argument has prototype
+$codei%
+    size_t %thread%
+%$$
+Either $cref/thread_num/ta_thread_num/$$ must be the same as $icode thread$$,
+or the current execution mode must be sequential
+(not $cref/parallel/ta_in_parallel/$$).
+
+$head snapshot$$
+The return value has prototype
+$codei%
+    std::vector<thread_alloc::telemetry_t> %snapshot%
+%$$
+It has one element for each capacity that
+$icode thread$$ has obtained or returned memory for since the
+counters were last reset.
+The elements are in order of increasing capacity.
+
+$head telemetry_t$$
+The type $code thread_alloc::telemetry_t$$ is a structure with the
+following $code size_t$$ fields:
+$table
+$icode Field$$ $cnext $icode Meaning$$ $rnext
+$code capacity$$ $cnext
+    number of bytes for each block with this capacity
+$rnext
+$code num_get$$ $cnext
+    number of calls to $cref/get_memory/ta_get_memory/$$
+$rnext
+$code num_hit$$ $cnext
+    number of $code get_memory$$ calls that used
+    $cref/available/ta_available/$$ memory
+    (the cache hit rate is $code num_hit$$ divided by $code num_get$$)
+$rnext
+$code num_return$$ $cnext
+    number of blocks returned; see $cref/return_memory/ta_return_memory/$$
+$rnext
+$code num_remote$$ $cnext
+    number of blocks returned by other threads during parallel mode;
+    see $cref/other threads/ta_return_memory/Thread/Other Threads/$$
+$rnext
+$code inuse_bytes$$ $cnext
+    number of bytes currently in use
+$rnext
+$code peak_bytes$$ $cnext
+    maximum value of $code inuse_bytes$$
+$rnext
+$code waste_bytes$$ $cnext
+    total number of bytes wasted by rounding requests up to the capacity
+$tend
+Memory that was obtained before the counting was turned on
+is not included in $code inuse_bytes$$.
+
+$head report$$
+This argument has prototype
+$codei%
+    thread_alloc::telemetry_report_t %report%
+%$$
+which is the type
+$codei%
+    void (*)(size_t %thread%, const std::vector<telemetry_t>& %snapshot%)
+%$$
+If it is not $code nullptr$$, $cref/free_all/ta_free_all/$$ calls
+$icode report$$ with the $icode snapshot$$ for each thread that has telemetry.
+The counters for all the threads are reset by $code free_all$$
+(even if $icode report$$ is $code nullptr$$).
+This routine cannot be called while in parallel mode.
+
+$head Cost$$
+The counters for each thread are only changed by that thread
+(or in sequential mode) so they do not require any locking.
+When the counting is off, the only cost is checking if it is on.
+
+$end
+*/
+    /*!
+    Turn the thread_alloc telemetry counting on or off.
+
+    \param value [in]
+    if true (false) the counting is turned on (off).
+    */
+    static void telemetry_enable(bool value)
+    {   CPPAD_ASSERT_KNOWN(
+            ! in_parallel(),
+            "telemetry_enable cannot be used while in parallel execution"
+        );
+        bool set = true;
+        set_get_telemetry(set, value);
+    }
+    /*!
+    Get the current telemetry for a thread.
+
+    \param thread [in]
+    thread for the telemetry. Durring parallel execution, this must be the
+    thread that is currently executing.
+
+    \return
+    one element for each capacity that has been obtained or returned
+    (in order of increasing capacity).
+    */
+    static std::vector<telemetry_t> telemetry_snapshot(size_t thread)
+    {   CPPAD_ASSERT_KNOWN(
+            thread < max_num_threads(),
+            "telemetry_snapshot: thread >= max_num_threads()"
+        );
+        CPPAD_ASSERT_KNOWN(
+            thread == thread_num() || (! in_parallel()),
+            "telemetry_snapshot: thread is not current thread "
+            "while in parallel mode"
+        );
+        std::vector<telemetry_t> snapshot;
+        const telemetry_t* telemetry = thread_telemetry(thread, false);
+        if( telemetry == nullptr )
+            return snapshot;
+        size_t num_cap = capacity_info()->number;
+        for(size_t c_index = 0; c_index < num_cap; ++c_index)
+        {   const telemetry_t& t = telemetry[c_index];
+            if( t.num_get != 0 || t.num_return != 0 )
+            {   snapshot.push_back(t);
+                snapshot.back().capacity = capacity_info()->value[c_index];
+            }
+        }
+        return snapshot;
+    }
+    /*!
+    Set the routine that free_all uses to report the telemetry.
+
+    \param report [in]
+    is the routine (nullptr for no report).
+    */
+    static void telemetry_report(telemetry_report_t report)
+    {   CPPAD_ASSERT_KNOWN(
+            ! in_parallel(),
+            "telemetry_report cannot be used while in parallel execution"
+        );
+        bool set = true;
+        set_get_telemetry_report(set, report);
+    }
 
 /* -----------------------------------------------------------------------
 $begin ta_inuse$$
@@ -1179,7 +2206,7 @@ $end
 
     \param thread [in]
     Thread for which we are determining the amount of memory
-    (must be < CPPAD_MAX_NUM_THREADS).
+    (must be < max_num_threads()).
     Durring parallel execution, this must be the thread
     that is currently executing.
 
@@ -1188,7 +2215,7 @@ $end
     */
     static size_t inuse(size_t thread)
     {
-        CPPAD_ASSERT_UNKNOWN( thread < CPPAD_MAX_NUM_THREADS);
+        CPPAD_ASSERT_UNKNOWN( thread < max_num_threads() );
         CPPAD_ASSERT_UNKNOWN(
             thread == thread_num() || (! in_parallel())
         );
@@ -1242,7 +2269,7 @@ $end
     */
     static size_t available(size_t thread)
     {
-        CPPAD_ASSERT_UNKNOWN( thread < CPPAD_MAX_NUM_THREADS);
+        CPPAD_ASSERT_UNKNOWN( thread < max_num_threads() );
         CPPAD_ASSERT_UNKNOWN(
             thread == thread_num() || (! in_parallel())
         );
@@ -1478,6 +2505,10 @@ Otherwise, the return value will be false.
 $head Restrictions$$
 This function cannot be called while in parallel mode.
 
+$head Telemetry$$
+The $cref/telemetry/ta_telemetry/$$ for every thread is reported
+(if a report routine has been set) and then all its counters are reset.
+
 $head Example$$
 $cref thread_alloc.cpp$$
 $end
@@ -1496,9 +2527,21 @@ $end
             "free_all cannot be used while in parallel execution"
         );
         bool ok = true;
-        size_t thread = CPPAD_MAX_NUM_THREADS;
+        telemetry_report_t report = set_get_telemetry_report(false);
+        size_t thread = max_num_threads();
         while(thread--)
-        {   ok &= inuse(thread) == 0;
+        {   drain_remote( thread_info(thread) );
+            //
+            // report and then free the telemetry for this thread
+            telemetry_t*& telemetry = thread_telemetry(thread, false);
+            if( telemetry != nullptr )
+            {   if( report != nullptr )
+                    report(thread, telemetry_snapshot(thread) );
+                ::operator delete( reinterpret_cast<void*>(telemetry) );
+                telemetry = nullptr;
+            }
+            //
+            ok &= inuse(thread) == 0;
             free_available(thread);
         }
         return ok;
@@ -1510,6 +2553,8 @@ $end
 
 // preprocessor symbols local to this file
 # undef CPPAD_MAX_NUM_CAPACITY
+# undef CPPAD_MIN_MAP_BYTES
+# undef CPPAD_HUGE_PAGE_BYTES
 # undef CPPAD_MIN_DOUBLE_CAPACITY
 # undef CPPAD_TRACE_CAPACITY
 # undef CPPAD_TRACE_THREAD
@@ -0,0 +1,440 @@
+# ifndef CPPAD_UTILITY_THREAD_POOL_HPP
+# define CPPAD_UTILITY_THREAD_POOL_HPP
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-22 Bradley M. Bell
+
+CppAD is distributed under the terms of the
+             Eclipse Public License Version 2.0.
+
+This Source Code may also be made available under the following
+Secondary License when the conditions for such availability set forth
+in the Eclipse Public License, Version 2.0 are satisfied:
+      GNU General Public License, Version 2.0 or later.
+---------------------------------------------------------------------------- */
+/*
+$begin thread_pool$$
+$spell
+    CppAD
+    num
+    alloc
+    jac
+    hes
+    const
+    std
+    bool
+    pthread
+    lpthread
+    cmake
+$$
+
+$section A Work Stealing Pool of Threads$$
+
+$head Syntax$$
+$codei%# include <cppad/utility/thread_pool.hpp>
+%$$
+$codei%thread_pool %pool%(%num_threads%)
+%$$
+$icode%number% = %pool%.num_threads()
+%$$
+$icode%pool%.run(%n_task%, %job%)
+%$$
+$icode%flag% = thread_pool::in_parallel()
+%$$
+$icode%thread% = thread_pool::thread_num()
+%$$
+
+$head Purpose$$
+This class creates the threads for CppAD multi-threading
+(without having to write the $cref/team/team_thread.hpp/$$ routines
+for a particular threading system).
+It uses $code std::thread$$, so on some systems the program must be linked
+with the threading library; e.g., using $code -lpthread$$.
+(The $cref cmake$$ and autotools builds of the CppAD tests
+take care of this.)
+
+$head Constructor$$
+The constructor creates $icode%num_threads%-1%$$ new threads
+and has the following prototype
+$codei%
+    thread_pool::thread_pool(size_t %num_threads%)
+%$$
+The thread that calls the constructor is thread zero in the pool.
+The constructor uses
+$codei%
+    thread_alloc::parallel_setup(
+        %num_threads%, thread_pool::in_parallel, thread_pool::thread_num
+    )
+%$$
+to inform $cref thread_alloc$$ about the threads;
+see $cref/parallel_setup/ta_parallel_setup/$$.
+There can only be one $code thread_pool$$ object at a time and
+it must be constructed in sequential execution mode.
+
+$head Destructor$$
+The destructor waits for the other threads to terminate,
+frees the memory that $code thread_alloc$$ is
+$cref/holding/ta_hold_memory/$$ for them, and uses
+$codei%
+    thread_alloc::parallel_setup(1, nullptr, nullptr)
+%$$
+to return to sequential execution mode.
+
+$head parallel_ad$$
+The threads in the pool can record and evaluate
+$codei%AD<%Base%>%$$ and $codei%ADFun<%Base%>%$$ objects without first
+calling $cref/parallel_ad<Base>()/parallel_ad/$$; see
+$cref/lazy initialization/parallel_ad/Lazy Initialization/$$.
+
+$head num_threads$$
+The return value $icode number$$ has prototype
+$codei%
+    size_t %number%
+%$$
+and is the number of threads in the pool
+(including the thread that constructed it).
+
+$head run$$
+This member function has prototype
+$codei%
+    void %pool%.run(
+        size_t %n_task%,
+        const std::function<void(size_t %task%, size_t %thread%)>& %job%
+    )
+%$$
+For each $icode%task% = 0 , %...% , %n_task%-1%$$,
+the function call $icode%job%(%task%, %thread%)%$$
+is executed by exactly one of the threads in the pool.
+The thread number $icode thread$$ is less than $icode num_threads$$
+and is equal to $code thread_alloc::thread_num()$$ during the call.
+This function returns after all the tasks have completed.
+It must be called in sequential execution mode
+(a job cannot call $code run$$).
+If one of the calls to $icode job$$ throws an exception,
+the other tasks are still executed and then the exception
+is re-thrown by $code run$$.
+
+$subhead Work Stealing$$
+The tasks are initially divided into $icode num_threads$$ contiguous
+ranges, one for each thread.
+Each thread executes the tasks in its range in increasing order.
+When a thread has no more tasks in its range,
+it takes half of the remaining tasks from the range of another thread.
+Thus the tasks can take different amounts of time
+and all the threads stay busy until there are no tasks left.
+
+$head in_parallel$$
+The return value $icode flag$$ has prototype
+$codei%
+    bool %flag%
+%$$
+It is true (false) if the pool is (is not) currently executing a
+$icode job$$.
+
+$head thread_num$$
+The return value $icode thread$$ has prototype
+$codei%
+    size_t %thread%
+%$$
+It is the index of the pool thread that is currently executing
+(zero if the current thread is not in the pool).
+
+$head Drivers$$
+The following CppAD drivers have versions with a $icode pool$$ argument
+that divide their forward and reverse sweeps between the threads in the pool:
+$table
+$cref/Jacobian/Jacobian/pool/$$ $cnext
+    $icode%jac% = %f%.Jacobian(%x%, %pool%)%$$ $rnext
+$cref/Hessian/Hessian/pool/$$ $cnext
+    $icode%hes% = %f%.Hessian(%x%, %w%, %pool%)%$$ $rnext
+$cref/sparse_jac/sparse_jac/pool/$$ $cnext
+    $icode%f%.sparse_jac_for(%group_max%, %x%, %subset%, %pattern%, %coloring%, %work%, %pool%)%$$ $rnext
+$cref/sparse_jac/sparse_jac/pool/$$ $cnext
+    $icode%f%.sparse_jac_rev(%x%, %subset%, %pattern%, %coloring%, %work%, %pool%)%$$ $rnext
+$cref/sparse_hes/sparse_hes/pool/$$ $cnext
+    $icode%f%.sparse_hes(%x%, %w%, %subset%, %pattern%, %coloring%, %work%, %pool%)%$$
+$tend
+
+$children%
+    example/utility/thread_pool.cpp
+%$$
+$head Example$$
+The file $cref thread_pool.cpp$$ is an example and test of this class.
+
+$end
+*/
+# include <atomic>
+# include <condition_variable>
+# include <exception>
+# include <functional>
+# include <mutex>
+# include <thread>
+# include <vector>
+
+# include <cppad/core/cppad_assert.hpp>
+# include <cppad/utility/thread_alloc.hpp>
+
+namespace CppAD { // BEGIN_CPPAD_NAMESPACE
+/*!
+\file thread_pool.hpp
+A pool of threads that use work stealing to execute a set of tasks.
+*/
+
+/*!
+A pool of threads that use work stealing to execute a set of tasks.
+*/
+class thread_pool {
+private:
+    /// range of tasks [begin, end) that have not yet been started
+    struct queue_t {
+        /// protects begin and end
+        std::mutex mutex;
+        /// first task in this range
+        size_t     begin;
+        /// one more than the last task in this range
+        size_t     end;
+        /// constructor
+        queue_t(void) : begin(0), end(0)
+        { }
+    };
+    /// type of a job (task, thread)
+    typedef std::function<void(size_t, size_t)> job_t;
+    // ------------------------------------------------------------------------
+    /// number of threads in the pool (including thread zero)
+    const size_t             num_threads_;
+    /// the threads that were created by this pool
+    std::vector<std::thread> worker_;
+    /// tasks that have not yet been started by each thread
+    std::vector<queue_t>     queue_;
+    //
+    /// protects the values below
+    std::mutex               mutex_;
+    /// used to wake up the workers when a new job starts
+    std::condition_variable  start_cv_;
+    /// used to wake up thread zero when the workers are done
+    std::condition_variable  done_cv_;
+    /// incremented each time a new job starts
+    size_t                   generation_;
+    /// number of workers that have not finished the current job
+    size_t                   n_running_;
+    /// are the workers being terminated
+    bool                     stop_;
+    /// the current job
+    const job_t*             job_;
+    /// first exception thrown by the current job
+    std::exception_ptr       error_;
+    // ------------------------------------------------------------------------
+    /// pool thread number for the current operating system thread
+    static size_t& thread_index(void)
+    {   static thread_local size_t index = 0;
+        return index;
+    }
+    /// is a job currently running
+    static std::atomic<bool>& running(void)
+    {   static std::atomic<bool> flag(false);
+        return flag;
+    }
+    /// does a thread_pool object currently exist
+    static bool& exists(void)
+    {   static bool flag = false;
+        return flag;
+    }
+    // ------------------------------------------------------------------------
+    /*!
+    Get the next task for a thread.
+
+    \param thread
+    is the pool thread number for the current thread.
+
+    \param task
+    if the return value is true, the input value of task does not matter
+    and its output value is the next task for this thread.
+
+    \return
+    is false if there are no more tasks for any of the threads.
+    */
+    bool next_task(size_t thread, size_t& task)
+    {   queue_t& own( queue_[thread] );
+        {   std::lock_guard<std::mutex> lock(own.mutex);
+            if( own.begin < own.end )
+            {   task = own.begin++;
+                return true;
+            }
+        }
+        // steal the second half of the tasks from another thread
+        for(size_t i = 1; i < num_threads_; ++i)
+        {   queue_t& other( queue_[ (thread + i) % num_threads_ ] );
+            size_t begin, end;
+            {   std::lock_guard<std::mutex> lock(other.mutex);
+                if( other.begin == other.end )
+                    continue;
+                end         = other.end;
+                begin       = end - (end - other.begin + 1) / 2;
+                other.end   = begin;
+            }
+            // execute the first stolen task now and queue the others
+            std::lock_guard<std::mutex> lock(own.mutex);
+            task      = begin;
+            own.begin = begin + 1;
+            own.end   = end;
+            return true;
+        }
+        return false;
+    }
+    /*!
+    Execute tasks for the current job until there are no more tasks.
+
+    \param thread
+    is the pool thread number for the current thread.
+    */
+    void work(size_t thread)
+    {   size_t task;
+        while( next_task(thread, task) )
+        {   try
+            {   (*job_)(task, thread);
+            }
+            catch(...)
+            {   std::lock_guard<std::mutex> lock(mutex_);
+                if( ! error_ )
+                    error_ = std::current_exception();
+            }
+        }
+    }
+    /*!
+    Main routine for each of the threads created by this pool.
+
+    \param thread
+    is the pool thread number for the new thread (greater than zero).
+    */
+    void worker(size_t thread)
+    {   thread_index() = thread;
+        size_t generation = 0;
+        while( true )
+        {   {   std::unique_lock<std::mutex> lock(mutex_);
+                while( ! stop_ && generation == generation_ )
+                    start_cv_.wait(lock);
+                if( stop_ )
+                    return;
+                generation = generation_;
+            }
+            work(thread);
+            {   std::lock_guard<std::mutex> lock(mutex_);
+                if( --n_running_ == 0 )
+                    done_cv_.notify_one();
+            }
+        }
+    }
+public:
+    /*!
+    Create the pool threads and inform thread_alloc about them.
+
+    \param num_threads
+    is the number of threads in the pool including the current thread.
+    */
+    thread_pool(size_t num_threads)
+    : num_threads_(num_threads)
+    , queue_(num_threads)
+    , generation_(0)
+    , n_running_(0)
+    , stop_(false)
+    , job_(nullptr)
+    {   CPPAD_ASSERT_KNOWN(
+            num_threads > 0,
+            "thread_pool: num_threads is zero"
+        );
+        CPPAD_ASSERT_KNOWN(
+            ! thread_alloc::in_parallel(),
+            "thread_pool: constructor called in parallel mode"
+        );
+        CPPAD_ASSERT_KNOWN(
+            ! exists(),
+            "thread_pool: another thread_pool object already exists"
+        );
+        exists() = true;
+        thread_alloc::parallel_setup(num_threads, in_parallel, thread_num);
+        for(size_t thread = 1; thread < num_threads; ++thread)
+            worker_.push_back( std::thread(&thread_pool::worker, this, thread) );
+    }
+    /// a pool cannot be copied
+    thread_pool(const thread_pool& other) = delete;
+    thread_pool& operator=(const thread_pool& other) = delete;
+    /*!
+    Terminate the pool threads and return to sequential execution mode.
+    */
+    ~thread_pool(void)
+    {   {   std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        start_cv_.notify_all();
+        for(size_t i = 0; i < worker_.size(); ++i)
+            worker_[i].join();
+        //
+        // memory that thread_alloc is holding for the terminated threads
+        for(size_t thread = 1; thread < num_threads_; ++thread)
+            thread_alloc::free_available(thread);
+        thread_alloc::parallel_setup(1, nullptr, nullptr);
+        exists() = false;
+    }
+    /// number of threads in the pool
+    size_t num_threads(void) const
+    {   return num_threads_; }
+    /// is the pool currently executing a job
+    static bool in_parallel(void)
+    {   return running().load(std::memory_order_acquire); }
+    /// pool thread number for the current thread
+    static size_t thread_num(void)
+    {   return thread_index(); }
+    /*!
+    Execute a job using the threads in the pool.
+
+    \param n_task
+    is the number of tasks in this job.
+
+    \param job
+    for task = 0, ..., n_task-1, job(task, thread) is called by one of the
+    threads in the pool, where thread is the pool number for that thread.
+    */
+    void run(size_t n_task, const job_t& job)
+    {   CPPAD_ASSERT_KNOWN(
+            ! thread_alloc::in_parallel(),
+            "thread_pool::run: called in parallel mode"
+        );
+        if( n_task == 0 )
+            return;
+        //
+        // initial partition of the tasks between the threads
+        for(size_t thread = 0; thread < num_threads_; ++thread)
+        {   queue_[thread].begin = (n_task * thread) / num_threads_;
+            queue_[thread].end   = (n_task * (thread + 1)) / num_threads_;
+        }
+        //
+        // start the other threads
+        {   std::lock_guard<std::mutex> lock(mutex_);
+            job_       = &job;
+            error_     = nullptr;
+            n_running_ = num_threads_ - 1;
+            ++generation_;
+            running().store(true, std::memory_order_release);
+        }
+        start_cv_.notify_all();
+        //
+        // this is thread zero in the pool
+        work(0);
+        //
+        // wait for the other threads to finish
+        std::exception_ptr error;
+        {   std::unique_lock<std::mutex> lock(mutex_);
+            while( n_running_ != 0 )
+                done_cv_.wait(lock);
+            running().store(false, std::memory_order_release);
+            job_  = nullptr;
+            error = error_;
+            error_ = nullptr;
+        }
+        if( error )
+            std::rethrow_exception(error);
+    }
+};
+
+} // END_CPPAD_NAMESPACE
+
+# endif
@@ -46,6 +46,8 @@ $srccode%cpp% */
 extern std::map<std::string, bool> global_option;
 // see comments in main program for this external
 extern size_t global_cppad_thread_alloc_inuse;
+// see comments in main program for this external
+extern CppAD::optimize_report global_cppad_optimize_report;
 
 bool link_det_lu(
     size_t                           size     ,
@@ -56,7 +58,7 @@ bool link_det_lu(
 
     // --------------------------------------------------------------------
     // check global options
-    const char* valid[] = { "memory", "optimize"};
+    const char* valid[] = { "memory", "optimize", "report"};
     size_t n_valid = sizeof(valid) / sizeof(valid[0]);
     typedef std::map<std::string, bool>::iterator iterator;
     //
@@ -110,7 +112,9 @@ bool link_det_lu(
         // create function object f : A -> detA
         f.Dependent(A, detA);
         if( global_option["optimize"] )
-            f.optimize(optimize_options);
+        {   f.optimize(optimize_options);
+            global_cppad_optimize_report = f.optimize_report();
+        }
 
         // evaluate and return gradient using reverse mode
         f.Forward(0, matrix);
@@ -40,6 +40,8 @@ $srccode%cpp% */
 extern std::map<std::string, bool> global_option;
 // see comments in main program for this external
 extern size_t global_cppad_thread_alloc_inuse;
+// see comments in main program for this external
+extern CppAD::optimize_report global_cppad_optimize_report;
 
 namespace {
     // typedefs
@@ -85,6 +87,7 @@ namespace {
         {   std::string optimize_options =
                 "no_conditional_skip no_compare_op no_print_for_op";
             f.optimize(optimize_options);
+            global_cppad_optimize_report = f.optimize_report();
         }
 
     }
@@ -101,7 +104,7 @@ bool link_det_minor(
 
     // --------------------------------------------------------------------
     // check global options
-    const char* valid[] = { "memory", "onetape", "optimize"};
+    const char* valid[] = { "memory", "onetape", "optimize", "report"};
     size_t n_valid = sizeof(valid) / sizeof(valid[0]);
     typedef std::map<std::string, bool>::iterator iterator;
     //
@@ -45,6 +45,8 @@ $srccode%cpp% */
 extern std::map<std::string, bool> global_option;
 // see comments in main program for this external
 extern size_t global_cppad_thread_alloc_inuse;
+// see comments in main program for this external
+extern CppAD::optimize_report global_cppad_optimize_report;
 
 bool link_mat_mul(
     size_t                           size     ,
@@ -57,7 +59,7 @@ bool link_mat_mul(
 
     // --------------------------------------------------------------------
     // check global options
-    const char* valid[] = { "memory", "onetape", "optimize", "atomic"};
+    const char* valid[] = { "memory", "onetape", "optimize", "report", "atomic"};
     size_t n_valid = sizeof(valid) / sizeof(valid[0]);
     typedef std::map<std::string, bool>::iterator iterator;
     //
@@ -130,7 +132,9 @@ bool link_mat_mul(
         f.Dependent(X, Z);
 
         if( global_option["optimize"] )
-            f.optimize(optimize_options);
+        {   f.optimize(optimize_options);
+            global_cppad_optimize_report = f.optimize_report();
+        }
 
         // skip comparison operators
         f.compare_change_count(0);
@@ -167,7 +171,9 @@ bool link_mat_mul(
         f.Dependent(X, Z);
 
         if( global_option["optimize"] )
-            f.optimize(optimize_options);
+        {   f.optimize(optimize_options);
+            global_cppad_optimize_report = f.optimize_report();
+        }
 
         // skip comparison operators
         f.compare_change_count(0);
@@ -47,6 +47,8 @@ $srccode%cpp% */
 extern std::map<std::string, bool> global_option;
 // see comments in main program for this external
 extern size_t global_cppad_thread_alloc_inuse;
+// see comments in main program for this external
+extern CppAD::optimize_report global_cppad_optimize_report;
 
 bool link_ode(
     size_t                     size       ,
@@ -58,7 +60,7 @@ bool link_ode(
 
     // --------------------------------------------------------------------
     // check global options
-    const char* valid[] = { "memory", "onetape", "optimize"};
+    const char* valid[] = { "memory", "onetape", "optimize", "report"};
     size_t n_valid = sizeof(valid) / sizeof(valid[0]);
     typedef std::map<std::string, bool>::iterator iterator;
     //
@@ -111,7 +113,9 @@ bool link_ode(
         f.Dependent(X, Y);
 
         if( global_option["optimize"] )
-            f.optimize(optimize_options);
+        {   f.optimize(optimize_options);
+            global_cppad_optimize_report = f.optimize_report();
+        }
 
         // skip comparison operators
         f.compare_change_count(0);
@@ -134,7 +138,9 @@ bool link_ode(
         f.Dependent(X, Y);
 
         if( global_option["optimize"] )
-            f.optimize(optimize_options);
+        {   f.optimize(optimize_options);
+            global_cppad_optimize_report = f.optimize_report();
+        }
 
         // skip comparison operators
         f.compare_change_count(0);
@@ -52,6 +52,8 @@ $srccode%cpp% */
 extern std::map<std::string, bool> global_option;
 // see comments in main program for this external
 extern size_t global_cppad_thread_alloc_inuse;
+// see comments in main program for this external
+extern CppAD::optimize_report global_cppad_optimize_report;
 
 namespace {
     // typedefs
@@ -102,7 +104,9 @@ namespace {
             fun.Dependent(a1x, a1y);
             //
             if( global_option["optimize"] )
-                fun.optimize(optimize_options);
+            {   fun.optimize(optimize_options);
+                global_cppad_optimize_report = fun.optimize_report();
+            }
             //
             // skip comparison operators
             fun.compare_change_count(0);
@@ -137,7 +141,9 @@ namespace {
         fun.Dependent(a1x, a1z);
         //
         if( global_option["optimize"] )
-            fun.optimize(optimize_options);
+        {   fun.optimize(optimize_options);
+            global_cppad_optimize_report = fun.optimize_report();
+        }
         //
         // skip comparison operators
         fun.compare_change_count(0);
@@ -245,6 +251,10 @@ namespace {
                 coloring = "colpack";
             if( global_option["symmetric"] )
                 coloring += ".symmetric";
+            else if( global_option["star"] )
+                coloring += ".star";
+            else if( global_option["acyclic"] )
+                coloring += ".acyclic";
             else
                 coloring += ".general";
             //
@@ -302,8 +312,8 @@ bool link_sparse_hessian(
     // --------------------------------------------------------------------
     // check global options
     const char* valid[] = {
-        "memory", "onetape", "optimize", "hes2jac", "subgraph",
-        "boolsparsity", "revsparsity", "symmetric"
+        "memory", "onetape", "optimize", "report", "hes2jac", "subgraph",
+        "boolsparsity", "revsparsity", "symmetric", "star", "acyclic"
 # if CPPAD_HAS_COLPACK
         , "colpack"
 # else
@@ -332,6 +342,15 @@ bool link_sparse_hessian(
     {   if( ! global_option["hes2jac"] )
             return false;
     }
+    if( global_option["star"] || global_option["acyclic"] )
+    {   // these are CppAD symmetric coloring methods for sparse_hes
+        if( global_option["colpack"] || global_option["hes2jac"] )
+            return false;
+        if( global_option["symmetric"] )
+            return false;
+        if( global_option["star"] && global_option["acyclic"] )
+            return false;
+    }
 # if ! CPPAD_HAS_COLPACK
     if( global_option["colpack"] )
         return false;
@@ -47,6 +47,8 @@ $srccode%cpp% */
 extern std::map<std::string, bool> global_option;
 // see comments in main program for this external
 extern size_t global_cppad_thread_alloc_inuse;
+// see comments in main program for this external
+extern CppAD::optimize_report global_cppad_optimize_report;
 
 namespace {
     using CppAD::vector;
@@ -147,7 +149,9 @@ namespace {
         f.Dependent(a_x, a_y);
         //
         if( global_option["optimize"] )
-            f.optimize(optimize_options);
+        {   f.optimize(optimize_options);
+            global_cppad_optimize_report = f.optimize_report();
+        }
         //
         // coloring method
         std::string coloring = "cppad";
@@ -157,6 +161,8 @@ namespace {
 # else
         CPPAD_ASSERT_UNKNOWN( ! global_option["colpack"] );
 # endif
+        if( global_option["bidirectional"] )
+            coloring = "cppad.bidirectional";
         //
         // sparsity pattern for subset of Jacobian that is evaluated
         size_t nnz = row.size();
@@ -207,8 +213,8 @@ bool link_sparse_jacobian(
     // --------------------------------------------------------------------
     // check global options
     const char* valid[] = {
-        "memory", "onetape", "optimize", "subgraph",
-        "boolsparsity", "revsparsity", "subsparsity"
+        "memory", "onetape", "optimize", "report", "subgraph",
+        "boolsparsity", "revsparsity", "subsparsity", "bidirectional"
 # if CPPAD_HAS_COLPACK
         , "colpack"
 # endif
@@ -231,6 +237,10 @@ bool link_sparse_jacobian(
         ||  global_option["colpack"]  )
             return false;
     }
+    if( global_option["bidirectional"] )
+    {   if( global_option["colpack"] )
+            return false;
+    }
     // -----------------------------------------------------
     // size corresponding to static_f
     static size_t static_size = 0;
@@ -286,6 +296,8 @@ bool link_sparse_jacobian(
     std::string coloring = "cppad";
     if( global_option["colpack"] )
         coloring = "colpack";
+    if( global_option["bidirectional"] )
+        coloring = "cppad.bidirectional";
     // ------------------------------------------------------
     while(repeat--)
     {   if( onetape )
@@ -0,0 +1,394 @@
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-22 Bradley M. Bell
+
+CppAD is distributed under the terms of the
+             Eclipse Public License Version 2.0.
+
+This Source Code may also be made available under the following
+Secondary License when the conditions for such availability set forth
+in the Eclipse Public License, Version 2.0 are satisfied:
+      GNU General Public License, Version 2.0 or later.
+---------------------------------------------------------------------------- */
+/*
+$begin speed_coloring.cpp$$
+$spell
+    cppad
+    colpack
+    jac
+    hes
+    Jacobians
+    Jacobian
+    Hessians
+    sec
+    bidirectional
+$$
+
+$section Compare Coloring Methods for Sparse Jacobians and Hessians$$
+
+$head Syntax$$
+$codei%speed_coloring
+%$$
+$codei%speed_coloring %size% %time_min%
+%$$
+
+$head Purpose$$
+This program compares the $icode coloring$$ methods for
+$cref/sparse_jac/sparse_jac/coloring/$$ and
+$cref/sparse_hes/sparse_hes/coloring/$$
+on sparsity patterns with different structure.
+The $cref/sparse_jacobian/link_sparse_jacobian/$$ and
+$cref/sparse_hessian/link_sparse_hessian/$$ speed tests
+only use one pattern, and time the coloring together with the evaluation;
+see the
+$cref/bidirectional/speed_main/Sparsity Options/bidirectional/$$,
+$cref/star/speed_main/Sparsity Options/star/$$ and
+$cref/acyclic/speed_main/Sparsity Options/acyclic/$$ options.
+
+$head size$$
+This is the number of independent variables for each function.
+Its default value is 400.
+
+$head time_min$$
+This is the minimum time in seconds used to time each calculation.
+Its default value is 0.1.
+
+$head Patterns$$
+Each pattern is symmetric, includes the diagonal,
+and is used as both the Jacobian and Hessian sparsity pattern:
+$table
+$code banded$$ $cnext
+    entries with $latex | i - j | \leq 2$$
+$rnext
+$code arrow$$ $cnext
+    a banded pattern with a dense first row and column
+$rnext
+$code random$$ $cnext
+    three random entries in each row (before making it symmetric)
+$rnext
+$code stencil$$ $cnext
+    five point stencil for a square grid
+    ($icode size$$ is rounded down to a square)
+$tend
+
+$head Functions$$
+The Jacobian is computed for
+$latex \[
+    f_i (x) = \sum_{(i,j) \in P} x_j^2
+\] $$
+and the Hessian is computed for
+$latex \[
+    g(x) = \sum_{(i,j) \in P, i \leq j} x_i x_j
+\] $$
+where $latex P$$ is the sparsity pattern.
+
+$head Output$$
+There is one line of output for each pattern and method with the columns:
+$table
+$code pattern$$   $cnext name of the sparsity pattern $rnext
+$code method$$    $cnext routine and coloring method  $rnext
+$code n_color$$   $cnext
+    number of colors; i.e., the return value $icode n_sweep$$
+$rnext
+$code color_sec$$ $cnext
+    seconds used to compute the coloring
+    (the difference between the two times below)
+$rnext
+$code total_sec$$ $cnext
+    seconds per evaluation starting with an empty $icode work$$
+$rnext
+$code eval_sec$$ $cnext
+    seconds per evaluation reusing $icode work$$
+$rnext
+$code ok$$        $cnext
+    is the calculated derivative correct
+$tend
+The colpack methods are only included when
+$cref/colpack_prefix/cmake/colpack_prefix/$$ is specified.
+
+$head Source$$
+$srcthisfile%0%// BEGIN C++%// END C++%1%$$
+
+$end
+*/
+// BEGIN C++
+# include <cppad/cppad.hpp>
+# include <set>
+# include <cstdlib>
+# include <iomanip>
+
+namespace {
+    using CppAD::vector;
+    typedef vector<size_t>                        s_vector;
+    typedef vector<double>                        d_vector;
+    typedef CppAD::sparse_rc<s_vector>            sparsity_pattern;
+    typedef CppAD::sparse_rcv<s_vector, d_vector> sparse_matrix;
+    // ------------------------------------------------------------------------
+    // pattern with the specified name and n rows and columns
+    // (n is changed to the number of rows for the stencil pattern)
+    void create_pattern(
+        const std::string& name, size_t& n, sparsity_pattern& pattern
+    )
+    {   std::set< std::pair<size_t, size_t> > entry;
+        if( name == "stencil" )
+        {   size_t k = 1;
+            while( (k + 1) * (k + 1) <= n )
+                ++k;
+            n = k * k;
+            for(size_t i = 0; i < k; ++i)
+            {   for(size_t j = 0; j < k; ++j)
+                {   size_t ij = i * k + j;
+                    entry.insert( std::make_pair(ij, ij) );
+                    if( i + 1 < k )
+                        entry.insert( std::make_pair(ij, ij + k) );
+                    if( j + 1 < k )
+                        entry.insert( std::make_pair(ij, ij + 1) );
+                }
+            }
+        }
+        else
+        {   // simple random number generator so results are reproducible
+            size_t seed = 1;
+            for(size_t i = 0; i < n; ++i)
+            {   entry.insert( std::make_pair(i, i) );
+                if( name == "banded" || name == "arrow" )
+                {   for(size_t j = i + 1; j < n && j <= i + 2; ++j)
+                        entry.insert( std::make_pair(i, j) );
+                }
+                if( name == "arrow" )
+                    entry.insert( std::make_pair(size_t(0), i) );
+                if( name == "random" )
+                {   for(size_t ell = 0; ell < 3; ++ell)
+                    {   seed = (seed * 1103515245 + 12345) % 2147483648;
+                        size_t j = seed % n;
+                        entry.insert( std::make_pair(i, j) );
+                    }
+                }
+            }
+        }
+        // make the pattern symmetric
+        std::set< std::pair<size_t, size_t> > upper(entry);
+        std::set< std::pair<size_t, size_t> >::const_iterator itr;
+        for(itr = upper.begin(); itr != upper.end(); ++itr)
+            entry.insert( std::make_pair(itr->second, itr->first) );
+        //
+        pattern.resize(n, n, entry.size());
+        size_t k = 0;
+        for(itr = entry.begin(); itr != entry.end(); ++itr)
+            pattern.set(k++, itr->first, itr->second);
+    }
+    // ------------------------------------------------------------------------
+    // record the function used for the Jacobian and the one for the Hessian
+    void create_fun(
+        const sparsity_pattern&  pattern ,
+        CppAD::ADFun<double>&    f_jac   ,
+        CppAD::ADFun<double>&    g_hes   )
+    {   using CppAD::AD;
+        size_t n = pattern.nr();
+        vector< AD<double> > ax(n), ay(n), az(1);
+        for(size_t j = 0; j < n; ++j)
+            ax[j] = 1.0;
+        //
+        CppAD::Independent(ax);
+        for(size_t i = 0; i < n; ++i)
+            ay[i] = 0.0;
+        for(size_t k = 0; k < pattern.nnz(); ++k)
+        {   size_t i = pattern.row()[k];
+            size_t j = pattern.col()[k];
+            ay[i] += ax[j] * ax[j];
+        }
+        f_jac.Dependent(ax, ay);
+        f_jac.optimize();
+        //
+        CppAD::Independent(ax);
+        az[0] = 0.0;
+        for(size_t k = 0; k < pattern.nnz(); ++k)
+        {   size_t i = pattern.row()[k];
+            size_t j = pattern.col()[k];
+            if( i <= j )
+                az[0] += ax[i] * ax[j];
+        }
+        g_hes.Dependent(ax, az);
+        g_hes.optimize();
+    }
+    // ------------------------------------------------------------------------
+    // information needed to compute a sparse Jacobian or Hessian
+    struct sparse_calc {
+        // function that we are computing the derivative of
+        CppAD::ADFun<double>* fun;
+        // routine: sparse_jac_for, sparse_jac_rev, or sparse_hes
+        std::string routine;
+        // coloring method
+        std::string coloring;
+        // sparsity pattern
+        const sparsity_pattern* pattern;
+        // argument value
+        d_vector x;
+        // subset of the derivative that we are computing
+        sparse_matrix subset;
+        // work space for the calculation
+        CppAD::sparse_jac_work jac_work;
+        CppAD::sparse_hes_work hes_work;
+        //
+        // compute the derivative and return the number of colors
+        size_t operator()(void)
+        {   size_t n_color = 0;
+            if( routine == "sparse_jac_for" )
+            {   size_t group_max = 1;
+                n_color = fun->sparse_jac_for(
+                    group_max, x, subset, *pattern, coloring, jac_work
+                );
+            }
+            else if( routine == "sparse_jac_rev" )
+            {   n_color = fun->sparse_jac_rev(
+                    x, subset, *pattern, coloring, jac_work
+                );
+            }
+            else
+            {   d_vector w(1);
+                w[0] = 1.0;
+                n_color = fun->sparse_hes(
+                    x, w, subset, *pattern, coloring, hes_work
+                );
+            }
+            return n_color;
+        }
+        // seconds per calculation; clear the work space for each
+        // calculation when clear_work is true
+        double seconds(bool clear_work, double time_min)
+        {   size_t repeat = 1;
+            double s0     = CppAD::elapsed_seconds();
+            double s1     = s0;
+            while( s1 - s0 < time_min )
+            {   repeat *= 2;
+                s0      = CppAD::elapsed_seconds();
+                for(size_t r = 0; r < repeat; ++r)
+                {   if( clear_work )
+                    {   jac_work.clear();
+                        hes_work.clear();
+                    }
+                    (*this)();
+                }
+                s1 = CppAD::elapsed_seconds();
+            }
+            return (s1 - s0) / double(repeat);
+        }
+        // check the values in subset
+        bool check(void) const
+        {   bool ok = true;
+            double eps = 100. * std::numeric_limits<double>::epsilon();
+            for(size_t k = 0; k < subset.nnz(); ++k)
+            {   size_t i     = subset.row()[k];
+                size_t j     = subset.col()[k];
+                double check = 2.0 * x[j];
+                if( routine == "sparse_hes" && i != j )
+                    check = 1.0;
+                else if( routine == "sparse_hes" )
+                    check = 2.0;
+                ok &= CppAD::NearEqual(subset.val()[k], check, eps, eps);
+            }
+            return ok;
+        }
+    };
+}
+
+int main(int argc, char* argv[])
+{   bool ok = true;
+    using std::cout;
+    using std::setw;
+    //
+    if( argc != 1 && argc != 3 )
+    {   std::cerr << "usage: speed_coloring [size time_min]\n";
+        return 1;
+    }
+    size_t size     = 400;
+    double time_min = 0.1;
+    if( argc == 3 )
+    {   size     = size_t( std::atoi( argv[1] ) );
+        time_min = std::atof( argv[2] );
+    }
+    if( size < 4 )
+    {   std::cerr << "speed_coloring: size is less than 4\n";
+        return 1;
+    }
+    //
+    // pattern names
+    const char* pattern_list[] = { "banded", "arrow", "random", "stencil" };
+    size_t n_pattern = sizeof(pattern_list) / sizeof(pattern_list[0]);
+    //
+    // routine and coloring for each method
+    const char* method_list[][2] = {
+        { "sparse_jac_for", "cppad" },
+        { "sparse_jac_rev", "cppad" },
+        { "sparse_jac_for", "cppad.bidirectional" },
+# if CPPAD_HAS_COLPACK
+        { "sparse_jac_for", "colpack" },
+        { "sparse_jac_rev", "colpack" },
+# endif
+        { "sparse_hes",     "cppad.general" },
+        { "sparse_hes",     "cppad.symmetric" },
+        { "sparse_hes",     "cppad.star" },
+        { "sparse_hes",     "cppad.acyclic" },
+# if CPPAD_HAS_COLPACK
+        { "sparse_hes",     "colpack.general" },
+        { "sparse_hes",     "colpack.symmetric" },
+# endif
+    };
+    size_t n_method = sizeof(method_list) / sizeof(method_list[0]);
+    //
+    cout << std::left;
+    cout << setw(10) << "pattern" << setw(36) << "method";
+    cout << std::right;
+    cout << setw(8)  << "n_color";
+    cout << setw(12) << "color_sec";
+    cout << setw(12) << "total_sec";
+    cout << setw(12) << "eval_sec";
+    cout << setw(5)  << "ok" << "\n";
+    //
+    for(size_t i_pattern = 0; i_pattern < n_pattern; ++i_pattern)
+    {   std::string name = pattern_list[i_pattern];
+        size_t n = size;
+        sparsity_pattern pattern;
+        create_pattern(name, n, pattern);
+        //
+        CppAD::ADFun<double> f_jac, g_hes;
+        create_fun(pattern, f_jac, g_hes);
+        //
+        for(size_t i_method = 0; i_method < n_method; ++i_method)
+        {   sparse_calc calc;
+            calc.routine  = method_list[i_method][0];
+            calc.coloring = method_list[i_method][1];
+            calc.pattern  = &pattern;
+            if( calc.routine == "sparse_hes" )
+                calc.fun = &g_hes;
+            else
+                calc.fun = &f_jac;
+            calc.x.resize(n);
+            for(size_t j = 0; j < n; ++j)
+                calc.x[j] = double(j + 1) / double(n);
+            calc.subset = sparse_matrix(pattern);
+            //
+            size_t n_color   = calc();
+            bool   calc_ok   = calc.check();
+            double total_sec = calc.seconds(true, time_min);
+            double eval_sec  = calc.seconds(false, time_min);
+            double color_sec = total_sec - eval_sec;
+            if( color_sec < 0.0 )
+                color_sec = 0.0;
+            ok &= calc_ok;
+            //
+            std::string method = calc.routine + "(" + calc.coloring + ")";
+            cout << std::left;
+            cout << setw(10) << name << setw(36) << method;
+            cout << std::right << std::setprecision(3) << std::scientific;
+            cout << setw(8)  << n_color;
+            cout << setw(12) << color_sec;
+            cout << setw(12) << total_sec;
+            cout << setw(12) << eval_sec;
+            cout << setw(5)  << (calc_ok ? "yes" : "no") << "\n";
+        }
+    }
+    if( ok )
+        return 0;
+    return 1;
+}
+// END C++
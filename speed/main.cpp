@@ -24,6 +24,7 @@ in the Eclipse Public License, Version 2.0 are satisfied:
 # include <cppad/utility/poly.hpp>
 # include <cppad/utility/track_new_del.hpp>
 # include <cppad/utility/thread_alloc.hpp>
+# include <cppad/core/optimize_report.hpp>
 
 # ifdef CPPAD_ADOLC_SPEED
 # define AD_PACKAGE "adolc"
@@ -80,6 +81,7 @@ $spell
     lu
     Jacobian
     cppadcg
+    bidirectional
 $$
 
 
@@ -214,6 +216,13 @@ If it is false, this optimization will not be done.
 Note that this option is usually slower unless it is combined with the
 $code onetape$$ option.
 
+$subhead report$$
+If this option and the $code optimize$$ option are present,
+the $cref optimize_report$$ for the last optimization done by
+each correctness test, and for each size of each speed test,
+is printed after the corresponding results.
+So far, only the CppAD speed tests implement this option.
+
 $subhead atomic$$
 If this option is present,
 CppAD will use a user defined
@@ -280,6 +289,37 @@ The CppAD
 $cref/sparse_hessian/link_sparse_hessian/$$ test
 is implemented for this option.
 
+$subhead star$$
+If this option is present, CppAD will use the
+$cref/cppad.star/sparse_hes/coloring/cppad.star/$$
+coloring method to compute Hessians.
+The CppAD
+$cref/sparse_hessian/link_sparse_hessian/$$ test
+is implemented for this option
+(when $code colpack$$, $code symmetric$$, and $code hes2jac$$
+are not present).
+
+$subhead acyclic$$
+If this option is present, CppAD will use the
+$cref/cppad.acyclic/sparse_hes/coloring/cppad.acyclic/$$
+coloring method to compute Hessians.
+The CppAD
+$cref/sparse_hessian/link_sparse_hessian/$$ test
+is implemented for this option
+(when $code colpack$$, $code symmetric$$, $code star$$, and $code hes2jac$$
+are not present).
+
+$subhead bidirectional$$
+If this option is present, CppAD will use the
+$cref/cppad.bidirectional/sparse_jac/coloring/cppad.bidirectional/$$
+coloring method to compute Jacobians.
+The CppAD
+$cref/sparse_jacobian/link_sparse_jacobian/$$ test
+is implemented for this option
+(when $code colpack$$ is not present).
+The program $cref speed_coloring.cpp$$ compares all the coloring methods
+on sparsity patterns with different structure.
+
 $head Correctness Results$$
 One, but not both, of the following two output lines
 $codei%
@@ -375,6 +415,10 @@ std::map<std::string, bool> global_option;
 // current thread at end of the test.
 size_t global_cppad_thread_alloc_inuse = 0;
 //
+// Report for the previous optimization done by a CppAD speed test
+// (not valid if the test did not optimize).
+CppAD::optimize_report global_cppad_optimize_report;
+//
 // This is the value of seed in the main program comamnd line.
 // It can be used by the sparse matrix routines to reset the random generator
 // so same sparsity pattern is obtained during source generation and usage.
@@ -389,6 +433,7 @@ namespace {
         "memory",
         "onetape",
         "optimize",
+        "report",
         "atomic",
         "hes2jac",
         "subgraph",
@@ -396,7 +441,10 @@ namespace {
         "revsparsity",
         "subsparsity",
         "colpack",
-        "symmetric"
+        "symmetric",
+        "star",
+        "acyclic",
+        "bidirectional"
     };
     size_t num_option = sizeof(option_list) / sizeof( option_list[0] );
     // ----------------------------------------------------------------
@@ -430,6 +478,26 @@ namespace {
         }
         cout << " ]";
     }
+    // ------------------------------------------------------
+    // output an optimize report and then clear it
+    void output_report(const std::string& case_name, size_t size)
+    {   if( global_option["report"] && global_cppad_optimize_report.valid )
+        {   // run_speed sets a fixed floating point format
+            std::ios_base::fmtflags flags     = cout.flags();
+            std::streamsize         precision = cout.precision();
+            cout.unsetf( std::ios_base::floatfield );
+            cout.precision(6);
+            //
+            cout << case_name;
+            if( size > 0 )
+                cout << "_size_" << size;
+            cout << "_" << global_cppad_optimize_report;
+            //
+            cout.flags(flags);
+            cout.precision(precision);
+        }
+        global_cppad_optimize_report.clear();
+    }
 
     // ----------------------------------------------------------------
     // function that runs one correctness case
@@ -441,6 +509,7 @@ namespace {
         const char *case_name     )
     {   bool available = available_case();
         bool ok        = true;
+        global_cppad_optimize_report.clear();
         if( available )
         {
 # ifdef CPPAD_DOUBLE_SPEED
@@ -469,6 +538,7 @@ namespace {
         {   cout << " false" << endl;
             Run_error_count++;
         }
+        output_report(case_name, 0);
         return ok;
     }
     // ----------------------------------------------------------------
@@ -483,6 +553,7 @@ namespace {
         cout << endl;
         cout << AD_PACKAGE << "_" << case_name << "_rate = ";
         cout << std::fixed;
+        CppAD::vector<CppAD::optimize_report> report( size_vec.size() );
         for(size_t i = 0; i < size_vec.size(); i++)
         {   if( i == 0 )
                 cout << "[ ";
@@ -490,7 +561,9 @@ namespace {
                 cout << ", ";
             cout << std::flush;
             size_t size = size_vec[i];
+            global_cppad_optimize_report.clear();
             double time = time_case(time_min, size);
+            report[i]   = global_cppad_optimize_report;
             double rate = 1. / time;
             if( rate >= 1000 )
                 cout << std::setprecision(0) << rate;
@@ -501,6 +574,10 @@ namespace {
         }
         cout << " ]" << endl;
         //
+        for(size_t i = 0; i < size_vec.size(); i++)
+        {   global_cppad_optimize_report = report[i];
+            output_report(case_name, size_vec[i]);
+        }
         return;
     }
 }
@@ -0,0 +1,123 @@
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-22 Bradley M. Bell
+
+CppAD is distributed under the terms of the
+             Eclipse Public License Version 2.0.
+
+This Source Code may also be made available under the following
+Secondary License when the conditions for such availability set forth
+in the Eclipse Public License, Version 2.0 are satisfied:
+      GNU General Public License, Version 2.0 or later.
+---------------------------------------------------------------------------- */
+/*
+Test the thread_alloc telemetry.
+*/
+# include <thread>
+# include <vector>
+# include <cppad/utility/thread_alloc.hpp>
+
+namespace {
+    using CppAD::thread_alloc;
+    typedef thread_alloc::telemetry_t telemetry_t;
+
+    // parallel mode and thread number for each operating system thread
+    bool                 parallel_mode = false;
+    thread_local size_t  thread_number = 0;
+    bool in_parallel(void)
+    {   return parallel_mode; }
+    size_t thread_num(void)
+    {   return thread_number; }
+
+    // get memory using thread one
+    void get_job(size_t min_bytes, void** v_ptr)
+    {   thread_number = 1;
+        size_t cap_bytes;
+        *v_ptr = thread_alloc::get_memory(min_bytes, cap_bytes);
+    }
+
+    // reported telemetry for each thread
+    std::vector<telemetry_t> reported[2];
+    size_t                   num_report = 0;
+    void report(size_t thread, const std::vector<telemetry_t>& snapshot)
+    {   ++num_report;
+        if( thread < 2 )
+            reported[thread] = snapshot;
+    }
+}
+
+bool alloc_telemetry(void)
+{   bool ok = true;
+    //
+    // reset the counters (other tests may have memory in use)
+    thread_alloc::free_all();
+    thread_alloc::telemetry_enable(true);
+    thread_alloc::hold_memory(true);
+    //
+    // first request for this capacity
+    size_t min_bytes = 100;
+    size_t cap_bytes;
+    void*  v_ptr_1 = thread_alloc::get_memory(min_bytes, cap_bytes);
+    std::vector<telemetry_t> snapshot = thread_alloc::telemetry_snapshot(0);
+    ok &= snapshot.size() == 1;
+    ok &= snapshot[0].capacity    == cap_bytes;
+    ok &= snapshot[0].num_get     == 1;
+    ok &= snapshot[0].num_hit     == 0;
+    ok &= snapshot[0].num_return  == 0;
+    ok &= snapshot[0].inuse_bytes == cap_bytes;
+    ok &= snapshot[0].peak_bytes  == cap_bytes;
+    ok &= snapshot[0].waste_bytes == cap_bytes - min_bytes;
+    //
+    // second request uses the available memory
+    thread_alloc::return_memory(v_ptr_1);
+    v_ptr_1 = thread_alloc::get_memory(min_bytes, cap_bytes);
+    void* v_ptr_2 = thread_alloc::get_memory(min_bytes, cap_bytes);
+    thread_alloc::return_memory(v_ptr_1);
+    thread_alloc::return_memory(v_ptr_2);
+    snapshot = thread_alloc::telemetry_snapshot(0);
+    ok &= snapshot.size() == 1;
+    ok &= snapshot[0].num_get     == 3;
+    ok &= snapshot[0].num_hit     == 1;
+    ok &= snapshot[0].num_return  == 3;
+    ok &= snapshot[0].num_remote  == 0;
+    ok &= snapshot[0].inuse_bytes == 0;
+    ok &= snapshot[0].peak_bytes  == 2 * cap_bytes;
+    ok &= snapshot[0].waste_bytes == 3 * (cap_bytes - min_bytes);
+    //
+    // memory for thread one that is returned by thread zero
+    size_t num_threads = 2;
+    thread_alloc::parallel_setup(num_threads, in_parallel, thread_num);
+    parallel_mode = true;
+    std::thread first(get_job, 10 * min_bytes, &v_ptr_1);
+    first.join();
+    thread_alloc::return_memory(v_ptr_1);
+    std::thread second(get_job, 10 * min_bytes, &v_ptr_2);
+    second.join();
+    parallel_mode = false;
+    snapshot = thread_alloc::telemetry_snapshot(1);
+    ok &= snapshot.size() == 1;
+    ok &= snapshot[0].num_get     == 2;
+    ok &= snapshot[0].num_hit     == 1;
+    ok &= snapshot[0].num_return  == 1;
+    ok &= snapshot[0].num_remote  == 1;
+    thread_alloc::return_memory(v_ptr_2);
+    //
+    // free_all reports and resets the counters
+    // (parallel_setup may have used memory for thread zero)
+    snapshot = thread_alloc::telemetry_snapshot(0);
+    thread_alloc::telemetry_report(report);
+    thread_alloc::free_all();
+    ok &= num_report == 2;
+    ok &= reported[0].size() == snapshot.size();
+    ok &= reported[0][0].num_get == snapshot[0].num_get;
+    ok &= reported[1].size() == 1 && reported[1][0].num_return == 2;
+    ok &= thread_alloc::telemetry_snapshot(0).size() == 0;
+    ok &= thread_alloc::telemetry_snapshot(1).size() == 0;
+    //
+    // restore the defaults
+    thread_alloc::parallel_setup(1, nullptr, nullptr);
+    thread_alloc::telemetry_report(nullptr);
+    thread_alloc::telemetry_enable(false);
+    thread_alloc::hold_memory(false);
+    //
+    return ok;
+}
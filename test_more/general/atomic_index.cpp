@@ -0,0 +1,110 @@
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-22 Bradley M. Bell
+
+CppAD is distributed under the terms of the
+             Eclipse Public License Version 2.0.
+
+This Source Code may also be made available under the following
+Secondary License when the conditions for such availability set forth
+in the Eclipse Public License, Version 2.0 are satisfied:
+      GNU General Public License, Version 2.0 or later.
+---------------------------------------------------------------------------- */
+/*
+Test creating, using, and destroying atomic functions in parallel mode.
+*/
+# include <cppad/cppad.hpp>
+
+namespace {
+    using CppAD::AD;
+    typedef CPPAD_TESTVECTOR(double)       d_vector;
+    typedef CPPAD_TESTVECTOR( AD<double> ) a_vector;
+    //
+    // y = factor * x
+    class atomic_scale : public CppAD::atomic_four<double> {
+    private:
+        const double factor_;
+    public:
+        atomic_scale(const std::string& name, double factor)
+        : CppAD::atomic_four<double>(name), factor_(factor)
+        { }
+    private:
+        bool for_type(
+            size_t                                     call_id     ,
+            const CppAD::vector<CppAD::ad_type_enum>&  type_x      ,
+            CppAD::vector<CppAD::ad_type_enum>&        type_y      ) override
+        {   type_y[0] = type_x[0];
+            return true;
+        }
+        bool forward(
+            size_t                              call_id      ,
+            const CppAD::vector<bool>&          select_y     ,
+            size_t                              order_low    ,
+            size_t                              order_up     ,
+            const CppAD::vector<double>&        taylor_x     ,
+            CppAD::vector<double>&              taylor_y     ) override
+        {   for(size_t k = order_low; k <= order_up; ++k)
+                taylor_y[k] = factor_ * taylor_x[k];
+            return true;
+        }
+    };
+    //
+    // each task creates its own atomic function and uses it
+    class scale_job {
+    private:
+        std::vector<double>& result_;
+    public:
+        scale_job(std::vector<double>& result)
+        : result_(result)
+        { }
+        void operator()(size_t task, size_t thread)
+        {   double factor = double(task + 1);
+            atomic_scale afun("atomic_scale", factor);
+            //
+            a_vector ax(1), au(1), ay(1);
+            ax[0] = 1.0;
+            CppAD::Independent(ax);
+            afun(ax, au);
+            ay[0] = au[0] + ax[0];
+            CppAD::ADFun<double> f(ax, ay);
+            //
+            d_vector x(1), dx(1);
+            x[0]  = double(thread + 2);
+            dx[0] = 1.0;
+            double y  = f.Forward(0, x)[0];
+            double dy = f.Forward(1, dx)[0];
+            result_[task] = 0.0;
+            if( y == (factor + 1.0) * x[0] && dy == factor + 1.0 )
+                result_[task] = factor;
+        }
+    };
+}
+
+bool atomic_index(void)
+{   bool ok = true;
+    //
+    size_t n_task = 60;
+    std::vector<double> result(n_task);
+    {   // pool of threads
+        size_t num_threads = 4;
+        CppAD::thread_pool pool(num_threads);
+        CppAD::parallel_ad<double>();
+        //
+        scale_job job(result);
+        pool.run(n_task, job);
+    }
+    for(size_t task = 0; task < n_task; ++task)
+        ok &= result[task] == double(task + 1);
+    //
+    // an atomic function created in sequential mode after the others
+    atomic_scale afun("atomic_scale", 3.0);
+    a_vector ax(1), ay(1);
+    ax[0] = 1.0;
+    CppAD::Independent(ax);
+    afun(ax, ay);
+    CppAD::ADFun<double> f(ax, ay);
+    d_vector x(1);
+    x[0] = 2.0;
+    ok &= f.Forward(0, x)[0] == 6.0;
+    //
+    return ok;
+}
@@ -0,0 +1,179 @@
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-22 Bradley M. Bell
+
+CppAD is distributed under the terms of the
+             Eclipse Public License Version 2.0.
+
+This Source Code may also be made available under the following
+Secondary License when the conditions for such availability set forth
+in the Eclipse Public License, Version 2.0 are satisfied:
+      GNU General Public License, Version 2.0 or later.
+---------------------------------------------------------------------------- */
+/*
+Test the const forward and reverse routines by having many threads use the
+same function object at the same time, and comparing with the results of
+f.Forward and f.Reverse.
+*/
+# include <cppad/cppad.hpp>
+
+namespace {
+    using CppAD::AD;
+    using CppAD::NearEqual;
+    //
+    typedef CPPAD_TESTVECTOR(double)       d_vector;
+    typedef CPPAD_TESTVECTOR( AD<double> ) a_vector;
+    //
+    double eps99 = 99.0 * std::numeric_limits<double>::epsilon();
+    //
+    bool check_vector(const d_vector& check, const d_vector& value)
+    {   bool ok = size_t( check.size() ) == size_t( value.size() );
+        for(size_t i = 0; i < size_t( check.size() ); ++i)
+            ok &= NearEqual(check[i], value[i], eps99, eps99);
+        return ok;
+    }
+    //
+    // function with a conditional expression (conditional skipping),
+    // a VecAD object (load operations), and a comparison
+    void record(size_t n, CppAD::ADFun<double>& f)
+    {   a_vector ax(n), ay(3);
+        for(size_t j = 0; j < n; ++j)
+            ax[j] = double(j + 1);
+        CppAD::Independent(ax);
+        //
+        CppAD::VecAD<double> av(n);
+        for(size_t j = 0; j < n; ++j)
+        {   AD<double> index = double(j);
+            av[index] = ax[j] * ax[j];
+        }
+        AD<double> asum = 0.0;
+        for(size_t j = 0; j < n; ++j)
+        {   AD<double> index = double(n - j - 1);
+            asum += av[index] * ax[j];
+        }
+        AD<double> azero = 0.0;
+        ay[0] = asum;
+        ay[1] = CppAD::CondExpGt(ax[0], azero, sin(ax[1]), cos(ax[1]));
+        if( ax[0] * ax[0] < ax[1] )
+            ay[2] = ax[0] * ax[1];
+        else
+            ay[2] = ax[0] + ax[1];
+        f.Dependent(ax, ay);
+    }
+    //
+    // argument for a task
+    d_vector task_x(size_t task, size_t n)
+    {   d_vector x(n);
+        for(size_t j = 0; j < n; ++j)
+            x[j] = double(task) - 10.0 + double(j) / double(n);
+        return x;
+    }
+    //
+    // evaluate function values, first order forward, and second order
+    // reverse for each task using a separate workspace for each thread
+    class eval_job {
+    private:
+        const CppAD::ADFun<double>&            f_;
+        std::vector< CppAD::fun_work<double> >& work_;
+        std::vector<d_vector>&                 y_;
+        std::vector<d_vector>&                 dy_;
+        std::vector<d_vector>&                 dw_;
+        std::vector<size_t>&                   number_;
+    public:
+        eval_job(
+            const CppAD::ADFun<double>&             f      ,
+            std::vector< CppAD::fun_work<double> >& work   ,
+            std::vector<d_vector>&                  y      ,
+            std::vector<d_vector>&                  dy     ,
+            std::vector<d_vector>&                  dw     ,
+            std::vector<size_t>&                    number )
+        : f_(f), work_(work), y_(y), dy_(dy), dw_(dw), number_(number)
+        { }
+        void operator()(size_t task, size_t thread)
+        {   size_t n = f_.Domain();
+            size_t m = f_.Range();
+            CppAD::fun_work<double>& work( work_[thread] );
+            //
+            d_vector x = task_x(task, n);
+            y_[task]   = f_.forward(work, 0, x);
+            number_[task] = work.compare_change_number();
+            //
+            d_vector dx(n);
+            for(size_t j = 0; j < n; ++j)
+                dx[j] = 1.0;
+            dy_[task] = f_.forward(work, 1, dx);
+            //
+            d_vector w(m);
+            for(size_t i = 0; i < m; ++i)
+                w[i] = double(i + 1);
+            dw_[task] = f_.reverse(work, 2, w);
+        }
+    };
+    //
+    bool check_eval(CppAD::ADFun<double>& f, size_t num_threads)
+    {   bool ok = true;
+        size_t n = f.Domain();
+        size_t m = f.Range();
+        //
+        // results for each task
+        size_t n_task = 50;
+        std::vector<d_vector> y(n_task), dy(n_task), dw(n_task);
+        std::vector<size_t>   number(n_task);
+        {   // pool of threads
+            CppAD::thread_pool pool(num_threads);
+            CppAD::parallel_ad<double>();
+            //
+            std::vector< CppAD::fun_work<double> > work(num_threads);
+            eval_job job(f, work, y, dy, dw, number);
+            pool.run(n_task, job);
+            //
+            // free memory held by the workspaces (in sequential mode)
+            for(size_t thread = 0; thread < num_threads; ++thread)
+                work[thread].clear();
+        }
+        //
+        // check the results
+        d_vector dx(n), w(m);
+        for(size_t j = 0; j < n; ++j)
+            dx[j] = 1.0;
+        for(size_t i = 0; i < m; ++i)
+            w[i] = double(i + 1);
+        for(size_t task = 0; task < n_task; ++task)
+        {   d_vector x = task_x(task, n);
+            ok &= check_vector( f.Forward(0, x), y[task] );
+            ok &= f.compare_change_number() == number[task];
+            ok &= check_vector( f.Forward(1, dx), dy[task] );
+            ok &= check_vector( f.Reverse(2, w), dw[task] );
+        }
+        return ok;
+    }
+}
+
+bool fun_work(void)
+{   bool ok = true;
+    //
+    size_t n = 5;
+    CppAD::ADFun<double> f;
+    record(n, f);
+    //
+    // the comparison changes for some of the tasks
+    f.compare_change_count(1);
+    ok &= check_eval(f, 4);
+    //
+    // optimized version of the function
+    f.optimize();
+    ok &= check_eval(f, 4);
+    //
+    // a workspace used with one function and then a different function
+    CppAD::ADFun<double> g;
+    record(n + 1, g);
+    CppAD::fun_work<double> work;
+    d_vector x = task_x(3, n);
+    f.forward(work, 0, x);
+    ok &= work.size_order() == 1;
+    x = task_x(3, n + 1);
+    ok &= check_vector( g.Forward(0, x), g.forward(work, 0, x) );
+    ok &= work.size_order() == 1;
+    //
+    ok &= CppAD::thread_alloc::num_threads() == 1;
+    return ok;
+}
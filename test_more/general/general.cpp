@@ -30,6 +30,7 @@ extern bool AddEq(void);
 extern bool Add(void);
 extern bool AddZero(void);
 extern bool adfun(void);
+extern bool alloc_telemetry(void);
 extern bool alloc_openmp(void);
 extern bool asinh(void);
 extern bool asin(void);
@@ -37,6 +38,7 @@ extern bool assign(void);
 extern bool atan2(void);
 extern bool atanh(void);
 extern bool atan(void);
+extern bool atomic_index(void);
 extern bool atomic_three(void);
 extern bool azmul(void);
 extern bool base_adolc(void);
@@ -73,14 +75,18 @@ extern bool forward_order(void);
 extern bool Forward(void);
 extern bool FromBase(void);
 extern bool FunCheck(void);
+extern bool fun_work(void);
 extern bool cpp_graph(void);
 extern bool hes_sparsity(void);
+extern bool huge_pages(void);
 extern bool ipopt_solve(void);
 extern bool jacobian(void);
 extern bool json_graph(void);
+extern bool lazy_tape(void);
 extern bool log10(void);
 extern bool log1p(void);
 extern bool log(void);
+extern bool max_num_threads(void);
 extern bool mul_cond_rev(void);
 extern bool mul_cskip(void);
 extern bool MulEq(void);
@@ -91,6 +97,7 @@ extern bool MulZeroOne(void);
 extern bool NearEqualExt(void);
 extern bool Neg(void);
 extern bool new_dynamic(void);
+extern bool numa_bind(void);
 extern bool num_limits(void);
 extern bool ode_err_control(void);
 extern bool optimize(void);
@@ -99,6 +106,7 @@ extern bool Poly(void);
 extern bool PowInt(void);
 extern bool Pow(void);
 extern bool print_for(void);
+extern bool remote_free(void);
 extern bool reverse(void);
 extern bool rev_sparse_jac(void);
 extern bool RevTwo(void);
@@ -124,6 +132,7 @@ extern bool Sub(void);
 extern bool SubZero(void);
 extern bool tan(void);
 extern bool test_vector(void);
+extern bool thread_pool(void);
 extern bool to_string(void);
 extern bool Value(void);
 extern bool VecADPar(void);
@@ -153,12 +162,14 @@ int main(void)
     Run( AddEq,           "AddEq"          );
     Run( AddZero,         "AddZero"        );
     Run( adfun,           "adfun"          );
+    Run( alloc_telemetry, "alloc_telemetry");
     Run( asin,            "asin"           );
     Run( asinh,           "asinh"          );
     Run( assign,          "assign"         );
     Run( atan2,           "atan2"          );
     Run( atan,            "atan"           );
     Run( atanh,           "atanh"          );
+    Run( atomic_index,    "atomic_index"   );
     Run( atomic_three,    "atomic_three"   );
     Run( azmul,           "azmul"          );
     Run( bool_sparsity,   "bool_sparsity"  );
@@ -191,13 +202,17 @@ int main(void)
     Run( forward_order,   "forward_order"  );
     Run( FromBase,        "FromBase"       );
     Run( FunCheck,        "FunCheck"       );
+    Run( fun_work,        "fun_work"       );
     Run( cpp_graph,       "cpp_graph"      );
     Run( hes_sparsity,    "hes_sparsity"   );
+    Run( huge_pages,      "huge_pages"     );
     Run( jacobian,        "jacobian"       );
     Run( json_graph,      "json_graph"     );
+    Run( lazy_tape,       "lazy_tape"      );
     Run( log10,           "log10"          );
     Run( log1p,           "log1p"          );
     Run( log,             "log"            );
+    Run( max_num_threads, "max_num_threads");
     Run( mul_cond_rev,    "mul_cond_rev"   );
     Run( mul_cskip,       "Mul_cskip"      );
     Run( MulEq,           "MulEq"          );
@@ -208,6 +223,7 @@ int main(void)
     Run( NearEqualExt,    "NearEqualExt"   );
     Run( Neg,             "Neg"            );
     Run( new_dynamic,     "new_dynamic"    );
+    Run( numa_bind,       "numa_bind"      );
     Run( num_limits,      "num_limits"     );
     Run( ode_err_control, "ode_err_control");
     Run( optimize,        "optimize"       );
@@ -216,6 +232,7 @@ int main(void)
     Run( PowInt,          "PowInt"         );
     Run( Pow,             "Pow"            );
     Run( print_for,       "print_for"      );
+    Run( remote_free,     "remote_free"    );
     Run( reverse,         "reverse"        );
     Run( rev_sparse_jac,  "rev_sparse_jac" );
     Run( RevTwo,          "RevTwo"         );
@@ -240,6 +257,7 @@ int main(void)
     Run( Sub,             "Sub"            );
     Run( SubZero,         "SubZero"        );
     Run( tan,             "tan"            );
+    Run( thread_pool,     "thread_pool"    );
     Run( to_string,       "to_string"      );
     Run( Value,           "Value"          );
     Run( VecADPar,        "VecADPar"       );
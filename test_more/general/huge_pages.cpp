@@ -0,0 +1,105 @@
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-22 Bradley M. Bell
+
+CppAD is distributed under the terms of the
+             Eclipse Public License Version 2.0.
+
+This Source Code may also be made available under the following
+Secondary License when the conditions for such availability set forth
+in the Eclipse Public License, Version 2.0 are satisfied:
+      GNU General Public License, Version 2.0 or later.
+---------------------------------------------------------------------------- */
+/*
+Test thread_alloc huge pages and capacity ladders.
+*/
+# include <limits>
+# include <cppad/utility/thread_alloc.hpp>
+
+namespace {
+    using CppAD::thread_alloc;
+
+    // write to and then check the first, middle, and last bytes in a block
+    bool check_block(void* v_ptr, size_t cap_bytes)
+    {   unsigned char* ptr = reinterpret_cast<unsigned char*>(v_ptr);
+        size_t index[] = { 0, cap_bytes / 2, cap_bytes - 1 };
+        for(size_t i = 0; i < 3; ++i)
+            ptr[ index[i] ] = static_cast<unsigned char>(i + 1);
+        bool ok = true;
+        for(size_t i = 0; i < 3; ++i)
+            ok &= ptr[ index[i] ] == static_cast<unsigned char>(i + 1);
+        return ok;
+    }
+
+    // check the capacities for a ladder
+    bool check_ladder(size_t large_bytes, size_t percent)
+    {   bool ok = true;
+        ok &= thread_alloc::capacity_ladder(large_bytes, percent);
+        //
+        size_t min_bytes = 1000;
+        while( min_bytes < 100000000 )
+        {   size_t cap_bytes;
+            void* v_ptr = thread_alloc::get_memory(min_bytes, cap_bytes);
+            ok &= min_bytes <= cap_bytes;
+            //
+            // maximum waste for large requests
+            if( large_bytes <= min_bytes )
+                ok &= cap_bytes <= min_bytes + (min_bytes / 100) * percent;
+            //
+            ok &= check_block(v_ptr, cap_bytes);
+            thread_alloc::return_memory(v_ptr);
+            min_bytes = 2 * min_bytes + 1;
+        }
+        return ok;
+    }
+}
+
+bool huge_pages(void)
+{   bool ok = true;
+    size_t inuse = thread_alloc::inuse(0);
+    //
+    // the capacities cannot change while memory is in use
+    size_t cap_bytes;
+    void* v_ptr = thread_alloc::get_memory(1000, cap_bytes);
+    ok &= ! thread_alloc::capacity_ladder(1000000, 10);
+    thread_alloc::return_memory(v_ptr);
+    ok &= thread_alloc::inuse(0) == inuse;
+    //
+    // finer ladders (no memory can be in use)
+    ok &= check_ladder(1000000, 10);
+    ok &= check_ladder(0, 10);
+    ok &= check_ladder(0, 50);
+    //
+    // huge pages for blocks with at least 4 megabytes
+    ok &= thread_alloc::capacity_ladder(1000000, 10);
+    thread_alloc::huge_pages(4000000);
+    for(size_t i_hold = 0; i_hold < 2; ++i_hold)
+    {   bool hold_memory = i_hold == 1;
+        thread_alloc::hold_memory(hold_memory);
+        //
+        void* v_small = thread_alloc::get_memory(1000000, cap_bytes);
+        ok &= check_block(v_small, cap_bytes);
+        void* v_large = thread_alloc::get_memory(5000000, cap_bytes);
+        ok &= check_block(v_large, cap_bytes);
+        thread_alloc::return_memory(v_small);
+        thread_alloc::return_memory(v_large);
+        //
+        // held memory is reused
+        if( hold_memory )
+        {   v_ptr = thread_alloc::get_memory(5000000, cap_bytes);
+            ok &= v_ptr == v_large;
+            ok &= check_block(v_ptr, cap_bytes);
+            thread_alloc::return_memory(v_ptr);
+        }
+    }
+    //
+    // restore the defaults
+    thread_alloc::hold_memory(false);
+    thread_alloc::huge_pages(0);
+    ok &= thread_alloc::capacity_ladder(
+        std::numeric_limits<size_t>::max(), 50
+    );
+    ok &= thread_alloc::inuse(0) == 0;
+    ok &= thread_alloc::available(0) == 0;
+    //
+    return ok;
+}
@@ -0,0 +1,106 @@
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-22 Bradley M. Bell
+
+CppAD is distributed under the terms of the
+             Eclipse Public License Version 2.0.
+
+This Source Code may also be made available under the following
+Secondary License when the conditions for such availability set forth
+in the Eclipse Public License, Version 2.0 are satisfied:
+      GNU General Public License, Version 2.0 or later.
+---------------------------------------------------------------------------- */
+/*
+Test recording and evaluating AD<float> functions in parallel mode without
+calling parallel_ad<float>; i.e., the tape identifiers and tape handles for
+each thread are initialized the first time the thread uses them.
+The second pool has more threads than the first and so the tape identifiers
+must be rebased in parallel mode.
+*/
+# include <cppad/cppad.hpp>
+
+namespace {
+    using CppAD::AD;
+    typedef CPPAD_TESTVECTOR(float)       f_vector;
+    typedef CPPAD_TESTVECTOR( AD<float> ) a_vector;
+    //
+    // each task records y = factor * x_0 * x_1 and computes its Jacobian
+    // (ok_ is not a vector<bool> because its elements may share memory)
+    class record_job {
+    private:
+        std::vector<size_t>& ok_;
+    public:
+        record_job(std::vector<size_t>& ok)
+        : ok_(ok)
+        { }
+        void operator()(size_t task, size_t thread)
+        {   float factor = float(task + 1);
+            //
+            a_vector ax(2), ay(1);
+            ax[0] = 1.0f;
+            ax[1] = 1.0f;
+            CppAD::Independent(ax);
+            ay[0] = factor * ax[0] * ax[1];
+            CppAD::ADFun<float> f(ax, ay);
+            //
+            f_vector x(2);
+            x[0] = float(thread + 1);
+            x[1] = 2.0f;
+            f_vector y   = f.Forward(0, x);
+            f_vector jac = f.Jacobian(x);
+            //
+            bool ok = y[0] == factor * x[0] * x[1];
+            ok     &= jac[0] == factor * x[1];
+            ok     &= jac[1] == factor * x[0];
+            //
+            // a variable from the function above is a parameter for this tape
+            ax[1] = ay[0];
+            CppAD::Independent(ax);
+            ok &= CppAD::Parameter(ay[0]);
+            ay[0] = ax[0] + ax[1];
+            f.Dependent(ax, ay);
+            ok &= f.Forward(0, x)[0] == x[0] + x[1];
+            //
+            ok_[task] = size_t(ok);
+        }
+    };
+    //
+    bool run_pool(size_t num_threads, size_t n_task)
+    {   bool ok = true;
+        std::vector<size_t> task_ok(n_task, 0);
+        {   // pool of threads (note that parallel_ad<float> is not called)
+            CppAD::thread_pool pool(num_threads);
+            record_job job(task_ok);
+            pool.run(n_task, job);
+        }
+        for(size_t task = 0; task < n_task; ++task)
+            ok &= task_ok[task] == 1;
+        return ok;
+    }
+}
+
+bool lazy_tape(void)
+{   bool ok = true;
+    //
+    // a function recorded in sequential mode
+    a_vector ax(1), ay(1);
+    ax[0] = 1.0f;
+    CppAD::Independent(ax);
+    ay[0] = 2.0f * ax[0];
+    CppAD::ADFun<float> f(ax, ay);
+    //
+    // first pool of threads
+    ok &= run_pool(2, 30);
+    //
+    // second pool with more threads; i.e., max_num_threads increases
+    ok &= run_pool(6, 60);
+    //
+    // the sequential function is not affected by the pools and
+    // its variables are now parameters
+    ok &= CppAD::Parameter(ay[0]);
+    f_vector x(1);
+    x[0] = 3.0f;
+    ok &= f.Forward(0, x)[0] == 6.0f;
+    //
+    ok &= CppAD::thread_alloc::num_threads() == 1;
+    return ok;
+}
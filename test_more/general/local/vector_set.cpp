@@ -234,6 +234,66 @@ bool test_post(void)
     return ok;
 }
 
+template<class SetVector>
+bool test_large(void)
+{   bool ok = true;
+    //
+    // end spans several packing units for pack_setvec
+    SetVector vec_set;
+    size_t n_set = 4;
+    size_t end   = 200;
+    vec_set.resize(n_set, end);
+    //
+    // set[0] = multiples of 3, set[1] = multiples of 5
+    for(size_t j = 0; j < end; j += 3)
+        vec_set.add_element(0, j);
+    for(size_t j = 0; j < end; j += 5)
+        vec_set.add_element(1, j);
+    ok &= vec_set.number_elements(0) == (end + 2) / 3;
+    ok &= vec_set.number_elements(1) == (end + 4) / 5;
+    //
+    // set[2] = union, set[3] = intersection
+    vec_set.binary_union(2, 0, 1, vec_set);
+    vec_set.binary_intersection(3, 0, 1, vec_set);
+    size_t n_union = 0, n_intersection = 0;
+    for(size_t j = 0; j < end; ++j)
+    {   bool in_union        = (j % 3 == 0) || (j % 5 == 0);
+        bool in_intersection = (j % 15 == 0);
+        ok &= vec_set.is_element(2, j) == in_union;
+        ok &= vec_set.is_element(3, j) == in_intersection;
+        if( in_union )
+            ++n_union;
+        if( in_intersection )
+            ++n_intersection;
+    }
+    ok &= vec_set.number_elements(2) == n_union;
+    ok &= vec_set.number_elements(3) == n_intersection;
+    //
+    // iterate through the intersection
+    typename SetVector::const_iterator itr(vec_set, 3);
+    for(size_t j = 0; j < end; j += 15)
+    {   ok &= *itr == j;
+        ++itr;
+    }
+    ok &= *itr == end;
+    //
+    // union with the target equal to the left operand
+    vec_set.clear(3);
+    vec_set.add_element(3, end - 1);
+    vec_set.binary_union(3, 3, 0, vec_set);
+    ok &= vec_set.number_elements(3) == (end + 2) / 3 + 1;
+    ok &= vec_set.is_element(3, end - 1);
+    //
+    // assignment and an empty set
+    vec_set.assignment(2, 1, vec_set);
+    ok &= vec_set.number_elements(2) == (end + 4) / 5;
+    vec_set.clear(1);
+    typename SetVector::const_iterator itr_empty(vec_set, 1);
+    ok &= *itr_empty == end;
+    //
+    return ok;
+}
+
 } // END empty namespace
 
 bool vector_set(void)
@@ -242,14 +302,22 @@ bool vector_set(void)
     ok     &= test_no_other<CppAD::local::sparse::pack_setvec>();
     ok     &= test_no_other<CppAD::local::sparse::list_setvec>();
     ok     &= test_no_other<CppAD::local::sparse::svec_setvec>();
+    ok     &= test_no_other<CppAD::local::sparse::hybrid_setvec>();
     //
     ok     &= test_yes_other<CppAD::local::sparse::pack_setvec>();
     ok     &= test_yes_other<CppAD::local::sparse::list_setvec>();
     ok     &= test_yes_other<CppAD::local::sparse::svec_setvec>();
+    ok     &= test_yes_other<CppAD::local::sparse::hybrid_setvec>();
     //
     ok     &= test_intersection<CppAD::local::sparse::pack_setvec>();
     ok     &= test_intersection<CppAD::local::sparse::list_setvec>();
     ok     &= test_intersection<CppAD::local::sparse::svec_setvec>();
+    ok     &= test_intersection<CppAD::local::sparse::hybrid_setvec>();
+    //
+    ok     &= test_large<CppAD::local::sparse::pack_setvec>();
+    ok     &= test_large<CppAD::local::sparse::list_setvec>();
+    ok     &= test_large<CppAD::local::sparse::svec_setvec>();
+    ok     &= test_large<CppAD::local::sparse::hybrid_setvec>();
     //
     ok     &= test_post<CppAD::local::sparse::pack_setvec>();
     ok     &= test_post<CppAD::local::sparse::list_setvec>();
@@ -257,6 +325,7 @@ bool vector_set(void)
     // 2DO: this test generates an assert error when using MSC compiler
     // need to track this down even though svec_setvec not currently being used
     ok     &= test_post<CppAD::local::sparse::svec_setvec>();
+    ok     &= test_post<CppAD::local::sparse::hybrid_setvec>();
 # endif
     //
     return ok;
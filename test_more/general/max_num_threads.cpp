@@ -0,0 +1,102 @@
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-22 Bradley M. Bell
+
+CppAD is distributed under the terms of the
+             Eclipse Public License Version 2.0.
+
+This Source Code may also be made available under the following
+Secondary License when the conditions for such availability set forth
+in the Eclipse Public License, Version 2.0 are satisfied:
+      GNU General Public License, Version 2.0 or later.
+---------------------------------------------------------------------------- */
+/*
+Test using more than CPPAD_MAX_NUM_THREADS threads.
+The threads are simulated by changing the value returned by thread_num
+(in parallel mode) while executing in one operating system thread.
+*/
+# include <cppad/cppad.hpp>
+
+namespace {
+    using CppAD::thread_alloc;
+    using CppAD::AD;
+    typedef CPPAD_TESTVECTOR(double)       d_vector;
+    typedef CPPAD_TESTVECTOR( AD<double> ) ad_vector;
+
+    // simulated parallel mode and thread number
+    bool   simulate_parallel = false;
+    size_t simulate_thread   = 0;
+    bool in_parallel(void)
+    {   return simulate_parallel; }
+    size_t thread_num(void)
+    {   return simulate_thread; }
+
+    // derivative of g(x) = f(x) * x where f is a checkpoint for x * x
+    bool check_thread(CppAD::chkpoint_two<double>& f_check, size_t thread)
+    {   bool ok = true;
+        simulate_thread = thread;
+        //
+        ad_vector ax(1), ay(1), az(1);
+        ax[0] = 2.0;
+        CppAD::Independent(ax);
+        f_check(ax, ay);
+        az[0] = ay[0] * ax[0];
+        CppAD::ADFun<double> g(ax, az);
+        //
+        d_vector x(1), dz(1);
+        x[0]  = 3.0;
+        dz    = g.Jacobian(x);
+        ok   &= dz[0] == 3.0 * x[0] * x[0];
+        //
+        return ok;
+    }
+}
+
+bool max_num_threads(void)
+{   bool ok = true;
+    //
+    // a variable on a tape that is no longer recording
+    ad_vector ax(1), ay(1);
+    ax[0] = 1.0;
+    CppAD::Independent(ax);
+    ay[0] = ax[0] * ax[0];
+    CppAD::ADFun<double> f(ax, ay);
+    ok &= CppAD::Parameter( ay[0] );
+    //
+    // checkpoint function for f
+    bool internal_bool    = false;
+    bool use_hes_sparsity = false;
+    bool use_base2ad      = false;
+    bool use_in_parallel  = true;
+    CppAD::chkpoint_two<double> f_check(f, "f_check",
+        internal_bool, use_hes_sparsity, use_base2ad, use_in_parallel
+    );
+    //
+    // more threads than the initial maximum
+    size_t num_threads = thread_alloc::max_num_threads() + 20;
+    thread_alloc::parallel_setup(num_threads, in_parallel, thread_num);
+    ok &= thread_alloc::num_threads() == num_threads;
+    ok &= thread_alloc::max_num_threads() == num_threads;
+    CppAD::parallel_ad<double>();
+    //
+    // old variable is still a parameter for the new tape identifiers
+    ok &= CppAD::Parameter( ay[0] );
+    //
+    // use the first and last thread in parallel mode
+    simulate_parallel = true;
+    ok &= check_thread(f_check, num_threads - 1);
+    ok &= check_thread(f_check, 0);
+    ok &= check_thread(f_check, num_threads - 1);
+    simulate_parallel = false;
+    simulate_thread   = 0;
+    //
+    // return to sequential mode (maximum does not decrease)
+    thread_alloc::parallel_setup(1, nullptr, nullptr);
+    ok &= thread_alloc::num_threads() == 1;
+    ok &= thread_alloc::max_num_threads() == num_threads;
+    //
+    // recording after the change
+    ok &= check_thread(f_check, 0);
+    ok &= CppAD::Parameter( ay[0] );
+    //
+    return ok;
+}
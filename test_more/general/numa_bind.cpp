@@ -0,0 +1,104 @@
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-22 Bradley M. Bell
+
+CppAD is distributed under the terms of the
+             Eclipse Public License Version 2.0.
+
+This Source Code may also be made available under the following
+Secondary License when the conditions for such availability set forth
+in the Eclipse Public License, Version 2.0 are satisfied:
+      GNU General Public License, Version 2.0 or later.
+---------------------------------------------------------------------------- */
+/*
+Test thread_alloc memory when large blocks are bound to a NUMA node.
+*/
+# include <thread>
+# include <cppad/utility/thread_alloc.hpp>
+
+namespace {
+    using CppAD::thread_alloc;
+
+    // parallel mode and thread number for each operating system thread
+    bool                 parallel_mode = false;
+    thread_local size_t  thread_number = 0;
+    bool in_parallel(void)
+    {   return parallel_mode; }
+    size_t thread_num(void)
+    {   return thread_number; }
+
+    // write to and then check all the bytes in a block
+    bool check_block(void* v_ptr, size_t cap_bytes, unsigned char value)
+    {   unsigned char* ptr = reinterpret_cast<unsigned char*>(v_ptr);
+        for(size_t i = 0; i < cap_bytes; ++i)
+            ptr[i] = static_cast<unsigned char>(value + i);
+        bool ok = true;
+        for(size_t i = 0; i < cap_bytes; ++i)
+            ok &= ptr[i] == static_cast<unsigned char>(value + i);
+        return ok;
+    }
+
+    // large block obtained by thread one
+    void*  large_ptr = nullptr;
+    size_t large_cap = 0;
+    bool   large_ok  = false;
+    void large_job(void)
+    {   thread_number = 1;
+        large_ptr = thread_alloc::get_memory(200000, large_cap);
+        large_ok  = check_block(large_ptr, large_cap, 3);
+    }
+}
+
+bool numa_bind(void)
+{   bool ok = true;
+    thread_alloc::numa_bind(true);
+    //
+    size_t inuse     = thread_alloc::inuse(0);
+    size_t available = thread_alloc::available(0);
+    for(size_t i_hold = 0; i_hold < 2; ++i_hold)
+    {   bool hold_memory = i_hold == 1;
+        thread_alloc::hold_memory(hold_memory);
+        //
+        // a large block and a small block
+        size_t cap_large, cap_small;
+        void* v_large = thread_alloc::get_memory(100000, cap_large);
+        void* v_small = thread_alloc::get_memory(100, cap_small);
+        ok &= 100000 <= cap_large;
+        ok &= 100 <= cap_small;
+        ok &= thread_alloc::inuse(0) == inuse + cap_large + cap_small;
+        ok &= check_block(v_large, cap_large, 1);
+        ok &= check_block(v_small, cap_small, 2);
+        thread_alloc::return_memory(v_large);
+        thread_alloc::return_memory(v_small);
+        ok &= thread_alloc::inuse(0) == inuse;
+        //
+        // the held memory is reused
+        if( hold_memory )
+        {   ok &= thread_alloc::available(0) >=
+                available + cap_large + cap_small;
+            void* v_ptr = thread_alloc::get_memory(100000, cap_large);
+            ok &= v_ptr == v_large;
+            ok &= check_block(v_ptr, cap_large, 4);
+            thread_alloc::return_memory(v_ptr);
+        }
+    }
+    //
+    // a large block obtained by thread one and returned by thread zero
+    size_t num_threads = 2;
+    thread_alloc::parallel_setup(num_threads, in_parallel, thread_num);
+    parallel_mode = true;
+    std::thread worker(large_job);
+    worker.join();
+    ok &= large_ok;
+    thread_alloc::return_memory(large_ptr);
+    parallel_mode = false;
+    thread_alloc::free_available(1);
+    ok &= thread_alloc::inuse(1)     == 0;
+    ok &= thread_alloc::available(1) == 0;
+    thread_alloc::parallel_setup(1, nullptr, nullptr);
+    //
+    thread_alloc::hold_memory(false);
+    thread_alloc::numa_bind(false);
+    thread_alloc::free_available(0);
+    //
+    return ok;
+}
@@ -0,0 +1,165 @@
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-22 Bradley M. Bell
+
+CppAD is distributed under the terms of the
+             Eclipse Public License Version 2.0.
+
+This Source Code may also be made available under the following
+Secondary License when the conditions for such availability set forth
+in the Eclipse Public License, Version 2.0 are satisfied:
+      GNU General Public License, Version 2.0 or later.
+---------------------------------------------------------------------------- */
+/*
+Test returning thread_alloc memory from a thread that did not allocate it
+while in parallel mode.
+*/
+# include <thread>
+# include <vector>
+# include <cppad/utility/thread_alloc.hpp>
+
+namespace {
+    using CppAD::thread_alloc;
+
+    // parallel mode and thread number for each operating system thread
+    bool                 parallel_mode = false;
+    thread_local size_t  thread_number = 0;
+    bool in_parallel(void)
+    {   return parallel_mode; }
+    size_t thread_num(void)
+    {   return thread_number; }
+
+    // ------------------------------------------------------------------------
+    // get memory using a specified thread number
+    void get_job(size_t thread, size_t min_bytes, void** v_ptr, size_t* cap)
+    {   thread_number = thread;
+        *v_ptr = thread_alloc::get_memory(min_bytes, *cap);
+    }
+    // check that the owner drains its queue during get_memory
+    bool check_drain(void)
+    {   bool ok = true;
+        size_t min_bytes = 100;
+        size_t cap_bytes;
+        void*  v_ptr;
+        //
+        // thread one gets the memory
+        parallel_mode = true;
+        std::thread first(get_job, 1, min_bytes, &v_ptr, &cap_bytes);
+        first.join();
+        //
+        // thread zero returns it
+        thread_alloc::return_memory(v_ptr);
+        parallel_mode = false;
+        //
+        // it is still in use by thread one
+        ok &= thread_alloc::inuse(1)     == cap_bytes;
+        ok &= thread_alloc::available(1) == 0;
+        //
+        // the next get_memory by thread one reuses the block
+        parallel_mode = true;
+        void* v_ptr_2;
+        std::thread second(get_job, 1, min_bytes, &v_ptr_2, &cap_bytes);
+        second.join();
+        parallel_mode = false;
+        ok &= v_ptr_2 == v_ptr;
+        ok &= thread_alloc::inuse(1)     == cap_bytes;
+        ok &= thread_alloc::available(1) == 0;
+        //
+        // thread one returns it for the last time
+        parallel_mode = true;
+        std::thread third(get_job, 1, 0, &v_ptr, &cap_bytes);
+        third.join();
+        thread_alloc::return_memory(v_ptr_2);
+        thread_alloc::return_memory(v_ptr);
+        parallel_mode = false;
+        //
+        // free_available also drains the queue
+        thread_alloc::free_available(1);
+        ok &= thread_alloc::inuse(1)     == 0;
+        ok &= thread_alloc::available(1) == 0;
+        //
+        return ok;
+    }
+    // ------------------------------------------------------------------------
+    // blocks that each thread allocates
+    const size_t n_block = 300;
+    std::vector<void*> block;
+    //
+    // allocate blocks for this thread
+    void allocate_job(size_t thread)
+    {   thread_number = thread;
+        size_t cap_bytes;
+        for(size_t k = 0; k < n_block; ++k)
+        {   size_t min_bytes = 10 * (k % 7 + 1);
+            block[thread * n_block + k] =
+                thread_alloc::get_memory(min_bytes, cap_bytes);
+        }
+    }
+    //
+    // return blocks that were allocated by other threads while this thread
+    // also allocates and returns its own memory
+    void mixed_job(size_t thread, size_t num_threads)
+    {   thread_number = thread;
+        size_t cap_bytes;
+        for(size_t owner = 0; owner < num_threads; ++owner)
+        for(size_t k = 0; k < n_block; ++k)
+        {   size_t pusher = (owner + 1 + k % (num_threads - 1)) % num_threads;
+            if( pusher == thread )
+                thread_alloc::return_memory( block[owner * n_block + k] );
+            //
+            void* v_ptr = thread_alloc::get_memory(10 * (k % 7 + 1), cap_bytes);
+            thread_alloc::return_memory(v_ptr);
+        }
+    }
+    // check many threads returning memory for each other at the same time
+    bool check_concurrent(void)
+    {   bool ok = true;
+        size_t num_threads = 4;
+        block.resize(num_threads * n_block);
+        size_t inuse_zero  = thread_alloc::inuse(0);
+        //
+        parallel_mode = true;
+        std::vector<std::thread> worker;
+        for(size_t thread = 1; thread < num_threads; ++thread)
+            worker.push_back( std::thread(allocate_job, thread) );
+        allocate_job(0);
+        for(size_t i = 0; i < worker.size(); ++i)
+            worker[i].join();
+        //
+        worker.clear();
+        for(size_t thread = 1; thread < num_threads; ++thread)
+            worker.push_back( std::thread(mixed_job, thread, num_threads) );
+        mixed_job(0, num_threads);
+        for(size_t i = 0; i < worker.size(); ++i)
+            worker[i].join();
+        parallel_mode = false;
+        thread_number = 0;
+        //
+        // all of the blocks were returned
+        thread_alloc::free_available(0);
+        ok &= thread_alloc::inuse(0) == inuse_zero;
+        for(size_t thread = 1; thread < num_threads; ++thread)
+        {   thread_alloc::free_available(thread);
+            ok &= thread_alloc::inuse(thread)     == 0;
+            ok &= thread_alloc::available(thread) == 0;
+        }
+        return ok;
+    }
+}
+
+bool remote_free(void)
+{   bool ok = true;
+    //
+    size_t num_threads = 4;
+    bool   hold_memory = true;
+    thread_alloc::parallel_setup(num_threads, in_parallel, thread_num);
+    thread_alloc::hold_memory(hold_memory);
+    //
+    ok &= check_drain();
+    ok &= check_concurrent();
+    //
+    hold_memory = false;
+    thread_alloc::hold_memory(hold_memory);
+    thread_alloc::parallel_setup(1, nullptr, nullptr);
+    //
+    return ok;
+}
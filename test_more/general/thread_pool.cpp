@@ -0,0 +1,226 @@
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-22 Bradley M. Bell
+
+CppAD is distributed under the terms of the
+             Eclipse Public License Version 2.0.
+
+This Source Code may also be made available under the following
+Secondary License when the conditions for such availability set forth
+in the Eclipse Public License, Version 2.0 are satisfied:
+      GNU General Public License, Version 2.0 or later.
+---------------------------------------------------------------------------- */
+/*
+Test the driver routines that use a thread_pool by comparing their results
+with the results when no pool is used.
+*/
+# include <cppad/cppad.hpp>
+
+namespace {
+    using CppAD::AD;
+    using CppAD::NearEqual;
+    using CppAD::sparse_rc;
+    using CppAD::sparse_rcv;
+    //
+    typedef CPPAD_TESTVECTOR(double)       d_vector;
+    typedef CPPAD_TESTVECTOR(size_t)       s_vector;
+    typedef CPPAD_TESTVECTOR(bool)         b_vector;
+    typedef CPPAD_TESTVECTOR( AD<double> ) a_vector;
+    //
+    double eps99 = 99.0 * std::numeric_limits<double>::epsilon();
+    //
+    bool check_vector(const d_vector& check, const d_vector& value)
+    {   bool ok = size_t( check.size() ) == size_t( value.size() );
+        for(size_t i = 0; i < size_t( check.size() ); ++i)
+            ok &= NearEqual(check[i], value[i], eps99, eps99);
+        return ok;
+    }
+    //
+    // y_i = x_i * x_{i+1} + sin(x_i) for i < n-1,
+    // y_{n-1} = x_0 * x_{n-1} and y_n = sum_j x_j * x_j
+    void record(size_t n, CppAD::ADFun<double>& f)
+    {   a_vector ax(n), ay(n + 1);
+        for(size_t j = 0; j < n; ++j)
+            ax[j] = double(j + 1);
+        CppAD::Independent(ax);
+        for(size_t i = 0; i < n - 1; ++i)
+            ay[i] = ax[i] * ax[i+1] + sin( ax[i] );
+        ay[n-1] = ax[0] * ax[n-1];
+        ay[n]   = 0.0;
+        for(size_t j = 0; j < n; ++j)
+            ay[n] += ax[j] * ax[j];
+        f.Dependent(ax, ay);
+    }
+    //
+    bool dense_drivers(CppAD::ADFun<double>& f, CppAD::thread_pool& pool)
+    {   bool ok = true;
+        size_t n = f.Domain();
+        size_t m = f.Range();
+        //
+        d_vector x(n), w(m);
+        for(size_t j = 0; j < n; ++j)
+            x[j] = 0.5 + double(j);
+        for(size_t i = 0; i < m; ++i)
+            w[i] = double(i + 1);
+        //
+        // Jacobian (forward mode because m > n)
+        d_vector check = f.Jacobian(x);
+        ok &= check_vector(check, f.Jacobian(x, pool) );
+        //
+        // Hessian
+        check = f.Hessian(x, w);
+        ok &= check_vector(check, f.Hessian(x, w, pool) );
+        //
+        // Jacobian (reverse mode because g has one component)
+        // g(x) = sum_j x_j * x_j * x_{j+1}
+        CppAD::ADFun<double> g;
+        a_vector ax(n), ay(1);
+        for(size_t j = 0; j < n; ++j)
+            ax[j] = x[j];
+        CppAD::Independent(ax);
+        ay[0] = 0.0;
+        for(size_t j = 0; j < n; ++j)
+            ay[0] += ax[j] * ax[j] * ax[ (j + 1) % n ];
+        g.Dependent(ax, ay);
+        check = g.Jacobian(x);
+        ok &= check_vector(check, g.Jacobian(x, pool) );
+        //
+        return ok;
+    }
+    //
+    bool sparse_jac_drivers(CppAD::ADFun<double>& f, CppAD::thread_pool& pool)
+    {   bool ok = true;
+        size_t n = f.Domain();
+        size_t m = f.Range();
+        //
+        d_vector x(n);
+        for(size_t j = 0; j < n; ++j)
+            x[j] = 0.5 + double(j);
+        //
+        // sparsity pattern for the Jacobian
+        b_vector select_domain(n), select_range(m);
+        for(size_t j = 0; j < n; ++j)
+            select_domain[j] = true;
+        for(size_t i = 0; i < m; ++i)
+            select_range[i] = true;
+        sparse_rc<s_vector> pattern;
+        bool transpose = false;
+        f.subgraph_sparsity(select_domain, select_range, transpose, pattern);
+        //
+        const char* coloring_list[] = { "cppad", "cppad.bidirectional" };
+        size_t      group_list[]    = { 1, 3 };
+        for(size_t i_coloring = 0; i_coloring < 2; ++i_coloring)
+        for(size_t i_group = 0; i_group < 2; ++i_group)
+        for(size_t i_mode = 0; i_mode < 2; ++i_mode)
+        {   std::string coloring = coloring_list[i_coloring];
+            size_t group_max     = group_list[i_group];
+            bool   forward       = i_mode == 0;
+            //
+            sparse_rcv<s_vector, d_vector> check(pattern), subset(pattern);
+            CppAD::sparse_jac_work work_check, work;
+            size_t n_check, n_color;
+            if( forward )
+            {   n_check = f.sparse_jac_for(
+                    group_max, x, check, pattern, coloring, work_check
+                );
+                n_color = f.sparse_jac_for(
+                    group_max, x, subset, pattern, coloring, work, pool
+                );
+            }
+            else
+            {   n_check = f.sparse_jac_rev(
+                    x, check, pattern, coloring, work_check
+                );
+                n_color = f.sparse_jac_rev(
+                    x, subset, pattern, coloring, work, pool
+                );
+            }
+            ok &= n_color == n_check;
+            ok &= check_vector(check.val(), subset.val());
+            //
+            // use the work computed during the previous call
+            for(size_t k = 0; k < subset.nnz(); ++k)
+                subset.set(k, 0.0);
+            if( forward ) f.sparse_jac_for(
+                group_max, x, subset, pattern, coloring, work, pool
+            );
+            else f.sparse_jac_rev(
+                x, subset, pattern, coloring, work, pool
+            );
+            ok &= check_vector(check.val(), subset.val());
+        }
+        return ok;
+    }
+    //
+    bool sparse_hes_driver(CppAD::ADFun<double>& f, CppAD::thread_pool& pool)
+    {   bool ok = true;
+        size_t n = f.Domain();
+        size_t m = f.Range();
+        //
+        d_vector x(n), w(m);
+        for(size_t j = 0; j < n; ++j)
+            x[j] = 0.5 + double(j);
+        for(size_t i = 0; i < m; ++i)
+            w[i] = double(i + 1);
+        //
+        // sparsity pattern for the Hessian
+        b_vector select_domain(n), select_range(m);
+        for(size_t j = 0; j < n; ++j)
+            select_domain[j] = true;
+        for(size_t i = 0; i < m; ++i)
+            select_range[i] = true;
+        bool internal_bool = false;
+        sparse_rc<s_vector> pattern;
+        f.for_hes_sparsity(
+            select_domain, select_range, internal_bool, pattern
+        );
+        //
+        const char* coloring_list[] = {
+            "cppad.symmetric", "cppad.general", "cppad.star", "cppad.acyclic"
+        };
+        for(size_t i_coloring = 0; i_coloring < 4; ++i_coloring)
+        {   std::string coloring = coloring_list[i_coloring];
+            sparse_rcv<s_vector, d_vector> check(pattern), subset(pattern);
+            CppAD::sparse_hes_work work_check, work;
+            size_t n_check = f.sparse_hes(
+                x, w, check, pattern, coloring, work_check
+            );
+            //
+            // the first call computes work (without using the pool)
+            size_t n_sweep = f.sparse_hes(
+                x, w, subset, pattern, coloring, work, pool
+            );
+            ok &= n_sweep == n_check;
+            ok &= check_vector(check.val(), subset.val());
+            //
+            // the second call uses the pool
+            for(size_t k = 0; k < subset.nnz(); ++k)
+                subset.set(k, 0.0);
+            n_sweep = f.sparse_hes(
+                x, w, subset, pattern, coloring, work, pool
+            );
+            ok &= n_sweep == n_check;
+            ok &= check_vector(check.val(), subset.val());
+        }
+        return ok;
+    }
+}
+
+bool thread_pool(void)
+{   bool ok = true;
+    //
+    size_t n = 12;
+    CppAD::ADFun<double> f;
+    record(n, f);
+    {   // pool of threads
+        size_t num_threads = 3;
+        CppAD::thread_pool pool(num_threads);
+        CppAD::parallel_ad<double>();
+        //
+        ok &= dense_drivers(f, pool);
+        ok &= sparse_jac_drivers(f, pool);
+        ok &= sparse_hes_driver(f, pool);
+    }
+    ok &= CppAD::thread_alloc::num_threads() == 1;
+    //
+    return ok;
+}